@@ -0,0 +1,179 @@
+/*
+ * enginethread.cpp
+ *
+ * Single engine thread fed by a bounded multi-producer queue (see enginethread.hpp)
+ */
+
+#include "enginethread.hpp"
+#include <stdexcept>
+
+#define ENGINE_SPINS_BEFORE_PARK 64
+
+enginethread::enginethread(size_t capacity) : mask(0), head(0), tail(0), sleeping(false), stopping(false), submitting(0), waiting(0)
+{
+   size_t n = 2;
+   while (n < capacity)
+      n <<= 1;
+   ring = std::vector<slot>(n);
+   mask = n - 1;
+   for (size_t i = 0; i < n; i++)
+      ring[i].turn.store(i, std::memory_order_relaxed);
+}
+
+enginethread::~enginethread()
+{
+   stop();
+}
+
+void enginethread::start(void) {
+   if (!thread.joinable() && !stopping)
+      thread = std::thread(&enginethread::loop, this);
+}
+
+void enginethread::stop(void) {
+   {
+      std::lock_guard<std::mutex> guard(parklock);
+      stopping = true;
+      sleeping = false;
+   }
+   park.notify_one();
+   {
+      std::lock_guard<std::mutex> guard(roomlock);
+   }
+   room.notify_all();                       // producers waiting for room give up
+   if (thread.joinable())
+      thread.join();
+   else
+      fail_queued();
+}
+
+static std::future<void> stopped_future(void) {
+   std::promise<void> failed;
+   failed.set_exception(std::make_exception_ptr(std::runtime_error("engine thread is stopped")));
+   return failed.get_future();
+}
+
+//
+// Queue a command. Claims the slot at head once its turn comes round (it is free), fills it,
+// then marks it full for the engine thread. Counted in submitting throughout, so the engine
+// thread does not exit under it; stop() either sees it counted or it sees stopping.
+//
+std::future<void> enginethread::submit(std::function<void()> command) {
+   submitting.fetch_add(1, std::memory_order_seq_cst);
+   if (stopping.load(std::memory_order_seq_cst)) {
+      submitting.fetch_sub(1, std::memory_order_seq_cst);
+      return stopped_future();
+   }
+   size_t pos = head.load(std::memory_order_relaxed);
+   slot *s;
+   for (;;) {
+      s = &ring[pos & mask];
+      size_t turn = s->turn.load(std::memory_order_acquire);
+      if (turn == pos) {
+         if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            break;
+      } else if (turn < pos) {
+         // Full: the engine has not run this slot yet. Pairs with loop(), which frees the slot
+         // before it looks at waiting, as this counts itself in waiting before it looks at the slot.
+         waiting.fetch_add(1, std::memory_order_seq_cst);
+         {
+            std::unique_lock<std::mutex> guard(roomlock);
+            room.wait(guard, [&] { return s->turn.load(std::memory_order_seq_cst) != turn || stopping; });
+         }
+         waiting.fetch_sub(1, std::memory_order_seq_cst);
+         if (stopping) {
+            submitting.fetch_sub(1, std::memory_order_seq_cst);
+            return stopped_future();
+         }
+         pos = head.load(std::memory_order_relaxed);
+      } else {
+         pos = head.load(std::memory_order_relaxed);   // another producer took it
+      }
+   }
+   s->command = std::move(command);
+   s->done = std::promise<void>();
+   s->queued = std::chrono::steady_clock::now();
+   auto future = s->done.get_future();
+   s->turn.store(pos + 1, std::memory_order_seq_cst);
+   submitting.fetch_sub(1, std::memory_order_seq_cst);
+
+   // Pairs with loop(): it sets sleeping before it looks at the ring one last time, and this
+   // looks at sleeping after filling the slot, so one of the two sees the other.
+   if (sleeping.load(std::memory_order_seq_cst)) {
+      {
+         std::lock_guard<std::mutex> guard(parklock);
+         sleeping = false;
+      }
+      park.notify_one();
+   }
+   return future;
+}
+
+bool enginethread::ready(void) const {
+   return ring[tail & mask].turn.load(std::memory_order_seq_cst) == tail + 1;
+}
+
+// A submit() still under way has a slot claimed or about to be, so the engine waits it out
+bool enginethread::drained(void) const {
+   return stopping.load(std::memory_order_seq_cst) &&
+          submitting.load(std::memory_order_seq_cst) == 0 &&
+          head.load(std::memory_order_seq_cst) == tail;
+}
+
+void enginethread::fail_queued(void) {
+   while (submitting.load(std::memory_order_seq_cst) > 0)
+      std::this_thread::yield();
+   for (; tail != head.load(std::memory_order_seq_cst); tail++) {
+      slot & s = ring[tail & mask];
+      s.command = nullptr;
+      s.done.set_exception(std::make_exception_ptr(std::runtime_error("engine thread is stopped")));
+      s.turn.store(tail + mask + 1, std::memory_order_release);
+   }
+}
+
+void enginethread::loop(void) {
+   int idle = 0;
+   for (;;) {
+      if (ready()) {
+         slot & s = ring[tail & mask];
+         auto command = std::move(s.command);
+         auto done = std::move(s.done);
+         auto start = std::chrono::steady_clock::now();
+         waits.observe(start - s.queued);
+         s.command = nullptr;
+         s.turn.store(tail + mask + 1, std::memory_order_seq_cst);   // free for the next lap
+         tail++;
+         idle = 0;
+         if (waiting.load(std::memory_order_seq_cst) > 0) {
+            {
+               std::lock_guard<std::mutex> guard(roomlock);
+            }
+            room.notify_all();
+         }
+         try {
+            command();
+            runs.observe(std::chrono::steady_clock::now() - start);
+            done.set_value();
+         } catch (...) {
+            runs.observe(std::chrono::steady_clock::now() - start);
+            done.set_exception(std::current_exception());
+         }
+         continue;
+      }
+      if (drained())
+         return;
+      if (++idle < ENGINE_SPINS_BEFORE_PARK || stopping) {
+         std::this_thread::yield();       // stopping: a submit() under way is about to fill its slot
+         continue;
+      }
+      std::unique_lock<std::mutex> guard(parklock);
+      sleeping = true;
+      if (ready() || stopping) {
+         sleeping = false;
+         continue;
+      }
+      park.wait(guard, [this] { return !sleeping || stopping; });
+      sleeping = false;
+      idle = 0;
+   }
+}
@@ -0,0 +1,79 @@
+#ifndef ENGINETHREAD_H
+#define ENGINETHREAD_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "metrics.hpp"
+
+//
+// The one thread that calls into libEA. Request threads parse and validate, then hand the
+// engine a command (set the time, add samples, step, set a knob, answer a case, ...) and wait
+// on its future, which is done once the command has run, or holds what it threw. Commands run
+// one at a time in the order they were queued, so no lock is needed around libEA.
+//
+// The queue is a bounded ring that many threads add to and only the engine thread takes from.
+// Adding is lock-free: a producer claims a slot with one compare-and-swap on head. A producer
+// finding the ring full waits on room until the engine frees a slot. The mutexes are only for
+// parking the engine thread when there is nothing to do, and producers when there is no room.
+//
+// Once stop() is called, submit() fails at once: its future holds a runtime_error. Commands
+// already claimed by a submit() still under way are run before the engine thread exits, so
+// every future handed out is done by the time stop() returns.
+//
+class enginethread
+{
+   public:
+      explicit enginethread(size_t);     // capacity, rounded up to a power of two
+      ~enginethread();
+
+      void start(void);
+      void stop(void);                   // runs what is already queued, then joins
+
+      std::future<void> submit(std::function<void()>);
+      void run(std::function<void()> command) { submit(std::move(command)).get(); }   // rethrows
+
+      // How long commands waited in the queue, and how long they then ran (for GET /metrics)
+      const histogram & queue_waits(void) const { return waits; }
+      const histogram & command_runs(void) const { return runs; }
+
+   private:
+      struct slot
+      {
+         std::atomic<size_t> turn;       // == position when free to fill, position + 1 when full
+         std::function<void()> command;
+         std::promise<void> done;
+         std::chrono::steady_clock::time_point queued;
+      };
+
+      void loop(void);
+      bool ready(void) const;            // engine thread only: is the slot at tail full?
+      bool drained(void) const;          // engine thread only: stopping, and nothing left to run
+      void fail_queued(void);            // stop() without an engine thread: fail what is queued
+
+      std::vector<slot> ring;
+      size_t mask;
+      std::atomic<size_t> head;          // next position to fill (producers)
+      size_t tail;                       // next position to run (engine thread only)
+
+      std::mutex parklock;
+      std::condition_variable park;
+      std::atomic<bool> sleeping;
+      std::atomic<bool> stopping;
+      std::atomic<size_t> submitting;    // submit() calls under way
+      std::mutex roomlock;
+      std::condition_variable room;
+      std::atomic<size_t> waiting;       // producers waiting on room
+      std::thread thread;
+
+      histogram waits;
+      histogram runs;
+};
+
+#endif // ENGINETHREAD_H
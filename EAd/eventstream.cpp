@@ -0,0 +1,78 @@
+/*
+ * eventstream.cpp
+ *
+ * Server-Sent Events push to subscribers (see eventstream.hpp)
+ */
+
+#include "eventstream.hpp"
+
+using namespace web;
+using namespace http;
+
+eventstream::eventstream(size_t queuebytes) : maxqueue(queuebytes), count(0), dropped(0)
+{
+}
+
+//
+// One SSE event: "id" lets a client that reconnects tell where it left off, "event" is the
+// event type and "data" its json (which never holds a newline, as serialize() writes none).
+//
+std::string eventstream::format(const std::string &event, uint64_t id, const std::string &data) {
+   std::string out;
+   out.reserve(data.size() + event.size() + 40);
+   out += "id: ";
+   out += std::to_string(id);
+   out += "\nevent: ";
+   out += event;
+   out += "\ndata: ";
+   out += data;
+   out += "\n\n";
+   return out;
+}
+
+// Append to one buffer. The buffer may read the bytes after this returns, so the
+// continuation holds the string until it has.
+void eventstream::send(Buffer_t &buf, const std::shared_ptr<const std::string> &text) {
+   buf.putn_nocopy(reinterpret_cast<const uint8_t *>(text->data()), text->size()).then([text](pplx::task<size_t> t) {
+      try { t.get(); } catch (...) { }
+   });
+}
+
+void eventstream::subscribe(const http_request &message, const std::string &first) {
+   std::lock_guard<std::mutex> guard(lock);
+   subs.emplace_back();
+   auto &buf = subs.back();
+   count = subs.size();
+
+   http_response response (status_codes::OK);
+   response.headers().add(U("Cache-Control"), U("no-cache"));
+   response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
+   response.headers().add(U("X-Accel-Buffering"), U("no"));       // stop nginx from holding events back
+   response.set_body(buf.create_istream(), U("text/event-stream"));
+   message.reply(response);
+   send(buf, std::make_shared<const std::string>(first));
+}
+
+void eventstream::publish(const std::string &event) {
+   auto text = std::make_shared<const std::string>(event);
+   std::lock_guard<std::mutex> guard(lock);
+   for (auto it = subs.begin(); it != subs.end(); ) {
+      if (it->in_avail() + text->size() > maxqueue) {
+         it->close(std::ios_base::out);     // ends the reply
+         it = subs.erase(it);
+         dropped++;
+      } else {
+         send(*it, text);
+         ++it;
+      }
+   }
+   count = subs.size();
+}
+
+void eventstream::close(void) {
+   std::lock_guard<std::mutex> guard(lock);
+   for (auto &buf : subs)
+      buf.close(std::ios_base::out);
+   subs.clear();
+   count = 0;
+}
@@ -0,0 +1,44 @@
+#ifndef EVENTSTREAM_H
+#define EVENTSTREAM_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "stdafx.h"
+
+//
+// Server-Sent Events subscribers (GET /ctrl/stream). Each subscriber's reply is left open with a
+// producer/consumer buffer as its body, and each event is appended to every buffer. cpprest sends
+// a buffer's contents as fast as its client reads them. A buffer that has grown past the queue
+// limit belongs to a client that is not keeping up (or is gone), so it is closed and dropped.
+// Publishing never waits on a client.
+//
+class eventstream
+{
+   public:
+      explicit eventstream(size_t);
+
+      void subscribe(const web::http::http_request &, const std::string &);   // replies with first event
+      void publish(const std::string &);
+      void close(void);                   // end every subscriber's reply, e.g. at shutdown
+      size_t subscribers(void) const { return count; }
+      size_t subscribers_dropped(void) const { return dropped; }
+
+      static std::string format(const std::string &, uint64_t, const std::string &);
+
+   private:
+      typedef concurrency::streams::producer_consumer_buffer<uint8_t> Buffer_t;
+
+      static void send(Buffer_t &, const std::shared_ptr<const std::string> &);
+
+      std::mutex lock;
+      size_t maxqueue;                    // bytes a subscriber may have waiting before it is dropped
+      std::list<Buffer_t> subs;
+      std::atomic<size_t> count;
+      std::atomic<size_t> dropped;        // slow or closed subscribers ended by publish()
+};
+
+#endif // EVENTSTREAM_H
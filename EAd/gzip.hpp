@@ -1,46 +1,94 @@
-// As found here: https://gist.github.com/yfnick/6ba33efa7ba12e93b148
+// Originally as found here: https://gist.github.com/yfnick/6ba33efa7ba12e93b148
+// (since rewritten over zlib directly)
 
-// This is a header-only implementation of a class to do gzip best_compression
-// and decompression of simple strings.
+// This is a header-only implementation of a class to do gzip compression
+// and decompression of simple strings, and to read an Accept-Encoding header.
 
 #ifndef __GZIP_H__
 #define __GZIP_H__
 
+#include <cctype>
+#include <cstdlib>
 #include <sstream>
-#include <boost/iostreams/filtering_streambuf.hpp>
-#include <boost/iostreams/copy.hpp>
-#include <boost/iostreams/filter/gzip.hpp>
+#include <stdexcept>
+#include <string>
+#include <zlib.h>
 
 class Gzip {
 public:
-	static std::string compress(const std::string& data)
+	// Compress in one pass straight into the returned string, which is sized up front by
+	// deflateBound() so there are no intermediate buffers. Level is zlib's: 1 is fastest,
+	// 9 is smallest; 6 is zlib's default and usually the best trade.
+	static std::string compress(const std::string& data, int level = Z_BEST_COMPRESSION)
 	{
-		namespace bio = boost::iostreams;
+		z_stream zs = {};
+		if (deflateInit2(&zs, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)	// +16 = gzip wrapper
+			throw std::runtime_error("Gzip::compress: deflateInit2 failed");
 
-		std::stringstream compressed;
-		std::stringstream origin(data);
+		std::string compressed;
+		compressed.resize(deflateBound(&zs, data.size()));
+		zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+		zs.avail_in = data.size();
+		zs.next_out = reinterpret_cast<Bytef*>(&compressed[0]);
+		zs.avail_out = compressed.size();
+		int rc = deflate(&zs, Z_FINISH);
+		compressed.resize(zs.total_out);
+		deflateEnd(&zs);
+		if (rc != Z_STREAM_END)
+			throw std::runtime_error("Gzip::compress: deflate did not finish");
 
-		bio::filtering_streambuf<bio::input> out;
-		out.push(bio::gzip_compressor(bio::gzip_params(bio::gzip::best_compression)));
-		out.push(origin);
-		bio::copy(out, compressed);
-
-		return compressed.str();
+		return compressed;
 	}
 
 	static std::string decompress(const std::string& data)
 	{
-		namespace bio = boost::iostreams;
+		z_stream zs = {};
+		if (inflateInit2(&zs, 15 + 32) != Z_OK)	// +32 = detect gzip or zlib wrapper
+			throw std::runtime_error("Gzip::decompress: inflateInit2 failed");
 
-		std::stringstream compressed(data);
-		std::stringstream decompressed;
+		std::string decompressed;
+		char chunk[16384];
+		zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+		zs.avail_in = data.size();
+		int rc;
+		do {
+			zs.next_out = reinterpret_cast<Bytef*>(chunk);
+			zs.avail_out = sizeof(chunk);
+			rc = inflate(&zs, Z_NO_FLUSH);
+			if (rc != Z_OK && rc != Z_STREAM_END) {
+				inflateEnd(&zs);
+				throw std::runtime_error("Gzip::decompress: corrupt input");
+			}
+			decompressed.append(chunk, sizeof(chunk) - zs.avail_out);
+		} while (rc != Z_STREAM_END && (zs.avail_in > 0 || zs.avail_out == 0));
+		inflateEnd(&zs);
 
-		bio::filtering_streambuf<bio::input> out;
-		out.push(bio::gzip_decompressor());
-		out.push(compressed);
-		bio::copy(out, decompressed);
+		return decompressed;
+	}
 
-		return decompressed.str();
+	// True if an Accept-Encoding header value allows a gzip reply, i.e., it names gzip (or
+	// x-gzip, or *) with a nonzero q-value. An explicit "gzip;q=0" wins over "*".
+	static bool accepted(const std::string& acceptEncoding)
+	{
+		std::stringstream ss(acceptEncoding);
+		std::string item;
+		int gzip = -1, star = -1;	// -1 not named, 0 refused, 1 accepted
+		while (std::getline(ss, item, ',')) {
+			std::string coding = item.substr(0, item.find(';'));
+			coding.erase(0, coding.find_first_not_of(" \t"));
+			coding.erase(coding.find_last_not_of(" \t") + 1);
+			for (auto& c : coding)
+				c = std::tolower(c);
+			bool ok = true;
+			auto q = item.find("q=");
+			if (q != std::string::npos)
+				ok = (std::strtod(item.c_str() + q + 2, nullptr) > 0.0);
+			if (coding == "gzip" || coding == "x-gzip")
+				gzip = ok ? 1 : 0;
+			else if (coding == "*")
+				star = ok ? 1 : 0;
+		}
+		return (gzip == 1) || (gzip == -1 && star == 1);
 	}
 };
 
@@ -9,9 +9,10 @@
 #include "handler.hpp"
 #include "apiver.hpp"
 #include "exportCalls.hpp"
+#include "cpprest/rawptrstream.h"
 #include <iostream>
 #include <string>
-#include <regex>
+#include <unordered_map>
 #include <algorithm>
 #include <ctime>
 #include <memory>
@@ -35,7 +36,91 @@ using namespace http;
 using namespace utility;
 using namespace http::experimental::listener;
 
-const std::regex handler::re_api("^(/v([0-9]+))?(/.*)$");
+// Route tables, built once at startup, so a request costs one hash lookup on its path
+// (after any /vN prefix is stripped). Each handler is defined further down.
+const std::unordered_map<utility::string_t, handler::route_t> handler::get_routes = {
+   { U("/apiver"), &handler::get_noop },
+   { U("/api"), &handler::get_noop },
+   { U("/noop"), &handler::get_noop },
+   { U("/ctrl/eventwait"), &handler::get_ctrl_eventwait },
+   { U("/domain"), &handler::get_domain },
+   { U("/casekeys"), &handler::get_casekeys },
+   { U("/casecounts"), &handler::get_casecounts },
+   { U("/case"), &handler::get_case },
+   { U("/cases"), &handler::get_cases },
+   { U("/featurekeys"), &handler::get_featurekeys },
+   { U("/feature"), &handler::get_feature },
+   { U("/features"), &handler::get_features },
+   { U("/krono"), &handler::get_krono },
+   { U("/subjectkeys"), &handler::get_subjectkeys },
+   { U("/subjects"), &handler::get_subjects },
+   { U("/subject"), &handler::get_subject },
+   { U("/alerts"), &handler::get_alerts },
+   { U("/batch"), &handler::get_batch },
+   { U("/ctrl/stream"), &handler::get_ctrl_stream },
+   { U("/metrics"), &handler::get_metrics },
+   { U("/debug/trace"), &handler::get_debug_trace }
+};
+
+const std::unordered_map<utility::string_t, handler::route_t> handler::post_routes = {
+   { U("/ctrl/singlestep"), &handler::post_ctrl_singlestep },
+   { U("/ctrl/shutdown"), &handler::post_ctrl_shutdown }
+};
+
+const std::unordered_map<utility::string_t, handler::route_t> handler::put_routes = {
+   { U("/ctrl/time"), &handler::put_ctrl_time },
+   { U("/ctrl/sample"), &handler::put_ctrl_sample },
+   { U("/ctrl/sampletimestep"), &handler::put_ctrl_sampletimestep },
+   { U("/ctrl/answercase"), &handler::put_ctrl_answercase },
+   { U("/set/knob"), &handler::put_set_knob },
+   { U("/set/histogram/mode"), &handler::put_set_histogram_mode },
+   { U("/set/histogram/span"), &handler::put_set_histogram_span },
+   { U("/ctrl/ingest"), &handler::put_ctrl_ingest },
+   { U("/ctrl/layout"), &handler::put_ctrl_layout }
+};
+
+// Split "/vN/rest" into api version N (clamped to 1..api_latest_version) and "/rest". A path
+// without a version prefix keeps the caller's api and is routed as is. False if not a path.
+bool handler::split_api_path(const utility::string_t &fullpath, int &api, utility::string_t &path) {
+   if (fullpath.empty() || fullpath[0] != U('/'))
+      return false;
+   size_t i = 2;
+   if (fullpath.size() > 2 && fullpath[1] == U('v')) {
+      int v = 0;
+      while (i < fullpath.size() && fullpath[i] >= U('0') && fullpath[i] <= U('9') && v < 100000)
+         v = v * 10 + (fullpath[i++] - U('0'));
+      if (i > 2 && i < fullpath.size() && fullpath[i] == U('/')) {
+         api = std::max(1, std::min(v, api_latest_version));
+         ucout << "Set API version to " << v << endl;
+         path = fullpath.substr(i);
+         return true;
+      }
+   }
+   path = fullpath;
+   return true;
+}
+
+// Optional "since" of the list GETs: if given, the reply lists only the objects whose reply
+// changed after that seq, and echoes it. Returns true if given (and good).
+bool handler::get_since(request_args & req, json::value & reply, status_code & retval, uint64_t & since) {
+   if (!get_json_value(true, req.jvalue, req.querystringmap, U("since"), reply, since)) {
+      if (reply.has_field(U("error")))
+         retval = status_codes::BadRequest;
+      return false;
+   }
+   reply[U("since")] = json::value(since);
+   return true;
+}
+
+// GET routes replying with large object trees; these get compression_config::bulk_level
+const std::set<utility::string_t> handler::bulk_routes = {
+   U("/domain"), U("/case"), U("/cases"), U("/feature"), U("/features"), U("/krono"), U("/subject"), U("/subjects"), U("/batch")
+};
+
+// PUT routes that read the request body themselves, as it arrives, so handle_put leaves it alone
+const std::set<utility::string_t> handler::stream_routes = {
+   U("/ctrl/ingest")
+};
 
 // Use a global mutex to lock all libEA API calls since it's doubtful the back end
 // is thread-safe!
@@ -53,9 +138,9 @@ const std::regex handler::re_api("^(/v([0-9]+))?(/.*)$");
 //}
 
 #ifdef USE_SSL
-handler::handler(const utility::string_t& url, const web::http::experimental::listener::http_listener_config& server_config, IExportOmni *tool) : m_listener(url,server_config), p_Port(tool), domain(tool->SayInfoFromDomain()), seq(0), alertseq(0)
+handler::handler(const utility::string_t& url, const web::http::experimental::listener::http_listener_config& server_config, IExportOmni *tool) : m_listener(url,server_config), p_Port(tool), domain(tool->SayInfoFromDomain()), cache(DEFAULT_RESPONSECACHE_ENTRIES), compression{DEFAULT_GZIP_BULK_LEVEL, DEFAULT_GZIP_SMALL_LEVEL, DEFAULT_GZIP_MIN_BYTES}, events(DEFAULT_EVENTSTREAM_QUEUE_BYTES), stats(metric_routes()), traces(DEFAULT_TRACE_RING_ENTRIES), seq(0), engine(DEFAULT_ENGINE_QUEUE_COMMANDS)
 #else
-handler::handler(const utility::string_t& url, IExportOmni *tool) : m_listener(url), p_Port(tool), domain(tool->SayInfoFromDomain()), seq(0), alertseq(0)
+handler::handler(const utility::string_t& url, IExportOmni *tool) : m_listener(url), p_Port(tool), domain(tool->SayInfoFromDomain()), cache(DEFAULT_RESPONSECACHE_ENTRIES), compression{DEFAULT_GZIP_BULK_LEVEL, DEFAULT_GZIP_SMALL_LEVEL, DEFAULT_GZIP_MIN_BYTES}, events(DEFAULT_EVENTSTREAM_QUEUE_BYTES), stats(metric_routes()), traces(DEFAULT_TRACE_RING_ENTRIES), seq(0), engine(DEFAULT_ENGINE_QUEUE_COMMANDS)
 #endif
 {
    m_listener.support(methods::GET, std::bind(&handler::handle_get, this, std::placeholders::_1));
@@ -63,6 +148,11 @@ handler::handler(const utility::string_t& url, IExportOmni *tool) : m_listener(u
    m_listener.support(methods::POST, std::bind(&handler::handle_post, this, std::placeholders::_1));
    m_listener.support(methods::DEL, std::bind(&handler::handle_delete, this, std::placeholders::_1));
    m_listener.support(methods::OPTIONS, std::bind(&handler::handle_options, this, std::placeholders::_1));  // for CORS preflight requests
+
+   // Publish a first read model before the listener opens, so GETs always have one. Nothing
+   // else can call into libEA yet, so this runs here rather than on the engine thread.
+   publish_model();
+   engine.start();
 }
 
 handler::~handler()
@@ -72,6 +162,17 @@ handler::~handler()
    // ever be created and it will only be destroyed on exit, so doing nothing explicit is acceptable.
 }
 
+// Stop taking requests, then stop the engine thread once those in flight are done (they may
+// still be waiting on it), so nothing calls into libEA after this completes.
+pplx::task<void> handler::close()
+{
+   events.close();
+   return m_listener.close().then([this](pplx::task<void> t) {
+      engine.stop();
+      t.get();
+   });
+}
+
 void handler::handle_error(pplx::task<void>& t)
 {
    try { t.get(); }
@@ -355,10 +456,11 @@ bool handler::get_json_value(const bool optional, const json::value& jv, const s
 }
 
 //
-// Define some macros to streamline error handling below
+// Define some macros to streamline error handling below. CODE runs on the engine thread, and
+// the request thread waits for it, so CODE may use the caller's locals and reply.
 //
 #define TRYAPI0(CODE) \
-try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) { \
+try { run_engine([&] { CODE }); } catch (...) { \
    stringstream ss; \
    ss << "API call failed"; \
    reply[U("error")] = json::value(U(ss.str())); \
@@ -366,7 +468,7 @@ try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) {
    retval = status_codes::BadRequest; \
 }
 #define TRYAPI1(VAR,CODE) \
-   try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) { \
+   try { run_engine([&] { CODE }); } catch (...) { \
       stringstream ss; \
       ss << "API call failed for " #VAR "=" << VAR; \
       reply[U("error")] = json::value(U(ss.str())); \
@@ -374,7 +476,7 @@ try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) {
       retval = status_codes::BadRequest; \
    }
 #define TRYAPI2(VAR1,VAR2,CODE) \
-   try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) { \
+   try { run_engine([&] { CODE }); } catch (...) { \
       stringstream ss; \
       ss << "API call failed for " #VAR1 "=" << VAR1 << " " #VAR2 "=" << VAR2; \
       reply[U("error")] = json::value(U(ss.str())); \
@@ -382,7 +484,7 @@ try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) {
       retval = status_codes::BadRequest; \
    }
 #define TRYAPI3(VAR1,VAR2,VAR3,CODE) \
-   try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) { \
+   try { run_engine([&] { CODE }); } catch (...) { \
       stringstream ss; \
       ss << "API call failed for " #VAR1 "=" << VAR1 << " " #VAR2 "=" << VAR2 << " " #VAR3 "=" << VAR3; \
       reply[U("error")] = json::value(U(ss.str())); \
@@ -390,7 +492,7 @@ try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) {
       retval = status_codes::BadRequest; \
    }
 #define TRYAPI4(VAR1,VAR2,VAR3,VAR4,CODE) \
-   try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) { \
+   try { run_engine([&] { CODE }); } catch (...) { \
       stringstream ss; \
       ss << "API call failed for " #VAR1 "=" << VAR1 << " " #VAR2 "=" << VAR2 << " " #VAR3 "=" << VAR3 << " " #VAR4 "=" << VAR4; \
       reply[U("error")] = json::value(U(ss.str())); \
@@ -398,7 +500,7 @@ try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) {
       retval = status_codes::BadRequest; \
    }
 #define TRYAPI5(VAR1,VAR2,VAR3,VAR4,VAR5,CODE) \
-   try { std::lock_guard<std::mutex> glock(instance_api_lock); CODE } catch (...) { \
+   try { run_engine([&] { CODE }); } catch (...) { \
       stringstream ss; \
       ss << "API call failed for " #VAR1 "=" << VAR1 << " " #VAR2 "=" << VAR2 << " " #VAR3 "=" << VAR3 << " " #VAR4 "=" << VAR4 << " " #VAR5 "=" << VAR5; \
       reply[U("error")] = json::value(U(ss.str())); \
@@ -414,10 +516,11 @@ pplx::task<bool> handler::wait_for_event(uint64_t oldseq, unsigned int timeout)
    std::chrono::seconds duration(timeout);
 
    return pplx::create_task([=]{
-      std::cout << "wait_for_event:create_task waiting for lock" << std::endl;
+      stats.waiting(1);
       std::unique_lock<std::mutex> lk(cvm);
-      std::cout << "wait_for_event:create_task got lock; waiting for timeout or seq change" << std::endl;
-      return(cv.wait_for(lk, duration, [=]{ return(oldseq != seq); }));
+      bool changed = cv.wait_for(lk, duration, [=]{ return(oldseq != seq); });
+      stats.waiting(-1);
+      return(changed);
    });
 }
 
@@ -435,6 +538,151 @@ void handler::update_seq(void) {
    cv.notify_all();
 }
 
+//
+// Every (method, route) of the route tables, sorted, for the per-route series of GET /metrics
+//
+std::vector<std::pair<std::string, std::string>> handler::metric_routes(void) {
+   std::vector<std::pair<std::string, std::string>> all;
+   for (auto const & r : get_routes)
+      all.emplace_back("GET", r.first);
+   for (auto const & r : post_routes)
+      all.emplace_back("POST", r.first);
+   for (auto const & r : put_routes)
+      all.emplace_back("PUT", r.first);
+   std::sort(all.begin(), all.end());
+   return all;
+}
+
+//
+// Run a command on the engine thread and wait for it. If the calling request is being traced,
+// the time the command waited in the queue and the time it ran are added to its trace.
+//
+void handler::run_engine(std::function<void()> command) {
+   auto t = tracer::current();
+   if (t == nullptr) {
+      engine.run(std::move(command));
+      return;
+   }
+   auto queued = tracer::clock::now();
+   engine.run([&] {
+      auto started = tracer::clock::now();
+      tracer::add(t, "engine wait", queued, started);
+      try {
+         command();
+      } catch (...) {
+         tracer::add(t, "engine command", started, tracer::clock::now());
+         throw;
+      }
+      tracer::add(t, "engine command", started, tracer::clock::now());
+   });
+}
+
+//
+// Step the domain on the time and inputs already set, timing the step for GET /metrics
+//
+void handler::single_step(void) {
+   auto start = std::chrono::steady_clock::now();
+   p_Port->SingleStepDomainOnTimeAndInputs();
+   stats.stepped(start);
+}
+
+//
+// Take a new read model and make it the one GETs see. Call on the engine thread, after
+// anything that changes the back end. Alerts stay in libEA's ring; the model only notes
+// the id the next one will get, so a reply's alertseq matches the rest of the model.
+//
+void handler::publish_model(void) {
+   auto oldmodel = current_model();
+
+   // Realtime Kronos that GET replies showed, as if the GUI had asked libEA for them directly
+   if (oldmodel) {
+      for (auto const & k : oldmodel->kronosshown) {
+         if (k.second.load(std::memory_order_relaxed))
+            p_Port->NoteGuiRequestOnKrono(k.first);
+      }
+   }
+   std::shared_ptr<const readmodel> newmodel = std::make_shared<readmodel>(p_Port, domain, seq, oldmodel.get());
+
+   // Push what changed to stream subscribers. Done here, on the engine thread, so they get
+   // deltas in model order and a subscriber added by another command never misses one.
+   if (oldmodel && events.subscribers() > 0) {
+      auto newalerts = p_Port->SayAlertsFromDomainSince(oldmodel->alertseq);
+      events.publish(eventstream::format("step", newmodel->seq, json_delta(*oldmodel, *newmodel, newalerts).serialize()));
+   }
+
+   std::atomic_store(&model, newmodel);
+}
+
+//
+// Latest published read model. The caller's copy of the pointer keeps it alive however
+// many models are published after it.
+//
+std::shared_ptr<const readmodel> handler::current_model(void) const {
+   return(std::atomic_load(&model));
+}
+
+//
+// Strong ETag for a GET reply built at this seq. The URL is implied by the request, so the seq
+// and the encoding alone tell replies apart.
+//
+utility::string_t handler::make_etag(uint64_t seqat, bool gzipped) {
+   return(U("\"") + std::to_string(seqat) + (gzipped ? U("-gzip") : U("")) + U("\""));
+}
+
+//
+// True if an If-None-Match header value ("*" or a comma-separated list of tags, possibly weak)
+// names this ETag
+//
+bool handler::etag_matches(const utility::string_t &header, const utility::string_t &etag) {
+   std::stringstream ss(header);
+   std::string tag;
+   while (std::getline(ss, tag, ',')) {
+      auto first = tag.find_first_not_of(" \t");
+      if (first == std::string::npos)
+         continue;
+      tag = tag.substr(first, tag.find_last_not_of(" \t") - first + 1);
+      if (tag.compare(0, 2, U("W/")) == 0)
+         tag = tag.substr(2);
+      if (tag == U("*") || tag == etag)
+         return(true);
+   }
+   return(false);
+}
+
+//
+// Reply to a GET with a serialized (and maybe gzipped) body. The body is streamed to the client
+// straight out of the entry's buffer, which the continuation keeps alive until the reply is sent,
+// so a body shared with the cache is never copied. Pass an empty etag for replies that must not
+// be cached.
+//
+void handler::reply_get(http_request &message, status_code retval, const responsecache::entry &e, const utility::string_t &etag) {
+   http_response response (retval);
+   response.headers().add(U("Cache-Control"), U("no-cache"));
+   response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
+   response.headers().add(U("Vary"), U("Accept-Encoding"));
+   if (!etag.empty())
+      response.headers().add(U("ETag"), etag);
+   if (e.compressed)
+      response.headers().add(U("Content-Encoding"), U("gzip"));
+   auto body = e.body;
+   auto stream = concurrency::streams::rawptr_stream<uint8_t>::open_istream(reinterpret_cast<const uint8_t*>(body->data()), body->size());
+   response.set_body(stream, body->size(), U("application/json"));
+   message.reply(response).then([body](pplx::task<void> t) {
+      try { t.get(); } catch (...) { /* client went away; nothing to do */ }
+   });
+}
+
+//
+// Set before open(); not changed while requests are being served
+//
+void handler::set_compression(const compression_config &config) {
+   compression = config;
+}
+
+void handler::set_tracing(const tracing_config &config) {
+   traces.configure(config);
+}
+
 // return a json object with a number
 inline static const json::value json_num(const GuiFpn_t fpn) {
    return(json::value(fpn));
@@ -729,13 +977,13 @@ inline static const json::value json_pointname(const EPointName & t) {
 
 
 // fill in a json object reference with subject data
-const json::value handler::json_subject(const NGuiKey & key, bool recurse) {
+const json::value handler::json_subject(const readmodel & m, const NGuiKey & key, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      obj[U("idtext")] = json_string(p_Port->SayTextIdentifyingSubject(key));
-      GuiPackSubjectBasic_t s = p_Port->SayInfoFromSubject(key);
+      obj[U("idtext")] = json_string(m.subjecttexts.at(key));
+      const GuiPackSubjectBasic_t & s = m.subjects.at(key);
       obj[U("reply")] = json_reply(s.getterReply);
       obj[U("domain")] = json_key(s.hostDomainKey);
       obj[U("label")] = json_string(s.infoText_byCR[0]);
@@ -759,30 +1007,30 @@ const json::value handler::json_subject(const NGuiKey & key, bool recurse) {
       i = 0;
       for (auto const& fkey : s.featureKeys) {
          if (recurse)
-            obj[U("features")][i] = json_feature(fkey);
+            obj[U("features")][i] = json_feature(m, fkey);
          obj[U("featurekeys")][i++] = json_key(fkey);
       }
       i = 0;
       for (auto const& kkey : s.paramKnobKeys) {
          if (recurse)
-            obj[U("knobs")][i] = json_knob(kkey);
+            obj[U("knobs")][i] = json_knob(m, kkey);
          obj[U("knobkeys")][i++] = json_key(kkey);
       }
       i = 0;
       for (auto const& kkey : s.ruleKitKeys) {
          if (recurse)
-            obj[U("rulekits")][i] = json_rulekit(kkey);
+            obj[U("rulekits")][i] = json_rulekit(m, kkey);
          obj[U("rulekitkeys")][i++] = json_key(kkey);
       }
       i = 0;
-      auto cases = p_Port->SayCurrentCasesFromSubject(key);
+      auto const & cases = m.subjectcases.at(key);
       for (auto const& ckey : cases.currentCaseKeys) {
          if (recurse)
-            obj[U("cases")][i] = json_case(ckey);
+            obj[U("cases")][i] = json_case(m, ckey);
          obj[U("casekeys")][i++] = json_key(ckey);
       }
       i = 0;
-      auto points = p_Port->SayInputPointNameOrderExpectedBySubject(key);
+      auto const & points = m.subjectpoints.at(key);
       for (auto const& p : points) {
          obj[U("points")][i++] = json_pointname(p);
       }
@@ -793,17 +1041,17 @@ const json::value handler::json_subject(const NGuiKey & key, bool recurse) {
 }
 
 // fill in a json object reference with case data
-const json::value handler::json_case(const NGuiKey & key, bool recurse) {
+const json::value handler::json_case(const readmodel & m, const NGuiKey & key, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      GuiPackCaseFull_t c = p_Port->SayFullInfoFromCase(key);
+      const GuiPackCaseFull_t & c = m.cases.at(key);
       obj[U("reply")] = json_reply(c.getterReply);
       if (c.getterReply == EGuiReply::OKAY_allDone) {
          obj[U("label")] = json_string(c.caseName);
          if (c.snapshotKronoKey.Peek() > 0) {
-             obj[U("krono")] = json_krono(c.snapshotKronoKey);
+             obj[U("krono")] = json_krono(m, c.snapshotKronoKey);
          }
          obj[U("report")] = json_array(c.reportText_byCR);
          obj[U("prompt")] = json_array(c.promptText_byCR);
@@ -817,12 +1065,12 @@ const json::value handler::json_case(const NGuiKey & key, bool recurse) {
    return(obj);
 }
 // fill in a json object reference with feature data
-const json::value handler::json_feature(const NGuiKey & key, bool recurse) {
+const json::value handler::json_feature(const readmodel & m, const NGuiKey & key, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      GuiPackFeatureFull_t f = p_Port->SayFullInfoFromFeature(key);
+      const GuiPackFeatureFull_t & f = m.features.at(key);
       obj[U("type")] = json_objtype(f.ownType);
       obj[U("uai")] = json::value(f.featureUai);
       obj[U("label")] = json_string(f.labelText);
@@ -830,10 +1078,10 @@ const json::value handler::json_feature(const NGuiKey & key, bool recurse) {
       obj[U("message")] = json_string(f.messageText);
       obj[U("state")] = json_state(f.messageState);
       obj[U("knobs")] = json::value::array();
-      obj[U("histogram")] = json_histogram(f.sourceHistogramKey);
+      obj[U("histogram")] = json_histogram(m, f.sourceHistogramKey);
       auto i = 0;
       for (auto const& kkey : f.ownKnobKeys) {
-         obj[U("knobs")][i++] = json_knob(kkey);
+         obj[U("knobs")][i++] = json_knob(m, kkey);
       }
    } catch (...) {
       obj[U("error")] = json_string("Error fetching feature info");
@@ -842,13 +1090,13 @@ const json::value handler::json_feature(const NGuiKey & key, bool recurse) {
 }
 
 // fill in a json object with histogram data
-const json::value handler::json_histogram(const NGuiKey & key, bool recurse) {
+const json::value handler::json_histogram(const readmodel & m, const NGuiKey & key, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      obj[U("idtext")] = json_string(p_Port->SayTextIdentifyingHistogram(key));
-      GuiPackHistogram_t h = p_Port->SayInfoFromHistogram(key);
+      obj[U("idtext")] = json_string(m.histogramtexts.at(key));
+      const GuiPackHistogram_t & h = m.histograms.at(key);
       obj[U("type")] = json_objtype(h.ownType);
       obj[U("reply")] = json_reply(h.getterReply);
       obj[U("bartype")] = json_objtype(h.barTypeDisplayed);
@@ -868,7 +1116,7 @@ const json::value handler::json_histogram(const NGuiKey & key, bool recurse) {
       obj[U("knobs")] = json::value::array();
       i = 0;
       for (auto const & k : h.knobKeys) {
-         obj[U("knobs")][i++] = json_knob(k);
+         obj[U("knobs")][i++] = json_knob(m, k);
       }
       obj[U("bar_labels")] = json::value::array();
       if (h.barTypeDisplayed != EGuiType::HistogramBars_analogBins) {
@@ -905,13 +1153,13 @@ const json::value handler::json_histogram(const NGuiKey & key, bool recurse) {
    }
 
 // fill in a json object reference with knob data
-const json::value handler::json_knob(const NGuiKey & key, bool recurse) {
+const json::value handler::json_knob(const readmodel & m, const NGuiKey & key, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      obj[U("idtext")] = json_string(p_Port->SayTextIdentifyingKnob(key));
-      GuiPackKnob_t knob = p_Port->GetInfoFromKnob(key);
+      obj[U("idtext")] = json_string(m.knobtexts.at(key));
+      const GuiPackKnob_t & knob = m.knobs.at(key);
       obj[U("reply")] = json_reply(knob.getterReply);
       obj[U("type")] = json_objtype(knob.ownType);
       obj[U("label")] = json_string(knob.labelText);
@@ -941,22 +1189,22 @@ const json::value handler::json_knob(const NGuiKey & key, bool recurse) {
    return(obj);
 }
 
-const json::value handler::json_rulekit(const NGuiKey &key, bool recurse) {
+const json::value handler::json_rulekit(const readmodel & m, const NGuiKey &key, bool recurse) {
    json::value obj;
    int count;
 
    obj[U("key")] = json_key(key);
    try {
-      obj[U("idtext")] = json_string(p_Port->SayTextIdentifyingRuleKit(key));
-      GuiPackRuleKitFull_t rule = p_Port->SayFullInfoFromRuleKit(key);
+      obj[U("idtext")] = json_string(m.rulekittexts.at(key));
+      const GuiPackRuleKitFull_t & rule = m.rulekits.at(key);
       obj[U("reply")] = json_reply(rule.getterReply);
-      obj[U("histogram")] = json_histogram(rule.ruleKitHistogramKey);
-      obj[U("krono")] = json_krono(rule.realtimeKronoKey_zeroIfNone);
+      obj[U("histogram")] = json_histogram(m, rule.ruleKitHistogramKey);
+      obj[U("krono")] = json_krono(m, rule.realtimeKronoKey_zeroIfNone);
       obj[U("caption")] = json_string(rule.captionText);
       obj[U("knobs")] = json::value::array();
       count = 0;
       for (auto & kkey : rule.ruleKitKnobKeys) {
-         obj[U("knobs")][count++] = json_knob(kkey);
+         obj[U("knobs")][count++] = json_knob(m, kkey);
       }
       obj[U("rulelabels")] = json_array(rule.ruleLabels_topToBottom);
       obj[U("ruletexts_if")] = json_array(rule.ruleTexts_if_topToBottom);
@@ -971,7 +1219,7 @@ const json::value handler::json_rulekit(const NGuiKey &key, bool recurse) {
          obj[U("ruleknobs")] = json::value::array();
          count = 0;
          for (auto & kkey : rule.ruleKnobKeys_topToBottom) {
-            obj[U("ruleknobs")][count++] = json_knob(kkey);
+            obj[U("ruleknobs")][count++] = json_knob(m, kkey);
          }
       }
       obj[U("rulehistogramkeys")] = json_array(rule.ruleHistogramKeys_topToBottom);
@@ -979,7 +1227,7 @@ const json::value handler::json_rulekit(const NGuiKey &key, bool recurse) {
          obj[U("rulehistograms")] = json::value::array();
          count = 0;
          for (auto const &hkey : rule.ruleHistogramKeys_topToBottom) {
-            obj[U("rulehistograms")][count++] = json_histogram(hkey);
+            obj[U("rulehistograms")][count++] = json_histogram(m, hkey);
          }
       }
    } catch (...) {
@@ -988,12 +1236,12 @@ const json::value handler::json_rulekit(const NGuiKey &key, bool recurse) {
    return(obj);
 }
 
-const json::value handler::json_traceinkrono(const NGuiKey & key, const NGuiKey & krono, bool recurse) {
+const json::value handler::json_traceinkrono(const readmodel & m, const NGuiKey & key, const NGuiKey & krono, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      GuiPackTraceFull_t trace = p_Port->SayFullInfoFromTraceInKrono(key, krono);  // SWB TODO: what if not in krono?
+      const GuiPackTraceFull_t & trace = m.traces.at(std::make_pair(key, krono));  // SWB TODO: what if not in krono?
       obj[U("reply")] = json_reply(trace.getterReply);
       obj[U("type")] = json_objtype(trace.ownType);
       obj[U("tag")] = json_string(trace.tag);
@@ -1003,11 +1251,11 @@ const json::value handler::json_traceinkrono(const NGuiKey & key, const NGuiKey
       for (auto const & s : trace.states_olderToNewer) {
           obj[U("states")][i++] = json_state(s);
       }
-      obj[U("histogram")] = json_histogram(trace.sourceHistogramKey);
+      obj[U("histogram")] = json_histogram(m, trace.sourceHistogramKey);
       obj[U("knobs")] = json::value::array();
       i = 0;
       for (auto & knob : trace.knobKeys) {
-         obj[U("knobs")][i++] = json_knob(knob);
+         obj[U("knobs")][i++] = json_knob(m, knob);
       }
    } catch(...) {
       obj[U("error")] = json_string("Error fetching trace info");
@@ -1015,12 +1263,12 @@ const json::value handler::json_traceinkrono(const NGuiKey & key, const NGuiKey
    return(obj);
 }
 
-const json::value handler::json_paneinkrono(const NGuiKey & key, const NGuiKey & krono, bool recurse) {
+const json::value handler::json_paneinkrono(const readmodel & m, const NGuiKey & key, const NGuiKey & krono, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      GuiPackPane_t pane = p_Port->SayInfoFromPane(key);
+      const GuiPackPane_t & pane = m.panes.at(key);
       obj[U("reply")] = json_reply(pane.getterReply);
       obj[U("type")] = json_objtype(pane.ownType);
       //obj[U("ylabel")] = json_string(pane.yAxisLabel);  // SWB: NO LABEL???
@@ -1030,7 +1278,7 @@ const json::value handler::json_paneinkrono(const NGuiKey & key, const NGuiKey &
       obj[U("traces")] = json::value::array();
       int count = 0;
       for (auto & t : pane.traceKeys) {
-         obj[U("traces")][count++] = json_traceinkrono(t, krono);
+         obj[U("traces")][count++] = json_traceinkrono(m, t, krono);
       }
    } catch(...) {
       obj[U("error")] = json_string("Error fetching pane info");
@@ -1038,25 +1286,28 @@ const json::value handler::json_paneinkrono(const NGuiKey & key, const NGuiKey &
    return(obj);
 }
 
-const json::value handler::json_krono(const NGuiKey & key, bool recurse) {
+const json::value handler::json_krono(const readmodel & m, const NGuiKey & key, bool recurse) {
    json::value obj;
 
    obj[U("key")] = json_key(key);
    try {
-      GuiPackKronoFull_t krono = p_Port->SayFullInfoFromKrono(key);
+      // Key 0 is a rule kit with no realtime Krono; reply as libEA would have, with no call to it
+      static const GuiPackKronoFull_t none(EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled);
+      const GuiPackKronoFull_t & krono = (key.Peek() == 0) ? none : m.kronos.at(key);
+      m.shown(key);
       obj[U("reply")] = json_reply(krono.getterReply);
       obj[U("type")] = json_objtype(krono.ownType);
       obj[U("caption")] = json_string(krono.captionText);
       obj[U("panes")] = json::value::array();
       int count = 0;
       for (auto & p : krono.paneKeys_topToBottom) {
-         obj[U("panes")][count++] = json_paneinkrono(p, key);
+         obj[U("panes")][count++] = json_paneinkrono(m, p, key);
       }
       obj[U("timestamps")] = json_array(krono.timestamps_olderToNewer);
       obj[U("knobs")] = json::value::array();
       count = 0;
       for (auto & kkey : krono.knobKeys) {
-          obj[U("knobs")][count++] = json_knob(kkey);
+          obj[U("knobs")][count++] = json_knob(m, kkey);
       }
    } catch(...) {
       obj[U("error")] = json_string("Error fetching krono info");
@@ -1064,6 +1315,99 @@ const json::value handler::json_krono(const NGuiKey & key, bool recurse) {
    return(obj);
 }
 
+//
+// One alert from libEA's ring: id and the message text as it always was, plus its parts
+//
+const json::value handler::json_alert(const GuiPackAlert_t & a) {
+   json::value obj;
+   obj[U("id")] = json::value(a.alertId);
+   obj[U("message")] = json_string(a.fullText);
+   obj[U("time")] = json::value((int64_t) a.timestamp);
+   obj[U("subject")] = json_string(a.subjectText);
+   obj[U("source")] = json_string(a.sourceTag);
+   obj[U("text")] = json_string(a.alertText);
+   return(obj);
+}
+
+//
+// What changed from one model to the next, for stream subscribers: features whose message or
+// state changed, rule kits whose rule states changed, cases opened and closed per subject, new
+// alerts, and the engine's step time the newer model was taken at. Lists are left out when empty.
+//
+const json::value handler::json_delta(const readmodel & older, const readmodel & newer, const std::vector<GuiPackAlert_t> & newalerts) {
+   json::value obj;
+   obj[U("seq")] = json::value(newer.seq);
+   obj[U("time")] = json::value((uint64_t) newer.time);
+
+   auto features = json::value::array();
+   int i = 0;
+   for (auto const & f : newer.features) {
+      auto was = older.features.find(f.first);
+      if (was == older.features.end() || was->second.messageText != f.second.messageText || was->second.messageState != f.second.messageState) {
+         features[i][U("key")] = json_key(f.first);
+         features[i][U("message")] = json_string(f.second.messageText);
+         features[i][U("state")] = json_state(f.second.messageState);
+         i++;
+      }
+   }
+   if (i > 0)
+      obj[U("features")] = features;
+
+   auto rulekits = json::value::array();
+   i = 0;
+   for (auto const & r : newer.rulekits) {
+      auto was = older.rulekits.find(r.first);
+      if (was == older.rulekits.end() || was->second.ruleStates_topToBottom != r.second.ruleStates_topToBottom) {
+         rulekits[i][U("key")] = json_key(r.first);
+         rulekits[i][U("rulestates")] = json::value::array();
+         int count = 0;
+         for (auto const & s : r.second.ruleStates_topToBottom)
+            rulekits[i][U("rulestates")][count++] = json_state(s);
+         i++;
+      }
+   }
+   if (i > 0)
+      obj[U("rulekits")] = rulekits;
+
+   auto cases = json::value::array();
+   i = 0;
+   for (auto const & s : newer.subjectcases) {
+      auto const & now = s.second.currentCaseKeys;
+      static const std::vector<NGuiKey> none;
+      auto was = older.subjectcases.find(s.first);
+      auto const & before = (was == older.subjectcases.end()) ? none : was->second.currentCaseKeys;
+      std::vector<NGuiKey> opened, closed;
+      for (auto const & ckey : now) {
+         if (std::find(before.begin(), before.end(), ckey) == before.end())
+            opened.push_back(ckey);
+      }
+      for (auto const & ckey : before) {
+         if (std::find(now.begin(), now.end(), ckey) == now.end())
+            closed.push_back(ckey);
+      }
+      if (!opened.empty() || !closed.empty()) {
+         cases[i][U("subject")] = json_key(s.first);
+         cases[i][U("opened")] = json_array(opened);
+         cases[i][U("closed")] = json_array(closed);
+         i++;
+      }
+   }
+   if (i > 0)
+      obj[U("cases")] = cases;
+
+   auto alerts = json::value::array();
+   i = 0;
+   for (auto const & a : newalerts) {
+      if (a.alertId >= newer.alertseq)
+         break;
+      alerts[i++] = json_alert(a);
+   }
+   if (i > 0)
+      obj[U("alerts")] = alerts;
+
+   return(obj);
+}
+
 static void json_object_merge(json::value &target, const json::value &copyfrom) {
    //ucout << "json_object_merge: copying fields into target" << endl;
    //ucout << " Copying from:" << endl << copyfrom << endl;
@@ -1081,457 +1425,823 @@ static void json_object_merge(json::value &target, const json::value &copyfrom)
 }
 
 
-///////////////////////////////////////////////////////////////////////////////
 //
-// Code below are handlers for the various HTTP request types
+// Helpers for PUT /ctrl/ingest
 //
-///////////////////////////////////////////////////////////////////////////////
 
+// Size step for n subjects, keeping the capacity of the value vectors it already has
+static std::vector<double> & ingest_values(ingest_step & step, size_t i, const NGuiKey & subject) {
+   if (step.values.size() <= i)
+      step.values.resize(i + 1);
+   step.values[i].first = subject;
+   step.values[i].second.clear();
+   return step.values[i].second;
+}
 
-//
-// GET Request
-//
-void handler::handle_get(http_request message)
-{
-   auto uri = message.relative_uri();
-   //auto paths = http::uri::split_path(uri.path());
-   auto querystringmap = http::uri::split_query(uri.query());
-   bool compress = false;
-
-   //auto encoding = message.headers().find(U("Accept-Encoding"));
-   //if (encoding != message.headers().end()) {
-   //   // if *encoding contains "gzip" then set the compress flag
-   //   if (encoding->second.find("gzip") != std::string::npos)
-   //      compress = true;
-   //}
-
-   // Pull in any alerts and store them in our local alert list. We have to keep
-   // them because the library throws them away as soon as it reports them. Lock
-   // everything for thread safety.
-   {
-      std::lock_guard<std::mutex> glock(instance_api_lock);
-      auto newalerts = p_Port->SayNewAlertsFifoFromDomainThenClear();   // std::queue<std::string>
+// A date and time of day in the layout of tests/testdata ("2025/07/9" and "0:00"), as local time
+static bool parse_csv_time(const char * date, const char * tod, time_t & t) {
+   std::tm tm = {};
+   int sec = 0;
+   if (sscanf(date, "%d/%d/%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday) != 3 ||
+         sscanf(tod, "%d:%d:%d", &tm.tm_hour, &tm.tm_min, &sec) < 2)
+      return false;
+   tm.tm_year -= 1900;
+   tm.tm_mon -= 1;
+   tm.tm_sec = sec;
+   tm.tm_isdst = -1;
+   t = mktime(&tm);
+   return t != (time_t) -1;
+}
 
-      // Make sure we keep the total alert count under control
-      int s = alerts.size();
-      int rm = newalerts.size() + s - MAX_ALERT_BUFFER_SIZE;
-      auto realNumToRemove = std::min(std::max(0, rm), s);
-      auto eraseIter = alerts.begin();
-      std::advance(eraseIter, realNumToRemove);
-      alerts.erase(alerts.begin(), eraseIter);
+// Split a CSV row in place, terminating each field where its comma was
+static void split_csv(std::string & line, std::vector<const char *> & fields) {
+   fields.clear();
+   fields.push_back(&line[0]);
+   for (auto & c : line) {
+      if (c == ',') {
+         c = '\0';
+         fields.push_back(&c + 1);
+      }
+   }
+}
 
-      // Move the new alerts into our stashed alert list.
-      while (!newalerts.empty()) {
-         alerts.insert(std::make_pair(alertseq++, newalerts.front()));
-         newalerts.pop();
+// One CSV row: date, time, ground truth code (ignored), then each subject's points in column order
+static bool parse_ingest_csv(std::string & line, const std::vector<std::pair<NGuiKey, size_t>> & columns, size_t ncolumns, ingest_step & step, std::string & error) {
+   std::vector<const char *> fields;
+   fields.reserve(ncolumns);
+   split_csv(line, fields);
+   if (fields.size() < ncolumns) {
+      stringstream msg;
+      msg << "expected " << ncolumns << " columns, got " << fields.size();
+      error = msg.str();
+      return false;
+   }
+   if (!parse_csv_time(fields[0], fields[1], step.time)) {
+      error = "bad date or time";
+      return false;
+   }
+   size_t f = 3;
+   step.nsubjects = columns.size();
+   for (size_t i = 0; i < columns.size(); i++) {
+      auto & dlist = ingest_values(step, i, columns[i].first);
+      dlist.reserve(columns[i].second);
+      for (size_t p = 0; p < columns[i].second; p++, f++) {
+         char * end;
+         double v = std::strtod(fields[f], &end);
+         if (end == fields[f]) {
+            stringstream msg;
+            msg << "non-numeric value in column " << f + 1;
+            error = msg.str();
+            return false;
+         }
+         dlist.push_back(v);
       }
    }
+   return true;
+}
 
-   std::smatch match;
-   auto api = api_latest_version;
-   auto retval = status_codes::OK;
-   bool recurse = true;
-   json::value reply;
-   if (std::regex_match(uri.path(), match, re_api)) {
-      if (match[2].length() > 0) {
-         api = std::max(1,std::min(std::stoi(match[1]), api_latest_version));
-         ucout << "Set API version to " << match[1] << endl;
+// One NDJSON line: the same object /ctrl/sampletimestep takes, {"time":INT,"values_by_subject":[...]}
+static bool parse_ingest_ndjson(const std::string & line, ingest_step & step, std::string & error) {
+   try {
+      auto jv = json::value::parse(line);
+      step.time = (time_t) jv.at(U("time")).as_number().to_int64();
+      auto const & subjects = jv.at(U("values_by_subject")).as_array();
+      step.nsubjects = subjects.size();
+      size_t i = 0;
+      for (auto const & json_o : subjects) {
+         NGuiKey subject(json_o.at(U("subject")).as_number().to_uint64());
+         auto const & a = json_o.at(U("values")).as_array();
+         auto & dlist = ingest_values(step, i++, subject);
+         dlist.reserve(a.size());
+         for (auto const & v : a)
+            dlist.push_back(v.as_double());
       }
-      auto path = match[3].str();
-      json::value jvalue;
-      try {
-         handler::extract_json(message, jvalue);
-      } catch (...) {
-         // Error parsing the json, probably a syntax error
-         ucout << U("Warning: extract_json failed - probably a syntax error") << endl;
+   } catch (...) {
+      error = "not a valid sampletimestep object";
+      return false;
+   }
+   return true;
+}
+
+// One CSV row in a registered layout: date, time, then one field per layout column
+static bool parse_layout_csv(std::string & line, const ingest_layout & layout, std::vector<const char *> & fields, ingest_step & step, std::string & error) {
+   split_csv(line, fields);
+   if (fields.size() != layout.names.size() + 2) {
+      stringstream msg;
+      msg << "expected " << layout.names.size() + 2 << " columns, got " << fields.size();
+      error = msg.str();
+      return false;
+   }
+   if (!parse_csv_time(fields[0], fields[1], step.time)) {
+      error = "bad date or time";
+      return false;
+   }
+   layout.begin(step);
+   for (size_t c = 0; c < layout.names.size(); c++) {
+      if (layout.scatter[c].first == ingest_layout::skip)
+         continue;
+      const char * field = fields[c + 2];
+      char * end;
+      double v = std::strtod(field, &end);
+      if (end == field) {
+         error = "non-numeric value in column " + layout.names[c];
+         return false;
       }
-      int compact = 0;
-      if (handler::get_json_value(true, jvalue, querystringmap, U("compact"), reply, compact)) {
-         if (compact != 0)
-            recurse = false;
-      }
-      if (path == U("/apiver") || path == U("/api") || path == U("/noop")) {
-         ; // apiver is returned with all requests
-
-      } else if (path == U("/ctrl/eventwait")) {
-         // wait for a timeout (param - default = 5 seconds); return either
-         // update:true or update:false
-         auto funcname = U("WaitForEvent");
-         uint64_t oldseq = 0;
-         unsigned int timeout = default_eventwait_seconds;
-         handler::get_json_value(true, jvalue, querystringmap, U("timeout"), reply, timeout);   // optional
-         if (handler::get_json_value(false, jvalue, querystringmap, U("seq"), reply, oldseq)) {  // required
-            // wait until either timeout or seq is no longer current
-            std::cout << funcname << ": Waiting for event (seq " << oldseq << ")" << std::endl;
-            if (handler::wait_for_event(oldseq, timeout).get()) {
-               std::cout << funcname << ": Seq update detected (now " << seq << ")" << std::endl;
-            } else {
-               std::cout << funcname << ": Timed out waiting for seq update (still " << seq << ")" << std::endl;
-               reply[U("timedout")] = json::value(true);
-            }
-         } else {
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
+      layout.put(step, c, v);
+   }
+   return true;
+}
 
-      } else if (path == U("/domain")) {
-         auto funcname = U("SayInfoFromDomain");
-         reply[U("label")] = json_string(domain.ownNameText);
-         reply[U("subjectkeys")] = json::value::array();
-         if (recurse)
-            reply[U("subjects")] = json::value::array();
-         int i = 0;
-         for (auto & skey : domain.subjectKeys) {
-            if (recurse)
-               reply[U("subjects")][i] = json_subject(skey);
-            reply[U("subjectkeys")][i++] = json_key(skey);
-         }
+// The "values" array of a step in a registered layout, one value per layout column
+static bool parse_layout_values(const json::value & values, const ingest_layout & layout, ingest_step & step, std::string & error) {
+   if (!values.is_array() || values.size() != layout.names.size()) {
+      stringstream msg;
+      msg << "values must be an array of " << layout.names.size() << " numbers";
+      error = msg.str();
+      return false;
+   }
+   layout.begin(step);
+   size_t c = 0;
+   try {
+      for (auto const & v : values.as_array()) {
+         if (layout.scatter[c].first != ingest_layout::skip)
+            layout.put(step, c, v.as_double());
+         c++;
+      }
+   } catch (...) {
+      error = "non-numeric value for " + layout.names[c];
+      return false;
+   }
+   return true;
+}
 
-      } else if (path == U("/casekeys")) {
-         // return json array of case labels (note: these are not rawlabels!)
-         auto funcname = U("CaseKeys"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
-         uint64_t subjectkey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("subject"), reply, subjectkey)) {
-            NGuiKey subject(subjectkey);
-            try {
-               auto cases = p_Port->SayCurrentCasesFromSubject(subject);
-               reply[U("casekeys")] = json_array(cases.currentCaseKeys);
-            } catch (...) {
-               stringstream msg;
-               ucout << funcname << ": Invalid subject key provided in request" << endl;
-               retval = status_codes::BadRequest;
-            }
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
+// One NDJSON line in a registered layout: {"time":INT,"values":[...]}
+static bool parse_layout_ndjson(const std::string & line, const ingest_layout & layout, ingest_step & step, std::string & error) {
+   json::value jv;
+   try {
+      jv = json::value::parse(line);
+      step.time = (time_t) jv.at(U("time")).as_number().to_int64();
+      if (!jv.has_field(U("values")))
+         throw std::runtime_error("no values");
+   } catch (...) {
+      error = "not a valid layout step object";
+      return false;
+   }
+   return parse_layout_values(jv.at(U("values")), layout, step, error);
+}
 
-      } else if (path == U("/casecounts")) {
-         auto funcname = U("SayCaseCountsForAllSubjects");
-         reply[U("casecounts")] = json::value::array();
-         int i = 0;
-         try {
-            for (auto & skey : domain.subjectKeys) {
-               reply[U("casecounts")][i] = json::value::object();
-               reply[U("casecounts")][i][U("subject")] = json_key(skey);
-               auto cases = p_Port->SayCurrentCasesFromSubject(skey);
-               reply[U("casecounts")][i][U("cases")] = json_num((int) cases.currentCaseKeys.size());
-               i++;
-            }
-         } catch (...) {
-            stringstream msg;
-            ucout << funcname << ": Unable to query subjects" << endl;
-            reply[U("error")] = json_string("Unable to query subjects");
-            retval = status_codes::BadRequest;
-         }
 
-      } else if (path == U("/case")) {
-         // return a single json object with all info about a certain case
-         compress = true;
-         auto funcname = U("SayCase"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
-         uint64_t keykey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, keykey)) {
-            NGuiKey key(keykey);
-            json_object_merge(reply, handler::json_case(key, recurse));
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
+///////////////////////////////////////////////////////////////////////////////
+//
+// Route handlers, dispatched through the route tables by handle_get/post/put
+//
+///////////////////////////////////////////////////////////////////////////////
 
-     } else if (path == U("/cases")) {
-         // return json array of case objects
-         auto funcname = U("SayCases"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
-         json::value caselist = json::value::array();
-         uint64_t subjectkey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("subject"), reply, subjectkey)) {
-            NGuiKey subject(subjectkey);
-            try {
-               auto cases = p_Port->SayCurrentCasesFromSubject(subject);
-               int i = 0;
-               for (auto const& key : cases.currentCaseKeys) {
-                  caselist[i] = json::value::object();
-                  json_object_merge(caselist[i], handler::json_case(key, recurse));
-                  i++;
-               }
-            } catch(...) {
-            }
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
-         compress = true;
-         reply[U("cases")] = caselist;
+//
+// GET routes. Each reads only req.m, the model loaded when the request started.
+//
+// GET /apiver, /api, /noop
+void handler::get_noop(request_args & req, json::value & reply, status_code & retval) {
+   ; // apiver is returned with all requests
+}
 
-      } else if (path == U("/featurekeys")) {
-         auto funcname = U("FeatureKeys");
-         uint64_t subjectkey;
+// GET /ctrl/eventwait
+void handler::get_ctrl_eventwait(request_args & req, json::value & reply, status_code & retval) {
+   // wait for a timeout (param - default = 5 seconds); return either
+   // update:true or update:false
+   auto funcname = U("WaitForEvent");
+   uint64_t oldseq = 0;
+   unsigned int timeout = default_eventwait_seconds;
+   handler::get_json_value(true, req.jvalue, req.querystringmap, U("timeout"), reply, timeout);   // optional
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("seq"), reply, oldseq)) {  // required
+      // wait until either timeout or seq is no longer current
+      if (!handler::wait_for_event(oldseq, timeout).get())
+         reply[U("timedout")] = json::value(true);
+   } else {
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
 
-         if (handler::get_json_value(false, jvalue, querystringmap, U("subject"), reply, subjectkey)) {
-            NGuiKey subject(subjectkey);
-            try {
-               GuiPackSubjectBasic_t s = p_Port->SayInfoFromSubject(subject);
-               reply[U("featurekeys")] = json_array(s.featureKeys);
-            } catch(...) {
-               stringstream msg;
-               ucout << funcname << ": Invalid subject key provided in request" << endl;
-               retval = status_codes::BadRequest;
-            }
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
+// GET /domain
+void handler::get_domain(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayInfoFromDomain");
+   reply[U("label")] = json_string(domain.ownNameText);
+   reply[U("subjectkeys")] = json::value::array();
+   if (req.recurse)
+      reply[U("subjects")] = json::value::array();
+   int i = 0;
+   for (auto & skey : domain.subjectKeys) {
+      if (req.recurse)
+         reply[U("subjects")][i] = json_subject(*req.m, skey);
+      reply[U("subjectkeys")][i++] = json_key(skey);
+   }
+}
 
-      } else if (path == U("/feature")) {
-         auto funcname = U("SayFeature"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
-         uint64_t featurekey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, featurekey)) {
-            NGuiKey feature(featurekey);
-            json_object_merge(reply, handler::json_feature(feature, recurse));
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
+// GET /casekeys
+void handler::get_casekeys(request_args & req, json::value & reply, status_code & retval) {
+   // return json array of case labels (note: these are not rawlabels!)
+   auto funcname = U("CaseKeys"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
+   uint64_t subjectkey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("subject"), reply, subjectkey)) {
+      NGuiKey subject(subjectkey);
+      try {
+         auto const & cases = req.m->subjectcases.at(subject);
+         reply[U("casekeys")] = json_array(cases.currentCaseKeys);
+      } catch (...) {
+         stringstream msg;
+         ucout << funcname << ": Invalid subject key provided in request" << endl;
+         retval = status_codes::BadRequest;
+      }
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
 
-      } else if (path == U("/features")) {
-         auto funcname = U("SayFeatures"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
-         int fcount = 0;
-         json::value featurelist = json::value::array();
-         uint64_t subjectkey;
+// GET /casecounts
+void handler::get_casecounts(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayCaseCountsForAllSubjects");
+   reply[U("casecounts")] = json::value::array();
+   int i = 0;
+   try {
+      for (auto & skey : domain.subjectKeys) {
+         reply[U("casecounts")][i] = json::value::object();
+         reply[U("casecounts")][i][U("subject")] = json_key(skey);
+         auto const & cases = req.m->subjectcases.at(skey);
+         reply[U("casecounts")][i][U("cases")] = json_num((int) cases.currentCaseKeys.size());
+         i++;
+      }
+   } catch (...) {
+      stringstream msg;
+      ucout << funcname << ": Unable to query subjects" << endl;
+      reply[U("error")] = json_string("Unable to query subjects");
+      retval = status_codes::BadRequest;
+   }
+}
 
-         if (handler::get_json_value(false, jvalue, querystringmap, U("subject"), reply, subjectkey)) {
-            NGuiKey subject(subjectkey);
-            try {
-               GuiPackSubjectBasic_t s = p_Port->SayInfoFromSubject(subject); // Could probably be cached...?
-               int i = 0;
-               for (auto const &key : s.featureKeys) {
-                  featurelist[i] = json::value::object();
-                  json_object_merge(featurelist[i], handler::json_feature(key, recurse));
-                  i++;
-               }
-            } catch(...) {
-            }
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
-         compress = true;
-         reply[U("features")] = featurelist;
+// GET /case
+void handler::get_case(request_args & req, json::value & reply, status_code & retval) {
+   // return a single json object with all info about a certain case
+   auto funcname = U("SayCase"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
+   uint64_t keykey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, keykey)) {
+      NGuiKey key(keykey);
+      json_object_merge(reply, handler::json_case(*req.m, key, req.recurse));
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
 
-      } else if (path == U("/krono")) {
-         auto funcname = U("SayKrono");
+// GET /cases
+void handler::get_cases(request_args & req, json::value & reply, status_code & retval) {
+   // return json array of case objects
+   auto funcname = U("SayCases"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
+   json::value caselist = json::value::array();
+   uint64_t subjectkey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("subject"), reply, subjectkey)) {
+      NGuiKey subject(subjectkey);
+      uint64_t since = 0;
+      bool delta = get_since(req, reply, retval, since);
+      if (delta && since < req.m->removedhorizon) {
+         delta = false;    // removals that far back are forgotten, so send everything
+         reply[U("full")] = json::value(true);
+      }
+      try {
+         auto const & cases = req.m->subjectcases.at(subject);
          int i = 0;
-         uint64_t kronokey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, kronokey)) {
-            NGuiKey krono(kronokey);
-            json_object_merge(reply, handler::json_krono(krono, recurse));
-
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
-         compress = true;
-
-      } else if (path == U("/subjectkeys")) {
-         auto funcname = U("SaySubjectKeys");
-         reply[U("subjectkeys")] = json_array(domain.subjectKeys);
-
-      } else if (path == U("/subjects")) {
-         auto funcname = U("SaySubjects");
-         reply[U("subjects")] = json::value::array();
-         utility::string_t detailsliststr;
-         std::set<uint64_t> detailkeys;
-         if (handler::get_json_value(true, jvalue, querystringmap, U("details"), reply, detailsliststr)) {
-            recurse = false;
-            ucout << "GET subjects: trying to get details for " << detailsliststr << endl;
-            std::stringstream s_stream(detailsliststr); //create string stream from the string
-            while(s_stream.good()) {
-               std::string substr;
-               getline(s_stream, substr, ','); //get first string delimited by comma
-               try {
-                  detailkeys.insert(std::stol(substr));
-                  //ucout << "GET subjects: added detail for str '" << substr << "'" << endl;
-              } catch (...) {
-                  // unable to convert arg to long int - no good way to handle, so skip it
-                  ucout << "GET subjects: unable to add detail for str '" << substr << "' " << endl;
-              }
-            }
+         for (auto const& key : cases.currentCaseKeys) {
+            if (delta && !req.m->changed_since(req.m->caseseqs, key, since))
+               continue;
+            caselist[i] = json::value::object();
+            json_object_merge(caselist[i], handler::json_case(*req.m, key, req.recurse));
+            i++;
          }
+      } catch(...) {
+      }
+      if (delta) {
+         json::value removed = json::value::array();
          int i = 0;
-         for (auto & skey : domain.subjectKeys) {
-            if (detailkeys.find(skey.Peek()) != detailkeys.end()) {
-                reply[U("subjects")][i++] = json_subject(skey, true);
-            } else {
-                reply[U("subjects")][i++] = json_subject(skey, recurse);
-            }
+         for (auto const & r : req.m->removedcases) {
+            if (r.second.first == subject && r.second.second > since)
+               removed[i++] = json::value(r.first.Peek());
          }
-         compress = true;
+         reply[U("removed")] = removed;
+      }
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+   reply[U("cases")] = caselist;
+}
 
-      } else if (path == U("/subject")) {
-         auto funcname = U("SaySubject");
-         int i = 0;
-         uint64_t subjectkey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("subject"), reply, subjectkey)) {
-            NGuiKey subject(subjectkey);
-            json_object_merge(reply, handler::json_subject(subject, recurse));
+// GET /featurekeys
+void handler::get_featurekeys(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("FeatureKeys");
+   uint64_t subjectkey;
 
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
-         }
-         compress = true;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("subject"), reply, subjectkey)) {
+      NGuiKey subject(subjectkey);
+      try {
+         auto const & s = req.m->subjects.at(subject);
+         reply[U("featurekeys")] = json_array(s.featureKeys);
+      } catch(...) {
+         stringstream msg;
+         ucout << funcname << ": Invalid subject key provided in request" << endl;
+         retval = status_codes::BadRequest;
+      }
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
+
+// GET /feature
+void handler::get_feature(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayFeature"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
+   uint64_t featurekey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, featurekey)) {
+      NGuiKey feature(featurekey);
+      json_object_merge(reply, handler::json_feature(*req.m, feature, req.recurse));
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
 
-      } else if (path == U("/alerts")) {
-         auto funcname = U("SayCachedAlerts");
-         auto alertlist = json::value::array();
+// GET /features
+void handler::get_features(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayFeatures"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
+   int fcount = 0;
+   json::value featurelist = json::value::array();
+   uint64_t subjectkey;
+
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("subject"), reply, subjectkey)) {
+      NGuiKey subject(subjectkey);
+      uint64_t since = 0;
+      bool delta = get_since(req, reply, retval, since);
+      try {
+         auto const & s = req.m->subjects.at(subject);
          int i = 0;
-         std::lock_guard<std::mutex> glock(instance_api_lock);
-         for (auto & a : alerts) {
-            alertlist[i] = json::value();
-            alertlist[i][U("id")] = json::value(a.first);
-            alertlist[i][U("message")] = json_string(a.second);
+         for (auto const &key : s.featureKeys) {
+            if (delta && !req.m->changed_since(req.m->featureseqs, key, since))
+               continue;
+            featurelist[i] = json::value::object();
+            json_object_merge(featurelist[i], handler::json_feature(*req.m, key, req.recurse));
             i++;
          }
-         reply[U("alerts")] = alertlist;
-         compress = true;
+      } catch(...) {
+      }
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+   reply[U("features")] = featurelist;
+}
 
+// GET /krono
+void handler::get_krono(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayKrono");
+   int i = 0;
+   uint64_t kronokey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, kronokey)) {
+      NGuiKey krono(kronokey);
+      json_object_merge(reply, handler::json_krono(*req.m, krono, req.recurse));
+
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
+
+// GET /subjectkeys
+void handler::get_subjectkeys(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SaySubjectKeys");
+   reply[U("subjectkeys")] = json_array(domain.subjectKeys);
+}
+
+// GET /subjects
+void handler::get_subjects(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SaySubjects");
+   reply[U("subjects")] = json::value::array();
+   utility::string_t detailsliststr;
+   std::set<uint64_t> detailkeys;
+   if (handler::get_json_value(true, req.jvalue, req.querystringmap, U("details"), reply, detailsliststr)) {
+      req.recurse = false;
+      ucout << "GET subjects: trying to get details for " << detailsliststr << endl;
+      std::stringstream s_stream(detailsliststr); //create string stream from the string
+      while(s_stream.good()) {
+         std::string substr;
+         getline(s_stream, substr, ','); //get first string delimited by comma
+         try {
+            detailkeys.insert(std::stol(substr));
+            //ucout << "GET subjects: added detail for str '" << substr << "'" << endl;
+        } catch (...) {
+            // unable to convert arg to long int - no good way to handle, so skip it
+            ucout << "GET subjects: unable to add detail for str '" << substr << "' " << endl;
+        }
+      }
+   }
+   uint64_t since = 0;
+   bool delta = get_since(req, reply, retval, since);
+   int i = 0;
+   for (auto & skey : domain.subjectKeys) {
+      if (delta && !req.m->changed_since(req.m->subjectseqs, skey, since))
+         continue;
+      if (detailkeys.find(skey.Peek()) != detailkeys.end()) {
+          reply[U("subjects")][i++] = json_subject(*req.m, skey, true);
       } else {
-         ucout << "Unrecognized GET path: " << match[3] << endl;
-         reply[U("error")] = json::value::string(U("Unrecognized GET path (" + match[3].str() + ")"));
-         retval = status_codes::NotImplemented;
+          reply[U("subjects")][i++] = json_subject(*req.m, skey, req.recurse);
       }
    }
-   reply[U("apiver")] = json::value(api);   // Always include the API version in the reply
-   reply[U("seq")] = json::value(seq);      // Always include the sequence number in the reply
-   reply[U("alertseq")] = json::value(alertseq);
-   //message.reply(retval, reply);
-   http_response response (retval);
-   response.headers().add(U("Cache-Control"), U("no-cache"));
-   response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
-   if (compress) {
-      std::stringstream body;
-      reply.serialize(body);
-      auto gzbody = Gzip::compress(body.str());
-      response.set_body(gzbody);
-      response.headers().add(U("Content-Encoding"), U("gzip"));
+}
+
+// GET /subject
+void handler::get_subject(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SaySubject");
+   int i = 0;
+   uint64_t subjectkey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("subject"), reply, subjectkey)) {
+      NGuiKey subject(subjectkey);
+      json_object_merge(reply, handler::json_subject(*req.m, subject, req.recurse));
+
    } else {
-      response.set_body(reply);
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
    }
-   message.reply(response);         // reply is done here
-   return;
-};
+}
 
+// GET /alerts
 //
-// A POST request
-//
-void handler::handle_post(http_request message)
-{
-   auto uri = message.relative_uri();
-   //auto paths = http::uri::split_path(uri.path());
-   auto querystringmap = http::uri::split_query(uri.query());
+// Reads libEA's alert ring directly: it is the one libEA call safe on any thread, and takes
+// no lock. Without since, the last MAX_ALERT_BUFFER_SIZE alerts; with since (an alertseq the
+// client saw before), those posted after it. Alerts newer than the model are left for the
+// next reply, so it agrees with the model's alertseq.
+void handler::get_alerts(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayAlertsFromDomainSince");
+   AlertId_t from = (req.m->alertseq > MAX_ALERT_BUFFER_SIZE) ? req.m->alertseq - MAX_ALERT_BUFFER_SIZE : 0;
+   uint64_t since = 0;
+   bool cursor = handler::get_json_value(true, req.jvalue, req.querystringmap, U("since"), reply, since);
+   if (!cursor && reply.has_field(U("error"))) {
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+      return;
+   }
+   if (cursor)
+      from = std::min<AlertId_t>(since, req.m->alertseq);
+   auto alertlist = json::value::array();
+   AlertId_t next = req.m->alertseq;
+   int i = 0;
+   for (auto const & a : p_Port->SayAlertsFromDomainSince(from)) {
+      if (a.alertId >= req.m->alertseq)
+         break;
+      if (i == 0)
+         next = a.alertId;
+      alertlist[i++] = json_alert(a);
+   }
+   if (cursor) {
+      reply[U("since")] = json::value(since);
+      reply[U("missed")] = json::value(next - from);   // overwritten in the ring before being read
+   }
+   reply[U("alerts")] = alertlist;
+}
 
-   std::smatch match;
-   auto api = api_latest_version;
-   auto retval = status_codes::OK;
-   json::value reply;
-   if (std::regex_match(uri.path(), match, re_api)) {
-      if (match[2].length() > 0) {
-         api = std::max(1,std::min(std::stoi(match[1]), api_latest_version));
-         ucout << "Set API version to " << match[1] << endl;
-      }
-      auto path = match[3].str();
-      if (path == U("/ctrl/singlestep")) {
-         p_Port->SingleStepDomainOnTimeAndInputs();
-         update_seq();
-         //ucout << "SingleStepDomainOnTimeAndInputs() called" << endl;
-      } else if (path == U("/ctrl/shutdown")) {
-         extern std::atomic<int> stop_main;   // tell the main loop that we want to shut down
-         stop_main.store(1);
-         ucout << "Shutdown requested due to API request" << endl;
+// GET /batch
+//
+// Any mix of keyed objects in one reply, all from the same read model, so a page needing dozens
+// of kronos, knobs and histograms makes one request. keys is a comma-separated list of KIND:KEY,
+// or KIND:KEY@KRONO for panes and traces. Objects come back in the order asked for, each tagged
+// with its kind; a key that can't be found gets the usual error text in its object.
+void handler::get_batch(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SayBatch"); // THIS IS AN EXTRA COMPOUND GETTER - funcname is made up
+   utility::string_t keylist;
+   if (!handler::get_json_value(false, req.jvalue, req.querystringmap, U("keys"), reply, keylist)) {
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+      return;
+   }
+   json::value objects = json::value::array();
+   std::stringstream s_stream(keylist);
+   std::string item;
+   int i = 0;
+   while (std::getline(s_stream, item, ',')) {
+      if (i >= MAX_BATCH_KEYS) {
+         reply[U("error")] = json::value::string(U("Too many keys, the limit is " + std::to_string(MAX_BATCH_KEYS)));
+         retval = status_codes::BadRequest;
+         return;
+      }
+      auto colon = item.find(':');
+      auto at = item.find('@');
+      std::string kind = item.substr(0, colon);
+      uint64_t key = 0, krono = 0;
+      bool good = (colon != std::string::npos);
+      try {
+         if (good) {
+            key = std::stoull(item.substr(colon + 1, at == std::string::npos ? std::string::npos : at - colon - 1));
+            if (at != std::string::npos)
+               krono = std::stoull(item.substr(at + 1));
+         }
+      } catch (...) {
+         good = false;
+      }
+      json::value obj;
+      if (!good) {
+         obj[U("error")] = json::value::string(U("Expected KIND:KEY, got '" + item + "'"));
+      } else if (kind == "subject") {
+         obj = json_subject(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "feature") {
+         obj = json_feature(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "case") {
+         obj = json_case(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "knob") {
+         obj = json_knob(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "histogram") {
+         obj = json_histogram(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "rulekit") {
+         obj = json_rulekit(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "krono") {
+         obj = json_krono(*req.m, NGuiKey(key), req.recurse);
+      } else if (kind == "pane" && at != std::string::npos) {
+         obj = json_paneinkrono(*req.m, NGuiKey(key), NGuiKey(krono), req.recurse);
+      } else if (kind == "trace" && at != std::string::npos) {
+         obj = json_traceinkrono(*req.m, NGuiKey(key), NGuiKey(krono), req.recurse);
       } else {
-         ucout << "Unrecognized POST path: " << match[3] << endl;
-         reply[U("error")] = json::value::string(U("Unrecognized POST path (" + match[3].str() + ")"));
-         retval = status_codes::NotImplemented;
+         obj[U("error")] = json::value::string(U("Unknown kind '" + kind + "' (panes and traces need @KRONO)"));
       }
+      obj[U("kind")] = json::value::string(U(kind));
+      objects[i++] = obj;
    }
-   reply[U("apiver")] = json::value(api);   // Always include the API version in the reply
-   reply[U("seq")] = json::value(seq);      // Always include the sequence number
-   //message.reply(retval, reply);
-   http_response response (retval);
+   reply[U("objects")] = objects;
+}
+
+// GET /ctrl/stream
+//
+// Server-Sent Events: a "hello" event giving the seq of the current model, then a "step" event
+// holding a delta (see json_delta) each time a new model is published. The reply stays open
+// until the client goes away or falls too far behind. Subscribing on the engine thread means no
+// model can be published between the hello and the first delta.
+//
+void handler::get_ctrl_stream(request_args & req, json::value & reply, status_code & retval) {
+   run_engine([&] {
+      auto m = current_model();
+      json::value hello;
+      hello[U("seq")] = json::value(m->seq);
+      hello[U("alertseq")] = json::value(m->alertseq);
+      events.subscribe(req.message, eventstream::format("hello", m->seq, hello.serialize()));
+   });
+   req.replied = true;
+}
+
+// GET /metrics
+//
+// Runtime metrics in the Prometheus text format (version 0.0.4), for scraping. Replied to here,
+// as text rather than json, and never cached. Each series is read where it is kept, without
+// taking a lock or going through the engine thread.
+//
+void handler::get_metrics(request_args & req, json::value & reply, status_code & retval) {
+   std::ostringstream os;
+   stats.write(os);
+
+   metrics::write_header(os, "ead_engine_queue_wait_seconds", "histogram", "Time a command waits for the engine thread, which makes every call into libEA");
+   engine.queue_waits().write(os, "ead_engine_queue_wait_seconds", "");
+   metrics::write_header(os, "ead_engine_command_duration_seconds", "histogram", "Time the engine thread takes to run a command");
+   engine.command_runs().write(os, "ead_engine_command_duration_seconds", "");
+
+   metrics::write_header(os, "ead_seq", "gauge", "Sequence number of the latest model");
+   metrics::write_sample(os, "ead_seq", "", (double) req.m->seq);
+   metrics::write_header(os, "ead_stream_subscribers", "gauge", "Clients subscribed to GET /ctrl/stream");
+   metrics::write_sample(os, "ead_stream_subscribers", "", (double) events.subscribers());
+   metrics::write_header(os, "ead_stream_subscribers_dropped_total", "counter", "Stream subscribers ended for falling behind or closing");
+   metrics::write_sample(os, "ead_stream_subscribers_dropped_total", "", (double) events.subscribers_dropped());
+   metrics::write_header(os, "ead_alerts_total", "counter", "Alerts posted to the domain");
+   metrics::write_sample(os, "ead_alerts_total", "", (double) req.m->alertseq);
+
+   metrics::write_header(os, "ead_open_cases", "gauge", "Cases currently open, by subject");
+   for (auto const & sc : req.m->subjectcases) {
+      auto name = req.m->subjecttexts.find(sc.first);
+      metrics::write_sample(os, "ead_open_cases",
+         metrics::label("subject", name == req.m->subjecttexts.end() ? "" : name->second) + "," + metrics::label("key", std::to_string(sc.first.Peek())),
+         (double) sc.second.currentCaseKeys.size());
+   }
+
+   auto kbio = p_Port->SayIoCountsFromKnowledgeBases();
+   metrics::write_header(os, "ead_kbase_nodes_read_total", "counter", "Knowledge base nodes loaded from HDF5 files");
+   metrics::write_sample(os, "ead_kbase_nodes_read_total", "", (double) kbio.nodesReadFromFile);
+   metrics::write_header(os, "ead_kbase_nodes_written_total", "counter", "Knowledge base nodes written behind to HDF5 files");
+   metrics::write_sample(os, "ead_kbase_nodes_written_total", "", (double) kbio.nodesWrittenToFile);
+   metrics::write_header(os, "ead_kbase_flushes_total", "counter", "Knowledge base write-behind batches and table flushes");
+   metrics::write_sample(os, "ead_kbase_flushes_total", "", (double) kbio.flushesToFile);
+   metrics::write_header(os, "ead_kbase_cursor_reads_total", "counter", "Knowledge base node reads by cases");
+   metrics::write_sample(os, "ead_kbase_cursor_reads_total", "", (double) kbio.imagesReadAtCursor);
+   metrics::write_header(os, "ead_kbase_cursor_writes_total", "counter", "Knowledge base node writes by cases");
+   metrics::write_sample(os, "ead_kbase_cursor_writes_total", "", (double) kbio.imagesWrittenAtCursor);
+
+   http_response response (status_codes::OK);
    response.headers().add(U("Cache-Control"), U("no-cache"));
    response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
-   response.set_body(reply);
-   message.reply(response);         // reply is done here
-   return;
-};
+   response.set_body(os.str(), U("text/plain; version=0.0.4; charset=utf-8"));
+   req.message.reply(response).then([](pplx::task<void> t) {
+      try { t.get(); } catch (...) { /* client went away; nothing to do */ }
+   });
+   req.replied = true;
+}
 
+// GET /debug/trace
+//
+// The sampled and slow request traces still held, as a Chrome trace-event file (see tracer).
+// Replied to here, as the file itself rather than wrapped in the usual reply, and never cached.
+//
+void handler::get_debug_trace(request_args & req, json::value & reply, status_code & retval) {
+   std::ostringstream os;
+   traces.write_chrome(os);
+   http_response response (status_codes::OK);
+   response.headers().add(U("Cache-Control"), U("no-cache"));
+   response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
+   response.set_body(os.str(), U("application/json"));
+   req.message.reply(response).then([](pplx::task<void> t) {
+      try { t.get(); } catch (...) { /* client went away; nothing to do */ }
+   });
+   req.replied = true;
+}
 
 //
-// A PUT request
+// POST routes
 //
-void handler::handle_put(http_request message)
-{
-   auto uri = message.relative_uri();
-   //auto paths = http::uri::split_path(uri.path());
-   auto querystringmap = http::uri::split_query(uri.query());
+// POST /ctrl/singlestep
+void handler::post_ctrl_singlestep(request_args & req, json::value & reply, status_code & retval) {
+   run_engine([this] {
+      single_step();
+      update_seq();
+      publish_model();
+   });
+   //ucout << "SingleStepDomainOnTimeAndInputs() called" << endl;
+}
 
-   std::smatch match;
-   auto api = api_latest_version;
-   auto retval = status_codes::OK;
-   json::value reply;
-   stringstream msg;
-   if (std::regex_match(uri.path(), match, re_api)) {
-      if (match[2].length() > 0) {
-         api = std::max(1,std::min(std::stoi(match[1]), api_latest_version));
-         ucout << "Set API version to " << match[1] << endl;
-      }
-      auto path = match[3].str();
-      json::value jvalue;
-      try {
-         handler::extract_json(message, jvalue);
-      } catch (...) {
-         // Error parsing the json, probably a syntax error
-         ucout << U("Warning: extract_json failed - probably a syntax error") << endl;
-      }
+// POST /ctrl/shutdown
+void handler::post_ctrl_shutdown(request_args & req, json::value & reply, status_code & retval) {
+   extern std::atomic<int> stop_main;   // tell the main loop that we want to shut down
+   stop_main.store(1);
+   ucout << "Shutdown requested due to API request" << endl;
+}
 
-      if (path == U("/ctrl/time")) {
-         const auto funcname = U("SetTimeStampInDomain");
-         time_t timestamp;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("time"), reply, timestamp)) {
-            std::tm tm;
-            localtime_s(&tm, &timestamp);
-            TRYAPI1(time,
-               p_Port->SetTimeStampInDomain(tm);
-               reply[U("status")] = json::value(U("time set"));
+//
+// PUT routes
+//
+// PUT /ctrl/time
+void handler::put_ctrl_time(request_args & req, json::value & reply, status_code & retval) {
+   const auto funcname = U("SetTimeStampInDomain");
+   time_t timestamp;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("time"), reply, timestamp)) {
+      std::tm tm;
+      localtime_s(&tm, &timestamp);
+      TRYAPI1(time,
+         p_Port->SetTimeStampInDomain(tm);
+         stats.sample_time(timestamp);
+         reply[U("status")] = json::value(U("time set"));
+         reply[U("returncode")] = json::value(0);
+         retval = status_codes::OK;
+      );
+   } else {
+      cout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+}
+
+// PUT /ctrl/sample
+void handler::put_ctrl_sample(request_args & req, json::value & reply, status_code & retval) {
+   const auto funcname = U("SetCoincidentInputsForSubject");
+   json::value values;
+   uint64_t subjectkey;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("subject"), reply, subjectkey) &&
+      handler::get_json_value(false, req.jvalue, req.querystringmap, U("values"), values)) {
+      NGuiKey subject(subjectkey);
+      if (values.is_array()) {
+         auto a = values.as_array();
+         // a is now a json::value::array (hopefully of doubles)
+         int count = a.size();
+         if (count > 0 && count < 10000) {  // MAXIMUM 9999 values accepted in a sample (make into a constant!)
+            // WARNING: dlist gets freed at end of block, so if Dan's code isn't
+            // making a copy of it there WILL be problems!
+            std::vector<double> dlist;
+            try {
+               for (auto const& v : a) {
+                  dlist.push_back(v.as_double());
+               }
+            } catch (...) {
+               stringstream msg;
+               msg << U("Invalid value type likely due to non-numeric data");
+               ucout << msg.str() << endl;
+               reply[U("error")] = json::value(msg.str());
+               reply[U("returncode")] = json::value(-1);
+               retval = status_codes::BadRequest;
+               return;
+            }
+            TRYAPI1(values,
+               p_Port->SetCoincidentInputsForSubject(dlist, subject);
+               update_seq();
+               stringstream msg;
+               msg << U("added sample of ") << count << U(" channels");
                reply[U("returncode")] = json::value(0);
-               retval = status_codes::OK;
+               reply[U("status")] = json::value(msg.str());
             );
          } else {
-            cout << funcname << ": " << reply[U("error")].as_string() << endl;
+            stringstream msg;
+            msg << U("channel count out of range");
+            ucout << funcname << U(": ") << msg.str() << endl;
+            reply[U("error")] = json::value(msg.str());
+            reply[U("returncode")] = json::value(-1);
             retval = status_codes::BadRequest;
          }
+      } else {
+         stringstream msg;
+         msg << U("values parameter must be array of doubles");
+         ucout << funcname << U(": ") << msg.str() << endl;
+         reply[U("error")] = json::value(msg.str());
+         reply[U("returncode")] = json::value(-1);
+         retval = status_codes::BadRequest;
+      }
+   } else {
+      stringstream msg;
+      msg << U("values parameter not found");
+      ucout << funcname << U(": ") << msg.str() << endl;
+      reply[U("error")] = json::value(msg.str());
+      reply[U("returncode")] = json::value(-1);
+      retval = status_codes::BadRequest;
+   }
+}
+
+// PUT /ctrl/sampletimestep
+//
+// Everything is parsed and checked here first, then the time, samples and step go to the
+// engine as one command, so they are applied together and nothing else runs in between.
+void handler::put_ctrl_sampletimestep(request_args & req, json::value & reply, status_code & retval) {
+   const auto funcname = U("SampleTimeStep");
+
+   // A step in a registered layout, {"layout":ID,"time":INT,"values":[...]}, goes in as an
+   // ingest batch of one
+   json::value layoutparam;
+   if (handler::get_json_value(true, req.jvalue, req.querystringmap, U("layout"), layoutparam)) {
+      uint64_t layoutid = 0;
+      std::shared_ptr<const ingest_layout> layout;
+      json::value values;
+      std::vector<ingest_step> batch(1);
+      ingest_result result;
+      std::string error;
+      if (!handler::get_json_value(false, req.jvalue, req.querystringmap, U("layout"), reply, layoutid) || !(layout = find_layout(layoutid)))
+         error = "unknown layout";
+      else if (!handler::get_json_value(false, req.jvalue, req.querystringmap, U("time"), reply, batch[0].time))
+         error = "time parameter not found";
+      else if (!handler::get_json_value(false, req.jvalue, req.querystringmap, U("values"), values))
+         error = "values parameter not found";
+      else if (parse_layout_values(values, *layout, batch[0], error)) {
+         batch[0].line = 1;
+         run_ingest_batch(batch, 1, result);
+         if (result.failed > 0)
+            error = result.errors.empty() ? "API call failed" : result.errors[0].second;
+      }
+      if (!error.empty()) {
+         ucout << funcname << U(": ") << error << endl;
+         reply[U("error")] = json::value(error);
+         reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
+         retval = status_codes::BadRequest;
+         return;
+      }
+      stringstream msg;
+      msg << U("added sample of ") << values.size() << U(" values in layout ") << layoutid;
+      reply[U("returncode")] = json_reply(EGuiReply::OKAY_allDone);
+      reply[U("status")] = json::value(msg.str());
+      return;
+   }
 
-      } else if (path == U("/ctrl/sample")) {
-         const auto funcname = U("SetCoincidentInputsForSubject");
-         json::value values;
-         uint64_t subjectkey;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("subject"), reply, subjectkey) &&
-            handler::get_json_value(false, jvalue, querystringmap, U("values"), values)) {
+   time_t timestamp;
+   json::value valuesbysubject;
+   if (  handler::get_json_value(false, req.jvalue, req.querystringmap, U("values_by_subject"), valuesbysubject) &&
+         handler::get_json_value(false, req.jvalue, req.querystringmap, U("time"), reply, timestamp) ) {
+      std::vector<std::pair<NGuiKey, std::vector<double>>> samples;
+      auto m = current_model();
+      if (valuesbysubject.is_array()) {
+         for (const auto & json_o : valuesbysubject.as_array()) {
+            // json_o is a json object with properties "subject" and "values"
+            uint64_t subjectkey = 0;
+            try { subjectkey = json_o.at(U("subject")).as_integer(); } catch (...) { /* NEED ERROR MESSAGE HERE */ continue; };
             NGuiKey subject(subjectkey);
-            if (values.is_array()) {
-               auto a = values.as_array();
-               // a is now a json::value::array (hopefully of doubles)
+            try {
+               auto const & points = m->subjectpoints.at(subject);
+               auto a = json_o.at(U("values")).as_array();
                int count = a.size();
-               if (count > 0 && count < 10000) {  // MAXIMUM 9999 values accepted in a sample (make into a constant!)
-                  // WARNING: dlist gets freed at end of block, so if Dan's code isn't
-                  // making a copy of it there WILL be problems!
+               // TODO: We don't currently have any way to validate the point names
+               // (But for now we can at least validate the number of points matches
+               // what is expected by this subject)
+               if (points.size() == count && count > 0) {
                   std::vector<double> dlist;
                   try {
                      for (auto const& v : a) {
@@ -1542,220 +2252,794 @@ void handler::handle_put(http_request message)
                      msg << U("Invalid value type likely due to non-numeric data");
                      ucout << msg.str() << endl;
                      reply[U("error")] = json::value(msg.str());
-                     reply[U("returncode")] = json::value(-1);
+                     reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
                      retval = status_codes::BadRequest;
-                     goto done;
+                     return;
                   }
-                  TRYAPI1(values,
-                     p_Port->SetCoincidentInputsForSubject(dlist, subject);
-                     update_seq();
-                     stringstream msg;
-                     msg << U("added sample of ") << count << U(" channels");
-                     reply[U("returncode")] = json::value(0);
-                     reply[U("status")] = json::value(msg.str());
-                  );
+                  samples.push_back(std::make_pair(subject, std::move(dlist)));
                } else {
                   stringstream msg;
-                  msg << U("channel count out of range");
+                  msg << U("channel count out of range for subject ") << subjectkey;
                   ucout << funcname << U(": ") << msg.str() << endl;
                   reply[U("error")] = json::value(msg.str());
-                  reply[U("returncode")] = json::value(-1);
+                  reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenContainerWrongSizeForKeyGiven);
                   retval = status_codes::BadRequest;
                }
-            } else {
-               stringstream msg;
-               msg << U("values parameter must be array of doubles");
-               ucout << funcname << U(": ") << msg.str() << endl;
-               reply[U("error")] = json::value(msg.str());
-               reply[U("returncode")] = json::value(-1);
+            } catch (...) {
+               /* NEED ERROR MESSAGE HERE */
+               continue;
+            };
+         } // end foreach(subject)
+
+      } else {
+         stringstream msg;
+         msg << U("values_by_subject parameter must be array of objects with subject and values parameters");
+         ucout << funcname << U(": ") << msg.str() << endl;
+         reply[U("error")] = json::value(msg.str());
+         reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
+         retval = status_codes::BadRequest;
+      }
+      if (retval == status_codes::OK) {
+         std::tm tm;
+         localtime_s(&tm, &timestamp);
+         TRYAPI1(timestamp,
+            p_Port->SetTimeStampInDomain(tm);
+            stats.sample_time(timestamp);
+            for (auto const & s : samples)
+               p_Port->SetCoincidentInputsForSubject(s.second, s.first);
+            single_step();
+            update_seq();
+            publish_model();
+         );
+      } else {
+         ucout << funcname << ": skipping SingleStep because of previous errors" << endl;
+      }
+      if (retval == status_codes::OK) {
+         stringstream msg;
+         if (samples.empty())
+            msg << U("time set");
+         else
+            msg << U("added sample of ") << samples.back().second.size() << U(" channels to subject ") << samples.back().first.Peek();
+         reply[U("returncode")] = json_reply(EGuiReply::OKAY_allDone);
+         reply[U("status")] = json::value(msg.str());
+      }
+   } else {
+      stringstream msg;
+      msg << U("time and/or values_by_subject parameters not found");
+      ucout << funcname << U(": ") << msg.str() << endl;
+      reply[U("error")] = json::value(msg.str());
+      reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
+      retval = status_codes::BadRequest;
+   }
+}
+
+// PUT /ctrl/answercase
+void handler::put_ctrl_answercase(request_args & req, json::value & reply, status_code & retval) {
+   // EGuiReply AnswerCaseOnSubjectWithZeroBasedOptionIndex( NGuiKey, NGuiKey, size_t );
+
+   const auto funcname = U("AnswerCaseOnSubjectWithZeroBasedOptionIndex");
+   EGuiReply returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
+   uint64_t casekeykey;
+   int answer;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("case"), reply, casekeykey) &&
+         handler::get_json_value(false, req.jvalue, req.querystringmap, U("answer"), reply, answer)) {
+      auto casekey = NGuiKey(casekeykey);
+      TRYAPI2(casekeykey, answer,
+         returncode = p_Port->AnswerCaseWithZeroBasedOptionIndex(casekey, (size_t) answer);
+         update_seq();
+         publish_model();
+      );
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+   reply[U("returncode")] = json_reply(returncode);
+   reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
+}
+
+// PUT /set/knob
+void handler::put_set_knob(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SetKnobToValue");
+   auto returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
+   uint64_t knobkey;
+   GuiFpn_t fpnvalue;
+   int intvalue;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, knobkey) &&
+         handler::get_json_value(false, req.jvalue, req.querystringmap, U("value"), reply, fpnvalue)) {
+      TRYAPI2(knobkey, fpnvalue,
+         returncode = p_Port->SetKnobToValue(NGuiKey(knobkey), fpnvalue);
+         update_seq();
+         publish_model();
+      );
+   } else if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, knobkey) &&
+         handler::get_json_value(false, req.jvalue, req.querystringmap, U("value"), reply, intvalue)) {
+      fpnvalue = (GuiFpn_t) intvalue;
+      TRYAPI2(knobkey, fpnvalue,
+         returncode = p_Port->SetKnobToValue(NGuiKey(knobkey), fpnvalue);
+         update_seq();
+         publish_model();
+      );
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+   reply[U("returncode")] = json_reply(returncode);
+   reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
+}
+
+// PUT /set/histogram/mode
+void handler::put_set_histogram_mode(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SetHistogramMode");
+   auto returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
+   uint64_t hkey;
+   size_t intvalue;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, hkey) &&
+         handler::get_json_value(false, req.jvalue, req.querystringmap, U("value"), reply, intvalue)) {
+      TRYAPI2(hkey, intvalue,
+         returncode = p_Port->SetModeOfHistogramToZeroBasedOptionIndex(NGuiKey(hkey), intvalue);
+         update_seq();
+         publish_model();
+      );
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+   reply[U("returncode")] = json_reply(returncode);
+   reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
+}
+
+// PUT /set/histogram/span
+void handler::put_set_histogram_span(request_args & req, json::value & reply, status_code & retval) {
+   auto funcname = U("SetHistogramSpan");
+   auto returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
+   uint64_t hkey;
+   size_t intvalue;
+   if (handler::get_json_value(false, req.jvalue, req.querystringmap, U("key"), reply, hkey) &&
+         handler::get_json_value(false, req.jvalue, req.querystringmap, U("value"), reply, intvalue)) {
+      TRYAPI2(hkey, intvalue,
+         returncode = p_Port->SetSpanOfHistogramToZeroBasedOptionIndex(NGuiKey(hkey), intvalue);
+         update_seq();
+         publish_model();
+      );
+   } else {
+      stringstream msg;
+      ucout << funcname << ": " << reply[U("error")].as_string() << endl;
+      retval = status_codes::BadRequest;
+   }
+   reply[U("returncode")] = json_reply(returncode);
+   reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
+}
+
+// PUT /ctrl/ingest
+//
+// Bulk ingest of many timesteps in one request, for collector catch-up and historical loads.
+// The body is read in chunks as it arrives and each line becomes one step: either NDJSON,
+// one sampletimestep body per line, or the CSV layout of tests/testdata (date, time, ground
+// truth code, then each subject's points in turn). With format protobuf the body is instead
+// a stream of length-prefixed SampleTimeStep messages (protobuf/ingest.proto), each decoded
+// straight into the step's value vectors. Steps are queued into batches, and each batch
+// runs as a single engine command, with one seq update and one read model published at its
+// end. A bad line is reported and skipped; the rest still run. A message length that cannot
+// be read, or is over MAX_INGEST_MESSAGE_BYTES, is a framing error: nothing after it can be
+// found, so the steps before it run and the reply is 400, naming the length's byte offset.
+//
+void handler::put_ctrl_ingest(request_args & req, json::value & reply, status_code & retval) {
+   const auto funcname = U("Ingest");
+   auto m = current_model();
+
+   utility::string_t format;
+   if (!handler::get_querystring(req.querystringmap, U("format"), format)) {
+      auto ct = req.message.headers().find(U("Content-Type"));
+      format = U("ndjson");
+      if (ct != req.message.headers().end() && ct->second.find(U("csv")) != utility::string_t::npos)
+         format = U("csv");
+      else if (ct != req.message.headers().end() && ct->second.find(U("protobuf")) != utility::string_t::npos)
+         format = U("protobuf");
+   }
+   const bool csv = (format == U("csv"));
+   const bool protobuf = (format == U("protobuf"));
+   if (!csv && !protobuf && format != U("ndjson")) {
+      ucout << funcname << ": unknown format " << format << endl;
+      reply[U("error")] = json::value(U("format must be csv, ndjson or protobuf"));
+      retval = status_codes::BadRequest;
+      return;
+   }
+
+   unsigned int batchsteps = DEFAULT_INGEST_BATCH_STEPS;
+   handler::get_json_value(true, req.jvalue, req.querystringmap, U("batch"), reply, batchsteps);   // optional
+   batchsteps = std::max(1u, std::min(batchsteps, (unsigned int) MAX_INGEST_BATCH_STEPS));
+
+   // With "layout", each CSV row or NDJSON object holds values in that registered layout
+   std::shared_ptr<const ingest_layout> layout;
+   utility::string_t layoutstr;
+   if (handler::get_querystring(req.querystringmap, U("layout"), layoutstr)) {
+      try { layout = find_layout(std::stoull(layoutstr)); } catch (...) { }
+      if (!layout || protobuf) {
+         ucout << funcname << ": bad layout " << layoutstr << endl;
+         reply[U("error")] = json::value(layout ? U("layout applies to csv and ndjson only") : U("unknown layout"));
+         retval = status_codes::BadRequest;
+         return;
+      }
+   }
+
+   // CSV columns belong to the subjects listed in "subjects" (default: domain order), each
+   // taking as many columns as it has points
+   std::vector<std::pair<NGuiKey, size_t>> columns;
+   size_t ncolumns = 3;
+   if (csv && !layout) {
+      utility::string_t subjectliststr;
+      std::vector<NGuiKey> order;
+      if (handler::get_querystring(req.querystringmap, U("subjects"), subjectliststr)) {
+         std::stringstream s_stream(subjectliststr);
+         std::string substr;
+         while (getline(s_stream, substr, ',')) {
+            try {
+               order.push_back(NGuiKey(std::stoull(substr)));
+            } catch (...) {
+               ucout << funcname << ": bad subject key '" << substr << "'" << endl;
+               reply[U("error")] = json::value(U("subjects must be a comma-separated list of subject keys"));
                retval = status_codes::BadRequest;
+               return;
             }
-         } else {
+         }
+      } else {
+         order = domain.subjectKeys;
+      }
+      for (auto const & skey : order) {
+         auto points = m->subjectpoints.find(skey);
+         if (points == m->subjectpoints.end()) {
             stringstream msg;
-            msg << U("values parameter not found");
-            ucout << funcname << U(": ") << msg.str() << endl;
+            msg << "unknown subject key " << skey.Peek();
+            ucout << funcname << ": " << msg.str() << endl;
             reply[U("error")] = json::value(msg.str());
-            reply[U("returncode")] = json::value(-1);
             retval = status_codes::BadRequest;
+            return;
          }
+         columns.emplace_back(skey, points->second.size());
+         ncolumns += points->second.size();
+      }
+   }
 
-      } else if (path == U("/ctrl/sampletimestep")) {
-         const auto funcname = U("SampleTimeStep");
-         time_t timestamp;
-         json::value valuesbysubject;
-         uint64_t subjectkey;
-         std::lock_guard<std::mutex> stslock(instance_sampletimestep_lock);  // released at end of scope
-         if (  handler::get_json_value(false, jvalue, querystringmap, U("values_by_subject"), valuesbysubject) &&
-               handler::get_json_value(false, jvalue, querystringmap, U("time"), reply, timestamp) ) {
-            std::tm tm;
-            localtime_s(&tm, &timestamp);
-            TRYAPI1(time,
-               p_Port->SetTimeStampInDomain(tm);
-               reply[U("status")] = json::value(U("time set"));
-               reply[U("returncode")] = json::value(0);
-               retval = status_codes::OK;
-            );
-            if (valuesbysubject.is_array() && retval == status_codes::OK) {
-               for (const auto & json_o : valuesbysubject.as_array()) {
-                  // json_o is a json object with properties "subject" and "values"
-                  uint64_t subjectkey = 0;
-                  try { subjectkey = json_o.at(U("subject")).as_integer(); } catch (...) { /* NEED ERROR MESSAGE HERE */ continue; };
-                  NGuiKey subject(subjectkey);
-                  auto points = p_Port->SayInputPointNameOrderExpectedBySubject(subject);
-                  try {
-                     auto a = json_o.at(U("values")).as_array();
-                     int count = a.size();
-                     // TODO: We don't currently have any way to validate the point names
-                     // (But for now we can at least validate the number of points matches
-                     // what is expected by this subject)
-                     if (points.size() == count && count > 0) {
-                        // WARNING: dlist gets freed at end of block, so if Dan's code isn't
-                        // making a copy of it there WILL be problems!
-                        std::vector<double> dlist;
-                        try {
-                           for (auto const& v : a) {
-                              dlist.push_back(v.as_double());
-                           }
-                        } catch (...) {
-                           stringstream msg;
-                           msg << U("Invalid value type likely due to non-numeric data");
-                           ucout << msg.str() << endl;
-                           reply[U("error")] = json::value(msg.str());
-                           reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
-                           retval = status_codes::BadRequest;
-                           goto done;
-                        }
-                        TRYAPI1(valuesbysubject,
-                           p_Port->SetCoincidentInputsForSubject(dlist, subject);
-                           stringstream msg;
-                           msg << U("added sample of ") << count << U(" channels to subject ") << subjectkey;
-                           reply[U("returncode")] = json_reply(EGuiReply::OKAY_allDone);
-                           reply[U("status")] = json::value(msg.str());
-                        );
-                     } else {
-                        stringstream msg;
-                        msg << U("channel count out of range for subject ") << subjectkey;
-                        ucout << funcname << U(": ") << msg.str() << endl;
-                        reply[U("error")] = json::value(msg.str());
-                        reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenContainerWrongSizeForKeyGiven);
-                        retval = status_codes::BadRequest;
-                     }
-                  } catch (...) {
-                     /* NEED ERROR MESSAGE HERE */
-                     continue;
-                  };
-               } // end foreach(subject)
+   std::vector<ingest_step> batch(batchsteps);
+   size_t queued = 0;
+   ingest_result result;
+   std::vector<uint8_t> chunk(INGEST_CHUNK_BYTES);
+   std::string pending;
+   std::string line;
+   std::vector<const char *> fields;
+   size_t lineno = 0;
+   size_t offset = 0;                   // of pending[0] in the body
+   std::string framingerror;
+
+   // Queue the step just parsed into batch[queued], running the batch once it is full
+   auto queue_step = [&](bool ok, const std::string & error) {
+      if (!ok) {
+         result.fail(lineno, error);
+      } else if (++queued == batch.size()) {
+         run_ingest_batch(batch, queued, result);
+         queued = 0;
+      }
+   };
 
-            } else {
-               stringstream msg;
-               msg << U("values_by_subject parameter must be array of objects with subject and values parameters");
-               ucout << funcname << U(": ") << msg.str() << endl;
-               reply[U("error")] = json::value(msg.str());
-               reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
-               retval = status_codes::BadRequest;
+   try {
+      auto body = req.message.body().streambuf();
+      bool eof = false;
+      while (!eof && framingerror.empty()) {
+         size_t got = body.getn(chunk.data(), chunk.size()).get();
+         if (got == 0) {
+            eof = true;
+            if (!protobuf && !pending.empty() && pending.back() != '\n')
+               pending += '\n';         // last line had no newline
+         } else {
+            pending.append(reinterpret_cast<const char *>(chunk.data()), got);
+         }
+         size_t start = 0;
+         if (protobuf) {
+            const uint8_t * p = reinterpret_cast<const uint8_t *>(pending.data());
+            size_t header;
+            uint64_t len;
+            std::string framing;
+            while (ingestproto::decode_length(p + start, pending.size() - start, header, len, framing)) {
+               if (len > MAX_INGEST_MESSAGE_BYTES) {
+                  framing = "message length " + std::to_string(len) + " is over the maximum of " + std::to_string(MAX_INGEST_MESSAGE_BYTES);
+                  break;
+               }
+               if (len > pending.size() - start - header)
+                  break;                // rest of this message is still to come
+               lineno++;
+               std::string error;
+               auto & step = batch[queued];
+               step.line = lineno;
+               bool ok = ingestproto::decode_step(p + start + header, len, step, error);
+               start += header + len;
+               queue_step(ok, error);
             }
-            if (retval == status_codes::OK) {
-               p_Port->SingleStepDomainOnTimeAndInputs();
-               update_seq();
-            } else {
-               ucout << funcname << ": skipping SingleStep because of previous errors" << endl;
+            if (!framing.empty()) {
+               // No later message can be found once a length is bad, so the rest of the body is refused
+               stringstream msg;
+               msg << framing << " at byte " << (offset + start);
+               framingerror = msg.str();
+            } else if (eof && start < pending.size()) {
+               result.fail(lineno + 1, "truncated message at end of body");
             }
          } else {
-            stringstream msg;
-            msg << U("time and/or values_by_subject parameters not found");
-            ucout << funcname << U(": ") << msg.str() << endl;
-            reply[U("error")] = json::value(msg.str());
-            reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
-            retval = status_codes::BadRequest;
+            size_t nl;
+            while ((nl = pending.find('\n', start)) != std::string::npos) {
+               line.assign(pending, start, nl - start);
+               start = nl + 1;
+               lineno++;
+               if (!line.empty() && line.back() == '\r')
+                  line.pop_back();
+               if (line.empty())
+                  continue;
+               if (csv && lineno == 1 && !std::isdigit((unsigned char) line[0]))
+                  continue;             // header row
+               std::string error;
+               auto & step = batch[queued];
+               step.line = lineno;
+               if (layout)
+                  queue_step(csv ? parse_layout_csv(line, *layout, fields, step, error)
+                                 : parse_layout_ndjson(line, *layout, step, error), error);
+               else
+                  queue_step(csv ? parse_ingest_csv(line, columns, ncolumns, step, error)
+                                 : parse_ingest_ndjson(line, step, error), error);
+            }
          }
+         offset += start;
+         pending.erase(0, start);
+      }
+   } catch (...) {
+      ucout << funcname << ": request body read failed after step " << lineno << endl;
+      reply[U("error")] = json::value(U("request body read failed"));
+      retval = status_codes::BadRequest;
+   }
+   if (!framingerror.empty()) {
+      ucout << funcname << ": " << framingerror << endl;
+      reply[U("error")] = json::value(framingerror);
+      retval = status_codes::BadRequest;
+   }
+   if (queued > 0)
+      run_ingest_batch(batch, queued, result);
+
+   ucout << funcname << ": " << result.steps << " steps from " << lineno << " " << (protobuf ? "messages" : "lines") << ", " << result.failed << " failed" << endl;
+   json::value errors = json::value::array();
+   for (size_t i = 0; i < result.errors.size(); i++) {
+      errors[i] = json::value::object();
+      errors[i][U("line")] = json_num(result.errors[i].first);
+      errors[i][U("error")] = json::value(result.errors[i].second);
+   }
+   reply[U("steps")] = json_num(result.steps);
+   reply[U("failed")] = json_num(result.failed);
+   reply[U("errors")] = errors;
+   reply[U("returncode")] = json_reply(result.failed == 0 ? EGuiReply::OKAY_allDone : EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
+}
 
-      } else if (path == U("/ctrl/answercase")) {
-         // EGuiReply AnswerCaseOnSubjectWithZeroBasedOptionIndex( NGuiKey, NGuiKey, size_t );
-
-         const auto funcname = U("AnswerCaseOnSubjectWithZeroBasedOptionIndex");
-         EGuiReply returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
-         uint64_t casekeykey;
-         int answer;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("case"), reply, casekeykey) &&
-               handler::get_json_value(false, jvalue, querystringmap, U("answer"), reply, answer)) {
-            auto casekey = NGuiKey(casekeykey);
-            TRYAPI2(casekeykey, answer,
-               returncode = p_Port->AnswerCaseWithZeroBasedOptionIndex(casekey, (size_t) answer);
-               update_seq();
-            );
-         } else {
-            stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
+// PUT /ctrl/layout
+//
+// Register a named-point layout, {"columns":[{"name":..., "subject":KEY, "point":NAME}, ...]},
+// for later steps to be sent in. A column may give "channel" (0-based) instead of "point", and
+// a column with no "subject" is skipped. Every point of each subject named must be fed by
+// exactly one column. Registering a layout identical to one already held returns its id.
+//
+void handler::put_ctrl_layout(request_args & req, json::value & reply, status_code & retval) {
+   const auto funcname = U("Layout");
+   auto m = current_model();
+   auto fail = [&](const std::string & error) {
+      ucout << funcname << ": " << error << endl;
+      reply[U("error")] = json::value(error);
+      reply[U("returncode")] = json_reply(EGuiReply::FAIL_set_givenValueOutOfRangeAllowed);
+      retval = status_codes::BadRequest;
+   };
+
+   json::value columns;
+   if (!handler::get_json_value(false, req.jvalue, req.querystringmap, U("columns"), columns) || !columns.is_array() || columns.size() == 0) {
+      fail("columns must be a non-empty array of objects with name, subject and point or channel");
+      return;
+   }
+
+   auto layout = std::make_shared<ingest_layout>();
+   std::map<NGuiKey, size_t> slots;
+   std::vector<std::vector<size_t>> fedby;      // per slot and channel: column feeding it, or skip
+   std::set<std::string> names;
+   for (auto const & col : columns.as_array()) {
+      const size_t c = layout->names.size();
+      std::string name;
+      NGuiKey subject;
+      bool hassubject = false;
+      long long channel = -1;
+      std::string point;
+      try {
+         name = col.at(U("name")).as_string();
+         if (col.has_field(U("subject"))) {
+            subject = NGuiKey(col.at(U("subject")).as_number().to_uint64());
+            hassubject = true;
          }
-         reply[U("returncode")] = json_reply(returncode);
-         reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
-
-      } else if (path == U("/set/knob")) {
-         auto funcname = U("SetKnobToValue");
-         auto returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
-         uint64_t knobkey;
-         GuiFpn_t fpnvalue;
-         int intvalue;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, knobkey) &&
-               handler::get_json_value(false, jvalue, querystringmap, U("value"), reply, fpnvalue)) {
-            TRYAPI2(knobkey, fpnvalue,
-               returncode = p_Port->SetKnobToValue(NGuiKey(knobkey), fpnvalue);
-               update_seq();
-            );
-         } else if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, knobkey) &&
-               handler::get_json_value(false, jvalue, querystringmap, U("value"), reply, intvalue)) {
-            fpnvalue = (GuiFpn_t) intvalue;
-            TRYAPI2(knobkey, fpnvalue,
-               returncode = p_Port->SetKnobToValue(NGuiKey(knobkey), fpnvalue);
-               update_seq();
-            );
-         } else {
+         if (col.has_field(U("channel")))
+            channel = col.at(U("channel")).as_integer();
+         else if (col.has_field(U("point")))
+            point = col.at(U("point")).as_string();
+      } catch (...) {
+         stringstream msg;
+         msg << "column " << c << " is not an object with name, subject and point or channel";
+         fail(msg.str());
+         return;
+      }
+      if (!names.insert(name).second) {
+         fail("duplicate column name " + name);
+         return;
+      }
+      layout->names.push_back(name);
+      if (!hassubject) {
+         layout->scatter.emplace_back(ingest_layout::skip, 0);
+         continue;
+      }
+
+      auto points = m->subjectpoints.find(subject);
+      if (points == m->subjectpoints.end()) {
+         stringstream msg;
+         msg << "unknown subject key " << subject.Peek() << " for column " << name;
+         fail(msg.str());
+         return;
+      }
+      auto slot = slots.find(subject);
+      if (slot == slots.end()) {
+         slot = slots.emplace(subject, layout->subjects.size()).first;
+         layout->subjects.emplace_back(subject, points->second.size());
+         fedby.emplace_back(points->second.size(), ingest_layout::skip);
+      }
+      auto & fed = fedby[slot->second];
+
+      // A point name goes to the first channel of that name not already fed, so a subject
+      // with two points of the same name takes them in channel order
+      if (channel < 0 && !point.empty()) {
+         for (size_t i = 0; i < points->second.size(); i++) {
+            if (fed[i] == ingest_layout::skip && json_pointname(points->second[i]).as_string() == point) {
+               channel = i;
+               break;
+            }
+         }
+         if (channel < 0) {
             stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
+            msg << "subject " << subject.Peek() << " has no unfed point " << point << " for column " << name;
+            fail(msg.str());
+            return;
          }
-         reply[U("returncode")] = json_reply(returncode);
-         reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
-
-      } else if (path == U("/set/histogram/mode")) {
-         auto funcname = U("SetHistogramMode");
-         auto returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
-         uint64_t hkey;
-         size_t intvalue;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, hkey) &&
-               handler::get_json_value(false, jvalue, querystringmap, U("value"), reply, intvalue)) {
-            TRYAPI2(hkey, intvalue,
-               returncode = p_Port->SetModeOfHistogramToZeroBasedOptionIndex(NGuiKey(hkey), intvalue);
-               update_seq();
-            );
-         } else {
+      }
+      if (channel < 0 || (size_t) channel >= fed.size()) {
+         stringstream msg;
+         msg << "column " << name << " needs a point name or a channel below " << fed.size();
+         fail(msg.str());
+         return;
+      }
+      if (fed[channel] != ingest_layout::skip) {
+         stringstream msg;
+         msg << "channel " << channel << " of subject " << subject.Peek() << " is fed by both " << layout->names[fed[channel]] << " and " << name;
+         fail(msg.str());
+         return;
+      }
+      fed[channel] = c;
+      layout->scatter.emplace_back(slot->second, channel);
+   }
+
+   for (size_t j = 0; j < layout->subjects.size(); j++) {
+      auto const & points = m->subjectpoints.at(layout->subjects[j].first);
+      for (size_t i = 0; i < fedby[j].size(); i++) {
+         if (fedby[j][i] == ingest_layout::skip) {
             stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
+            msg << "no column feeds point " << json_pointname(points[i]).as_string() << " (channel " << i << ") of subject " << layout->subjects[j].first.Peek();
+            fail(msg.str());
+            return;
          }
-         reply[U("returncode")] = json_reply(returncode);
-         reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
-
-      } else if (path == U("/set/histogram/span")) {
-         auto funcname = U("SetHistogramSpan");
-         auto returncode = EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
-         uint64_t hkey;
-         size_t intvalue;
-         if (handler::get_json_value(false, jvalue, querystringmap, U("key"), reply, hkey) &&
-               handler::get_json_value(false, jvalue, querystringmap, U("value"), reply, intvalue)) {
-            TRYAPI2(hkey, intvalue,
-               returncode = p_Port->SetSpanOfHistogramToZeroBasedOptionIndex(NGuiKey(hkey), intvalue);
-               update_seq();
-            );
-         } else {
+      }
+   }
+
+   uint64_t layoutid = 0;
+   {
+      std::lock_guard<std::mutex> guard(layoutlock);
+      for (size_t i = 0; i < layouts.size() && layoutid == 0; i++) {
+         if (*layouts[i] == *layout)
+            layoutid = i + 1;
+      }
+      if (layoutid == 0 && layouts.size() < MAX_INGEST_LAYOUTS) {
+         layouts.push_back(layout);
+         layoutid = layouts.size();
+      }
+   }
+   if (layoutid == 0) {
+      fail("too many layouts registered");
+      return;
+   }
+
+   json::value subjectkeys = json::value::array();
+   for (size_t j = 0; j < layout->subjects.size(); j++)
+      subjectkeys[j] = json_key(layout->subjects[j].first);
+   reply[U("layout")] = json::value(layoutid);
+   reply[U("columns")] = json_num(layout->names.size());
+   reply[U("subjects")] = subjectkeys;
+   reply[U("returncode")] = json_reply(EGuiReply::OKAY_allDone);
+}
+
+// Registered layout by id, or null
+std::shared_ptr<const ingest_layout> handler::find_layout(uint64_t layoutid) {
+   std::lock_guard<std::mutex> guard(layoutlock);
+   if (layoutid == 0 || layoutid > layouts.size())
+      return nullptr;
+   return layouts[layoutid - 1];
+}
+
+//
+// Step the engine through the first n steps of a batch, as one engine command. Each step is
+// checked against the subjects' point counts first, here on the caller's thread, as
+// sampletimestep does; a step that fails the check, or whose API calls throw, is reported and
+// skipped. Called by PUT /ctrl/ingest and by the gRPC ingest service (ingestservice.hpp).
+//
+void handler::run_ingest_batch(std::vector<ingest_step> & batch, size_t n, ingest_result & result) {
+   auto m = current_model();
+   const size_t steps0 = result.steps;
+   const size_t failed0 = result.failed;
+   std::vector<bool> good(n, false);
+   for (size_t i = 0; i < n; i++) {
+      auto const & step = batch[i];
+      bool ok = (step.nsubjects > 0);
+      for (size_t j = 0; j < step.nsubjects && ok; j++) {
+         auto points = m->subjectpoints.find(step.values[j].first);
+         if (points == m->subjectpoints.end() || points->second.size() != step.values[j].second.size()) {
             stringstream msg;
-            ucout << funcname << ": " << reply[U("error")].as_string() << endl;
-            retval = status_codes::BadRequest;
+            msg << "channel count out of range for subject " << step.values[j].first.Peek();
+            result.fail(step.line, msg.str());
+            ok = false;
          }
-         reply[U("returncode")] = json_reply(returncode);
-         reply[U("success")] = returncode != EGuiReply::OKAY_allDone ? json::value(false) : json::value(true);
+      }
+      if (!ok && step.nsubjects == 0)
+         result.fail(step.line, "no values_by_subject");
+      good[i] = ok;
+   }
+   run_engine([&] {
+      for (size_t i = 0; i < n; i++) {
+         if (!good[i])
+            continue;
+         auto const & step = batch[i];
+         try {
+            std::tm tm;
+            localtime_s(&tm, &step.time);
+            p_Port->SetTimeStampInDomain(tm);
+            stats.sample_time(step.time);
+            for (size_t j = 0; j < step.nsubjects; j++)
+               p_Port->SetCoincidentInputsForSubject(step.values[j].second, step.values[j].first);
+            single_step();
+            result.steps++;
+         } catch (...) {
+            result.fail(step.line, "API call failed");
+         }
+      }
+      update_seq();
+      publish_model();
+   });
+   stats.ingested(result.steps - steps0, result.failed - failed0);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Code below are handlers for the various HTTP request types
+//
+///////////////////////////////////////////////////////////////////////////////
+
+
+//
+// GET Request
+//
+void handler::handle_get(http_request message)
+{
+   metrics::request timing(stats, "GET");
+   tracer::request tracing(traces, "GET");
+   auto uri = message.relative_uri();
+
+   // Everything below reads this one model (alerts included), so a reply is consistent
+   // even if the engine steps while it is being built. No lock is taken. Seq is the model's
+   // own, not the counter: writers bump the counter before they publish, so in between it is
+   // ahead of the model and a reply tagged with it would hold older data than its seq says.
+   auto m = current_model();
+   const uint64_t seqnow = m->seq;
+   bool cacheable = false;
+   bool gzipok = false;
+   int level = 0;
+   utility::string_t cachekey;
+
+   auto api = api_latest_version;
+   auto retval = status_codes::OK;
+   json::value reply;
+   utility::string_t path;
+   if (split_api_path(uri.path(), api, path)) {
+      timing.at(path);
+      tracing.at(path);
+      request_args req;
+      req.querystringmap = http::uri::split_query(uri.query());
+      req.recurse = true;
+      req.m = m;
+      req.message = message;
+      try {
+         tracer::phase traced("extract_json");
+         handler::extract_json(message, req.jvalue);
+      } catch (...) {
+         // Error parsing the json, probably a syntax error
+         ucout << U("Warning: extract_json failed - probably a syntax error") << endl;
+      }
+      int compact = 0;
+      if (handler::get_json_value(true, req.jvalue, req.querystringmap, U("compact"), reply, compact)) {
+         if (compact != 0)
+            req.recurse = false;
+      }
+
+      // Gzip the reply only if the client takes gzip and the route's class has a nonzero level.
+      // The two encodings are different representations, so they get their own cache entry, and
+      // their own ETag. The ETag follows the body actually sent: one under compression.min_bytes
+      // goes out plain even to a client taking gzip, so it carries the plain ETag.
+      level = (bulk_routes.count(path) > 0) ? compression.bulk_level : compression.small_level;
+      auto encoding = message.headers().find(U("Accept-Encoding"));
+      gzipok = level > 0 && encoding != message.headers().end() && Gzip::accepted(encoding->second);
+      cachekey = uri.to_string() + (gzipok ? U(" gzip") : U(""));
+
+      // Apart from eventwait (which waits on seq) a reply depends only on the URL and seq, so
+      // a repeat is answered from the cache, or with 304 if the client already holds it.
+      // Parameters passed in a json body are not part of the URL, so those are never cached.
+      cacheable = req.jvalue.is_null() && path != U("/ctrl/eventwait") && path != U("/ctrl/stream") && path != U("/metrics") && path != U("/debug/trace");
+      if (cacheable) {
+         // At one seq a URL always gets the same body, so for a gzip-taking client it was sent
+         // gzipped or plain every time, and whichever ETag the client holds names it.
+         auto inm = message.headers().find(U("If-None-Match"));
+         utility::string_t etag;
+         if (inm != message.headers().end()) {
+            if (etag_matches(inm->second, make_etag(seqnow, false)))
+               etag = make_etag(seqnow, false);
+            else if (gzipok && etag_matches(inm->second, make_etag(seqnow, true)))
+               etag = make_etag(seqnow, true);
+         }
+         if (!etag.empty()) {
+            http_response response (status_codes::NotModified);
+            tracing.status(status_codes::NotModified);
+            response.headers().add(U("Cache-Control"), U("no-cache"));
+            response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
+            response.headers().add(U("ETag"), etag);
+            response.headers().add(U("Vary"), U("Accept-Encoding"));
+            message.reply(response);
+            return;
+         }
+         responsecache::entry hit;
+         if (cache.find(cachekey, seqnow, hit)) {
+            tracer::phase traced("reply (cached)");
+            reply_get(message, status_codes::OK, hit, make_etag(seqnow, hit.compressed));
+            return;
+         }
+      }
+
+      auto route = get_routes.find(path);
+      if (route != get_routes.end()) {
+         tracer::phase traced("route");
+         (this->*(route->second))(req, reply, retval);
+         if (req.replied)
+            return;
+      } else {
+         ucout << "Unrecognized GET path: " << path << endl;
+         reply[U("error")] = json::value::string(U("Unrecognized GET path (" + path + ")"));
+         retval = status_codes::NotImplemented;
+      }
+   }
+   reply[U("apiver")] = json::value(api);   // Always include the API version in the reply
+   // Always include the sequence number in the reply (the one the reply was built at, so the
+   // cached copy agrees with its ETag; eventwait reports the seq it woke up on)
+   reply[U("seq")] = cacheable ? json::value(seqnow) : json::value(seq);
+   reply[U("alertseq")] = json::value(m->alertseq);
+   timing.status(retval);
+   tracing.status(retval);
+   //message.reply(retval, reply);
+   std::string body;
+   {
+      tracer::phase traced("serialize");
+      body = reply.serialize();
+   }
+   responsecache::entry built;
+   built.seq = seqnow;
+   built.compressed = gzipok && body.size() >= compression.min_bytes;   // small bodies gain nothing
+   if (built.compressed) {
+      tracer::phase traced("gzip");
+      auto gzipped = Gzip::compress(body, level);
+      stats.gzipped(body.size(), gzipped.size());
+      built.body = std::make_shared<const std::string>(std::move(gzipped));
+   } else {
+      built.body = std::make_shared<const std::string>(std::move(body));
+   }
+   tracer::phase traced("reply");
+   if (cacheable && retval == status_codes::OK) {
+      cache.put(cachekey, built);
+      reply_get(message, retval, built, make_etag(seqnow, built.compressed));   // reply is done here
+   } else {
+      reply_get(message, retval, built, U(""));        // reply is done here
+   }
+   return;
+};
+
+//
+// A POST request
+//
+void handler::handle_post(http_request message)
+{
+   metrics::request timing(stats, "POST");
+   tracer::request tracing(traces, "POST");
+   auto uri = message.relative_uri();
+
+   auto api = api_latest_version;
+   auto retval = status_codes::OK;
+   json::value reply;
+   utility::string_t path;
+   if (split_api_path(uri.path(), api, path)) {
+      timing.at(path);
+      tracing.at(path);
+      request_args req;
+      req.querystringmap = http::uri::split_query(uri.query());
+      req.recurse = true;
+      auto route = post_routes.find(path);
+      if (route != post_routes.end()) {
+         tracer::phase traced("route");
+         (this->*(route->second))(req, reply, retval);
+      } else {
+         ucout << "Unrecognized POST path: " << path << endl;
+         reply[U("error")] = json::value::string(U("Unrecognized POST path (" + path + ")"));
+         retval = status_codes::NotImplemented;
+      }
+   }
+   reply[U("apiver")] = json::value(api);   // Always include the API version in the reply
+   reply[U("seq")] = json::value(seq);      // Always include the sequence number
+   timing.status(retval);
+   tracing.status(retval);
+   //message.reply(retval, reply);
+   tracer::phase traced("reply");
+   http_response response (retval);
+   response.headers().add(U("Cache-Control"), U("no-cache"));
+   response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
+   response.set_body(reply);
+   message.reply(response);         // reply is done here
+   return;
+};
+
+
+//
+// A PUT request
+//
+void handler::handle_put(http_request message)
+{
+   metrics::request timing(stats, "PUT");
+   tracer::request tracing(traces, "PUT");
+   auto uri = message.relative_uri();
+
+   auto api = api_latest_version;
+   auto retval = status_codes::OK;
+   json::value reply;
+   utility::string_t path;
+   if (split_api_path(uri.path(), api, path)) {
+      timing.at(path);
+      tracing.at(path);
+      request_args req;
+      req.querystringmap = http::uri::split_query(uri.query());
+      req.recurse = true;
+      req.message = message;
+      if (stream_routes.count(path) == 0) {
+         try {
+            tracer::phase traced("extract_json");
+            handler::extract_json(message, req.jvalue);
+         } catch (...) {
+            // Error parsing the json, probably a syntax error
+            ucout << U("Warning: extract_json failed - probably a syntax error") << endl;
+         }
+      }
 
+      auto route = put_routes.find(path);
+      if (route != put_routes.end()) {
+         tracer::phase traced("route");
+         (this->*(route->second))(req, reply, retval);
       } else {
          stringstream msg;
          msg << "Unrecognized PUT path: " << path;
@@ -1764,10 +3048,12 @@ void handler::handle_put(http_request message)
          retval = status_codes::NotImplemented;
       }
    }
-done:
    reply[U("apiver")] = json::value(api);   // Always include the API version in the reply
    reply[U("seq")] = json::value(seq);      // Always include the sequence number in the reply
+   timing.status(retval);
+   tracing.status(retval);
    //message.reply(retval, reply);
+   tracer::phase traced("reply");
    http_response response (retval);
    response.headers().add(U("Cache-Control"), U("no-cache"));
    response.headers().add(U("Access-Control-Allow-Origin"), U("*")); // TODO SECURITY: GET RID OF *
@@ -1,17 +1,51 @@
 #ifndef HANDLER_H
 #define HANDLER_H
 #include <iostream>
-#include <regex>
 #include <mutex>
 #include <atomic>
 #include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <ctime>
 #include "stdafx.h"
 #include "exportCalls.hpp"
+#include "readmodel.hpp"
+#include "responsecache.hpp"
+#include "ingest.hpp"
+#include "eventstream.hpp"
+#include "enginethread.hpp"
+#include "metrics.hpp"
+#include "tracing.hpp"
 
 #define DEFAULT_EVENTWAIT_SECONDS 30
 #define MAX_ALERT_BUFFER_SIZE 128
-
-typedef uint64_t AlertId_t;
+#define MAX_BATCH_KEYS 1000
+#define DEFAULT_RESPONSECACHE_ENTRIES 256
+#define DEFAULT_EVENTSTREAM_QUEUE_BYTES (1024 * 1024)
+#define DEFAULT_GZIP_BULK_LEVEL 6
+#define DEFAULT_GZIP_SMALL_LEVEL 1
+#define DEFAULT_GZIP_MIN_BYTES 1024
+#define DEFAULT_INGEST_BATCH_STEPS 256
+#define MAX_INGEST_BATCH_STEPS 10000
+#define INGEST_CHUNK_BYTES 65536
+#define MAX_INGEST_MESSAGE_BYTES (16 * 1024 * 1024)
+#define DEFAULT_ENGINE_QUEUE_COMMANDS 1024
+#define MAX_INGEST_LAYOUTS 64
+#define MIN_HTTP_THREADS 2
+#define DEFAULT_TRACE_SAMPLE_EVERY 16
+#define DEFAULT_TRACE_SLOW_MS 250
+#define DEFAULT_TRACE_RING_ENTRIES 256
+
+// GET reply compression, by route class. Level is zlib's 1 (fastest) to 9 (smallest); 0 never
+// compresses that class. Bodies under min_bytes are always sent uncompressed.
+struct compression_config
+{
+   int bulk_level;      // routes replying with object trees (subjects, features, cases, kronos)
+   int small_level;     // all other GET routes
+   size_t min_bytes;
+};
 
 class handler
 {
@@ -25,7 +59,11 @@ class handler
       virtual ~handler();
 
       pplx::task<void>open()  {return m_listener.open();}
-      pplx::task<void>close() {return m_listener.close();}
+      pplx::task<void>close();
+
+      void set_compression(const compression_config&);
+      void set_tracing(const tracing_config&);
+      void run_ingest_batch(std::vector<ingest_step>&, size_t, ingest_result&);   // any thread
 
    protected:
 
@@ -36,24 +74,76 @@ class handler
       void handle_delete(web::http::http_request message);
       void handle_options(web::http::http_request message);
       void handle_error(pplx::task<void>& t);
+
+      // What a route handler needs from its request, parsed once by handle_get/post/put
+      struct request_args
+      {
+         std::map<utility::string_t,utility::string_t> querystringmap;
+         web::json::value jvalue;      // json body, or null
+         bool recurse;                 // false if GET asked for compact=1
+         std::shared_ptr<const readmodel> m;   // GET only: the model this reply is built from
+         web::http::http_request message;      // for routes that read their own body (stream_routes)
+         bool replied = false;                 // set by a GET route that sent its own reply
+      };
+      typedef void (handler::*route_t)(request_args &, web::json::value &, web::http::status_code &);
+      static bool split_api_path(const utility::string_t&, int&, utility::string_t&);
+      static bool get_since(request_args &, web::json::value &, web::http::status_code &, uint64_t &);
+      void get_noop(request_args &, web::json::value &, web::http::status_code &);
+      void get_ctrl_eventwait(request_args &, web::json::value &, web::http::status_code &);
+      void get_domain(request_args &, web::json::value &, web::http::status_code &);
+      void get_casekeys(request_args &, web::json::value &, web::http::status_code &);
+      void get_casecounts(request_args &, web::json::value &, web::http::status_code &);
+      void get_case(request_args &, web::json::value &, web::http::status_code &);
+      void get_cases(request_args &, web::json::value &, web::http::status_code &);
+      void get_featurekeys(request_args &, web::json::value &, web::http::status_code &);
+      void get_feature(request_args &, web::json::value &, web::http::status_code &);
+      void get_features(request_args &, web::json::value &, web::http::status_code &);
+      void get_krono(request_args &, web::json::value &, web::http::status_code &);
+      void get_subjectkeys(request_args &, web::json::value &, web::http::status_code &);
+      void get_subjects(request_args &, web::json::value &, web::http::status_code &);
+      void get_subject(request_args &, web::json::value &, web::http::status_code &);
+      void get_alerts(request_args &, web::json::value &, web::http::status_code &);
+      void get_batch(request_args &, web::json::value &, web::http::status_code &);
+      void get_ctrl_stream(request_args &, web::json::value &, web::http::status_code &);
+      void get_metrics(request_args &, web::json::value &, web::http::status_code &);
+      void get_debug_trace(request_args &, web::json::value &, web::http::status_code &);
+      void post_ctrl_singlestep(request_args &, web::json::value &, web::http::status_code &);
+      void post_ctrl_shutdown(request_args &, web::json::value &, web::http::status_code &);
+      void put_ctrl_time(request_args &, web::json::value &, web::http::status_code &);
+      void put_ctrl_sample(request_args &, web::json::value &, web::http::status_code &);
+      void put_ctrl_sampletimestep(request_args &, web::json::value &, web::http::status_code &);
+      void put_ctrl_answercase(request_args &, web::json::value &, web::http::status_code &);
+      void put_set_knob(request_args &, web::json::value &, web::http::status_code &);
+      void put_set_histogram_mode(request_args &, web::json::value &, web::http::status_code &);
+      void put_set_histogram_span(request_args &, web::json::value &, web::http::status_code &);
+      void put_ctrl_ingest(request_args &, web::json::value &, web::http::status_code &);
+      void put_ctrl_layout(request_args &, web::json::value &, web::http::status_code &);
+      std::shared_ptr<const ingest_layout> find_layout(uint64_t);
       pplx::task<bool> wait_for_event(uint64_t, unsigned int);
       void update_seq(void);
-      // generate JSON objects from EA objects
-      const web::json::value json_subject(const NGuiKey &, bool recurse = true);
-      const web::json::value json_rulekit(const NGuiKey &, bool recurse = true);
-      const web::json::value json_case(const NGuiKey &, bool recurse = true);
-      const web::json::value json_feature(const NGuiKey &, bool recurse = true);
-      const web::json::value json_knob(const NGuiKey &, bool recurse = true);
-      const web::json::value json_histogram(const NGuiKey &, bool recurse = true);
-      const web::json::value json_traceinkrono(const NGuiKey &, const NGuiKey &, bool recurse = true);
-      const web::json::value json_paneinkrono(const NGuiKey &, const NGuiKey &, bool recurse = true);
-      const web::json::value json_krono(const NGuiKey &, bool recurse = true);
+      void single_step(void);       // call on the engine thread
+      void run_engine(std::function<void()>);
+      void publish_model(void);     // call on the engine thread
+      static std::vector<std::pair<std::string, std::string>> metric_routes(void);
+      std::shared_ptr<const readmodel> current_model(void) const;
+      static utility::string_t make_etag(uint64_t, bool);
+      static bool etag_matches(const utility::string_t&, const utility::string_t&);
+      static void reply_get(web::http::http_request&, web::http::status_code, const responsecache::entry&, const utility::string_t&);
+      // generate JSON objects from EA objects, as copied into a read model
+      static const web::json::value json_subject(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_rulekit(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_case(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_feature(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_knob(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_histogram(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_traceinkrono(const readmodel &, const NGuiKey &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_paneinkrono(const readmodel &, const NGuiKey &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_krono(const readmodel &, const NGuiKey &, bool recurse = true);
+      static const web::json::value json_alert(const GuiPackAlert_t &);
+      static const web::json::value json_delta(const readmodel &, const readmodel &, const std::vector<GuiPackAlert_t> &);
 
       web::http::experimental::listener::http_listener m_listener;
 
-      std::mutex instance_api_lock;
-      std::mutex instance_sampletimestep_lock;
-
       // condition_variable monitors seq so tasks can wait for updates efficiently
       std::atomic<uint64_t> seq;    // the global atomic sequence counter
       std::mutex cvm;
@@ -65,14 +155,40 @@ class handler
       // Keep local copies of "UNCHANGING" EA information and precomputed lookup information
       GuiPackDomain_t domain;
 
-      // Keep a list of the last X alert messages. We don't have sessions so the clients
-      // will have to keep track of which ones they've seen.
-      std::map<AlertId_t, std::string> alerts;
-      std::atomic<AlertId_t> alertseq;  // id number for alerts
+      // Latest read model. Swapped with std::atomic_store by writers, so a GET holding the
+      // previous one keeps it alive until its reply is built. Never null after construction.
+      std::shared_ptr<const readmodel> model;
+
+      // Serialized GET replies, each good until seq moves on
+      responsecache cache;
+      compression_config compression;
+
+      // GET /ctrl/stream subscribers, sent a delta each time a model is published
+      eventstream events;
+
+      // Request, step, ingest and gzip metrics for GET /metrics
+      metrics stats;
+
+      // Sampled and slow request traces for GET /debug/trace
+      tracer traces;
+
+      // Alerts are kept in libEA's alert ring, not here. We don't have sessions so the clients
+      // keep track of which ones they've seen by id (alertseq), and GET /alerts reads the ring
+      // from there, lock-free.
 
       // Since we don't currently have sessions, the client must keep track of the
       // current subject. Don't store one here!
 
+      // Named-point layouts registered with PUT /ctrl/layout; layout id n is layouts[n - 1].
+      // Never removed, so an id a client holds stays good for the life of the server.
+      std::mutex layoutlock;
+      std::vector<std::shared_ptr<const ingest_layout>> layouts;
+
+      // Runs every call into libEA (ingestion, stepping, setters, taking a read model), one at
+      // a time, so request threads never contend for it. GETs read the published model instead.
+      // Declared last so it is stopped before the members its commands use are destroyed.
+      enginethread engine;
+
       static void extract_json(const web::http::http_request&, web::json::value&);
       static bool get_querystring(const std::map<utility::string_t,utility::string_t>&, const utility::string_t&, utility::string_t&);
 
@@ -91,7 +207,11 @@ class handler
       static bool get_json_value(const bool, const web::json::value&, const std::map<utility::string_t,utility::string_t>&, const utility::string_t&, web::json::value&, size_t&);
 #endif
 
-      static const std::regex re_api;
+      static const std::unordered_map<utility::string_t, route_t> get_routes;
+      static const std::unordered_map<utility::string_t, route_t> post_routes;
+      static const std::unordered_map<utility::string_t, route_t> put_routes;
+      static const std::set<utility::string_t> bulk_routes;
+      static const std::set<utility::string_t> stream_routes;
       static const unsigned int default_eventwait_seconds = DEFAULT_EVENTWAIT_SECONDS;
 };
 
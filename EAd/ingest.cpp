@@ -0,0 +1,205 @@
+/*
+ * ingest.cpp
+ *
+ * Bulk ingest types and the protobuf wire format of protobuf/ingest.proto (see ingest.hpp)
+ */
+
+#include "ingest.hpp"
+#include <cstring>
+
+void ingest_result::fail(size_t line, const std::string &error) {
+   if (errors.size() < MAX_INGEST_ERRORS)
+      errors.emplace_back(line, error);
+   failed++;
+}
+
+// Size the step's value vectors for this layout's subjects, keeping the capacity they already have
+void ingest_layout::begin(ingest_step & step) const {
+   step.nsubjects = subjects.size();
+   if (step.values.size() < subjects.size())
+      step.values.resize(subjects.size());
+   for (size_t i = 0; i < subjects.size(); i++) {
+      step.values[i].first = subjects[i].first;
+      step.values[i].second.assign(subjects[i].second, 0.0);
+   }
+}
+
+bool ingest_layout::operator==(const ingest_layout & other) const {
+   return names == other.names && scatter == other.scatter && subjects == other.subjects;
+}
+
+// Wire types
+enum { WIRE_VARINT = 0, WIRE_FIXED64 = 1, WIRE_LEN = 2, WIRE_FIXED32 = 5 };
+
+#define MAX_VARINT_BYTES 10
+
+static bool read_varint(const uint8_t *&p, const uint8_t *end, uint64_t &v) {
+   v = 0;
+   for (int shift = 0; shift < 64 && p < end; shift += 7) {
+      uint8_t b = *p++;
+      v |= (uint64_t) (b & 0x7f) << shift;
+      if ((b & 0x80) == 0)
+         return true;
+   }
+   return false;
+}
+
+// Skip a field we do not use. False if it runs past the end or has a wire type we cannot skip.
+static bool skip_field(const uint8_t *&p, const uint8_t *end, int wiretype) {
+   uint64_t v;
+   switch (wiretype) {
+      case WIRE_VARINT:  return read_varint(p, end, v);
+      case WIRE_FIXED64: if (end - p < 8) return false; p += 8; return true;
+      case WIRE_FIXED32: if (end - p < 4) return false; p += 4; return true;
+      case WIRE_LEN:
+         if (!read_varint(p, end, v) || v > (uint64_t) (end - p))
+            return false;
+         p += v;
+         return true;
+      default:           return false;
+   }
+}
+
+static double read_double(const uint8_t *p) {
+   uint64_t bits = 0;
+   for (int i = 7; i >= 0; i--)
+      bits = (bits << 8) | p[i];     // wire is little-endian whatever the host is
+   double d;
+   std::memcpy(&d, &bits, sizeof(d));
+   return d;
+}
+
+// SubjectValues { uint64 subject = 1; repeated double values = 2; }
+static bool decode_subject(const uint8_t *p, const uint8_t *end, NGuiKey &subject, std::vector<double> &dlist) {
+   while (p < end) {
+      uint64_t tag;
+      if (!read_varint(p, end, tag))
+         return false;
+      int field = (int) (tag >> 3);
+      int wiretype = (int) (tag & 7);
+      if (field == 1 && wiretype == WIRE_VARINT) {
+         uint64_t key;
+         if (!read_varint(p, end, key))
+            return false;
+         subject = NGuiKey(key);
+      } else if (field == 2 && wiretype == WIRE_LEN) {
+         // packed: one run of little-endian doubles
+         uint64_t len;
+         if (!read_varint(p, end, len) || len > (uint64_t) (end - p) || len % 8 != 0)
+            return false;
+         size_t n = len / 8;
+         size_t at = dlist.size();
+         dlist.resize(at + n);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+         std::memcpy(dlist.data() + at, p, len);
+#else
+         for (size_t i = 0; i < n; i++)
+            dlist[at + i] = read_double(p + 8 * i);
+#endif
+         p += len;
+      } else if (field == 2 && wiretype == WIRE_FIXED64) {
+         // unpacked, which parsers must also accept
+         if (end - p < 8)
+            return false;
+         dlist.push_back(read_double(p));
+         p += 8;
+      } else if (!skip_field(p, end, wiretype)) {
+         return false;
+      }
+   }
+   return true;
+}
+
+//
+// SampleTimeStep { int64 time = 1; repeated SubjectValues values_by_subject = 2; }
+//
+bool ingestproto::decode_step(const uint8_t *p, size_t n, ingest_step &step, std::string &error) {
+   const uint8_t *end = p + n;
+   step.time = 0;
+   step.nsubjects = 0;
+   while (p < end) {
+      uint64_t tag;
+      if (!read_varint(p, end, tag)) {
+         error = "truncated message";
+         return false;
+      }
+      int field = (int) (tag >> 3);
+      int wiretype = (int) (tag & 7);
+      if (field == 1 && wiretype == WIRE_VARINT) {
+         uint64_t t;
+         if (!read_varint(p, end, t)) {
+            error = "truncated time";
+            return false;
+         }
+         step.time = (time_t) (int64_t) t;
+      } else if (field == 2 && wiretype == WIRE_LEN) {
+         uint64_t len;
+         if (!read_varint(p, end, len) || len > (uint64_t) (end - p)) {
+            error = "truncated values_by_subject";
+            return false;
+         }
+         if (step.values.size() <= step.nsubjects)
+            step.values.resize(step.nsubjects + 1);
+         auto &sv = step.values[step.nsubjects++];
+         sv.first = NGuiKey(0);
+         sv.second.clear();
+         if (!decode_subject(p, p + len, sv.first, sv.second)) {
+            error = "bad values_by_subject";
+            return false;
+         }
+         p += len;
+      } else if (!skip_field(p, end, wiretype)) {
+         error = "bad field in message";
+         return false;
+      }
+   }
+   return true;
+}
+
+//
+// Read the varint length that prefixes each message of a delimited stream. False if the prefix
+// is not all there yet, or, with error set, if it can never end: a varint is at most 10 bytes.
+// Otherwise header is the prefix's size and len the message's.
+//
+bool ingestproto::decode_length(const uint8_t *p, size_t n, size_t &header, uint64_t &len, std::string &error) {
+   const uint8_t *q = p;
+   if (!read_varint(q, p + n, len)) {
+      if (n >= MAX_VARINT_BYTES)
+         error = "length prefix does not end within 10 bytes";
+      return false;
+   }
+   header = q - p;
+   return true;
+}
+
+static void write_varint(std::string &out, uint64_t v) {
+   while (v >= 0x80) {
+      out += (char) ((v & 0x7f) | 0x80);
+      v >>= 7;
+   }
+   out += (char) v;
+}
+
+//
+// IngestReply { uint64 steps = 1; uint64 failed = 2; repeated IngestError errors = 3; }
+// IngestError { uint64 step = 1; string error = 2; }
+//
+std::string ingestproto::encode_reply(const ingest_result &result) {
+   std::string out;
+   write_varint(out, (1 << 3) | WIRE_VARINT);
+   write_varint(out, result.steps);
+   write_varint(out, (2 << 3) | WIRE_VARINT);
+   write_varint(out, result.failed);
+   for (auto const &e : result.errors) {
+      std::string item;
+      write_varint(item, (1 << 3) | WIRE_VARINT);
+      write_varint(item, e.first);
+      write_varint(item, (2 << 3) | WIRE_LEN);
+      write_varint(item, e.second.size());
+      item += e.second;
+      write_varint(out, (3 << 3) | WIRE_LEN);
+      write_varint(out, item.size());
+      out += item;
+   }
+   return out;
+}
@@ -0,0 +1,76 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <utility>
+#include <vector>
+#include "exportCalls.hpp"
+
+#define MAX_INGEST_ERRORS 100
+
+//
+// One timestep of a bulk ingest, as parsed from one line or message of the request. Batches are
+// reused, so only the first nsubjects entries of values are current; the rest keep their capacity.
+//
+struct ingest_step
+{
+   size_t line;         // line (or message) number in the request, for error reports
+   time_t time;
+   size_t nsubjects;
+   std::vector<std::pair<NGuiKey, std::vector<double>>> values;
+};
+
+//
+// A named-point layout registered with PUT /ctrl/layout. Each of the client's columns feeds one
+// channel of one subject, or is skipped. The names are resolved to channels once, when the layout
+// is registered, into a table of (subject slot, channel) per column, so a step in the layout is
+// filled by scattering each value straight into its subject's value vector. Registration checks
+// every channel of each subject named is fed by exactly one column, so a full row makes a full step.
+//
+struct ingest_layout
+{
+   static constexpr size_t skip = (size_t) -1;   // inline, as emplace_back() takes it by reference
+
+   std::vector<std::string> names;                      // column names, as registered
+   std::vector<std::pair<size_t, size_t>> scatter;      // per column: (subject slot or skip, channel)
+   std::vector<std::pair<NGuiKey, size_t>> subjects;    // per slot: subject and its point count
+
+   void begin(ingest_step &) const;
+   void put(ingest_step & step, size_t column, double v) const {
+      auto const & target = scatter[column];
+      if (target.first != skip)
+         step.values[target.first].second[target.second] = v;
+   }
+   bool operator==(const ingest_layout &) const;
+};
+
+//
+// Running totals of one ingest request
+//
+struct ingest_result
+{
+   size_t steps = 0;
+   size_t failed = 0;
+   std::vector<std::pair<size_t, std::string>> errors;   // (line, error), first MAX_INGEST_ERRORS only
+
+   void fail(size_t, const std::string &);
+};
+
+//
+// The messages of protobuf/ingest.proto, read and written directly in the protobuf wire format.
+// A SampleTimeStep's packed doubles are copied straight into the step's value vectors, which are
+// the ones handed to libEA, so there is no intermediate message object and no per-value parse.
+// Fields this code does not know are skipped, as protobuf requires.
+//
+class ingestproto
+{
+   public:
+      static bool decode_step(const uint8_t *, size_t, ingest_step &, std::string &);
+      static bool decode_length(const uint8_t *, size_t, size_t &, uint64_t &, std::string &);
+      static std::string encode_reply(const ingest_result &);
+};
+
+#endif // INGEST_H
@@ -0,0 +1,99 @@
+/*
+ * ingestservice.cpp
+ *
+ * gRPC service for streamed binary ingest (see ingestservice.hpp)
+ */
+
+#include "ingestservice.hpp"
+#include <iostream>
+#include <vector>
+
+//
+// One SampleTimeSteps call. Each message read is decoded into the next free step of a batch,
+// and full batches are run as they fill. When the client closes its side the last batch is
+// run and the IngestReply is sent.
+//
+class ingestreactor : public grpc::ServerGenericBidiReactor
+{
+   public:
+      ingestreactor(handler & hh) : h(hh), batch(DEFAULT_INGEST_BATCH_STEPS), queued(0), count(0) {
+         StartRead(&request);
+      }
+
+      void OnReadDone(bool ok) override {
+         if (!ok) {
+            // client is done sending
+            if (queued > 0)
+               h.run_ingest_batch(batch, queued, result);
+            std::cout << "gRPC Ingest: " << result.steps << " steps from " << count << " messages, " << result.failed << " failed" << std::endl;
+            auto out = ingestproto::encode_reply(result);
+            grpc::Slice slice(out);
+            response = grpc::ByteBuffer(&slice, 1);
+            StartWriteAndFinish(&response, grpc::WriteOptions(), grpc::Status::OK);
+            return;
+         }
+         count++;
+         std::string error;
+         auto & step = batch[queued];
+         step.line = count;
+         bool decoded;
+         std::vector<grpc::Slice> slices;
+         if (!request.Dump(&slices).ok()) {
+            decoded = false;
+            error = "unreadable message";
+         } else if (slices.size() == 1) {
+            decoded = ingestproto::decode_step(slices[0].begin(), slices[0].size(), step, error);
+         } else {
+            bytes.clear();
+            for (auto const & s : slices)
+               bytes.append(reinterpret_cast<const char *>(s.begin()), s.size());
+            decoded = ingestproto::decode_step(reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size(), step, error);
+         }
+         if (!decoded) {
+            result.fail(count, error);
+         } else if (++queued == batch.size()) {
+            h.run_ingest_batch(batch, queued, result);
+            queued = 0;
+         }
+         StartRead(&request);
+      }
+
+      void OnDone() override {
+         delete this;
+      }
+
+   private:
+      handler & h;
+      std::vector<ingest_step> batch;
+      size_t queued;
+      size_t count;
+      ingest_result result;
+      grpc::ByteBuffer request;
+      grpc::ByteBuffer response;
+      std::string bytes;            // for a message that arrived in more than one slice
+};
+
+ingestservice::ingestservice(handler & hh) : h(hh)
+{
+}
+
+grpc::ServerGenericBidiReactor* ingestservice::CreateReactor(grpc::GenericCallbackServerContext* context) {
+   if (context->method() == "/ingest.Ingest/SampleTimeSteps")
+      return new ingestreactor(h);
+   return grpc::CallbackGenericService::CreateReactor(context);   // UNIMPLEMENTED
+}
+
+bool ingestservice::start(const std::string & address) {
+   grpc::ServerBuilder builder;
+   builder.AddListeningPort(address, grpc::InsecureServerCredentials());
+   builder.RegisterCallbackGenericService(this);
+   server = builder.BuildAndStart();
+   return (bool) server;
+}
+
+void ingestservice::stop(void) {
+   if (server) {
+      server->Shutdown();
+      server.reset();
+   }
+}
@@ -0,0 +1,31 @@
+#ifndef INGESTSERVICE_H
+#define INGESTSERVICE_H
+
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/generic/async_generic_service.h>
+#include <memory>
+#include <string>
+#include "handler.hpp"
+
+//
+// Local gRPC ingest service, for collectors on the same host or network that stream timesteps
+// faster than HTTP/JSON allows. It serves ingest.Ingest/SampleTimeSteps of protobuf/ingest.proto
+// as a generic service, i.e., over raw bytes decoded by ingestproto, so EAd needs no generated
+// stub code. Steps go to handler::run_ingest_batch, the same path as PUT /ctrl/ingest.
+//
+class ingestservice : public grpc::CallbackGenericService
+{
+   public:
+      ingestservice(handler &);
+
+      bool start(const std::string &);   // listen on address, e.g. "127.0.0.1:50052"
+      void stop(void);
+
+      grpc::ServerGenericBidiReactor* CreateReactor(grpc::GenericCallbackServerContext*) override;
+
+   private:
+      handler & h;
+      std::unique_ptr<grpc::Server> server;
+};
+
+#endif // INGESTSERVICE_H
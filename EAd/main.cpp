@@ -7,6 +7,8 @@
 #include <limits>
 #include <csignal>
 #include <mutex>
+#include <thread>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 #ifdef USE_SSL
@@ -15,6 +17,7 @@
 #endif
 #include "stdafx.h"
 #include "handler.hpp"
+#include "ingestservice.hpp"
 #include <pplx/threadpool.h>
 
 using namespace std;
@@ -29,8 +32,11 @@ namespace ssl = boost::asio::ssl;
 #endif
 
 std::unique_ptr<handler> g_httpHandler;
+std::unique_ptr<ingestservice> g_ingestService;   // only if --grpc-ingest is given
 std::atomic<int> stop_main;   // store true when ready to shut down
 IExportOmni* tool;     // master pointer to the EA Runtime API
+compression_config compression = {DEFAULT_GZIP_BULK_LEVEL, DEFAULT_GZIP_SMALL_LEVEL, DEFAULT_GZIP_MIN_BYTES};
+tracing_config tracing = {DEFAULT_TRACE_SAMPLE_EVERY, DEFAULT_TRACE_SLOW_MS};
 
 #ifdef USE_SSL
 http_listener_config server_config;
@@ -70,6 +76,8 @@ void on_initialize(const string_t& address, IExportOmni* tool)
 #else
    g_httpHandler = std::unique_ptr<handler>(new handler(addr, tool));
 #endif
+   g_httpHandler->set_compression(compression);
+   g_httpHandler->set_tracing(tracing);
    g_httpHandler->open().wait();
 
    ucerr << utility::string_t(U("Listening for requests at: ")) << addr << endl;
@@ -79,6 +87,10 @@ void on_initialize(const string_t& address, IExportOmni* tool)
 
 void on_shutdown()
 {
+   if (g_ingestService) {
+      std::cout << "Shutting down gRPC ingest service..." << std::endl;
+      g_ingestService->stop();
+   }
    std::cout << "Shutting down http handler..." << std::endl;
    g_httpHandler->close().wait();
    if (tool) {
@@ -107,10 +119,6 @@ int main(int argc, char **argv) {
    bool interactive = false;
    bool fg = false;
 
-   // Initialize the CPPREST/PPLX thread pool
-   // NOTE: SWB: TODO: default is 40, min is 2 (hangs with 1) - reduced to ease debugging!
-   crossplat::threadpool::initialize_with_threads(5);
-
    // Initialize the EA library
    // Need to reference the library's init function here so it gets linked, otherwise it won't be called
    void LibMain(void);
@@ -129,6 +137,13 @@ int main(int argc, char **argv) {
          ("sslcert,c", po::value<std::string>()->default_value(default_certfile),"SSL certficate chain PEM file")
 #endif
          ("workdir,w", po::value<std::string>()->default_value(default_dir),"Work directory")
+         ("gzip-bulk-level", po::value<int>()->default_value(DEFAULT_GZIP_BULK_LEVEL),"Gzip level 0-9 for GET replies with object trees (0 = off)")
+         ("gzip-small-level",po::value<int>()->default_value(DEFAULT_GZIP_SMALL_LEVEL),"Gzip level 0-9 for other GET replies (0 = off)")
+         ("gzip-min-bytes",  po::value<int>()->default_value(DEFAULT_GZIP_MIN_BYTES),"Send GET replies smaller than this uncompressed")
+         ("threads,t", po::value<int>()->default_value(0),                 "HTTP request threads (default: one per core)")
+         ("trace-sample",  po::value<int>()->default_value(DEFAULT_TRACE_SAMPLE_EVERY),"Keep the phase trace of one in this many requests for GET /debug/trace (0 = none)")
+         ("trace-slow-ms", po::value<int>()->default_value(DEFAULT_TRACE_SLOW_MS),"Log and keep the phase trace of requests taking at least this long (0 = off)")
+         ("grpc-ingest",  po::value<std::string>()->default_value(""),     "Address for the gRPC ingest service, e.g. 127.0.0.1:50052 (default off)")
          ("fg,f",      po::bool_switch(&fg),                                "Run in foreground")
          ("interactive,i",po::bool_switch(&interactive),                    "Run until user hits return");
 
@@ -147,6 +162,8 @@ int main(int argc, char **argv) {
    int pval;
    std::string address;
    std::string workdir;
+   std::string grpcingest;
+   int threads;
 #ifdef USE_SSL
    std::string sslkeyfile;
    std::string sslcertfile;
@@ -155,6 +172,21 @@ int main(int argc, char **argv) {
    try { pval = vm["port"].as<int>(); } catch (...) { cerr << U("Port argument must be a positive integer") << endl; return(1); }
    try { address = std::string(vm["baseurl"].as<std::string>()); } catch (...) { cerr << U("Error parsing BaseURL string") << endl; return(1); }
    try { workdir = std::string(vm["workdir"].as<std::string>()); } catch (...) { cerr << U("Error parsing workdir argument") << endl; return(1); }
+   try { grpcingest = vm["grpc-ingest"].as<std::string>(); } catch (...) { cerr << U("Error parsing grpc-ingest argument") << endl; return(1); }
+   try { threads = vm["threads"].as<int>(); } catch (...) { cerr << U("Error parsing threads argument") << endl; return(1); }
+   try {
+      compression.bulk_level = vm["gzip-bulk-level"].as<int>();
+      compression.small_level = vm["gzip-small-level"].as<int>();
+      compression.min_bytes = std::max(0, vm["gzip-min-bytes"].as<int>());
+   } catch (...) { cerr << U("Error parsing gzip arguments") << endl; return(1); }
+   try {
+      tracing.sample_every = std::max(0, vm["trace-sample"].as<int>());
+      tracing.slow_ms = std::max(0, vm["trace-slow-ms"].as<int>());
+   } catch (...) { cerr << U("Error parsing trace arguments") << endl; return(1); }
+   if (compression.bulk_level < 0 || compression.bulk_level > 9 || compression.small_level < 0 || compression.small_level > 9) {
+      std::cerr << "Error: gzip levels must be 0 to 9" << endl;
+      return(1);
+   }
 #ifdef USE_SSL
    try { sslkeyfile = std::string(vm["sslkey"].as<std::string>()); } catch (...) { cerr << U("Error parsing sslkey argument") << endl; return(1); }
    try { sslcertfile = std::string(vm["sslcert"].as<std::string>()); } catch (...) { cerr << U("Error parsing sslcert argument") << endl; return(1); }
@@ -187,6 +219,13 @@ int main(int argc, char **argv) {
    }
 #endif
 
+   // Initialize the CPPREST/PPLX thread pool, before anything uses it. These threads only parse
+   // requests and build replies; calls into libEA all run on the handler's engine thread.
+   // The pool hangs with 1 thread, so at least MIN_HTTP_THREADS.
+   if (threads <= 0)
+      threads = std::thread::hardware_concurrency();
+   crossplat::threadpool::initialize_with_threads(std::max(threads, MIN_HTTP_THREADS));
+
    // Get the pointer to the EA objects
    try { tool = SExportedHandles::GetPortPointer(); } catch (...) { cerr << U("Unable to obtain the EA port pointer") << endl; return(1); }
    if (! tool) {
@@ -207,6 +246,15 @@ int main(int argc, char **argv) {
 #else
    on_initialize(address, tool);
 #endif
+   if (!grpcingest.empty()) {
+      g_ingestService = std::unique_ptr<ingestservice>(new ingestservice(*g_httpHandler));
+      if (!g_ingestService->start(grpcingest)) {
+         cerr << U("Unable to start gRPC ingest service at ") << grpcingest << endl;
+         on_shutdown();
+         return(1);
+      }
+      cerr << "gRPC ingest service listening at: " << grpcingest << endl;
+   }
 
    if (interactive) {
       // Wait for user to press return
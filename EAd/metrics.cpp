@@ -0,0 +1,180 @@
+/*
+ * metrics.cpp
+ *
+ * Lock-free runtime metrics in the Prometheus text format (see metrics.hpp)
+ */
+
+#include "metrics.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+// Bucket bounds in seconds, from a cached GET to a long ingest batch
+const double histogram::bounds[METRICS_HISTOGRAM_BUCKETS] = {
+   0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025,
+   0.05, 0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0
+};
+
+histogram::histogram() : sum_ns(0)
+{
+   for (auto & c : counts)
+      c.store(0, std::memory_order_relaxed);
+}
+
+void histogram::observe(std::chrono::steady_clock::duration d) {
+   const uint64_t ns = (uint64_t) std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+   const double seconds = ns / 1e9;
+   size_t i = 0;
+   while (i < METRICS_HISTOGRAM_BUCKETS && seconds > bounds[i])
+      i++;
+   counts[i].fetch_add(1, std::memory_order_relaxed);
+   sum_ns.fetch_add(ns, std::memory_order_relaxed);
+}
+
+uint64_t histogram::count(void) const {
+   uint64_t n = 0;
+   for (auto const & c : counts)
+      n += c.load(std::memory_order_relaxed);
+   return n;
+}
+
+// The _bucket, _sum and _count samples of one series. Buckets are cumulative, as Prometheus wants.
+void histogram::write(std::ostream & os, const std::string & name, const std::string & labels) const {
+   const std::string sep = labels.empty() ? "" : ",";
+   uint64_t n = 0;
+   for (size_t i = 0; i <= METRICS_HISTOGRAM_BUCKETS; i++) {
+      n += counts[i].load(std::memory_order_relaxed);
+      std::ostringstream le;
+      if (i < METRICS_HISTOGRAM_BUCKETS)
+         le << bounds[i];
+      else
+         le << "+Inf";
+      metrics::write_sample(os, name + "_bucket", labels + sep + metrics::label("le", le.str()), n);
+   }
+   metrics::write_sample(os, name + "_sum", labels, sum_ns.load(std::memory_order_relaxed) / 1e9);
+   metrics::write_sample(os, name + "_count", labels, n);
+}
+
+metrics::request::request(metrics & m, const std::string & method) : owner(m), method(method), start(std::chrono::steady_clock::now()), route(nullptr), failed(false)
+{
+}
+
+metrics::request::~request()
+{
+   if (route == nullptr)
+      route = owner.find(method, "");
+   if (route == nullptr)
+      return;
+   route->latency.observe(std::chrono::steady_clock::now() - start);
+   if (failed)
+      route->errors.fetch_add(1, std::memory_order_relaxed);
+}
+
+metrics::metrics(const std::vector<std::pair<std::string, std::string>> & table) : sampletime(0), stepsampletime(0), ingeststeps(0), ingestfailed(0), gzipin(0), gzipout(0), eventwaiters(0)
+{
+   auto add = [this](const std::string & method, const std::string & route) {
+      routes.emplace_back(new route_stats());
+      auto r = routes.back().get();
+      r->method = method;
+      r->route = route;
+      r->errors.store(0, std::memory_order_relaxed);
+      return r;
+   };
+   for (auto const & mr : table) {
+      auto m = methods.find(mr.first);
+      if (m == methods.end())
+         m = methods.emplace(mr.first, method_routes{ {}, nullptr }).first;
+      m->second.byroute[mr.second] = add(mr.first, mr.second);
+   }
+   for (auto & m : methods)
+      m.second.other = add(m.first, "other");
+}
+
+// Series for a method and route, the method's "other" if the route is not one of its own, or
+// null for a method with no routes. Only reads maps filled by the constructor.
+metrics::route_stats * metrics::find(const std::string & method, const std::string & path) {
+   auto m = methods.find(method);
+   if (m == methods.end())
+      return nullptr;
+   auto r = m->second.byroute.find(path);
+   return (r == m->second.byroute.end()) ? m->second.other : r->second;
+}
+
+// A step has just run, taking from start until now. Call on the engine thread.
+void metrics::stepped(std::chrono::steady_clock::time_point start) {
+   steps.observe(std::chrono::steady_clock::now() - start);
+   stepsampletime.store(sampletime.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void metrics::ingested(uint64_t nsteps, uint64_t nfailed) {
+   ingeststeps.fetch_add(nsteps, std::memory_order_relaxed);
+   ingestfailed.fetch_add(nfailed, std::memory_order_relaxed);
+}
+
+void metrics::gzipped(size_t in, size_t out) {
+   gzipin.fetch_add(in, std::memory_order_relaxed);
+   gzipout.fetch_add(out, std::memory_order_relaxed);
+}
+
+void metrics::write(std::ostream & os) const {
+   write_header(os, "ead_http_requests_total", "counter", "HTTP requests answered, by method and route");
+   for (auto const & r : routes)
+      write_sample(os, "ead_http_requests_total", label("method", r->method) + "," + label("route", r->route), r->latency.count());
+   write_header(os, "ead_http_request_errors_total", "counter", "HTTP requests answered with status 400 or over");
+   for (auto const & r : routes)
+      write_sample(os, "ead_http_request_errors_total", label("method", r->method) + "," + label("route", r->route), r->errors.load(std::memory_order_relaxed));
+   write_header(os, "ead_http_request_duration_seconds", "histogram", "Time to handle a request, from its arrival until its reply is handed to the listener");
+   for (auto const & r : routes)
+      r->latency.write(os, "ead_http_request_duration_seconds", label("method", r->method) + "," + label("route", r->route));
+
+   write_header(os, "ead_step_duration_seconds", "histogram", "Time libEA takes to step the domain once");
+   steps.write(os, "ead_step_duration_seconds", "");
+
+   const int64_t stepat = stepsampletime.load(std::memory_order_relaxed);
+   write_header(os, "ead_last_step_sample_time_seconds", "gauge", "Sample time of the last step, as a Unix time");
+   write_sample(os, "ead_last_step_sample_time_seconds", "", (double) stepat);
+   write_header(os, "ead_ingest_lag_seconds", "gauge", "Wall clock time less the sample time of the last step; 0 before the first");
+   write_sample(os, "ead_ingest_lag_seconds", "", stepat > 0 ? (double) (time(nullptr) - stepat) : 0.0);
+   write_header(os, "ead_ingest_steps_total", "counter", "Steps run through the ingest path: PUT /ctrl/ingest, gRPC, and layout sampletimesteps");
+   write_sample(os, "ead_ingest_steps_total", "", ingeststeps.load(std::memory_order_relaxed));
+   write_header(os, "ead_ingest_failed_steps_total", "counter", "Ingest steps rejected by the point count check or failed in libEA");
+   write_sample(os, "ead_ingest_failed_steps_total", "", ingestfailed.load(std::memory_order_relaxed));
+
+   write_header(os, "ead_gzip_bytes_in_total", "counter", "Bytes of GET replies before gzip");
+   write_sample(os, "ead_gzip_bytes_in_total", "", gzipin.load(std::memory_order_relaxed));
+   write_header(os, "ead_gzip_bytes_out_total", "counter", "Bytes of GET replies after gzip");
+   write_sample(os, "ead_gzip_bytes_out_total", "", gzipout.load(std::memory_order_relaxed));
+
+   write_header(os, "ead_eventwait_waiters", "gauge", "Requests waiting in GET /ctrl/eventwait");
+   write_sample(os, "ead_eventwait_waiters", "", eventwaiters.load(std::memory_order_relaxed));
+}
+
+void metrics::write_header(std::ostream & os, const std::string & name, const char * type, const std::string & help) {
+   os << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+}
+
+// Whole numbers are written without a fraction or exponent, so large counters stay exact
+void metrics::write_sample(std::ostream & os, const std::string & name, const std::string & labels, double value) {
+   os << name;
+   if (!labels.empty())
+      os << "{" << labels << "}";
+   if (value == std::floor(value) && std::fabs(value) < 9007199254740992.0)
+      os << " " << (int64_t) value << "\n";
+   else
+      os << " " << std::setprecision(9) << value << "\n";
+}
+
+// name="value", with the value escaped as the text format requires
+std::string metrics::label(const std::string & name, const std::string & value) {
+   std::string s = name + "=\"";
+   for (char c : value) {
+      if (c == '\\' || c == '"')
+         s += '\\';
+      if (c == '\n')
+         s += "\\n";
+      else
+         s += c;
+   }
+   return s + "\"";
+}
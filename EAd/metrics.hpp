@@ -0,0 +1,109 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#define METRICS_HISTOGRAM_BUCKETS 16
+
+//
+// A latency histogram in the Prometheus sense: counts of observations at or under each of a
+// fixed set of bounds, plus their sum. Observing is a few relaxed atomic adds, safe from any
+// thread. A scrape reads the counts as they are, so it may see one a little ahead of another.
+//
+class histogram
+{
+   public:
+      histogram();
+
+      void observe(std::chrono::steady_clock::duration);
+      uint64_t count(void) const;
+      void write(std::ostream &, const std::string &, const std::string &) const;   // name, labels
+
+   private:
+      static const double bounds[METRICS_HISTOGRAM_BUCKETS];    // seconds
+      std::atomic<uint64_t> counts[METRICS_HISTOGRAM_BUCKETS + 1];   // per bucket, last is +Inf
+      std::atomic<uint64_t> sum_ns;
+};
+
+//
+// Runtime metrics of EAd, served by GET /metrics in the Prometheus text format. Every series is
+// laid out when the server starts, one per route of the route tables, so recording a request,
+// a step or a gzip is a lookup in a map nobody writes and a few relaxed atomic adds: no lock
+// and no allocation on the hot path. Series kept elsewhere (the engine queue's histograms,
+// stream subscribers, open cases, knowledge base I/O) are read by the scrape from their owners.
+//
+class metrics
+{
+   public:
+      struct route_stats
+      {
+         std::string method;
+         std::string route;
+         histogram latency;
+         std::atomic<uint64_t> errors;     // replies with status 400 or over
+      };
+
+      // Times one request, from construction to destruction, against the route found by at().
+      // A request never routed is counted against the method's "other" series.
+      class request
+      {
+         public:
+            request(metrics &, const std::string &);   // method
+            ~request();
+            void at(const std::string & path) { route = owner.find(method, path); }
+            void status(unsigned int code) { failed = (code >= 400); }
+
+         private:
+            metrics & owner;
+            std::string method;
+            std::chrono::steady_clock::time_point start;
+            route_stats * route;
+            bool failed;
+      };
+
+      explicit metrics(const std::vector<std::pair<std::string, std::string>> &);   // (method, route)
+
+      route_stats * find(const std::string &, const std::string &);
+
+      void sample_time(time_t t) { sampletime.store(t, std::memory_order_relaxed); }
+      void stepped(std::chrono::steady_clock::time_point);
+      void ingested(uint64_t steps, uint64_t failed);
+      void gzipped(size_t in, size_t out);
+      void waiting(int n) { eventwaiters.fetch_add(n, std::memory_order_relaxed); }
+
+      void write(std::ostream &) const;
+
+      // Helpers for series written from outside this class, so all are formatted alike
+      static void write_header(std::ostream &, const std::string &, const char *, const std::string &);
+      static void write_sample(std::ostream &, const std::string &, const std::string &, double);
+      static std::string label(const std::string &, const std::string &);
+
+   private:
+      struct method_routes
+      {
+         std::unordered_map<std::string, route_stats *> byroute;
+         route_stats * other;
+      };
+      std::unordered_map<std::string, method_routes> methods;
+      std::vector<std::unique_ptr<route_stats>> routes;     // in the order registered
+
+      histogram steps;                             // SingleStepDomainOnTimeAndInputs() calls
+      std::atomic<int64_t> sampletime;             // last time given to SetTimeStampInDomain()
+      std::atomic<int64_t> stepsampletime;         // sampletime as of the last step
+      std::atomic<uint64_t> ingeststeps;
+      std::atomic<uint64_t> ingestfailed;
+      std::atomic<uint64_t> gzipin;
+      std::atomic<uint64_t> gzipout;
+      std::atomic<int64_t> eventwaiters;
+};
+
+#endif // METRICS_H
@@ -0,0 +1,340 @@
+/*
+ * readmodel.cpp
+ *
+ * Snapshot of libEA state served to GET requests (see readmodel.hpp)
+ */
+
+#include "readmodel.hpp"
+#include <algorithm>
+
+//
+// Take the model. Call on the handler's engine thread, since every getter here calls libEA.
+// Previous is the model this one replaces (null for the first), for the change seqs.
+//
+readmodel::readmodel(IExportOmni *p_Port, const GuiPackDomain_t &domain, uint64_t seqnow, const readmodel *previous) : seq(seqnow), alertseq(p_Port->SayNextAlertIdFromDomain()), time(p_Port->GetTimeStampFromDomain()), removedhorizon(0)
+{
+   for (auto const & skey : domain.subjectKeys) {
+      add_subject(p_Port, skey);
+   }
+   stamp(previous);
+}
+
+// Flag a realtime Krono as shown to a client. Safe from any thread: the map itself is never
+// changed after the model is taken.
+void readmodel::shown(const NGuiKey &key) const {
+   auto k = kronosshown.find(key);
+   if (k != kronosshown.end())
+      k->second.store(true, std::memory_order_relaxed);
+}
+
+// True if the object's reply changed after seq since (or it is unknown, to be safe)
+bool readmodel::changed_since(const std::map<NGuiKey, uint64_t> &seqs, const NGuiKey &key, uint64_t since) const {
+   auto s = seqs.find(key);
+   return s == seqs.end() || s->second > since;
+}
+
+void readmodel::add_subject(IExportOmni *p_Port, const NGuiKey &key) {
+   if (subjects.count(key) > 0)
+      return;
+   try {
+      subjecttexts.emplace(key, p_Port->SayTextIdentifyingSubject(key));
+      auto s = subjects.emplace(key, p_Port->SayInfoFromSubject(key)).first;
+      auto c = subjectcases.emplace(key, p_Port->SayCurrentCasesFromSubject(key)).first;
+      subjectpoints.emplace(key, p_Port->SayInputPointNameOrderExpectedBySubject(key));
+      for (auto const & fkey : s->second.featureKeys)
+         add_feature(p_Port, fkey);
+      for (auto const & kkey : s->second.paramKnobKeys)
+         add_knob(p_Port, kkey);
+      for (auto const & rkey : s->second.ruleKitKeys)
+         add_rulekit(p_Port, rkey);
+      for (auto const & ckey : c->second.currentCaseKeys)
+         add_case(p_Port, ckey);
+   } catch (...) {
+      // leave out whatever could not be fetched; GET reports it as an error
+   }
+}
+
+void readmodel::add_feature(IExportOmni *p_Port, const NGuiKey &key) {
+   if (features.count(key) > 0)
+      return;
+   try {
+      auto f = features.emplace(key, p_Port->SayFullInfoFromFeature(key)).first;
+      add_histogram(p_Port, f->second.sourceHistogramKey);
+      for (auto const & kkey : f->second.ownKnobKeys)
+         add_knob(p_Port, kkey);
+   } catch (...) {
+   }
+}
+
+void readmodel::add_knob(IExportOmni *p_Port, const NGuiKey &key) {
+   if (knobs.count(key) > 0)
+      return;
+   try {
+      knobtexts.emplace(key, p_Port->SayTextIdentifyingKnob(key));
+      knobs.emplace(key, p_Port->GetInfoFromKnob(key));
+   } catch (...) {
+   }
+}
+
+void readmodel::add_histogram(IExportOmni *p_Port, const NGuiKey &key) {
+   if (histograms.count(key) > 0)
+      return;
+   try {
+      histogramtexts.emplace(key, p_Port->SayTextIdentifyingHistogram(key));
+      auto h = histograms.emplace(key, p_Port->SayInfoFromHistogram(key)).first;
+      for (auto const & kkey : h->second.knobKeys)
+         add_knob(p_Port, kkey);
+   } catch (...) {
+   }
+}
+
+void readmodel::add_rulekit(IExportOmni *p_Port, const NGuiKey &key) {
+   if (rulekits.count(key) > 0)
+      return;
+   try {
+      rulekittexts.emplace(key, p_Port->SayTextIdentifyingRuleKit(key));
+      auto r = rulekits.emplace(key, p_Port->SayFullInfoFromRuleKit(key)).first;
+      add_histogram(p_Port, r->second.ruleKitHistogramKey);
+      add_krono(p_Port, r->second.realtimeKronoKey_zeroIfNone);
+      for (auto const & kkey : r->second.ruleKitKnobKeys)
+         add_knob(p_Port, kkey);
+      for (auto const & kkey : r->second.ruleKnobKeys_topToBottom)
+         add_knob(p_Port, kkey);
+      for (auto const & hkey : r->second.ruleHistogramKeys_topToBottom)
+         add_histogram(p_Port, hkey);
+   } catch (...) {
+   }
+}
+
+void readmodel::add_case(IExportOmni *p_Port, const NGuiKey &key) {
+   if (cases.count(key) > 0)
+      return;
+   try {
+      auto c = cases.emplace(key, p_Port->SayFullInfoFromCase(key)).first;
+      if (c->second.getterReply == EGuiReply::OKAY_allDone && c->second.snapshotKronoKey.Peek() > 0)
+         add_krono(p_Port, c->second.snapshotKronoKey);
+   } catch (...) {
+   }
+}
+
+void readmodel::add_krono(IExportOmni *p_Port, const NGuiKey &key) {
+   if (key.Peek() == 0 || kronos.count(key) > 0)
+      return;
+   try {
+      auto k = kronos.emplace(key, p_Port->PeekFullInfoFromKrono(key)).first;
+      if (k->second.ownType == EGuiType::Krono_realtime)
+         kronosshown[key];
+      for (auto const & pkey : k->second.paneKeys_topToBottom)
+         add_pane(p_Port, pkey, key);
+      for (auto const & kkey : k->second.knobKeys)
+         add_knob(p_Port, kkey);
+   } catch (...) {
+   }
+}
+
+void readmodel::add_pane(IExportOmni *p_Port, const NGuiKey &key, const NGuiKey &krono) {
+   try {
+      auto p = panes.find(key);
+      if (p == panes.end())
+         p = panes.emplace(key, p_Port->SayInfoFromPane(key)).first;
+      for (auto const & tkey : p->second.traceKeys)
+         add_trace(p_Port, tkey, krono);
+   } catch (...) {
+   }
+}
+
+void readmodel::add_trace(IExportOmni *p_Port, const NGuiKey &key, const NGuiKey &krono) {
+   auto tk = std::make_pair(key, krono);
+   if (traces.count(tk) > 0)
+      return;
+   try {
+      auto t = traces.emplace(tk, p_Port->SayFullInfoFromTraceInKrono(key, krono)).first;
+      add_histogram(p_Port, t->second.sourceHistogramKey);
+      for (auto const & kkey : t->second.knobKeys)
+         add_knob(p_Port, kkey);
+   } catch (...) {
+   }
+}
+
+//
+// FNV-1a over the fields a reply is built from. Scalars are hashed one at a time, never whole
+// structs, so padding bytes never get in.
+//
+class contenthash
+{
+   public:
+      uint64_t h = 14695981039346656037ULL;
+
+      void bytes(const void *p, size_t n) {
+         auto b = static_cast<const unsigned char *>(p);
+         for (size_t i = 0; i < n; i++) {
+            h ^= b[i];
+            h *= 1099511628211ULL;
+         }
+      }
+      template <typename T> void pod(const T &v) { bytes(&v, sizeof(v)); }
+      template <typename T> void pods(const std::vector<T> &v) { pod(v.size()); if (!v.empty()) bytes(v.data(), v.size() * sizeof(T)); }
+      void str(const std::string &s) { pod(s.size()); bytes(s.data(), s.size()); }
+      void strs(const std::vector<std::string> &v) { pod(v.size()); for (auto const & s : v) str(s); }
+      void key(const NGuiKey &k) { pod(k.Peek()); }
+      void keys(const std::vector<NGuiKey> &v) { pod(v.size()); for (auto const & k : v) key(k); }
+
+      // a child already hashed, looked up by key (0 if it could not be fetched)
+      template <typename K> void child(const std::map<K, uint64_t> &hashes, const K &k) {
+         auto f = hashes.find(k);
+         pod(f == hashes.end() ? (uint64_t) 0 : f->second);
+      }
+      void children(const std::map<NGuiKey, uint64_t> &hashes, const std::vector<NGuiKey> &v) {
+         for (auto const & k : v) child(hashes, k);
+      }
+};
+
+//
+// Hash every subject, feature and case with all it renders, then give each the seq it last
+// changed at: the previous model's if the hash is the same, else this model's seq.
+//
+void readmodel::stamp(const readmodel *previous) {
+   std::map<NGuiKey, uint64_t> knobhashes, histogramhashes, kronohashes;
+
+   for (auto const & k : knobs) {
+      contenthash c;
+      auto t = knobtexts.find(k.first);
+      c.str(t == knobtexts.end() ? std::string() : t->second);
+      c.pod(k.second.getterReply); c.pod(k.second.ownType);
+      c.str(k.second.labelText); c.str(k.second.unitsText);
+      c.pods(k.second.rangeMinMax_emptyIfBool); c.pods(k.second.definedSelection_emptyIfNA);
+      c.pod(k.second.valueNow_numerIfBool);
+      knobhashes[k.first] = c.h;
+   }
+   for (auto const & hg : histograms) {
+      auto const & p = hg.second;
+      contenthash c;
+      auto t = histogramtexts.find(hg.first);
+      c.str(t == histogramtexts.end() ? std::string() : t->second);
+      c.pod(p.getterReply); c.pod(p.ownType); c.pod(p.barTypeDisplayed); c.pod(p.numBarsDisplayed);
+      c.strs(p.captionText_byCR); c.pods(p.barHeights_leftToRight);
+      c.pod(p.leftEndBarNumericLabel_nanIfBarsNotAnalog); c.pod(p.eachBarNumericLabelIncr_nanIfBarsNotAnalog);
+      c.strs(p.barLabelsAsText_leftToRight_emptyIfBarsAnalog); c.strs(p.modeOptionsText_each); c.strs(p.spanOptionsText_each);
+      c.pod(p.modeNow_index); c.pod(p.spanNow_index);
+      c.keys(p.knobKeys); c.children(knobhashes, p.knobKeys);
+      histogramhashes[hg.first] = c.h;
+   }
+   for (auto const & k : kronos) {
+      auto const & p = k.second;
+      contenthash c;
+      c.pod(p.getterReply); c.pod(p.ownType); c.str(p.captionText);
+      c.pods(p.timestamps_olderToNewer);
+      c.keys(p.knobKeys); c.children(knobhashes, p.knobKeys);
+      c.keys(p.paneKeys_topToBottom);
+      for (auto const & pkey : p.paneKeys_topToBottom) {
+         auto pane = panes.find(pkey);
+         if (pane == panes.end())
+            continue;
+         c.pod(pane->second.getterReply); c.pod(pane->second.ownType); c.str(pane->second.yAxisUnitsText);
+         c.pod(pane->second.yAxisMin); c.pod(pane->second.yAxisMax);
+         c.keys(pane->second.traceKeys);
+         for (auto const & tkey : pane->second.traceKeys) {
+            auto trace = traces.find(std::make_pair(tkey, k.first));
+            if (trace == traces.end())
+               continue;
+            auto const & tr = trace->second;
+            c.pod(tr.getterReply); c.pod(tr.ownType); c.str(tr.tag);
+            c.pods(tr.numbers_olderToNewer); c.pods(tr.states_olderToNewer);
+            c.child(histogramhashes, tr.sourceHistogramKey);
+            c.keys(tr.knobKeys); c.children(knobhashes, tr.knobKeys);
+         }
+      }
+      kronohashes[k.first] = c.h;
+   }
+   for (auto const & f : features) {
+      auto const & p = f.second;
+      contenthash c;
+      c.pod(p.getterReply); c.pod(p.ownType); c.pod(p.featureUai);
+      c.str(p.labelText); c.str(p.unitsText); c.str(p.messageText); c.pod(p.messageState);
+      c.child(histogramhashes, p.sourceHistogramKey);
+      c.keys(p.ownKnobKeys); c.children(knobhashes, p.ownKnobKeys);
+      featurehashes[f.first] = c.h;
+   }
+   std::map<NGuiKey, uint64_t> rulekithashes;
+   for (auto const & r : rulekits) {
+      auto const & p = r.second;
+      contenthash c;
+      auto t = rulekittexts.find(r.first);
+      c.str(t == rulekittexts.end() ? std::string() : t->second);
+      c.pod(p.getterReply); c.pod(p.ownType); c.str(p.captionText);
+      c.strs(p.ruleLabels_topToBottom); c.strs(p.ruleTexts_if_topToBottom); c.strs(p.ruleTexts_then_topToBottom);
+      c.pods(p.ruleStates_topToBottom);
+      c.child(histogramhashes, p.ruleKitHistogramKey);
+      c.child(kronohashes, p.realtimeKronoKey_zeroIfNone);
+      c.keys(p.ruleKitKnobKeys); c.children(knobhashes, p.ruleKitKnobKeys);
+      c.keys(p.ruleKnobKeys_topToBottom); c.children(knobhashes, p.ruleKnobKeys_topToBottom);
+      c.keys(p.ruleHistogramKeys_topToBottom); c.children(histogramhashes, p.ruleHistogramKeys_topToBottom);
+      rulekithashes[r.first] = c.h;
+   }
+   for (auto const & k : cases) {
+      auto const & p = k.second;
+      contenthash c;
+      c.pod(p.getterReply); c.pod(p.ownType); c.str(p.caseName);
+      c.strs(p.reportText_byCR); c.strs(p.promptText_byCR); c.strs(p.optionText_each);
+      c.key(p.snapshotKronoKey); c.child(kronohashes, p.snapshotKronoKey);
+      casehashes[k.first] = c.h;
+   }
+   for (auto const & s : subjects) {
+      auto const & p = s.second;
+      contenthash c;
+      auto t = subjecttexts.find(s.first);
+      c.str(t == subjecttexts.end() ? std::string() : t->second);
+      c.pod(p.getterReply); c.pod(p.ownType); c.key(p.hostDomainKey);
+      c.str(p.ownNameText); c.strs(p.infoText_byCR);
+      c.keys(p.featureKeys); c.children(featurehashes, p.featureKeys);
+      c.keys(p.paramKnobKeys); c.children(knobhashes, p.paramKnobKeys);
+      c.keys(p.ruleKitKeys); c.children(rulekithashes, p.ruleKitKeys);
+      auto sc = subjectcases.find(s.first);
+      if (sc != subjectcases.end()) {
+         c.keys(sc->second.currentCaseKeys); c.children(casehashes, sc->second.currentCaseKeys);
+      }
+      auto points = subjectpoints.find(s.first);
+      if (points != subjectpoints.end())
+         c.pods(points->second);
+      subjecthashes[s.first] = c.h;
+   }
+
+   auto carry = [this](const std::map<NGuiKey, uint64_t> &hashes, const std::map<NGuiKey, uint64_t> *oldhashes,
+                       const std::map<NGuiKey, uint64_t> *oldseqs, std::map<NGuiKey, uint64_t> &seqs) {
+      for (auto const & hh : hashes) {
+         uint64_t at = seq;
+         if (oldhashes) {
+            auto was = oldhashes->find(hh.first);
+            if (was != oldhashes->end() && was->second == hh.second)
+               at = oldseqs->at(hh.first);
+         }
+         seqs[hh.first] = at;
+      }
+   };
+   carry(subjecthashes, previous ? &previous->subjecthashes : nullptr, previous ? &previous->subjectseqs : nullptr, subjectseqs);
+   carry(featurehashes, previous ? &previous->featurehashes : nullptr, previous ? &previous->featureseqs : nullptr, featureseqs);
+   carry(casehashes, previous ? &previous->casehashes : nullptr, previous ? &previous->caseseqs : nullptr, caseseqs);
+
+   if (!previous)
+      return;
+
+   // Cases gone since the previous model, oldest forgotten first once there are too many
+   removedcases = previous->removedcases;
+   removedhorizon = previous->removedhorizon;
+   for (auto const & sc : previous->subjectcases) {
+      auto now = subjectcases.find(sc.first);
+      for (auto const & ckey : sc.second.currentCaseKeys) {
+         if (now == subjectcases.end() || std::find(now->second.currentCaseKeys.begin(), now->second.currentCaseKeys.end(), ckey) == now->second.currentCaseKeys.end())
+            removedcases[ckey] = std::make_pair(sc.first, seq);
+      }
+   }
+   for (auto const & k : cases)
+      removedcases.erase(k.first);    // a key can come back
+   while (removedcases.size() > READMODEL_MAX_REMOVED_CASES) {
+      auto oldest = std::min_element(removedcases.begin(), removedcases.end(), [](const std::pair<const NGuiKey, std::pair<NGuiKey, uint64_t>> &a, const std::pair<const NGuiKey, std::pair<NGuiKey, uint64_t>> &b) {
+         return a.second.second < b.second.second;
+      });
+      removedhorizon = std::max(removedhorizon, oldest->second.second);
+      removedcases.erase(oldest);
+   }
+}
@@ -0,0 +1,88 @@
+#ifndef READMODEL_H
+#define READMODEL_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "exportCalls.hpp"
+
+typedef uint64_t AlertId_t;
+
+#define READMODEL_MAX_REMOVED_CASES 1024
+
+//
+// An immutable copy of everything the GET endpoints report, taken from libEA on the
+// engine thread. The handler publishes a new one after each change to the back end
+// and GET requests read whichever one was current when they started, so they never call
+// into libEA (which is not thread-safe) and never wait on ingestion or stepping.
+//
+// Objects are reached by walking down from the domain's subjects, the same way the json_*
+// functions in handler.cpp walk them. A key whose getter threw is simply absent, so the
+// .at() lookup in the json_* function throws and reports the usual "Error fetching" text.
+//
+// Subjects, features and cases also carry the seq at which their reply last changed, for the
+// "since" queries. Each is found by hashing everything its json_* reply is built from (its
+// children included) and comparing with the previous model: an unchanged hash keeps the old seq.
+// Cases that have gone away are remembered, up to READMODEL_MAX_REMOVED_CASES of them, so a
+// "since" query can report them; removals at or before removedhorizon have been forgotten.
+//
+class readmodel
+{
+   public:
+      readmodel(IExportOmni*, const GuiPackDomain_t&, uint64_t, const readmodel*);
+
+      const uint64_t seq;     // handler seq at the time this model was taken
+      const AlertId_t alertseq;   // id the next alert will get; alerts themselves stay in libEA's ring
+      const time_t time;      // engine's step time at the time this model was taken, 0 before any step
+
+      std::map<NGuiKey, std::string> subjecttexts;
+      std::map<NGuiKey, GuiPackSubjectBasic_t> subjects;
+      std::map<NGuiKey, GuiPackSubjectCases_t> subjectcases;
+      std::map<NGuiKey, std::vector<EPointName>> subjectpoints;
+      std::map<NGuiKey, GuiPackFeatureFull_t> features;
+      std::map<NGuiKey, std::string> knobtexts;
+      std::map<NGuiKey, GuiPackKnob_t> knobs;
+      std::map<NGuiKey, std::string> histogramtexts;
+      std::map<NGuiKey, GuiPackHistogram_t> histograms;
+      std::map<NGuiKey, std::string> rulekittexts;
+      std::map<NGuiKey, GuiPackRuleKitFull_t> rulekits;
+      std::map<NGuiKey, GuiPackCaseFull_t> cases;
+      std::map<NGuiKey, GuiPackKronoFull_t> kronos;
+      std::map<NGuiKey, GuiPackPane_t> panes;
+      std::map<std::pair<NGuiKey, NGuiKey>, GuiPackTraceFull_t> traces;   // keyed by (trace, krono)
+
+      std::map<NGuiKey, uint64_t> subjectseqs;    // seq each reply last changed at
+      std::map<NGuiKey, uint64_t> featureseqs;
+      std::map<NGuiKey, uint64_t> caseseqs;
+      std::map<NGuiKey, std::pair<NGuiKey, uint64_t>> removedcases;   // case -> (subject, seq it was gone at)
+      uint64_t removedhorizon;
+
+      // Realtime Kronos in this model, each flagged once a GET reply has shown it. Taking a model
+      // copies every Krono, so it is not a request from the GUI; the engine thread passes the
+      // flagged ones on to libEA at the next publish instead, keeping them from idle release.
+      mutable std::map<NGuiKey, std::atomic<bool>> kronosshown;
+      void shown(const NGuiKey&) const;
+
+      bool changed_since(const std::map<NGuiKey, uint64_t>&, const NGuiKey&, uint64_t) const;
+
+   private:
+      void add_subject(IExportOmni*, const NGuiKey&);
+      void add_feature(IExportOmni*, const NGuiKey&);
+      void add_knob(IExportOmni*, const NGuiKey&);
+      void add_histogram(IExportOmni*, const NGuiKey&);
+      void add_rulekit(IExportOmni*, const NGuiKey&);
+      void add_case(IExportOmni*, const NGuiKey&);
+      void add_krono(IExportOmni*, const NGuiKey&);
+      void add_pane(IExportOmni*, const NGuiKey&, const NGuiKey&);
+      void add_trace(IExportOmni*, const NGuiKey&, const NGuiKey&);
+      void stamp(const readmodel*);
+
+      std::map<NGuiKey, uint64_t> subjecthashes;
+      std::map<NGuiKey, uint64_t> featurehashes;
+      std::map<NGuiKey, uint64_t> casehashes;
+};
+
+#endif // READMODEL_H
@@ -0,0 +1,58 @@
+/*
+ * responsecache.cpp
+ *
+ * LRU cache of serialized GET replies (see responsecache.hpp)
+ */
+
+#include "responsecache.hpp"
+
+responsecache::responsecache(size_t entries) : capacity(entries)
+{
+}
+
+//
+// Copy out the entry for this key if it was built at this seq. Returns false on a miss.
+//
+bool responsecache::find(const std::string &key, uint64_t seq, entry &hit) {
+   std::lock_guard<std::mutex> guard(lock);
+   auto i = index.find(key);
+   if (i == index.end())
+      return(false);
+   if (i->second->second.seq < seq) {
+      // built at an older seq; it can never be served again
+      lru.erase(i->second);
+      index.erase(i);
+      return(false);
+   }
+   if (i->second->second.seq > seq) {
+      // built from a newer model than this request holds; keep it for the requests that will
+      return(false);
+   }
+   lru.splice(lru.begin(), lru, i->second);
+   hit = i->second->second;
+   return(true);
+}
+
+//
+// Store (or replace) the entry for this key, evicting the least recently used if full
+//
+void responsecache::put(const std::string &key, const entry &e) {
+   if (capacity == 0)
+      return;
+   std::lock_guard<std::mutex> guard(lock);
+   auto i = index.find(key);
+   if (i != index.end()) {
+      // a newer seq always wins over an older one built by a slower request
+      if (i->second->second.seq > e.seq)
+         return;
+      i->second->second = e;
+      lru.splice(lru.begin(), lru, i->second);
+      return;
+   }
+   lru.emplace_front(key, e);
+   index[key] = lru.begin();
+   if (lru.size() > capacity) {
+      index.erase(lru.back().first);
+      lru.pop_back();
+   }
+}
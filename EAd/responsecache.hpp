@@ -0,0 +1,43 @@
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+//
+// LRU cache of serialized GET replies. An entry is good only for the seq it was built at, so a
+// room full of dashboards polling the same URLs costs one serialization per URL per seq rather
+// than one per poll. Replies depend only on the read model (see readmodel.hpp) and seq, so the
+// key is the request path and query; the seq is checked on lookup and a stale entry is dropped.
+// An entry newer than the lookup (a request still holding the previous model) is a miss, kept.
+//
+class responsecache
+{
+   public:
+      struct entry {
+         uint64_t seq;
+         std::shared_ptr<const std::string> body;   // serialized reply, gzipped if compressed
+         bool compressed;
+      };
+
+      explicit responsecache(size_t);
+
+      bool find(const std::string &, uint64_t, entry &);
+      void put(const std::string &, const entry &);
+
+   private:
+      typedef std::list<std::pair<std::string, entry>> Lru_t;   // most recently used at front
+
+      std::mutex lock;              // held only for list/map updates, never while building a reply
+      size_t capacity;
+      Lru_t lru;
+      std::unordered_map<std::string, Lru_t::iterator> index;
+};
+
+#endif // RESPONSECACHE_H
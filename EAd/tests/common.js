@@ -0,0 +1,54 @@
+// Helpers shared by the ead-*.js request tests. Each failure found adds one to process.exitCode,
+// so a test file exits with the count of its failures.
+
+const http = require('http');
+
+const baseurl = "http://127.0.0.1:9876";
+
+process.exitCode = 0;
+
+// Request with no Accept-Encoding, so the reply is never gzipped; the body is kept as a Buffer
+function rawrequest(method, uri, headers, body) {
+  return new Promise((resolve, reject) => {
+    const req = http.request(baseurl + uri, {'method': method, 'headers': headers || {}}, (res) => {
+      const chunks = [];
+      res.on('data', (c) => chunks.push(c));
+      res.on('end', () => resolve({'status': res.statusCode, 'headers': res.headers, 'body': Buffer.concat(chunks)}));
+    });
+    req.on('error', reject);
+    req.end(body);
+  });
+}
+
+function rawget(uri, headers) {
+  return rawrequest('GET', uri, headers);
+}
+
+// PUT of a body that is not JSON (CSV, protobuf); the reply is always JSON
+async function rawput(uri, body, contenttype) {
+  const r = await rawrequest('PUT', uri, {'Content-Type': contenttype}, body);
+  return {'status': r.status, 'reply': JSON.parse(r.body)};
+}
+
+// Body of PUT /ctrl/sampletimestep giving every point of every subject the same value
+function stepbody(subjects, t) {
+  return {'time': t, 'values_by_subject': subjects.map((s) => ({'subject': s.key, 'values': s.points.map(() => 50.0)}))};
+}
+
+function check(ok, ...msg) {
+  if (!ok) {
+    console.log(...msg);
+    process.exitCode++;
+  }
+}
+
+async function test(name, f) {
+  try {
+    await f();
+  } catch (e) {
+    console.log("ERROR testing %s: %o", name, e.message);
+    process.exitCode++;
+  }
+}
+
+module.exports = {baseurl, rawrequest, rawget, rawput, stepbody, check, test};
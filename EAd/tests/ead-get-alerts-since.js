@@ -0,0 +1,39 @@
+#!/usr/bin/env node
+
+// GET /alerts reads alerts from libEA's ring by id. Ids ascend by one, and every reply carries
+// alertseq, the id the next alert will get. With since (an id), the reply holds the alerts from
+// that id on, and missed counts those already overwritten in the ring.
+
+const bent = require('bent');
+const {baseurl, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+
+test('alerts since', async () => {
+  const all = await get('/alerts');
+  const ids = all.alerts.map((a) => a.id);
+  ids.forEach((id, i) => {
+    if (i > 0)
+      check(id == ids[i - 1] + 1, "ERROR: GET /alerts listed id %s after %s", id, ids[i - 1]);
+  });
+  check(ids.length == 0 || ids[ids.length - 1] == all.alertseq - 1, "ERROR: GET /alerts ended at id %s with alertseq %s", ids[ids.length - 1], all.alertseq);
+  check(all.since === undefined && all.missed === undefined, "ERROR: GET /alerts without since returned since %s, missed %s", all.since, all.missed);
+
+  const none = await get('/alerts?since=' + all.alertseq);
+  check(none.since == all.alertseq, "ERROR: GET /alerts?since=%s echoed since %s", all.alertseq, none.since);
+  if (none.alertseq == all.alertseq)
+    check(none.alerts.length == 0 && none.missed == 0, "ERROR: GET /alerts?since=%s, the alertseq, returned %d alerts with missed %s", all.alertseq, none.alerts.length, none.missed);
+
+  if (ids.length < 2) {
+    console.log("WARNING: only %d alerts posted, so reading from the middle was not tested", ids.length);
+    return;
+  }
+  const mid = ids[Math.floor(ids.length / 2)];
+  const tail = await get('/alerts?since=' + mid);
+  if (tail.alertseq == all.alertseq) {
+    check(tail.missed == 0, "ERROR: GET /alerts?since=%s returned missed %s", mid, tail.missed);
+    check(JSON.stringify(tail.alerts.map((a) => a.id)) == JSON.stringify(ids.filter((id) => id >= mid)), "ERROR: GET /alerts?since=%s returned ids %o", mid, tail.alerts.map((a) => a.id));
+  }
+  const fromstart = await get('/alerts?since=0');
+  check(fromstart.missed == (fromstart.alerts.length > 0 ? fromstart.alerts[0].id : fromstart.alertseq), "ERROR: GET /alerts?since=0 returned missed %s with first id %s", fromstart.missed, fromstart.alerts.length > 0 ? fromstart.alerts[0].id : undefined);
+});
@@ -0,0 +1,60 @@
+#!/usr/bin/env node
+
+// GET /batch?keys=KIND:KEY,... returns the objects asked for in one reply, in order, each tagged
+// with its kind and the same as the single-object GET returns. An unknown kind or a malformed
+// item gets an error in its own object; more than 1000 keys is turned down.
+
+const bent = require('bent');
+const {baseurl, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const getany = bent(baseurl, 'GET', 'json', 200, 400);
+
+// json with object fields in sorted order, to compare replies field by field
+function canonical(v) {
+  if (Array.isArray(v))
+    return '[' + v.map(canonical).join(',') + ']';
+  if (v !== null && typeof v == 'object')
+    return '{' + Object.keys(v).sort().map((k) => JSON.stringify(k) + ':' + canonical(v[k])).join(',') + '}';
+  return JSON.stringify(v);
+}
+
+test('batch', async () => {
+  const domain = await get('/subjects?compact=1');
+  const subject = domain.subjects[0];
+  const items = ['subject:' + subject.key];
+  if (subject.featurekeys.length > 0)
+    items.push('feature:' + subject.featurekeys[0]);
+  if (subject.knobkeys.length > 0)
+    items.push('knob:' + subject.knobkeys[0]);
+  if (subject.rulekitkeys.length > 0)
+    items.push('rulekit:' + subject.rulekitkeys[0]);
+  items.push('widget:1', 'knob:abc', 'pane:1');
+
+  const batch = await get('/batch?compact=1&keys=' + items.join(','));
+  check(batch.objects.length == items.length, "ERROR: GET /batch of %d keys returned %d objects", items.length, batch.objects.length);
+  batch.objects.forEach((obj, i) => {
+    const kind = items[i].split(':')[0];
+    check(obj.kind == kind, "ERROR: GET /batch object %d had kind %s, not %s", i, obj.kind, kind);
+  });
+  const good = items.length - 3;
+  batch.objects.slice(0, good).forEach((obj, i) => {
+    check(!obj.error && obj.key == Number(items[i].split(':')[1]), "ERROR: GET /batch object %s returned key %s, error %s", items[i], obj.key, obj.error);
+  });
+  batch.objects.slice(good).forEach((obj, i) => {
+    check(obj.error, "ERROR: GET /batch item %s returned no error", items[good + i]);
+  });
+
+  // The same object as GET /subject, when both are read from one model
+  const single = await get('/subject?compact=1&subject=' + subject.key);
+  if (single.seq == batch.seq) {
+    const obj = Object.assign({}, batch.objects[0]);
+    delete obj.kind;
+    for (const field of ['seq', 'apiver'])
+      delete single[field];
+    check(canonical(obj) == canonical(single), "ERROR: GET /batch subject %s differs from GET /subject", subject.key);
+  }
+
+  const toomany = await getany('/batch?keys=' + Array(1001).fill('knob:1').join(','));
+  check(toomany.error, "ERROR: GET /batch of 1001 keys returned no error");
+});
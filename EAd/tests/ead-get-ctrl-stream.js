@@ -0,0 +1,110 @@
+#!/usr/bin/env node
+
+// GET /ctrl/stream is a Server-Sent Events stream: a "hello" event with the current seq, then a
+// "step" event holding a delta each time a model is published, with the model's seq as its id.
+// Each delta gives the step time its model was taken at, and lists the features, cases and alerts
+// that changed. Steps here are on 2025-07-17, then a day of fault testdata is ingested as 2025-07-18
+// (local time), once the cases left open by earlier tests are deleted so that new ones open.
+
+const bent = require('bent');
+const fs = require('fs');
+const http = require('http');
+const path = require('path');
+const {baseurl, rawput, stepbody, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const put = bent(baseurl, 'PUT', 'json');
+
+const day = new Date(2025, 6, 17).getTime() / 1000;
+const faultday = '2025/07/18';
+const faultend = new Date(2025, 6, 18, 23, 59).getTime() / 1000;
+
+const datafile = path.join(__dirname, 'testdata', 'ibal_ahu2Fault_250709_si.csv');
+
+// Answer every open case that offers it with "Delete this case."
+async function deletecases(subjects) {
+  for (const s of subjects) {
+    const cases = await get('/cases?subject=' + s.key);
+    for (const c of cases.cases) {
+      const answer = (c.options || []).indexOf("Delete this case.");
+      if (answer >= 0)
+        await put('/ctrl/answercase', {'case': c.key, 'answer': answer});
+    }
+  }
+}
+
+// Subscribe, collecting each event as {id, event, data} into events; resolves with the response
+function subscribe(events) {
+  return new Promise((resolve, reject) => {
+    const req = http.get(baseurl + '/ctrl/stream', (res) => {
+      let pending = '';
+      res.setEncoding('utf8');
+      res.on('data', (text) => {
+        pending += text;
+        let end;
+        while ((end = pending.indexOf('\n\n')) >= 0) {
+          const ev = {};
+          for (const line of pending.slice(0, end).split('\n')) {
+            const colon = line.indexOf(': ');
+            if (colon > 0)
+              ev[line.slice(0, colon)] = line.slice(colon + 2);
+          }
+          pending = pending.slice(end + 2);
+          events.push(ev);
+        }
+      });
+      resolve({'req': req, 'res': res});
+    });
+    req.on('error', (e) => { if (!req.destroyed) reject(e); });
+  });
+}
+
+async function waitfor(f) {
+  for (let i = 0; i < 100 && !f(); i++)
+    await new Promise((resolve) => setTimeout(resolve, 100));
+  return f();
+}
+
+test('stream', async () => {
+  const domain = await get('/subjects?compact=1');
+  await deletecases(domain.subjects);
+  const events = [];
+  const stream = await subscribe(events);
+  try {
+    check(stream.res.statusCode == 200, "ERROR: GET /ctrl/stream returned status %s", stream.res.statusCode);
+    check(/^text\/event-stream/.test(stream.res.headers['content-type']), "ERROR: GET /ctrl/stream returned Content-Type %s", stream.res.headers['content-type']);
+    if (!await waitfor(() => events.length > 0))
+      throw new Error("no hello event within 10 s");
+    const hello = JSON.parse(events[0].data);
+    check(events[0].event == 'hello', "ERROR: stream began with event %s, not hello", events[0].event);
+    check(events[0].id == hello.seq && hello.seq >= domain.seq, "ERROR: hello had id %s and seq %s, not at least %s", events[0].id, hello.seq, domain.seq);
+    check(hello.alertseq !== undefined, "ERROR: hello had no alertseq");
+
+    const stepped = await put('/ctrl/sampletimestep', stepbody(domain.subjects, day));
+    if (!await waitfor(() => events.some((ev) => ev.id == stepped.seq)))
+      throw new Error("no step event for seq " + stepped.seq + " within 10 s");
+    for (const ev of events.slice(1)) {
+      const data = JSON.parse(ev.data);
+      check(ev.event == 'step', "ERROR: stream sent event %s, not step", ev.event);
+      check(data.seq == ev.id, "ERROR: step event had id %s but seq %s", ev.id, data.seq);
+      check(Number(ev.id) > hello.seq, "ERROR: step event id %s not after hello's %s", ev.id, hello.seq);
+    }
+    const steppedevent = JSON.parse(events.find((ev) => ev.id == stepped.seq).data);
+    check(steppedevent.time == day, "ERROR: step event for seq %s had time %s, not the step's %s", stepped.seq, steppedevent.time, day);
+
+    // A day of fault data, so features change state, cases open and alerts are raised
+    const lines = fs.readFileSync(datafile, 'utf8').split('\n').map((line) => line.replace(/^\d+\/\d+\/\d+,/, faultday + ','));
+    const ingested = await rawput('/ctrl/ingest', lines.join('\n'), 'text/csv');
+    check(ingested.reply.steps == 1440 && ingested.reply.failed == 0, "ERROR: ingest of %s as %s ran %s steps with %s failed: %o", datafile, faultday, ingested.reply.steps, ingested.reply.failed, ingested.reply.errors);
+    if (!await waitfor(() => events.some((ev) => ev.id == ingested.reply.seq)))
+      throw new Error("no step event for seq " + ingested.reply.seq + " within 10 s");
+    const deltas = events.filter((ev) => Number(ev.id) > stepped.seq).map((ev) => JSON.parse(ev.data));
+    const last = deltas[deltas.length - 1];
+    check(last.time == faultend, "ERROR: step event for ingest seq %s had time %s, not its last step's %s", last.seq, last.time, faultend);
+    check(deltas.some((d) => (d.features || []).length > 0), "ERROR: no step event during the fault day listed a changed feature");
+    check(deltas.some((d) => (d.cases || []).some((c) => c.opened.length > 0)), "ERROR: no step event during the fault day listed an opened case");
+    check(deltas.some((d) => (d.alerts || []).length > 0), "ERROR: no step event during the fault day listed an alert");
+  } finally {
+    stream.req.destroy();
+  }
+});
@@ -0,0 +1,34 @@
+#!/usr/bin/env node
+
+// GET /debug/trace returns the request traces still held (one request in 16 is sampled, plus
+// any slow one) as a Chrome trace-event file: an "X" event per request, holding its status, with
+// an "X" event per phase inside it on the same tid, and "M" events naming the process and tids.
+
+const {rawget, check, test} = require('./common.js');
+
+test('debug trace', async () => {
+  for (let i = 0; i < 40; i++)
+    await rawget('/subjects?compact=1');
+  const r = await rawget('/debug/trace');
+  check(r.status == 200 && /^application\/json/.test(r.headers['content-type']), "ERROR: GET /debug/trace returned status %s, Content-Type %s", r.status, r.headers['content-type']);
+  check(r.headers['etag'] === undefined, "ERROR: GET /debug/trace returned ETag %s", r.headers['etag']);
+  const trace = JSON.parse(r.body);
+  check(trace.displayTimeUnit == "ms" && Array.isArray(trace.traceEvents), "ERROR: GET /debug/trace is not a trace-event file");
+
+  const events = trace.traceEvents;
+  check(events.some((e) => e.ph == "M" && e.name == "process_name"), "ERROR: GET /debug/trace named no process");
+  const requests = events.filter((e) => e.ph == "X" && e.cat == "request");
+  const phases = events.filter((e) => e.ph == "X" && e.cat == "phase");
+  check(requests.some((e) => e.name == "GET /subjects"), "ERROR: none of 40 GETs of /subjects was traced");
+  for (const e of requests) {
+    check(e.args && e.args.status > 0, "ERROR: traced request %s had no status", e.name);
+    check(events.some((m) => m.ph == "M" && m.name == "thread_name" && m.tid == e.tid), "ERROR: traced request %s had no thread_name for tid %s", e.name, e.tid);
+  }
+  for (const p of phases) {
+    const owner = requests.find((e) => e.tid == p.tid);
+    check(owner !== undefined, "ERROR: phase %s on tid %s belongs to no traced request", p.name, p.tid);
+    if (owner !== undefined)
+      check(p.ts >= owner.ts - 0.001 && p.ts + p.dur <= owner.ts + owner.dur + 0.002, "ERROR: phase %s runs outside its request %s", p.name, owner.name);
+  }
+  check(phases.length > 0, "ERROR: traced requests had no phases");
+});
@@ -0,0 +1,40 @@
+#!/usr/bin/env node
+
+// GET replies carry an ETag naming the seq they were built at, and the seq in the body agrees
+// with it. Sending the tag back gets 304 until a step moves seq on; a repeat GET at the same seq
+// is answered from the reply cache, byte for byte. Steps here are on 2025-07-11 (local time).
+
+const bent = require('bent');
+const {baseurl, rawget, stepbody, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const put = bent(baseurl, 'PUT', 'json');
+
+const day = new Date(2025, 6, 11).getTime() / 1000;
+
+test('etag', async () => {
+  const uri = '/subjects?compact=1';
+  const first = await rawget(uri);
+  const etag = first.headers['etag'];
+  const seq = JSON.parse(first.body).seq;
+  check(first.status == 200, "ERROR: GET %s returned status %s", uri, first.status);
+  check(etag == '"' + seq + '"', "ERROR: GET %s returned ETag %s for seq %s", uri, etag, seq);
+
+  const notmodified = await rawget(uri, {'If-None-Match': etag});
+  check(notmodified.status == 304, "ERROR: GET %s with If-None-Match %s returned status %s, not 304", uri, etag, notmodified.status);
+  check(notmodified.body.length == 0, "ERROR: 304 reply had a body of %d bytes", notmodified.body.length);
+
+  const listed = await rawget(uri, {'If-None-Match': 'W/"0-none", ' + etag});
+  check(listed.status == 304, "ERROR: GET %s with If-None-Match listing %s returned status %s, not 304", uri, etag, listed.status);
+
+  const cached = await rawget(uri);
+  check(cached.status == 200 && cached.body.equals(first.body), "ERROR: repeat GET %s at seq %s returned a different body", uri, seq);
+
+  const subjects = JSON.parse(first.body).subjects;
+  const stepped = await put('/ctrl/sampletimestep', stepbody(subjects, day));
+  const after = await rawget(uri, {'If-None-Match': etag});
+  const afterseq = after.status == 200 ? JSON.parse(after.body).seq : -1;
+  check(after.status == 200, "ERROR: GET %s with old ETag after a step returned status %s, not 200", uri, after.status);
+  check(afterseq >= stepped.seq, "ERROR: GET after a step returned seq %s, older than the step's %s", afterseq, stepped.seq);
+  check(after.headers['etag'] == '"' + afterseq + '"', "ERROR: GET %s returned ETag %s for seq %s", uri, after.headers['etag'], afterseq);
+});
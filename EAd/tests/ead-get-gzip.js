@@ -0,0 +1,33 @@
+#!/usr/bin/env node
+
+// A GET reply is gzipped when the client takes gzip and the body is at least --gzip-min-bytes
+// (1024 by default); its ETag then ends in "-gzip". Smaller replies, like /noop, go out plain
+// with the plain ETag. Either way the reply says it varies on Accept-Encoding.
+
+const zlib = require('zlib');
+const {rawget, check, test} = require('./common.js');
+
+test('gzip', async () => {
+  const uri = '/subjects';
+  const zipped = await rawget(uri, {'Accept-Encoding': 'gzip, deflate'});
+  check(zipped.status == 200, "ERROR: GET %s returned status %s", uri, zipped.status);
+  check(zipped.headers['content-encoding'] == 'gzip', "ERROR: GET %s taking gzip returned Content-Encoding %s", uri, zipped.headers['content-encoding']);
+  check(/accept-encoding/i.test(zipped.headers['vary'] || ''), "ERROR: GET %s returned Vary %s", uri, zipped.headers['vary']);
+  const body = JSON.parse(zlib.gunzipSync(zipped.body));
+  check(zipped.headers['etag'] == '"' + body.seq + '-gzip"', "ERROR: gzipped GET %s returned ETag %s for seq %s", uri, zipped.headers['etag'], body.seq);
+
+  // Same URL plain: a different representation, so a different ETag
+  const plain = await rawget(uri);
+  check(plain.headers['content-encoding'] === undefined, "ERROR: GET %s not taking gzip returned Content-Encoding %s", uri, plain.headers['content-encoding']);
+  check(plain.body.equals(zlib.gunzipSync(zipped.body)), "ERROR: GET %s plain differs from its gzipped reply unzipped", uri);
+  check(plain.headers['etag'] == '"' + body.seq + '"', "ERROR: plain GET %s returned ETag %s for seq %s", uri, plain.headers['etag'], body.seq);
+
+  const notmodified = await rawget(uri, {'Accept-Encoding': 'gzip', 'If-None-Match': zipped.headers['etag']});
+  check(notmodified.status == 304, "ERROR: GET %s with If-None-Match %s returned status %s, not 304", uri, zipped.headers['etag'], notmodified.status);
+
+  // Too small to be worth compressing
+  const small = await rawget('/noop', {'Accept-Encoding': 'gzip'});
+  check(small.headers['content-encoding'] === undefined, "ERROR: GET /noop of %d bytes was sent gzipped", small.body.length);
+  check(!/-gzip/.test(small.headers['etag'] || ''), "ERROR: GET /noop sent plain returned ETag %s", small.headers['etag']);
+  check(/accept-encoding/i.test(small.headers['vary'] || ''), "ERROR: GET /noop returned Vary %s", small.headers['vary']);
+});
@@ -0,0 +1,54 @@
+#!/usr/bin/env node
+
+// GET /metrics answers in the Prometheus text format (version 0.0.4): each series has HELP and
+// TYPE lines, histograms have cumulative buckets ending at +Inf, and request counts go up by the
+// requests made between two scrapes. It is never cached, so it has no ETag.
+
+const {rawget, check, test} = require('./common.js');
+
+// Samples by series name and labels, e.g. 'ead_http_requests_total{method="GET",route="/noop"}'
+function scrape(text) {
+  const samples = {};
+  const types = {};
+  for (const line of text.split('\n')) {
+    let m;
+    if ((m = line.match(/^# TYPE (\w+) (\w+)$/))) {
+      types[m[1]] = m[2];
+    } else if ((m = line.match(/^(\w+)(\{.*\})? (\S+)$/))) {
+      samples[m[1] + (m[2] || '')] = Number(m[3]);
+      const base = m[1].replace(/_(bucket|sum|count)$/, '');
+      if (types[m[1]] === undefined && types[base] === undefined) {
+        console.log("ERROR: /metrics sample %s has no TYPE line before it", m[1]);
+        process.exitCode++;
+      }
+    } else if (line != '' && !line.startsWith('# HELP ')) {
+      console.log("ERROR: /metrics line is not in the text format: %s", line);
+      process.exitCode++;
+    }
+  }
+  return samples;
+}
+
+test('metrics', async () => {
+  const noop = 'ead_http_requests_total{method="GET",route="/noop"}';
+  const first = await rawget('/metrics');
+  check(first.status == 200, "ERROR: GET /metrics returned status %s", first.status);
+  check(/^text\/plain; version=0\.0\.4/.test(first.headers['content-type']), "ERROR: GET /metrics returned Content-Type %s", first.headers['content-type']);
+  check(first.headers['etag'] === undefined, "ERROR: GET /metrics returned ETag %s", first.headers['etag']);
+  const before = scrape(first.body.toString());
+  for (const series of ['ead_seq', 'ead_alerts_total', 'ead_stream_subscribers', 'ead_stream_subscribers_dropped_total', noop, 'ead_engine_queue_wait_seconds_count', 'ead_kbase_nodes_read_total'])
+    check(before[series] !== undefined, "ERROR: GET /metrics had no %s", series);
+
+  const seqs = [];
+  for (let i = 0; i < 3; i++)
+    seqs.push(JSON.parse((await rawget('/noop')).body).seq);
+  const after = scrape((await rawget('/metrics')).body.toString());
+  check(after[noop] >= before[noop] + 3, "ERROR: %s went from %s to %s over 3 GETs", noop, before[noop], after[noop]);
+  if (seqs[2] == seqs[0])
+    check(after['ead_seq'] == seqs[2], "ERROR: ead_seq was %s while GET /noop returned seq %s", after['ead_seq'], seqs[2]);
+
+  const latency = 'ead_http_request_duration_seconds';
+  const labels = 'method="GET",route="/noop"';
+  check(after[latency + '_bucket{' + labels + ',le="+Inf"}'] == after[latency + '_count{' + labels + '}'], "ERROR: %s +Inf bucket differs from its count", latency);
+  check(after[latency + '_count{' + labels + '}'] == after[noop], "ERROR: %s count differs from %s", latency, noop);
+});
@@ -0,0 +1,53 @@
+#!/usr/bin/env node
+
+// GETs are built from a read model that is published after each change to the back end:
+// once a step has been answered, GETs report its seq, and a GET racing a step reports the seq
+// from before it or after it, never anything else. Steps here are on 2025-07-10 (local time);
+// each test file that steps uses a later day than the one before it in the Makefile.
+
+const bent = require('bent');
+const {baseurl, stepbody, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const put = bent(baseurl, 'PUT', 'json');
+
+const day = new Date(2025, 6, 10).getTime() / 1000;
+
+test('read model', async () => {
+  const domain = await get('/subjects?compact=1');
+  const subjects = domain.subjects;
+
+  const stepped = await put('/ctrl/sampletimestep', stepbody(subjects, day));
+  if (!(stepped.seq > domain.seq)) {
+    console.log("ERROR: step returned seq %s, not after %s", stepped.seq, domain.seq);
+    process.exitCode++;
+  }
+  const after = await get('/subjects');
+  if (after.seq < stepped.seq) {
+    console.log("ERROR: GET after a step returned seq %s, older than the step's %s", after.seq, stepped.seq);
+    process.exitCode++;
+  }
+  for (const subject of after.subjects) {
+    for (const rulekit of subject.rulekits) {
+      if (rulekit.krono.key == 0 && rulekit.krono.error) {
+        console.log("ERROR: rule kit %d with no realtime krono reported error %s", rulekit.key, rulekit.krono.error);
+        process.exitCode++;
+      }
+    }
+  }
+
+  // GETs racing a step see one model or the other
+  const racing = [];
+  for (let i = 0; i < 8; i++)
+    racing.push(get('/subjects?compact=1'));
+  const step = put('/ctrl/sampletimestep', stepbody(subjects, day + 60));
+  const replies = await Promise.all(racing);
+  const stepped2 = await step;
+  for (const r of replies) {
+    if (r.seq != after.seq && r.seq != stepped2.seq) {
+      console.log("ERROR: GET racing a step returned seq %s, neither %s nor %s", r.seq, after.seq, stepped2.seq);
+      process.exitCode++;
+    }
+  }
+  console.log("INFO: %d GETs racing a step saw seqs %o", replies.length, [...new Set(replies.map((r) => r.seq))]);
+});
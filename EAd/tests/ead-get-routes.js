@@ -0,0 +1,32 @@
+#!/usr/bin/env node
+
+// Every documented GET and PUT path is found in the route tables, with or without a /vN prefix,
+// and a path that is not there is answered 501 with an error. Routes are only probed here, so
+// a route may still turn a request down (400) for want of a key; it must not be 501.
+
+const {rawrequest, check, test} = require('./common.js');
+
+const json = {'Content-Type': 'application/json'};
+
+test('routes', async () => {
+  const gets = ['/apiver', '/api', '/noop', '/v1/noop', '/v3/noop', '/domain', '/casekeys', '/casecounts',
+                '/case', '/cases', '/featurekeys', '/feature', '/features', '/krono', '/subjectkeys',
+                '/subjects', '/subject', '/alerts', '/batch?keys=', '/metrics', '/debug/trace'];
+  for (const uri of gets) {
+    const r = await rawrequest('GET', uri);
+    check(r.status != 501 && r.status != 404, "ERROR: GET %s returned status %s", uri, r.status);
+  }
+
+  const unknown = await rawrequest('GET', '/no/such/path');
+  check(unknown.status == 501, "ERROR: GET of an unknown path returned status %s, not 501", unknown.status);
+  check(unknown.status == 501 && JSON.parse(unknown.body).error, "ERROR: GET of an unknown path returned no error");
+
+  // An empty body is turned down by each PUT route itself, not by the dispatcher
+  const puts = ['/ctrl/sample', '/ctrl/answercase', '/set/knob', '/set/histogram/mode', '/set/histogram/span', '/ctrl/layout'];
+  for (const uri of puts) {
+    const r = await rawrequest('PUT', uri, json, '{}');
+    check(r.status != 501 && r.status != 404, "ERROR: PUT %s returned status %s", uri, r.status);
+  }
+  const unknownput = await rawrequest('PUT', '/set/no/such/thing', json, '{}');
+  check(unknownput.status == 501, "ERROR: PUT of an unknown path returned status %s, not 501", unknownput.status);
+});
@@ -0,0 +1,53 @@
+#!/usr/bin/env node
+
+// With "since" (a seq), GET /subjects, /features and /cases list only what changed after it,
+// and /cases also lists the keys of cases removed after it. The day of testdata is ingested
+// first so that cases are open; this runs before any test stepping on a later day.
+
+const bent = require('bent');
+const fs = require('fs');
+const path = require('path');
+const {baseurl, rawput, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const put = bent(baseurl, 'PUT', 'json');
+
+const datafile = path.join(__dirname, 'testdata', 'ibal_ahu2Fault_250709_si.csv');
+
+test('since', async () => {
+  const before = await get('/subjects?compact=1');
+  const ingested = await rawput('/ctrl/ingest', fs.readFileSync(datafile), 'text/csv');
+  check(ingested.reply.steps == 1440 && ingested.reply.failed == 0, "ERROR: ingest of %s ran %s steps with %s failed: %o", datafile, ingested.reply.steps, ingested.reply.failed, ingested.reply.errors);
+
+  const changed = await get('/subjects?compact=1&since=' + before.seq);
+  check(changed.since == before.seq, "ERROR: GET /subjects?since=%s echoed since %s", before.seq, changed.since);
+  check((changed.subjects || []).length > 0, "ERROR: GET /subjects?since=%s after a day of steps listed no subjects", before.seq);
+  const unchanged = await get('/subjects?compact=1&since=' + changed.seq);
+  check((unchanged.subjects || []).length == 0, "ERROR: GET /subjects?since=%s at that seq listed %d subjects", changed.seq, (unchanged.subjects || []).length);
+
+  let target = null;
+  for (const s of before.subjects) {
+    const features = await get('/features?compact=1&subject=' + s.key + '&since=' + changed.seq);
+    check(features.since == changed.seq && features.features.length == 0, "ERROR: GET /features?since=%s at that seq listed %d features of subject %s", changed.seq, features.features.length, s.key);
+    const cases = await get('/cases?subject=' + s.key + '&since=' + before.seq);
+    check(cases.since == before.seq && Array.isArray(cases.removed), "ERROR: GET /cases?since=%s for subject %s echoed since %s with removed %o", before.seq, s.key, cases.since, cases.removed);
+    for (const c of cases.cases) {
+      const answer = (c.options || []).indexOf("Delete this case.");
+      if (target === null && answer >= 0)
+        target = {'subject': s.key, 'case': c.key, 'answer': answer};
+    }
+  }
+  if (target === null) {
+    console.log("WARNING: no case open after ingesting %s, so removal was not tested", datafile);
+    return;
+  }
+
+  const answered = await put('/ctrl/answercase', {'case': target.case, 'answer': target.answer});
+  check(answered.success, "ERROR: answering case %s with option %s returned %s", target.case, target.answer, answered.returncode);
+  const after = await get('/cases?compact=1&subject=' + target.subject + '&since=' + changed.seq);
+  check(!after.full, "ERROR: GET /cases?since=%s, taken just before the answer, sent the full list", changed.seq);
+  check((after.removed || []).includes(target.case), "ERROR: GET /cases?since=%s did not list deleted case %s as removed: %o", changed.seq, target.case, after.removed);
+  check(!after.cases.some((c) => c.key == target.case), "ERROR: GET /cases?since=%s still listed deleted case %s", changed.seq, target.case);
+  const later = await get('/cases?compact=1&subject=' + target.subject + '&since=' + after.seq);
+  check(!later.removed.includes(target.case), "ERROR: GET /cases?since=%s listed case %s, deleted before it, as removed", after.seq, target.case);
+});
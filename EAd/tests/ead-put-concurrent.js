@@ -0,0 +1,37 @@
+#!/usr/bin/env node
+
+// Every call into libEA runs on one engine thread, fed by a queue, so PUTs sent all at once are
+// each run exactly once, one after another: each adds one to seq, and none is lost or fails
+// for want of a lock. GETs sent alongside them are answered from the read model meanwhile.
+// Steps here are on 2025-07-19 (local time).
+
+const bent = require('bent');
+const {baseurl, stepbody, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const put = bent(baseurl, 'PUT', 'json');
+
+const day = new Date(2025, 6, 19).getTime() / 1000;
+const count = 20;
+
+test('concurrent', async () => {
+  const before = await get('/subjects?compact=1');
+  const puts = [];
+  const gets = [];
+  for (let i = 0; i < count; i++) {
+    puts.push(put('/ctrl/sampletimestep', stepbody(before.subjects, day + 60 * i)));
+    gets.push(get('/noop'));
+  }
+  const stepped = await Promise.all(puts);
+  const got = await Promise.all(gets);
+
+  for (const r of stepped) {
+    check(r.returncode == "OKAY_allDone", "ERROR: concurrent step returned %s", r.returncode);
+    check(r.seq > before.seq && r.seq <= before.seq + count, "ERROR: concurrent step returned seq %s, outside %s to %s", r.seq, before.seq + 1, before.seq + count);
+  }
+  for (const r of got)
+    check(r.seq >= before.seq && r.seq <= before.seq + count, "ERROR: GET during the steps returned seq %s, outside %s to %s", r.seq, before.seq, before.seq + count);
+  const after = await get('/subjects?compact=1');
+  check(after.seq == before.seq + count, "ERROR: %d concurrent steps moved seq from %s to %s", count, before.seq, after.seq);
+  check(Math.max(...stepped.map((r) => r.seq)) == after.seq, "ERROR: latest concurrent step returned seq %s, not %s", Math.max(...stepped.map((r) => r.seq)), after.seq);
+});
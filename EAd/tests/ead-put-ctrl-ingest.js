@@ -0,0 +1,49 @@
+#!/usr/bin/env node
+
+// PUT /ctrl/ingest runs many timesteps from one body, NDJSON by default or CSV, in batches.
+// A bad line is reported by line number and skipped; the rest still run. Steps here are on
+// 2025-07-15 (local time).
+
+const bent = require('bent');
+const {baseurl, rawput, stepbody, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+
+const day = new Date(2025, 6, 15).getTime() / 1000;
+
+test('ingest', async () => {
+  const domain = await get('/subjects?compact=1');
+  const subjects = domain.subjects;
+
+  // NDJSON, with a bad third line, run in batches of 2
+  const lines = [];
+  for (let i = 0; i < 5; i++)
+    lines.push(JSON.stringify(stepbody(subjects, day + 60 * i)));
+  lines.splice(2, 0, '{"time": "not a step"}');
+  const nd = await rawput('/ctrl/ingest?batch=2', lines.join('\n') + '\n', 'application/x-ndjson');
+  check(nd.status == 200, "ERROR: NDJSON ingest returned status %s", nd.status);
+  check(nd.reply.steps == 5 && nd.reply.failed == 1, "ERROR: NDJSON ingest ran %s steps with %s failed, not 5 and 1", nd.reply.steps, nd.reply.failed);
+  check(nd.reply.errors.length == 1 && nd.reply.errors[0].line == 3, "ERROR: NDJSON ingest reported errors %o, not one on line 3", nd.reply.errors);
+  check(nd.reply.seq > domain.seq, "ERROR: NDJSON ingest returned seq %s, not after %s", nd.reply.seq, domain.seq);
+
+  // CSV in the layout of testdata: date, time, ground truth code, then each subject's points
+  const rows = ['Date,Time,GTC'];
+  for (let i = 10; i < 15; i++) {
+    const values = [];
+    for (const s of subjects)
+      values.push(...s.points.map(() => 50.0));
+    rows.push('2025/07/15,0:' + i + ',0,' + values.join(','));
+  }
+  const csv = await rawput('/ctrl/ingest', rows.join('\r\n'), 'text/csv');
+  check(csv.status == 200, "ERROR: CSV ingest returned status %s", csv.status);
+  check(csv.reply.steps == 5 && csv.reply.failed == 0, "ERROR: CSV ingest ran %s steps with %s failed, not 5 and 0: %o", csv.reply.steps, csv.reply.failed, csv.reply.errors);
+  check(csv.reply.returncode == "OKAY_allDone", "ERROR: CSV ingest returned returncode %s", csv.reply.returncode);
+  const after = await get('/subjects?compact=1');
+  check(after.seq >= csv.reply.seq, "ERROR: GET after ingest returned seq %s, older than the ingest's %s", after.seq, csv.reply.seq);
+
+  const short = await rawput('/ctrl/ingest?format=csv', '2025/07/15,0:20,0,50.0\n', 'text/plain');
+  check(short.reply.failed == 1 && short.reply.steps == 0, "ERROR: CSV row with too few columns ran %s steps with %s failed", short.reply.steps, short.reply.failed);
+
+  const unknown = await rawput('/ctrl/ingest?format=xml', '<step/>', 'text/xml');
+  check(unknown.status == 400 && unknown.reply.error, "ERROR: ingest of an unknown format returned status %s", unknown.status);
+});
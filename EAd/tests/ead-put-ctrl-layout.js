@@ -0,0 +1,63 @@
+#!/usr/bin/env node
+
+// PUT /ctrl/layout registers named columns, each mapped to a subject's point by name or channel
+// (or skipped, with no subject), and returns an id that sampletimestep and ingest then take in
+// place of values_by_subject. The same columns registered again get the same id; a layout that
+// leaves a point unfed, or feeds one twice, is turned down. Steps here are on 2025-07-22 (local
+// time).
+
+const bent = require('bent');
+const {baseurl, rawput, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+const put = bent(baseurl, 'PUT', 'json');
+const putany = bent(baseurl, 'PUT', 'json', 200, 400);
+
+const day = new Date(2025, 6, 22).getTime() / 1000;
+
+// Each subject's channel 0 by number and the rest by point name, last point first, then a
+// column fed to nothing
+function layoutcolumns(subjects) {
+  const columns = [];
+  for (const s of subjects) {
+    columns.push({'name': s.key + '.0', 'subject': s.key, 'channel': 0});
+    for (let i = s.points.length - 1; i > 0; i--)
+      columns.push({'name': s.key + '.' + i, 'subject': s.key, 'point': s.points[i]});
+  }
+  columns.push({'name': 'note'});
+  return columns;
+}
+
+test('layout', async () => {
+  const domain = await get('/subjects?compact=1');
+  const subjects = domain.subjects;
+  const columns = layoutcolumns(subjects);
+
+  const registered = await put('/ctrl/layout', {'columns': columns});
+  check(registered.layout > 0 && registered.columns == columns.length, "ERROR: layout of %d columns registered as %s with %s columns", columns.length, registered.layout, registered.columns);
+  check(registered.subjects.length == subjects.length, "ERROR: layout over %d subjects lists %d", subjects.length, registered.subjects.length);
+  const again = await put('/ctrl/layout', {'columns': columns});
+  check(again.layout == registered.layout, "ERROR: same layout registered again got id %s, not %s", again.layout, registered.layout);
+
+  const unfed = await putany('/ctrl/layout', {'columns': columns.filter((c) => c.name != subjects[0].key + '.1')});
+  check(unfed.error && unfed.layout === undefined, "ERROR: layout leaving a point unfed returned no error");
+  const twice = await putany('/ctrl/layout', {'columns': columns.concat([{'name': 'again', 'subject': subjects[0].key, 'channel': 0}])});
+  check(twice.error && twice.layout === undefined, "ERROR: layout feeding a channel twice returned no error");
+
+  // Values in layout order: 50 for each point, then the skipped column
+  const values = columns.map((c) => c.subject === undefined ? -1.0 : 50.0);
+  const stepped = await put('/ctrl/sampletimestep', {'layout': registered.layout, 'time': day, 'values': values});
+  check(stepped.returncode == "OKAY_allDone", "ERROR: step in layout %s returned %s", registered.layout, stepped.returncode);
+  const short = await putany('/ctrl/sampletimestep', {'layout': registered.layout, 'time': day + 60, 'values': values.slice(1)});
+  check(short.error, "ERROR: step in layout %s with a value short returned no error", registered.layout);
+
+  const lines = [1, 2, 3].map((i) => JSON.stringify({'time': day + 60 * i, 'values': values}));
+  const nd = await rawput('/ctrl/ingest?layout=' + registered.layout, lines.join('\n'), 'application/x-ndjson');
+  check(nd.reply.steps == 3 && nd.reply.failed == 0, "ERROR: NDJSON ingest in layout %s ran %s steps with %s failed: %o", registered.layout, nd.reply.steps, nd.reply.failed, nd.reply.errors);
+  const rows = [4, 5, 6].map((i) => '2025/07/22,0:0' + i + ',' + values.join(','));
+  const csv = await rawput('/ctrl/ingest?format=csv&layout=' + registered.layout, rows.join('\n'), 'text/csv');
+  check(csv.reply.steps == 3 && csv.reply.failed == 0, "ERROR: CSV ingest in layout %s ran %s steps with %s failed: %o", registered.layout, csv.reply.steps, csv.reply.failed, csv.reply.errors);
+
+  const unknown = await rawput('/ctrl/ingest?layout=999999', lines[0], 'application/x-ndjson');
+  check(unknown.status == 400 && unknown.reply.error, "ERROR: ingest in an unknown layout returned status %s", unknown.status);
+});
@@ -0,0 +1,89 @@
+#!/usr/bin/env node
+
+// PUT /ctrl/ingest?format=protobuf takes a stream of length-delimited SampleTimeStep messages
+// (protobuf/ingest.proto), here encoded by hand so the test needs no protobuf library. A message
+// cut short at the end of the body is reported, and the steps before it still run; a length that
+// cannot be read or is too large is refused with 400 at its byte offset. Steps here
+// are on 2025-07-16 (local time). The gRPC service (--grpc-ingest) is off by default and is not
+// tested here.
+
+const bent = require('bent');
+const {baseurl, rawput, check, test} = require('./common.js');
+
+const get = bent(baseurl, 'GET', 'json');
+
+const day = new Date(2025, 6, 16).getTime() / 1000;
+
+// Protobuf wire format, for non-negative integers below 2^53
+function varint(n) {
+  const bytes = [];
+  while (n >= 128) {
+    bytes.push((n % 128) + 128);
+    n = Math.floor(n / 128);
+  }
+  bytes.push(n);
+  return Buffer.from(bytes);
+}
+
+function field(number, wiretype) {
+  return varint(number * 8 + wiretype);
+}
+
+function delimited(number, body) {
+  return Buffer.concat([field(number, 2), varint(body.length), body]);
+}
+
+// Values are packed, as protoc writes them, unless asked for unpacked (which decoders also take)
+function encodestep(subjects, t, unpacked) {
+  const parts = [field(1, 0), varint(t)];
+  for (const s of subjects) {
+    const values = s.points.map(() => {
+      const b = Buffer.alloc(8);
+      b.writeDoubleLE(50.0);
+      return b;
+    });
+    const encoded = unpacked ? Buffer.concat(values.map((b) => Buffer.concat([field(2, 1), b]))) : delimited(2, Buffer.concat(values));
+    parts.push(delimited(2, Buffer.concat([field(1, 0), varint(s.key), encoded])));
+  }
+  const step = Buffer.concat(parts);
+  return Buffer.concat([varint(step.length), step]);
+}
+
+test('protobuf ingest', async () => {
+  const domain = await get('/subjects?compact=1');
+  const subjects = domain.subjects;
+
+  const messages = [];
+  for (let i = 0; i < 4; i++)
+    messages.push(encodestep(subjects, day + 60 * i, i == 3));
+  const pb = await rawput('/ctrl/ingest', Buffer.concat(messages), 'application/x-protobuf');
+  check(pb.status == 200, "ERROR: protobuf ingest returned status %s", pb.status);
+  check(pb.reply.steps == 4 && pb.reply.failed == 0, "ERROR: protobuf ingest ran %s steps with %s failed, not 4 and 0: %o", pb.reply.steps, pb.reply.failed, pb.reply.errors);
+  check(pb.reply.seq > domain.seq, "ERROR: protobuf ingest returned seq %s, not after %s", pb.reply.seq, domain.seq);
+
+  // Last message cut short
+  const next = encodestep(subjects, day + 600);
+  const cut = Buffer.concat([encodestep(subjects, day + 540), next.subarray(0, next.length - 5)]);
+  const truncated = await rawput('/ctrl/ingest?format=protobuf', cut, 'application/octet-stream');
+  check(truncated.reply.steps == 1 && truncated.reply.failed == 1, "ERROR: protobuf ingest with a truncated message ran %s steps with %s failed, not 1 and 1", truncated.reply.steps, truncated.reply.failed);
+  check(truncated.reply.errors.length == 1 && truncated.reply.errors[0].line == 2, "ERROR: protobuf ingest reported errors %o, not one on message 2", truncated.reply.errors);
+
+  // Length prefix that never ends, and one over the maximum message size: each is a framing
+  // error at the byte where the prefix starts, and the step before it still runs
+  const first = encodestep(subjects, day + 660);
+  const unending = Buffer.concat([first, Buffer.alloc(12, 0xff)]);
+  const badprefix = await rawput('/ctrl/ingest?format=protobuf', unending, 'application/x-protobuf');
+  check(badprefix.status == 400, "ERROR: protobuf ingest with an unending length prefix returned status %s, not 400", badprefix.status);
+  check(badprefix.reply.error && badprefix.reply.error.endsWith(' at byte ' + first.length), "ERROR: protobuf ingest with an unending length prefix reported %o, not at byte %d", badprefix.reply.error, first.length);
+  check(badprefix.reply.steps == 1, "ERROR: protobuf ingest with an unending length prefix ran %s steps, not 1", badprefix.reply.steps);
+
+  const second = encodestep(subjects, day + 720);
+  const oversized = Buffer.concat([second, varint(16 * 1024 * 1024 + 1), Buffer.alloc(16)]);
+  const toolong = await rawput('/ctrl/ingest?format=protobuf', oversized, 'application/x-protobuf');
+  check(toolong.status == 400, "ERROR: protobuf ingest of an oversized message returned status %s, not 400", toolong.status);
+  check(toolong.reply.error && toolong.reply.error.startsWith('message length ') && toolong.reply.error.endsWith(' at byte ' + second.length), "ERROR: protobuf ingest of an oversized message reported %o, not its length at byte %d", toolong.reply.error, second.length);
+  check(toolong.reply.steps == 1, "ERROR: protobuf ingest of an oversized message ran %s steps, not 1", toolong.reply.steps);
+
+  const nolayout = await rawput('/ctrl/ingest?format=protobuf&layout=1', Buffer.concat(messages), 'application/x-protobuf');
+  check(nolayout.status == 400, "ERROR: protobuf ingest with a layout returned status %s, not 400", nolayout.status);
+});
@@ -0,0 +1,133 @@
+/*
+ * tracing.cpp
+ *
+ * Per-request span tracing, kept in a ring and dumped as Chrome trace-event JSON (see tracing.hpp)
+ */
+
+#include "tracing.hpp"
+#include "stdafx.h"
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+// The trace of the request the calling thread is handling, if any
+static thread_local tracer::trace * current_trace = nullptr;
+
+tracer::tracer(size_t capacity) : config{0, 0}, epoch(clock::now()), nextid(1), ring(capacity), ringnext(0)
+{
+}
+
+void tracer::configure(const tracing_config & c) {
+   config = c;
+}
+
+tracer::trace * tracer::current(void) {
+   return current_trace;
+}
+
+// Add a span to a trace. From the request's own thread, or from the engine thread while the
+// request is blocked waiting for its command, so never from two threads at once.
+void tracer::add(trace * t, const char * name, clock::time_point begin, clock::time_point end) {
+   t->spans.push_back(span{name, begin, end});
+}
+
+tracer::request::request(tracer & owner, const char * method) : owner(owner), outer(current_trace)
+{
+   if (owner.config.sample_every == 0 && owner.config.slow_ms == 0)
+      return;
+   t.reset(new trace());
+   t->id = owner.nextid.fetch_add(1, std::memory_order_relaxed);
+   t->method = method;
+   t->status = 200;
+   t->spans.reserve(TRACE_RESERVED_SPANS);
+   t->begin = clock::now();
+   current_trace = t.get();
+}
+
+tracer::request::~request()
+{
+   if (!t)
+      return;
+   current_trace = outer;
+   t->end = clock::now();
+   owner.finish(std::move(t));
+}
+
+//
+// Keep a finished trace if it is sampled or slow, and log the breakdown of a slow one
+//
+void tracer::finish(std::unique_ptr<trace> t) {
+   auto ms = [](clock::time_point begin, clock::time_point end) {
+      return std::chrono::duration<double, std::milli>(end - begin).count();
+   };
+   // Phases are added as they end, so an outer one follows those inside it; put them in start order
+   std::stable_sort(t->spans.begin(), t->spans.end(), [](const span & a, const span & b) { return a.begin < b.begin; });
+   const double total = ms(t->begin, t->end);
+   const bool slow = config.slow_ms > 0 && total >= config.slow_ms;
+   const bool sampled = config.sample_every > 0 && t->id % config.sample_every == 0;
+   if (slow) {
+      std::ostringstream msg;
+      msg << std::fixed << std::setprecision(1);
+      msg << "Slow request #" << t->id << ": " << t->method << " " << t->path << " " << t->status << " took " << total << " ms (";
+      for (size_t i = 0; i < t->spans.size(); i++)
+         msg << (i ? ", " : "") << t->spans[i].name << " " << ms(t->spans[i].begin, t->spans[i].end);
+      msg << ")";
+      ucout << msg.str() << std::endl;
+   }
+   if (!slow && !sampled)
+      return;
+   std::shared_ptr<const trace> kept(std::move(t));
+   std::lock_guard<std::mutex> guard(ringlock);
+   ring[ringnext] = std::move(kept);
+   ringnext = (ringnext + 1) % ring.size();
+}
+
+//
+// The ring, oldest first, in the Chrome trace-event format. Each request gets its own track
+// (tid), named for it, holding the request as one complete event with its phases nested under.
+// Times are microseconds since the tracer started.
+//
+void tracer::write_chrome(std::ostream & os) const {
+   std::vector<std::shared_ptr<const trace>> traces;
+   {
+      std::lock_guard<std::mutex> guard(ringlock);
+      for (size_t i = 0; i < ring.size(); i++) {
+         auto const & t = ring[(ringnext + i) % ring.size()];
+         if (t)
+            traces.push_back(t);
+      }
+   }
+   auto us = [this](clock::time_point at) {
+      return std::chrono::duration<double, std::micro>(at - epoch).count();
+   };
+   auto quoted = [](const std::string & s) {
+      std::string q = "\"";
+      for (char c : s) {
+         if (c == '"' || c == '\\')
+            q += '\\';
+         if ((unsigned char) c >= 0x20)
+            q += c;
+      }
+      return q + "\"";
+   };
+   auto event = [&](const char * cat, const std::string & name, uint64_t tid, clock::time_point begin, clock::time_point end) {
+      os << ",\n{\"name\":" << quoted(name) << ",\"cat\":\"" << cat << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+         << ",\"ts\":" << us(begin) << ",\"dur\":" << us(end) - us(begin);
+   };
+
+   os << std::fixed << std::setprecision(3);
+   os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+   os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"EAd\"}}";
+   for (auto const & t : traces) {
+      std::string name = std::string(t->method) + " " + t->path;
+      os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << t->id
+         << ",\"args\":{\"name\":" << quoted("#" + std::to_string(t->id) + " " + name) << "}}";
+      event("request", name, t->id, t->begin, t->end);
+      os << ",\"args\":{\"status\":" << t->status << "}}";
+      for (auto const & s : t->spans) {
+         event("phase", s.name, t->id, s.begin, s.end);
+         os << "}";
+      }
+   }
+   os << "\n]}\n";
+}
@@ -0,0 +1,107 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#define TRACE_RESERVED_SPANS 8
+
+// Which requests are traced. A request is kept if it is one of every sample_every requests, or
+// if it took at least slow_ms, in which case its breakdown is also logged. 0 turns either off;
+// with both off, no trace is even started.
+struct tracing_config
+{
+   unsigned int sample_every;
+   unsigned int slow_ms;
+};
+
+//
+// Per-request latency breakdown. A request is traced from arrival to reply on the thread that
+// handles it, which names itself current while it does; each phase (extract_json, the route,
+// waiting for the engine thread, the engine command, serialize, gzip, reply) adds a span to the
+// current trace, or does nothing if there is none. Finished traces that are sampled or slow go
+// into a ring of the latest ones, which GET /debug/trace dumps as Chrome trace-event JSON (load
+// it in chrome://tracing or Perfetto).
+//
+// The trace is only ever touched by one thread at a time: the request's own, or the engine
+// thread while the request waits on its command, so spans need no lock. The ring's mutex is
+// taken only to keep a finished trace and to dump the ring.
+//
+class tracer
+{
+   public:
+      typedef std::chrono::steady_clock clock;
+
+      struct span
+      {
+         const char * name;
+         clock::time_point begin;
+         clock::time_point end;
+      };
+
+      struct trace
+      {
+         uint64_t id;
+         const char * method;
+         std::string path;
+         unsigned int status;
+         clock::time_point begin;
+         clock::time_point end;
+         std::vector<span> spans;
+      };
+
+      // Traces the request handled on the calling thread, from construction to destruction
+      class request
+      {
+         public:
+            request(tracer &, const char *);     // method
+            ~request();
+            void at(const std::string & path) { if (t) t->path = path; }
+            void status(unsigned int code) { if (t) t->status = code; }
+
+         private:
+            tracer & owner;
+            std::unique_ptr<trace> t;
+            trace * outer;                       // current before this one, restored after
+      };
+
+      // Times one phase of the request traced on the calling thread, if there is one
+      class phase
+      {
+         public:
+            explicit phase(const char * name) : t(current()), name(name) { if (t) begin = clock::now(); }
+            ~phase() { if (t) add(t, name, begin, clock::now()); }
+
+         private:
+            trace * t;
+            const char * name;
+            clock::time_point begin;
+      };
+
+      explicit tracer(size_t);     // ring capacity
+      void configure(const tracing_config &);   // before requests are served
+
+      static trace * current(void);
+      static void add(trace *, const char *, clock::time_point, clock::time_point);
+      void write_chrome(std::ostream &) const;
+
+   private:
+      void finish(std::unique_ptr<trace>);
+
+      tracing_config config;
+      clock::time_point epoch;
+      std::atomic<uint64_t> nextid;
+
+      mutable std::mutex ringlock;
+      std::vector<std::shared_ptr<const trace>> ring;
+      size_t ringnext;
+};
+
+#endif // TRACING_H
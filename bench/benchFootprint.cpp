@@ -0,0 +1,132 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Benchmark of per-VAV memory footprint.  For each N (default N = 10, 100, 1000), an engine having one
+   AHU and N VAV Tools (CTool_vav_ibal) is built in a forked child process, in its own scratch directory.
+   Resident bytes added per VAV are reported, along with a per-VAV breakdown from the engine's memory
+   census (CApplication::SayMemoryCensus()).  "other" is the resident bytes the census does not cover
+   (Subject, point, fact, and rule objects themselves, knowledge bases, registries, allocator overhead).
+   The AHU and its built-in antecedents are built before the baseline reading, so are not counted.
+   Usage:  bin/benchFootprint [N ...]      (run from any writable directory)
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "tool.hpp"
+#include "HDF5Parts.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+static long long SayResidentBytes( void ) {
+
+   long long pagesTotal = 0;
+   long long pagesResident = 0;
+   std::ifstream statm( "/proc/self/statm" );
+   statm >> pagesTotal >> pagesResident;
+   return ( pagesResident * sysconf( _SC_PAGESIZE ) );
+}
+
+
+static std::string SayTopologyText( size_t numVavs ) {
+
+   std::string text = "ahu_ibal, AHU-1, 1, CHW Plant, HW PlantSim\n";
+   if ( numVavs > 0 ) {
+      text += "vav_ibal, VAV-, " + std::to_string( numVavs ) + ", AHU-1, HW PlantSim\n";
+   }
+   return text;
+}
+
+
+static int RunOneSize( size_t numVavs ) {
+
+   // Baseline is an engine of the AHU alone, so the difference is due only to the N VAVs
+   std::unique_ptr<CApplication> u_AppBase =
+      std::make_unique<CApplication>( CTopology::ReadFromText( SayTopologyText( 0 ) ) );
+   const MemoryCensus_t censusBase = u_AppBase->SayMemoryCensus();
+   u_AppBase.reset();
+
+   const long long bytesBefore = SayResidentBytes();
+   std::unique_ptr<CApplication> u_App =
+      std::make_unique<CApplication>( CTopology::ReadFromText( SayTopologyText( numVavs ) ) );
+   const long long bytesAfter = SayResidentBytes();
+   const MemoryCensus_t census = u_App->SayMemoryCensus();
+
+   const double n = static_cast<double>( numVavs );
+   auto KiBPerVav = [n]( size_t bytesNow, size_t bytesBase ) {
+      return ( ( static_cast<double>( bytesNow ) - static_cast<double>( bytesBase ) ) / 1024.0 / n );
+   };
+   const double kibResident = static_cast<double>( bytesAfter - bytesBefore ) / 1024.0 / n;
+   const double kibCensus = KiBPerVav( census.SayBytesTotal(), censusBase.SayBytesTotal() );
+
+   std::printf( "%6zu %10.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                  numVavs,
+                  kibResident,
+                  KiBPerVav( census.bytesRainfallLogs, censusBase.bytesRainfallLogs ),
+                  KiBPerVav( census.bytesSnapshotBanks, censusBase.bytesSnapshotBanks ),
+                  KiBPerVav( census.bytesHistograms, censusBase.bytesHistograms ),
+                  KiBPerVav( census.bytesKnobs, censusBase.bytesKnobs ),
+                  KiBPerVav( census.bytesTraces, censusBase.bytesTraces ),
+                  KiBPerVav( census.bytesStrings, censusBase.bytesStrings ),
+                  ( kibResident - kibCensus ) );
+   std::fflush( stdout );
+   return 0;
+}
+
+
+int main( int argc, char** argv ) {
+
+   std::vector<size_t> sizes;
+   for ( int i = 1; i < argc; ++i ) { sizes.push_back( std::strtoul( argv[i], nullptr, 10 ) ); }
+   if ( sizes.empty() ) { sizes = { 10, 100, 1000 }; }
+
+   H5Kit::CMuteHDF5ErrorHdlg muteHdf5;    // Each new knowledge base file otherwise logs "not found"
+
+   std::printf( "KiB per VAV (resident, then census breakdown)\n" );
+   std::printf( "%6s %10s %9s %9s %9s %9s %9s %9s %9s\n",
+                  "VAVs", "resident", "rainLogs", "snapshots", "histos", "knobs", "traces",
+                  "strings", "other" );
+   std::fflush( stdout );
+
+   const std::filesystem::path startDir = std::filesystem::current_path();
+
+   for ( size_t numVavs : sizes ) {
+
+      if ( numVavs == 0 ) { continue; }
+      const std::filesystem::path scratch = startDir / ( "benchFootprint_" + std::to_string( numVavs ) );
+      std::filesystem::remove_all( scratch );
+      std::filesystem::create_directory( scratch );
+
+      pid_t child = fork();
+      if ( child == 0 ) {
+         std::filesystem::current_path( scratch );
+         std::_Exit( RunOneSize( numVavs ) );
+      }
+      int status = 0;
+      waitpid( child, &status, 0 );
+      std::filesystem::remove_all( scratch );
+      if ( !WIFEXITED( status ) || ( WEXITSTATUS( status ) != 0 ) ) {
+         std::fprintf( stderr, "benchFootprint: run of %zu VAVs failed\n", numVavs );
+         return 1;
+      }
+   }
+   return 0;
+}
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
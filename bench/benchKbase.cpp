@@ -0,0 +1,148 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Benchmark of knowledge base (KB) formats.  For each number of nodes (default 500, 2000; at most 2000,
+   as HDF5 subgroup lookup holds 25 names per group) a KB of R rules x 10 hypos x 10 evids is built in
+   HDF5 format and in memory-mapped table format (EA_KBASE_FORMAT=mapped).  Reported per format: build
+   time, reopen time (KB startup), and time to pan and read every node.  The table KB is then exported
+   to HDF5, and the export reopened and read, to check it holds the same tallies.
+   Usage:  bin/benchKbase [numNodes ...]      (run from any writable directory)
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "knowBase.hpp"
+#include "HDF5Parts.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+const Nzint_t BENCH_HYPOS_PER_RULE = 10u;
+const Nzint_t BENCH_EVIDS_PER_HYPO = 10u;
+
+
+static double SayMsecsSince( std::chrono::steady_clock::time_point start ) {
+
+   return std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() - start ).count();
+}
+
+
+static void BuildKbase( const std::string& filename, Nzint_t numRules ) {
+
+   CKnowBaseH5 kbase( filename );
+   for ( Nzint_t r = 1; r <= numRules; ++r ) {
+      for ( Nzint_t h = 1; h <= BENCH_HYPOS_PER_RULE; ++h ) {
+         for ( Nzint_t e = 1; e <= BENCH_EVIDS_PER_HYPO; ++e ) {
+            kbase.PanCursorToNodeAt( r, h, e );
+            kbase.ReadCursorToImage();
+            for ( Nzint_t n = 0; n < ( ( r + h + e ) % 5u ); ++n ) { kbase.IncrementHypoTrueForEvid( e % 3u ); }
+            kbase.IncrementHypoFalseForEvid( h % 3u );
+            kbase.WriteImageToCursor();
+         }
+      }
+   }
+}
+
+
+static long long ReadAllNodes( CKnowBaseH5& kbaseRef, Nzint_t numRules ) {
+
+   long long checksum = 0;
+   for ( Nzint_t r = 1; r <= numRules; ++r ) {
+      for ( Nzint_t h = 1; h <= BENCH_HYPOS_PER_RULE; ++h ) {
+         for ( Nzint_t e = 1; e <= BENCH_EVIDS_PER_HYPO; ++e ) {
+            kbaseRef.PanCursorToNodeAt( r, h, e );
+            kbaseRef.ReadCursorToImage();
+            for ( size_t row = 0; row < 3; ++row ) {
+               checksum += ( kbaseRef.PriorCountsHypoTrueWhenEvid( row ) * ( row + 1 ) ) +
+                           ( kbaseRef.PriorCountsHypoFalseWhenEvid( row ) * ( row + 7 ) );
+            }
+         }
+      }
+   }
+   return checksum;
+}
+
+
+static long long RunOneFormat( const char* p_format, Nzint_t numRules ) {
+
+   setenv( "EA_KBASE_FORMAT", p_format, 1 );
+   const std::string filename = std::string( "bench_" ) + p_format + "_kbase.h5";
+
+   auto start = std::chrono::steady_clock::now();
+   BuildKbase( filename, numRules );
+   const double msecsBuild = SayMsecsSince( start );
+
+   start = std::chrono::steady_clock::now();
+   CKnowBaseH5 kbase( filename );
+   const double msecsOpen = SayMsecsSince( start );
+
+   start = std::chrono::steady_clock::now();
+   const long long checksum = ReadAllNodes( kbase, numRules );
+   const double msecsRead = SayMsecsSince( start );
+
+   std::printf( "%7u %-7s %10.1f %10.2f %10.2f %12lld\n",
+                  numRules * BENCH_HYPOS_PER_RULE * BENCH_EVIDS_PER_HYPO,
+                  p_format, msecsBuild, msecsOpen, msecsRead, checksum );
+
+   if ( std::string( p_format ) == "mapped" ) {
+      kbase.ExportToHdf5File( "bench_export_kbase.h5" );
+      setenv( "EA_KBASE_FORMAT", "hdf5", 1 );
+      CKnowBaseH5 kbaseExported( "bench_export_kbase.h5" );
+      const long long checksumExported = ReadAllNodes( kbaseExported, numRules );
+      std::printf( "%7s export to HDF5 %s\n", "", ( checksumExported == checksum ) ? "matches" : "DIFFERS" );
+   }
+   std::fflush( stdout );
+   return checksum;
+}
+
+
+int main( int argc, char** argv ) {
+
+   std::vector<size_t> sizes;
+   for ( int i = 1; i < argc; ++i ) { sizes.push_back( std::strtoul( argv[i], nullptr, 10 ) ); }
+   if ( sizes.empty() ) { sizes = { 500, 2000 }; }
+
+   H5Kit::CMuteHDF5ErrorHdlg muteHdf5;    // Each new knowledge base file otherwise logs "not found"
+
+   std::printf( "%7s %-7s %10s %10s %10s %12s\n",
+                  "nodes", "format", "build ms", "open ms", "read ms", "checksum" );
+
+   const std::filesystem::path startDir = std::filesystem::current_path();
+   int reply = 0;
+
+   for ( size_t numNodes : sizes ) {
+
+      const Nzint_t numRules = static_cast<Nzint_t>(
+         std::max<size_t>( 1u, numNodes / ( BENCH_HYPOS_PER_RULE * BENCH_EVIDS_PER_HYPO ) ) );
+      if ( numRules > 20u ) {
+         std::fprintf( stderr, "benchKbase: %zu nodes exceeds the 2000 an HDF5 KB can hold\n", numNodes );
+         return 1;
+      }
+      const std::filesystem::path scratch = startDir / ( "benchKbase_" + std::to_string( numNodes ) );
+      std::filesystem::remove_all( scratch );
+      std::filesystem::create_directory( scratch );
+      std::filesystem::current_path( scratch );
+
+      const long long checksumHdf5 = RunOneFormat( "hdf5", numRules );
+      const long long checksumMapped = RunOneFormat( "mapped", numRules );
+      if ( checksumHdf5 != checksumMapped ) { reply = 1; }
+
+      std::filesystem::current_path( startDir );
+      std::filesystem::remove_all( scratch );
+   }
+   return reply;
+}
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
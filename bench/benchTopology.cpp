@@ -0,0 +1,126 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Benchmark of EA engine construction from a topology of N Subjects (default N = 10, 100, 1000).  Each N
+   is built in a forked child process, in its own scratch directory (each Subject writes an HDF5 knowledge
+   base file), so resident memory and static name tables of one N cannot carry over into the next.
+   Usage:  bin/benchTopology [N ...]      (run from any writable directory)
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "tool.hpp"
+#include "HDF5Parts.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+static long long SayResidentBytes( void ) {
+
+   long long pagesTotal = 0;
+   long long pagesResident = 0;
+   std::ifstream statm( "/proc/self/statm" );
+   statm >> pagesTotal >> pagesResident;
+   return ( pagesResident * sysconf( _SC_PAGESIZE ) );
+}
+
+
+static std::string SayTopologyText( size_t numSubjects ) {
+
+   // One AHU (built-in antecedents) serving N-1 VAVs, so the count of Subjects is exactly N
+   std::string text = "ahu_ibal, AHU-1, 1, CHW Plant, HW PlantSim\n";
+   if ( numSubjects > 1 ) {
+      text += "vav_ibal, VAV-, " + std::to_string( numSubjects - 1 ) + ", AHU-1, HW PlantSim\n";
+   }
+   return text;
+}
+
+
+static int RunOneSize( size_t numSubjects ) {
+
+   typedef std::chrono::steady_clock  Clock_t;
+
+   CTopology topology = CTopology::ReadFromText( SayTopologyText( numSubjects ) );
+
+   const long long bytesBefore = SayResidentBytes();
+   const Clock_t::time_point start = Clock_t::now();
+
+   std::unique_ptr<CApplication> u_App = std::make_unique<CApplication>( topology );
+
+   const Clock_t::time_point built = Clock_t::now();
+   const long long bytesAfter = SayResidentBytes();
+
+   u_App.reset();
+   const Clock_t::time_point destroyed = Clock_t::now();
+
+   const double msBuild = std::chrono::duration<double, std::milli>( built - start ).count();
+   const double msDestroy = std::chrono::duration<double, std::milli>( destroyed - built ).count();
+   const double kbResident = static_cast<double>( bytesAfter - bytesBefore ) / 1024.0;
+
+   std::printf( "%8zu %12.1f %12.3f %12.1f %14.0f %12.1f\n",
+                  numSubjects,
+                  msBuild,
+                  ( msBuild / numSubjects ),
+                  msDestroy,
+                  kbResident,
+                  ( kbResident / numSubjects ) );
+   std::fflush( stdout );
+   return 0;
+}
+
+
+int main( int argc, char** argv ) {
+
+   std::vector<size_t> sizes;
+   for ( int i = 1; i < argc; ++i ) { sizes.push_back( std::strtoul( argv[i], nullptr, 10 ) ); }
+   if ( sizes.empty() ) { sizes = { 10, 100, 1000 }; }
+
+   H5Kit::CMuteHDF5ErrorHdlg muteHdf5;    // Each new knowledge base file otherwise logs "not found"
+
+   std::printf( "%8s %12s %12s %12s %14s %12s\n",
+                  "subjects", "build ms", "ms/subject", "destroy ms", "RSS delta KiB", "KiB/subject" );
+   std::fflush( stdout );
+
+   const std::filesystem::path startDir = std::filesystem::current_path();
+
+   for ( size_t numSubjects : sizes ) {
+
+      if ( numSubjects == 0 ) { continue; }
+      const std::filesystem::path scratch = startDir / ( "benchTopology_" + std::to_string( numSubjects ) );
+      std::filesystem::remove_all( scratch );
+      std::filesystem::create_directory( scratch );
+
+      pid_t child = fork();
+      if ( child == 0 ) {
+         std::filesystem::current_path( scratch );
+         std::_Exit( RunOneSize( numSubjects ) );
+      }
+      int status = 0;
+      waitpid( child, &status, 0 );
+      std::filesystem::remove_all( scratch );
+      if ( !WIFEXITED( status ) || ( WEXITSTATUS( status ) != 0 ) ) {
+         std::fprintf( stderr, "benchTopology: run of %zu subjects failed\n", numSubjects );
+         return 1;
+      }
+   }
+   return 0;
+}
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -18,6 +18,7 @@ See the License for the specific language governing permissions and limitations
 
 #include "HDF5Parts.hpp"
 
+#include <algorithm>
 #include <array>
 #include <cerrno>
 #include <cstring>
@@ -30,6 +31,13 @@ See the License for the specific language governing permissions and limitations
 // File created 
 
 
+bool H5Kit::IsNameAnHdf5File( const std::string& name ) {
+
+   // htri_t: <0 = fail or filename doesn't exist, 0 = filename exists but not HDF5, >0 = true
+   return ( H5Fis_hdf5( name.c_str() ) > 0 );
+}
+
+
 H5Kit::CFileCreatedIffAbsent::CFileCreatedIffAbsent( const std::string& name )
                                                      :   id (-1),
                                                          namePreexistsAsHdf5 (false),
@@ -101,8 +109,20 @@ hid_t H5Kit::CFileOpenedReadOnly::SayId( void ) const { return id; }
 
 H5Kit::CFileOpenedReadWrite::CFileOpenedReadWrite(const std::string& fileName) : id (-1) {
 
+   // A k-base file holds only small groups and 3x2 datasets, so its metadata cache is kept small
+   hid_t accessProps = H5Pcreate( H5P_FILE_ACCESS );
+   H5AC_cache_config_t cacheConfig;
+   cacheConfig.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+   if ( ( accessProps >= 0 ) && ( H5Pget_mdc_config( accessProps, &cacheConfig ) >= 0 ) ) {
+      cacheConfig.set_initial_size = true;
+      cacheConfig.initial_size = FIXED_KBASE_MDCACHE_BYTES;
+      cacheConfig.min_size = std::min( cacheConfig.min_size, FIXED_KBASE_MDCACHE_BYTES );
+      cacheConfig.max_size = std::max( cacheConfig.min_size, 4 * FIXED_KBASE_MDCACHE_BYTES );
+      H5Pset_mdc_config( accessProps, &cacheConfig );
+   }
    errno = 0;
-   id = H5Fopen(fileName.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+   id = H5Fopen( fileName.c_str(), H5F_ACC_RDWR, ( accessProps >= 0 ) ? accessProps : H5P_DEFAULT );
+   if ( accessProps >= 0 ) { H5Pclose( accessProps ); }
    if ( id < 0 ) {
       std::ostringstream squawk;
       squawk << "Cannot RW open HDF file " << fileName << ": " << std::strerror(errno);
@@ -120,6 +140,13 @@ H5Kit::CFileOpenedReadWrite::~CFileOpenedReadWrite(void) {
 hid_t H5Kit::CFileOpenedReadWrite::SayId( void ) const { return id; }
 
 
+char H5Kit::CFileOpenedReadWrite::FlushAllWrites( void ) {
+
+   if (id < 0) { return 'x'; }
+   return ( ( H5Fflush( id, H5F_SCOPE_LOCAL ) < 0 ) ? 'f' : 'v' );   // one flush per batch of writes
+}
+
+
 //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
 // Group created
 
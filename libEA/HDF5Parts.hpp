@@ -28,6 +28,8 @@ namespace H5Kit {
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // File classes
 
+bool IsNameAnHdf5File( const std::string& );    // Checks only, never creates or opens a file
+
 class CFileCreatedIffAbsent {    // File gets created if and only if not one already with given name
 
    public:
@@ -80,6 +82,7 @@ class CFileOpenedReadWrite {
       CFileOpenedReadWrite& operator=( const CFileOpenedReadWrite& ) = delete;
 
       hid_t SayId( void ) const;
+      char  FlushAllWrites( void );
 
    private:
 
@@ -21,6 +21,7 @@ See the License for the specific language governing permissions and limitations
 #define AGENTTASK_HPP
 
 #include "customTypes.hpp"
+#include <cstdint>
 #include <memory>
 
 // Forward declarations
@@ -30,6 +31,7 @@ class AFact;
 class CProcess;
 
 class CAgent;
+class CCheckpoint;
 class CClockPerPort;
 class CFormula; 
 class CRuleKit;
@@ -63,6 +65,7 @@ class CSequence {
      ~CSequence( void );
 
      EGuiReply          Trigger( const SClockRead& );    // See Class Note [1]
+     void               CreateCasesForTrapsRecorded( void ); // by rule kits on Trigger(), now deferred
      int                SayTriggerPeriodSecs( void );
 
      void              Register( ADataChannel* );
@@ -72,6 +75,12 @@ class CSequence {
      void              Register( AFact* );
      void              Register( CRuleKit* ); 
 
+     std::vector<size_t>  SayRegistrySizes( void ) const;      // See CApplication c-tor
+     void                 ReserveRegistries( const std::vector<size_t>& );
+     void                 AddBytesHeldTo( MemoryCensus_t& ) const;   // by all registered objects
+     void                 ExchangeStateWith( CCheckpoint& );          // See Class Note [2]
+     std::uint64_t        SayTopologyFingerprint( void ) const;
+
    private:
 
    // Fields
@@ -103,6 +112,10 @@ class CSequence {
 [1]   Triggering sends out basic info from clock so ISeqElement objects downstream do not need to run
       getters back to AClock just to get basic time-of-day info (i.e., saves CPU cycles).  ISeqElement
       subclasses needing more than basic info will hold a const ref back to the AClock object.
+
+[2]   Walks the time axis then all registered objects, in registry order, so a checkpoint is only good
+      for an engine of the same topology.  SayTopologyFingerprint() hashes that registry order, so a
+      checkpoint of another tool or build is rejected before any state is loaded into the engine.
  
 ^^^^ END CLASS NOTES */
 
@@ -138,6 +151,7 @@ class CSeqTimeAxis {
       EGuiReply                     ResizeLoggingToAtLeastSecsAgo( int );
       void                          CreateSnapshotForSetSgi( Nzint_t );
       void                          DestroySnapshotForSetSgi( Nzint_t );
+      void                          ExchangeStateWith( CCheckpoint& );
 
    private:
 
@@ -0,0 +1,110 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Implements class CAlertRing, the lock-free ring of the latest alerts posted to the Domain.
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "alertRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+
+CAlertRing::CAlertRing( void ) : slots( ALERT_RING_CAPACITY ), nextId( 0 ) {
+
+   for ( SSlot& slotRef : slots ) { slotRef.stamp.store( 0, std::memory_order_relaxed ); }
+}
+
+
+void CAlertRing::CopyTextTo( char* p_field, size_t fieldSize, const std::string& textCref ) {
+
+   size_t numChars = std::min( textCref.size(), fieldSize - 1 );
+   std::memcpy( p_field, textCref.data(), numChars );
+   p_field[numChars] = '\0';
+}
+
+
+void CAlertRing::Post(  time_t timestamp,
+                        const std::string& timeTextCref,
+                        const std::string& domainTextCref,
+                        const std::string& subjectTextCref,
+                        const std::string& sourceTagCref,
+                        const std::string& alertTextCref ) {
+
+   SRecord record;
+   std::memset( &record, 0, sizeof(record) );
+   record.timestamp = static_cast<std::int64_t>( timestamp );
+   CopyTextTo( record.timeText, sizeof(record.timeText), timeTextCref );
+   CopyTextTo( record.domainText, sizeof(record.domainText), domainTextCref );
+   CopyTextTo( record.subjectText, sizeof(record.subjectText), subjectTextCref );
+   CopyTextTo( record.sourceTag, sizeof(record.sourceTag), sourceTagCref );
+   CopyTextTo( record.alertText, sizeof(record.alertText), alertTextCref );
+
+   std::uint64_t buffer[numWords] = {};
+   std::memcpy( buffer, &record, sizeof(record) );
+
+   std::uint64_t id = nextId.load( std::memory_order_relaxed );   // only this thread writes it
+   SSlot& slotRef = slots[id % ALERT_RING_CAPACITY];
+
+   slotRef.stamp.store( 2 * id + 1, std::memory_order_relaxed );
+   std::atomic_thread_fence( std::memory_order_release );       // odd mark is seen before any word
+   for ( size_t i = 0; i < numWords; ++i ) {
+      slotRef.words[i].store( buffer[i], std::memory_order_relaxed );
+   }
+   slotRef.stamp.store( 2 * id + 2, std::memory_order_release );
+   nextId.store( id + 1, std::memory_order_release );
+}
+
+
+std::uint64_t CAlertRing::SayNextAlertId( void ) const { return nextId.load( std::memory_order_acquire ); }
+
+
+std::vector<GuiPackAlert_t> CAlertRing::SayAlertsSince( std::uint64_t cursor ) const {
+
+   std::uint64_t endId = nextId.load( std::memory_order_acquire );
+   std::uint64_t firstId = ( endId > ALERT_RING_CAPACITY ? endId - ALERT_RING_CAPACITY : 0 );
+   if ( cursor > firstId ) { firstId = std::min( cursor, endId ); }
+
+   std::vector<GuiPackAlert_t> reply;
+   reply.reserve( endId - firstId );
+
+   for ( std::uint64_t id = firstId; id < endId; ++id ) {
+
+      const SSlot& slotRef = slots[id % ALERT_RING_CAPACITY];
+      std::uint64_t buffer[numWords];
+
+      if ( slotRef.stamp.load( std::memory_order_acquire ) != 2 * id + 2 ) { continue; }  // lapped
+      for ( size_t i = 0; i < numWords; ++i ) {
+         buffer[i] = slotRef.words[i].load( std::memory_order_relaxed );
+      }
+      std::atomic_thread_fence( std::memory_order_acquire );    // words are read before the recheck
+      if ( slotRef.stamp.load( std::memory_order_relaxed ) != 2 * id + 2 ) { continue; }  // lapped
+
+      SRecord record;
+      std::memcpy( &record, buffer, sizeof(record) );
+
+      GuiPackAlert_t alert;
+      alert.alertId = id;
+      alert.timestamp = static_cast<time_t>( record.timestamp );
+      alert.subjectText = record.subjectText;
+      alert.sourceTag = record.sourceTag;
+      alert.alertText = record.alertText;
+      alert.fullText =  std::string( record.timeText ) + " " + record.domainText + " " +
+                        record.subjectText + " " + record.sourceTag + " " + record.alertText;
+      reply.push_back( alert );
+   }
+   return reply;
+}
+
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
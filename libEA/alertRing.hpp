@@ -0,0 +1,94 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Declares class CAlertRing, the fixed-size ring of the latest alerts posted to the Domain.  Alerts are
+   written by the one thread stepping the engine, and read by any number of GUI threads at once, each
+   from its own cursor (the ID of the next alert it has not seen), without locks (See Class Note [1]).
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#ifndef ALERTRING_HPP
+#define ALERTRING_HPP
+
+#include "exportTypes.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#define ALERT_RING_CAPACITY         1024     // alerts kept; older ones are overwritten
+
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+
+class CAlertRing {
+
+   public:
+
+      CAlertRing( void );
+
+      void                          Post( time_t,                       // single writer only
+                                          const std::string&,           // time as text
+                                          const std::string&,           // domain name
+                                          const std::string&,           // subject name
+                                          const std::string&,           // source tag
+                                          const std::string& );         // alert text
+      std::uint64_t                 SayNextAlertId( void ) const;       // any thread
+      std::vector<GuiPackAlert_t>   SayAlertsSince( std::uint64_t ) const;   // any thread; See Note [2]
+
+   private:
+
+      struct SRecord {                                // See Class Note [3]
+         std::int64_t   timestamp;
+         char           timeText[16];
+         char           domainText[48];
+         char           subjectText[48];
+         char           sourceTag[48];
+         char           alertText[96];
+      };
+
+      static const size_t  numWords = ( sizeof(SRecord) + 7 ) / 8;
+
+      struct SSlot {
+         std::atomic<std::uint64_t>                         stamp;   // 2*id+1 writing, 2*id+2 done
+         std::array<std::atomic<std::uint64_t>, numWords>   words;
+      };
+
+      std::vector<SSlot>            slots;
+      std::atomic<std::uint64_t>    nextId;
+
+      static void                   CopyTextTo( char*, size_t, const std::string& );
+
+/* CLASS NOTES vvvv2vvvvvvvvv3vvvvvvvvv4vvvvvvvvv5vvvvvvvvv6vvvvvvvvv7vvvvvvvvv8vvvvvvvvv9vvvvvvvvvCvvvvv
+
+[1]   Each slot is a sequence lock.  The writer marks a slot odd (being written), stores the record,
+      then marks it even with the alert's ID, and only then advances nextId.  A reader checks the mark
+      before and after copying the record out; if either differs from the ID it wanted, the writer has
+      lapped it and the alert is counted lost rather than returned torn.  Neither side ever waits.
+
+[2]   Returns the alerts with IDs from the cursor given up to SayNextAlertId(), oldest first.  A cursor
+      more than ALERT_RING_CAPACITY behind gets only the alerts still held; the caller can tell from
+      the first ID returned how many it missed.
+
+[3]   Records are stored as words of std::atomic so a reader copying a slot while it is overwritten
+      is not a data race.  Texts are cut to fit their fields, which hold all tabulated alert texts.
+
+^^^^ END CLASS NOTES */
+
+};
+
+#endif
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
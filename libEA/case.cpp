@@ -180,17 +180,18 @@ GuiOptionSet_t CCase::GenerateMultipleChoiceOfLength( size_t numChoices) {
 // Constructor/destructor
 
 CCase::CCase(  CRuleKit& ruleKitRef,
+               CCaseLease& leaseRef,
                ASubject& arg0,
                time_t arg1,
                int arg6,
                int arg2,
                CRule& arg3,
-               const CTraceRealtime& arg4,
+               const CTraceRealtimeLazy& arg4,
                bool arg5 )
                :  IGuiShadow( EApiType::Case ),
                   u_SnapshotTracesOfObjectsAntecedentToCaseRule_byKey(),
                   u_PanesInSnapshotKrono_byKey(),
-                  u_SnapshotTraceOfCaseRule( std::make_unique<CTraceSnapshot>(
+                  u_SnapshotTraceOfCaseRule( leaseRef.Make<CTraceSnapshot>(
                                                 arg4,
                                                 arg3.SaySnapshotSetSgi()
                                              )
@@ -208,6 +209,7 @@ CCase::CCase(  CRuleKit& ruleKitRef,
                   userOptions (choice_TopMenu_CaseInProcess),
                   answerMinMax( {0,0} ),
                   timeTrapped (arg1),
+                  triggerCountAtTrap (arg6),
                   sumPriorCountsTrueOfAllCaseHypos (0),
                   sumJointPostCountsAccumByHyposAlive (0),
                   caseSgi ( arg0.GenerateAndSaySgiForNewCase() ),
@@ -238,12 +240,14 @@ CCase::CCase(  CRuleKit& ruleKitRef,
                   caseVerifiedAndLearned (false),
                   waitingOnUserToAnswer (true) {
 
-   LoadSnapshotKronoWithLogicChainOfCase( ruleKitRef );
+   LoadSnapshotKronoWithLogicChainOfCase( ruleKitRef, leaseRef );
 
    p_Kbase->InitializeCaseTallies(  RuleRef.SayRuleUai(),
                                     hypoTally,
                                     evidTally,
-                                    sumPriorCountsTrueOfAllCaseHypos );
+                                    sumPriorCountsTrueOfAllCaseHypos,
+                                    tallyMatrix );
+   LinkTallyMatrixRowsToHypos();
 
    numHyposPrior = hypoTally.size();
    numHyposAlive = numHyposPrior;
@@ -271,7 +275,7 @@ CCase::~CCase( void ) {
 // private methods
 
 
-void CCase::LoadSnapshotKronoWithLogicChainOfCase( CRuleKit& ruleKitRef ) {
+void CCase::LoadSnapshotKronoWithLogicChainOfCase( CRuleKit& ruleKitRef, CCaseLease& leaseRef ) {
 
 
 // Declare locals used later when arranging Panes on Krono
@@ -282,41 +286,37 @@ void CCase::LoadSnapshotKronoWithLogicChainOfCase( CRuleKit& ruleKitRef ) {
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 // Load snapshot trace ownership table using realtime trace access from Rule. 
 
-   for ( const auto pairValues_trace :       // Here, want PBV not PBR, since both in pair are POD types
+   for ( const auto& pairValues_trace :      // PBR, so no copy of each pair in table is made
          RuleRef.SayRealtimeAccessTable() ) {
 
-      std::unique_ptr<CTraceSnapshot> u_SnapshotTrace_loopScopedToHeap =
-         std::make_unique<CTraceSnapshot>(   *(pairValues_trace.second), // deref of a raw ptr PBV
-                                             snapshotSetSgi
+      LeasedPtr_t<CTraceSnapshot> u_SnapshotTrace_loopScopedToLease =
+         leaseRef.Make<CTraceSnapshot>(   *(pairValues_trace.second), // deref of a raw ptr PBV
+                                          snapshotSetSgi
          );
 
-      NGuiKey keyOfNewTrace( u_SnapshotTrace_loopScopedToHeap->SayGuiKey() ); 
+      NGuiKey keyOfNewTrace( u_SnapshotTrace_loopScopedToLease->SayGuiKey() ); 
 
       std::pair<SsTraceOwnershipTable_t::iterator, bool> traceTableVerbReply =
          u_SnapshotTracesOfObjectsAntecedentToCaseRule_byKey.emplace(
-            std::pair< NGuiKey, std::unique_ptr<CTraceSnapshot> >(
-               keyOfNewTrace,
-               u_SnapshotTrace_loopScopedToHeap.release()    // xfers ownership from and nulls local ptr
-            )
+            keyOfNewTrace,
+            std::move( u_SnapshotTrace_loopScopedToLease )  // xfers ownership from and nulls local ptr
          );
    }  // destroys nulled local (loop) ptr
  
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 // Make local allocation to create Panes, and put Snapshot Trace of Case Rule into a Pane of its own
  
-   std::unique_ptr<CPaneSnapshot> u_SnapshotPane_locallyScopedOnHeap =
-         std::make_unique<CPaneSnapshot>( u_SnapshotTraceOfCaseRule.get(),
-                                          ViewRef
+   LeasedPtr_t<CPaneSnapshot> u_SnapshotPane_locallyScopedToLease =
+         leaseRef.Make<CPaneSnapshot>( u_SnapshotTraceOfCaseRule.get(),
+                                       ViewRef
          );
 
-   NGuiKey rulePaneKey( u_SnapshotPane_locallyScopedOnHeap->SayGuiKey() ); // Needed in Krono c-tor
+   NGuiKey rulePaneKey( u_SnapshotPane_locallyScopedToLease->SayGuiKey() ); // Needed in Krono c-tor
 
    std::pair<SsPaneOwnershipTable_t::iterator, bool> paneTableVerbReply =
       u_PanesInSnapshotKrono_byKey.emplace(
-         std::pair< NGuiKey, std::unique_ptr<CPaneSnapshot> >(
-            rulePaneKey,
-            u_SnapshotPane_locallyScopedOnHeap.release()
-         )
+         rulePaneKey,
+         std::move( u_SnapshotPane_locallyScopedToLease )
       );
 
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
@@ -349,19 +349,17 @@ void CCase::LoadSnapshotKronoWithLogicChainOfCase( CRuleKit& ruleKitRef ) {
          } 
          // ... or, if no more panes, create a new pane based upon currently iterated trace :
 
-         u_SnapshotPane_locallyScopedOnHeap = 
-            std::make_unique<CPaneSnapshot>( pairRef_trace.second.get(),
-                                             ViewRef
+         u_SnapshotPane_locallyScopedToLease = 
+            leaseRef.Make<CPaneSnapshot>( pairRef_trace.second.get(),
+                                          ViewRef
          );
 
-         NGuiKey keyOfNewPane( u_SnapshotPane_locallyScopedOnHeap->SayGuiKey() ); 
+         NGuiKey keyOfNewPane( u_SnapshotPane_locallyScopedToLease->SayGuiKey() ); 
 
          paneTableVerbReply =
             u_PanesInSnapshotKrono_byKey.emplace(
-               std::pair< NGuiKey, std::unique_ptr<CPaneSnapshot> >(
-                  keyOfNewPane,
-                  u_SnapshotPane_locallyScopedOnHeap.release()   // nulls the local ptr
-            )
+               keyOfNewPane,
+               std::move( u_SnapshotPane_locallyScopedToLease )   // nulls the local ptr
          );
          traceMatchedAndAddedToPane = true;
 
@@ -387,7 +385,7 @@ void CCase::LoadSnapshotKronoWithLogicChainOfCase( CRuleKit& ruleKitRef ) {
 /* Create Krono (with rule pane at top) and add Panes to it in following order:
       Top -> bottom : Rule result, all binary ("fact") panes, all analog ("data") panes.
 */
-   u_SnapshotKrono = std::make_unique<CKronoSnapshot>(
+   u_SnapshotKrono = leaseRef.Make<CKronoSnapshot>(
                         ruleKitRef,
                         ruleKitRef.SayCtrlrRef(),
                         ViewRef,
@@ -417,68 +415,111 @@ void  CCase::SetAnswerMinMax( size_t numChoices) {
 }
 
 
+void CCase::LinkTallyMatrixRowsToHypos( void ) {
+
+   p_HypoTalliesByRow.clear();
+   for ( Nzint_t hypoId : tallyMatrix.hypoUais ) {
+      p_HypoTalliesByRow.push_back( &hypoTally.at(hypoId) );   // map nodes stay put, so ptrs hold
+   }
+   return;
+}
+
+
 void CCase::ApplyBayesGivenEvidUpIs( size_t evidValue ) {
 
+   // Runs of tallyMatrix holding counts of evid up, across all case hypos (See Class Note [5])
+
+   const auto citerEvidCol =
+      std::find( tallyMatrix.evidUais.cbegin(), tallyMatrix.evidUais.cend(), uaiEvidUp );
+   if ( citerEvidCol == tallyMatrix.evidUais.cend() ) {   // checked before case state is touched
+      throw std::logic_error( "Evid up is not a column of the case tally matrix" ); // deliberately no catch
+   }
+   const size_t iEvidCol =
+      static_cast<size_t>( std::distance( tallyMatrix.evidUais.cbegin(), citerEvidCol ) );
+
+   evidTally.at(uaiEvidUp).evidStatus = evidValue;
+
+   if ( noEvidenceEvaluated ) {
+      noEvidenceEvaluated = false;
+   }
+
+   ApplyBayesOverTallyRuns(   tallyMatrix, iEvidCol, evidValue, p_HypoTalliesByRow,
+                              sumJointPostCountsAccumByHyposAlive, numHyposAlive,
+                              uaiMappHypo, mappAt100pct );
+   return;
+}
+
+
+void CCase::ApplyBayesOverTallyRuns(   const SCaseTallyMatrix& matrixRef,
+                                       size_t iEvidCol,
+                                       size_t evidValue,
+                                       const std::vector<SHypoTally*>& p_TalliesByRowRef,
+                                       Tally_t& sumJointPostCountsRef,
+                                       size_t& numHyposAliveRef,
+                                       Nzint_t& uaiMappHypoRef,
+                                       bool& mappAt100pctRef ) {
+
    Tally_t weightOfLatestEvidAtPostValue = 0;
    Tally_t weightOfLatestEvidAtAllValues = 0;
    Tally_t postCountsJointToIterHypoBeingTrue = 0;
-   Tally_t tallyZero = 0;
    bool evidValueGivenIsNovel = false;
 
-   sumJointPostCountsAccumByHyposAlive = 0;              // re-zero register in class
+   const size_t numRows = p_TalliesByRowRef.size();
 
-   evidTally.at(uaiEvidUp).evidStatus = evidValue;
+   sumJointPostCountsRef = 0;                            // re-zero register of caller
 
-   if ( noEvidenceEvaluated ) {
-      noEvidenceEvaluated = false;
+   const Tally_t* const p_Trues = matrixRef.countsTrue.data();
+   const Tally_t* const p_TruesAtPost = p_Trues + matrixRef.SayOffsetTo( iEvidCol, evidValue );
+   const Tally_t* const p_TruesAtF = p_Trues + matrixRef.SayOffsetTo( iEvidCol, 0 );
+   const Tally_t* const p_TruesAtT = p_Trues + matrixRef.SayOffsetTo( iEvidCol, 1 );
+   const Tally_t* const p_TruesAtU = p_Trues + matrixRef.SayOffsetTo( iEvidCol, 2 );
+   const Tally_t* const p_FalsesAtPost =
+      matrixRef.countsFalse.data() + matrixRef.SayOffsetTo( iEvidCol, evidValue );
+
+   std::vector<Tally_t> isAliveByRow( numRows );
+   for ( size_t iRow = 0; iRow < numRows; ++iRow ) {
+      isAliveByRow[iRow] = ( p_TalliesByRowRef[iRow]->hypoStatus != 0 ) ? 1 : 0;
    }
-   
+
    //'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
    // "Weigh" the evidence just now provided (See Method Note [1] )
 
-   for (auto& hypoIter : hypoTally) {
+   for ( size_t iRow = 0; iRow < numRows; ++iRow ) {    // scope of evid "weight" is hypos alive only
 
-      if (hypoIter.second.hypoStatus == 0) { continue; } // scope of evid "weight" is hypos alive only
-
-      p_Kbase->PanCursorToNodeAt(caseRuleUai, hypoIter.first, uaiEvidUp);  // hypoIter.first rtns hypoId
-      p_Kbase->ReadCursorToImage();
-
-      weightOfLatestEvidAtPostValue += p_Kbase->PriorCountsHypoTrueWhenEvid( evidValue );
-      weightOfLatestEvidAtAllValues += p_Kbase->PriorCountsHypoTrueWhenEvid( 0 );
-      weightOfLatestEvidAtAllValues += p_Kbase->PriorCountsHypoTrueWhenEvid( 1 );
-      weightOfLatestEvidAtAllValues += p_Kbase->PriorCountsHypoTrueWhenEvid( 2 );
+      weightOfLatestEvidAtPostValue += isAliveByRow[iRow] * p_TruesAtPost[iRow];
+      weightOfLatestEvidAtAllValues +=
+         isAliveByRow[iRow] * ( p_TruesAtF[iRow] + p_TruesAtT[iRow] + p_TruesAtU[iRow] );
    }
    
    evidValueGivenIsNovel = ( weightOfLatestEvidAtPostValue == 0 );
 
 
    //'''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
-   // Re-Walk all alive hypos, read KB's counts of given evid value being joint to each hypo being true
+   // Re-Walk all alive hypos, take counts of given evid value being joint to each hypo being true
    
-   for ( auto& hypoIter : hypoTally ) {
+   for ( size_t iRow = 0; iRow < numRows; ++iRow ) {
 
-      if ( hypoIter.second.hypoStatus == 0 ) { continue; }
+      SHypoTally& hypoTallyRef = *p_TalliesByRowRef[iRow];
+
+      if ( isAliveByRow[iRow] == 0 ) { continue; }
 
       if ( evidValueGivenIsNovel ) {                                    // See Method Note [2]
-         hypoIter.second.accumPostCountsJointToThisHypoTrue += 1;
-         sumJointPostCountsAccumByHyposAlive += 1;
+         hypoTallyRef.accumPostCountsJointToThisHypoTrue += 1;
+         sumJointPostCountsRef += 1;
          continue;
       }
 
-      p_Kbase->PanCursorToNodeAt(caseRuleUai, hypoIter.first, uaiEvidUp); // hypoIter.first rtns hypoId
-      p_Kbase->ReadCursorToImage();
-
-      postCountsJointToIterHypoBeingTrue = p_Kbase->PriorCountsHypoTrueWhenEvid( evidValue );
+      postCountsJointToIterHypoBeingTrue = p_TruesAtPost[iRow];
 
      //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
      // Test iterated hypo for the condition that justifies killing it (See Method Note [3])
 
       if (  ( postCountsJointToIterHypoBeingTrue == 0 ) &&
-            ( p_Kbase->HasHypoEverBeenFalseWhenEvid( evidValue ) == true ) ) {
+            ( p_FalsesAtPost[iRow] != 0 ) ) {
 
-         hypoIter.second.hypoStatus = 0;   // set iterated hypo to being likely false ("dead")
-         hypoIter.second.accumPostCountsJointToThisHypoTrue = 0;
-         --numHyposAlive;
+         hypoTallyRef.hypoStatus = 0;   // set iterated hypo to being likely false ("dead")
+         hypoTallyRef.accumPostCountsJointToThisHypoTrue = 0;
+         --numHyposAliveRef;
          continue;
       }
 
@@ -490,25 +531,25 @@ void CCase::ApplyBayesGivenEvidUpIs( size_t evidValue ) {
                   // i.e., every time evidUp had the value given, the iterated hypo had been true
                ) {
 
-         uaiMappHypo = hypoIter.first;
-         mappAt100pct = true;
-         hypoIter.second.hypoStatus = 1;
-         hypoIter.second.accumPostCountsJointToThisHypoTrue += postCountsJointToIterHypoBeingTrue;
+         uaiMappHypoRef = matrixRef.hypoUais[iRow];
+         mappAt100pctRef = true;
+         hypoTallyRef.hypoStatus = 1;
+         hypoTallyRef.accumPostCountsJointToThisHypoTrue += postCountsJointToIterHypoBeingTrue;
 
-         for ( auto& hypoIterB : hypoTally ) {             // kill all other hypos not already dead
+         for ( SHypoTally* p_HypoIterB : p_TalliesByRowRef ) {  // kill all other hypos not already dead
 
-            if (hypoIterB.second.hypoStatus == 2) {
+            if (p_HypoIterB->hypoStatus == 2) {
 
-               hypoIterB.second.hypoStatus = 0;
-               hypoIterB.second.accumPostCountsJointToThisHypoTrue = 0;
+               p_HypoIterB->hypoStatus = 0;
+               p_HypoIterB->accumPostCountsJointToThisHypoTrue = 0;
                continue;
             }
          }
-         sumJointPostCountsAccumByHyposAlive = hypoIter.second.accumPostCountsJointToThisHypoTrue;
+         sumJointPostCountsRef = hypoTallyRef.accumPostCountsJointToThisHypoTrue;
          break;
       }
-      hypoIter.second.accumPostCountsJointToThisHypoTrue += postCountsJointToIterHypoBeingTrue;
-      sumJointPostCountsAccumByHyposAlive += hypoIter.second.accumPostCountsJointToThisHypoTrue;
+      hypoTallyRef.accumPostCountsJointToThisHypoTrue += postCountsJointToIterHypoBeingTrue;
+      sumJointPostCountsRef += hypoTallyRef.accumPostCountsJointToThisHypoTrue;
    }
  
 /* METHOD NOTES vvv2vvvvvvvvv3vvvvvvvvv4vvvvvvvvv5vvvvvvvvv6vvvvvvvvv7vvvvvvvvv8vvvvvvvvv9vvvvvvvvvCvvvvv
@@ -937,6 +978,7 @@ void CCase::LearnFromUserVerifyingSoln( void ) {
             p_Kbase->WriteImageToCursor();
          }
       }
+      p_Kbase->LoadCaseTallyMatrix( caseRuleUai, tallyMatrix );    // See Class Note [5]
       caseVerifiedAndLearned = true;
    }
 
@@ -961,6 +1003,7 @@ void CCase::LearnFaultHasBeenFixed(void) {
          p_Kbase->DevolveCounts(); // $$$ TBD to get this 'devolve' working right $$$
          p_Kbase->WriteImageToCursor();
       }
+      p_Kbase->LoadCaseTallyMatrix( caseRuleUai, tallyMatrix );
    }
    return;
 }
@@ -1218,9 +1261,54 @@ Nzint_t CCase::SaySnapshotSetSgi( void ) const { return snapshotSetSgi; }
 time_t CCase::SayWhenTrapped( void ) const { return timeTrapped; }
 
 
+SCaseTrap CCase::SayTrap( void ) const { return { timeTrapped, caseRuleUai, triggerCountAtTrap }; }
+
+
 int CCase::SayDollarsPerDayCost( void ) const { return 0; } // $$$ TBD to implement $$$
 
 
+void CCase::RerankHyposPerKbase( void ) {
+
+   p_Kbase->LoadCaseTallyMatrix( caseRuleUai, tallyMatrix );
+
+   // Posteriors rest on the answers given, so only the a-priori ranking is re-derived from the KB
+   if ( ( ! noEvidenceEvaluated ) || caseVerifiedAndLearned ) { return; }
+
+   const size_t numRows = p_HypoTalliesByRow.size();
+   std::vector<Tally_t> priorCountsTrueByRow;
+
+   const Tally_t sumPriorCounts = SayPriorCountsTrueByRow( tallyMatrix, priorCountsTrueByRow );
+   if ( sumPriorCounts == 0 ) { return; }
+
+   sumPriorCountsTrueOfAllCaseHypos = sumPriorCounts;
+   for ( size_t iRow = 0; iRow < numRows; ++iRow ) {
+      p_HypoTalliesByRow[iRow]->priorCountsThisHypoTrue = priorCountsTrueByRow[iRow];
+   }
+   mappAt100pct = false;
+   UpdateBayesProbabilities();
+   if ( p_ActOnAnswer == &CCase::ActOnAnswerTo_TopMenu_CaseInProcess ) { WriteBayesProbsToReport(); }
+   return;
+}
+
+
+Tally_t CCase::SayPriorCountsTrueByRow(  const SCaseTallyMatrix& matrixRef,
+                                          std::vector<Tally_t>& priorCountsTrueByRowRef ) {
+
+   const size_t numRows = matrixRef.hypoUais.size();
+   priorCountsTrueByRowRef.assign( numRows, 0 );
+
+   for ( size_t iEvidCol = 0; iEvidCol < matrixRef.evidUais.size(); ++iEvidCol ) {
+      for ( size_t evidValue = 0; evidValue < 3; ++evidValue ) {
+
+         const Tally_t* const p_Run =
+            matrixRef.countsTrue.data() + matrixRef.SayOffsetTo( iEvidCol, evidValue );
+         for ( size_t iRow = 0; iRow < numRows; ++iRow ) { priorCountsTrueByRowRef[iRow] += p_Run[iRow]; }
+      }
+   }
+   return std::accumulate( priorCountsTrueByRowRef.cbegin(), priorCountsTrueByRowRef.cend(), Tally_t(0) );
+}
+
+
 AoaReply_t CCase::CheckAnswerValidThenSet( size_t answerGuiSent ) {
 
    if ( (answerGuiSent < answerMinMax[0]) || (answerGuiSent > answerMinMax[1]) ) {
@@ -1279,6 +1367,8 @@ CCaseKit::CCaseKit(  ASubject& arg0,
                      std::string arg2 )
                      :  SubjRef (arg0),
                         ViewRef ( arg0.SayViewRef() ),
+                        arena(),
+                        leases_byCaseKey(),
                         u_Cases_byKey(),
                         RankCasesOldestToNewest (
                            [&] ( NGuiKey sortedAheadOnTrue, NGuiKey sortedBehindOnTrue ) -> bool {
@@ -1338,6 +1428,7 @@ EGuiReply CCaseKit::DestroyCase( NGuiKey keyOfCaseToDestroy ) {
       // (CCase d-tor sets CRule assoc. w/ destroyed case back to "autoMode")
 
    u_Cases_byKey.erase( keyOfCaseToDestroy );          // unordered-map erases key-value pair from itself
+   leases_byCaseKey.erase( keyOfCaseToDestroy );       // returns case's regions to arena in one go
    caseKeysByDecrRank.remove( keyOfCaseToDestroy );   // calls "==" operation on NGuiKey, which it has
    return EGuiReply::OKAY_done_caseDestroyedByUser_discardKey;
 }
@@ -1352,6 +1443,16 @@ EGuiReply CCaseKit::RankCasesOnCostNotAge( bool knobInput ) {
 
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 
+void CCaseKit::RerankHyposOfAllCases( void ) {
+
+   for ( const auto& pairRef_case : u_Cases_byKey ) {
+      pairRef_case.second->RerankHyposPerKbase();
+   }
+   return;
+}
+
+//''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+
 void CCaseKit::RegenCaseRankings( void ) {
 
    caseKeysByDecrRank.clear();  // std::forward_list to provide faster sorts
@@ -1445,6 +1546,21 @@ std::vector<std::string> CCaseKit::SayCaseNamesByDecrRank( void ) const {
 }
 
 
+std::vector<SCaseTrap> CCaseKit::SayTrapsOfOpenCasesOldestFirst( void ) const {
+
+   std::vector<SCaseTrap> reply(0);
+   reply.reserve( u_Cases_byKey.size() );
+   for ( const auto& pairCref : u_Cases_byKey ) { reply.push_back( pairCref.second->SayTrap() ); }
+   std::sort(  reply.begin(),
+               reply.end(),
+               []( const SCaseTrap& lArg0, const SCaseTrap& lArg1 ) -> bool {
+                  return ( lArg0.timeTrapped < lArg1.timeTrapped );
+               }
+   );
+   return reply;
+}
+
+
 //======================================================================================================/
 
 EApiReply CCaseKit::CreateAndOwnCase(  CRuleKit& ruleKitRef,
@@ -1453,32 +1569,31 @@ EApiReply CCaseKit::CreateAndOwnCase(  CRuleKit& ruleKitRef,
                                        int trapTrigger,
                                        int secsPerRuleCycle,
                                        CRule& ruleRef,
-                                       const CTraceRealtime& ruleRtTraceRef ) { 
+                                       const CTraceRealtimeLazy& ruleRtTraceRef ) { 
 
    EApiReply reply = EApiReply::Okay_tallyZero; // default reply should following 'if' test as 'false'
 
    if ( u_Cases_byKey.size() < FIXED_CASEKIT_NUMCASESOUT_MAX ) {
 
-      std::unique_ptr<CCase> u_Case_locallyScopedOnHeap = 
-         std::make_unique<CCase>(   ruleKitRef,
-                                    subjRef,
-                                    trapTime,
-                                    trapTrigger,
-                                    secsPerRuleCycle,
-                                    ruleRef,
-                                    ruleRtTraceRef,
-                                    ruleRef.HasDiagnostics()
+      // Case and its view graph go in one lease, See Class Note [3] in header
+      CCaseLease leaseOfNewCase( arena );
+      LeasedPtr_t<CCase> u_Case_locallyScopedToLease = 
+         leaseOfNewCase.Make<CCase>(   ruleKitRef,
+                                       leaseOfNewCase,
+                                       subjRef,
+                                       trapTime,
+                                       trapTrigger,
+                                       secsPerRuleCycle,
+                                       ruleRef,
+                                       ruleRtTraceRef,
+                                       ruleRef.HasDiagnostics()
          );
 
-      NGuiKey keyOfNewCase( u_Case_locallyScopedOnHeap->SayGuiKey() );
+      NGuiKey keyOfNewCase( u_Case_locallyScopedToLease->SayGuiKey() );
 
+      leases_byCaseKey.emplace( keyOfNewCase, std::move( leaseOfNewCase ) );
       std::pair<CaseOwnershipTable_t::iterator, bool> caseTableVerbReply =
-         u_Cases_byKey.emplace(
-            std::pair< NGuiKey, std::unique_ptr<CCase> >(
-               keyOfNewCase,
-               u_Case_locallyScopedOnHeap.release()
-         )
-      );
+         u_Cases_byKey.emplace( keyOfNewCase, std::move( u_Case_locallyScopedToLease ) );
       RegenCaseRankings();
 
       ViewRef.AddCaseToCaseKitLookup( keyOfNewCase, this ); // Removal from LUT is by CCase d-tor
@@ -1506,8 +1621,13 @@ EGuiReply CCaseKit::AnswerCasePromptUsingOptionIndex( NGuiKey caseKey, size_t iO
             reply = DestroyCase( caseKey );
             break;
 
+         case ACTION_CASE_SOLNVERIFIED_UNMASKRULE :      // case just taught the KB
+            RerankHyposOfAllCases();
+            break;
+
          case ACTION_KIT_CASEVERIFIEDANDLEARNED_FAULTFIXED_DESTROYANDTELLGUI :
             reply = DestroyCase( caseKey );
+            RerankHyposOfAllCases();
             break;
 
          case ACTION_KIT_ANSWERNOTALLOWED_TELLGUI :
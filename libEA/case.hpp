@@ -30,6 +30,7 @@ See the License for the specific language governing permissions and limitations
 #include <forward_list>
 #include "customTypes.hpp"
 #include "guiShadow.hpp"
+#include "caseArena.hpp"
 
 
 // Forward declares (to avoid unnecessary #includes)
@@ -41,12 +42,13 @@ class CKronoSnapshot;
 class CPaneSnapshot;
 class CRule;
 class CRuleKit;
+class CTraceRealtimeLazy;
 class CTraceSnapshot;
 class CView;
 
 // typedefs
-typedef std::unordered_map<NGuiKey, std::unique_ptr<CTraceSnapshot>> SsTraceOwnershipTable_t;
-typedef std::unordered_map<NGuiKey, std::unique_ptr<CPaneSnapshot>>  SsPaneOwnershipTable_t;
+typedef std::unordered_map<NGuiKey, LeasedPtr_t<CTraceSnapshot>>     SsTraceOwnershipTable_t;
+typedef std::unordered_map<NGuiKey, LeasedPtr_t<CPaneSnapshot>>      SsPaneOwnershipTable_t;
 typedef std::string                                                  GuiMsgInsert_t;
 typedef std::vector<std::string>                                     GuiMsgPacket_t;
 typedef std::vector<std::string>                                     GuiOptionSet_t;
@@ -59,6 +61,14 @@ const size_t CASEID = 0;
 const size_t FAILCOST = 1;
 const size_t TRAPTIME = 2;
 
+// Trap record of an open case, enough for its rule kit to reopen it from a checkpoint
+struct SCaseTrap {
+
+   time_t      timeTrapped;
+   Nzint_t     ruleUai;
+   int         triggerCountAtTrap;
+};
+
 /*
 Complete lexicon for actions on answer (AOA) to a prompt sent to GUI
 e.g., the action taken based on answer User gave to an evidence query.  Action is either
@@ -90,12 +100,13 @@ class CCase : public IGuiShadow {
    // Methods
 
       CCase(   CRuleKit&,
+               CCaseLease&,                  // holds case and its view graph, See Class Note [6]
                ASubject&,                    // to send user alert to Domain
                time_t,                       // timestamp of latest FAIL on Rule ("trap time")
                int,                          // triggerCount at time trapped
                int,                          // secsPerCycle of Rule
                CRule&,                       // See Class Note [1]
-               const CTraceRealtime&,
+               const CTraceRealtimeLazy&,
                bool );                       // Rule has diagnostics
 
 
@@ -106,8 +117,21 @@ class CCase : public IGuiShadow {
       std::string                      SayCaseName( void ) const;
       Nzint_t                          SaySnapshotSetSgi( void ) const;
       time_t                           SayWhenTrapped( void ) const;
+      SCaseTrap                        SayTrap( void ) const;
       int                              SayDollarsPerDayCost( void ) const;
       AoaReply_t                       CheckAnswerValidThenSet( size_t );
+      void                             RerankHyposPerKbase( void );   // See Class Note [5]
+
+      // Passes over the dense tally matrix alone, so they can be checked apart from any case
+      static void    ApplyBayesOverTallyRuns(   const SCaseTallyMatrix&,
+                                                size_t,              // column of evid up
+                                                size_t,              // evid value given
+                                                const std::vector<SHypoTally*>&,  // by matrix row
+                                                Tally_t&,            // sum of joint post counts
+                                                size_t&,             // hypos alive
+                                                Nzint_t&,            // uai of MAPP hypo
+                                                bool& );             // MAPP at 100%
+      static Tally_t SayPriorCountsTrueByRow( const SCaseTallyMatrix&, std::vector<Tally_t>& );
 
 
    private:
@@ -142,8 +166,8 @@ class CCase : public IGuiShadow {
 
       SsTraceOwnershipTable_t          u_SnapshotTracesOfObjectsAntecedentToCaseRule_byKey;
       SsPaneOwnershipTable_t           u_PanesInSnapshotKrono_byKey;
-      std::unique_ptr<CTraceSnapshot>  u_SnapshotTraceOfCaseRule;
-      std::unique_ptr<CKronoSnapshot>  u_SnapshotKrono;
+      LeasedPtr_t<CTraceSnapshot>      u_SnapshotTraceOfCaseRule;
+      LeasedPtr_t<CKronoSnapshot>      u_SnapshotKrono;
 
       CRule&               RuleRef; // nonconst obj allows CCase to edit CRule (TBD, not yet used)
       CView&               ViewRef; // Trace/Pane/Krono d-tors call on View to release ptrs
@@ -156,12 +180,15 @@ class CCase : public IGuiShadow {
 
       HypoTallyMap_t       hypoTally;        // Maps hypoId to a SHypoTally struct
       EvidTallyMap_t       evidTally;        // Maps evidId to char giving status 'F', 'T', or 'U'
+      SCaseTallyMatrix     tallyMatrix;      // KB counts of case, dense (See Class Note [5])
+      std::vector<SHypoTally*>   p_HypoTalliesByRow;  // into hypoTally, in rows of tallyMatrix
       std::queue<Nzint_t>  evidsUnevaluated;
       GuiMsgPacket_t       userReport;    // "report" must be purely declarative, leader is userAlert
       GuiMsgPacket_t       userPrompt;    // "prompt" may begin declarative, must end interrogative
       GuiOptionSet_t       userOptions;   // currently only multichoice index 0 thru N into vector
       std::array<size_t,2> answerMinMax;  // per above, currently only multichoice w/ min = 0
       const time_t         timeTrapped;
+      const int            triggerCountAtTrap;
       Tally_t              sumPriorCountsTrueOfAllCaseHypos;
       Tally_t              sumJointPostCountsAccumByHyposAlive;
       const Nzint_t        caseSgi;
@@ -190,7 +217,7 @@ class CCase : public IGuiShadow {
       static std::string      InitReportPreamble( ERealName, time_t, int, int, const CRule& );
       static GuiOptionSet_t   GenerateMultipleChoiceOfLength( size_t );
 
-      void                 LoadSnapshotKronoWithLogicChainOfCase( CRuleKit& );
+      void                 LoadSnapshotKronoWithLogicChainOfCase( CRuleKit&, CCaseLease& );
 
       void                 SetAnswerMinMax( size_t );
       void                 ApplyBayesGivenEvidUpIs( size_t );
@@ -198,6 +225,7 @@ class CCase : public IGuiShadow {
       void                 WriteBayesProbsToReport( void );
       void                 LearnFromUserVerifyingSoln( void );
       void                 LearnFaultHasBeenFixed(void);
+      void                 LinkTallyMatrixRowsToHypos( void );
       void                 RegenGuiFieldsPerCaseAsIs( void );
 
       AoaReply_t           ActOnAnswerTo_ShouldThisCaseBeDeleted( void );
@@ -230,6 +258,17 @@ class CCase : public IGuiShadow {
       the context where it's used (i.e., 'priori' applies prior to first evidence answered,
       'posteriori' applies after first evidence annswered.)
 
+[5]   KB counts of all case hypos against all case evids are read once, at construction, into dense
+      tallyMatrix.  An evid answer is then applied by passes over the run of counts at that evid value.
+      Whenever the KB may have changed beneath the case (e.g., the case itself taught it), the matrix
+      is re-read.  RerankHyposPerKbase() does so and re-derives the a-priori ranking from the matrix,
+      and is how CCaseKit re-ranks the hypos of all its open cases in one batch.  Both passes are
+      static members taking the matrix and its row links only, which lets tests run them on a KB
+      without standing up a case (see tests/testBayes.cpp).
+
+[6]   The lease is only used during construction, to place the snapshot Traces, Panes and Krono beside
+      the case itself.  It is owned by the CCaseKit, which returns it only after the case is destroyed.
+
 ^^^^ END CLASS NOTES */
 };
 
@@ -242,7 +281,7 @@ class CCase : public IGuiShadow {
    go in the corresponding "CaseKit".
 */
 
-typedef std::unordered_map<NGuiKey, std::unique_ptr<CCase>>    CaseOwnershipTable_t; 
+typedef std::unordered_map<NGuiKey, LeasedPtr_t<CCase>>        CaseOwnershipTable_t; 
 
 class CCaseKit { 
 
@@ -259,6 +298,7 @@ class CCaseKit {
       GuiPackCaseDyna_t                SayDynamicGuiPackFromCase( NGuiKey ) const;
       std::vector<NGuiKey>             SayCaseKeysByDecrRank( void ) const;
       std::vector<std::string>         SayCaseNamesByDecrRank( void ) const;
+      std::vector<SCaseTrap>           SayTrapsOfOpenCasesOldestFirst( void ) const;
       EGuiReply                        AnswerCasePromptUsingOptionIndex( NGuiKey, size_t );
 
       // Public Methods called internally within API
@@ -268,13 +308,15 @@ class CCaseKit {
                                                          int,
                                                          int,
                                                          CRule&,
-                                                         const CTraceRealtime& );
+                                                         const CTraceRealtimeLazy& );
 
    private:
 
    // Handles, private
       ASubject&                                             SubjRef;
       CView&                                                ViewRef;
+      CCaseArena                                            arena;              // See Class Note [3]
+      std::unordered_map<NGuiKey, CCaseLease>               leases_byCaseKey;   // outlive their cases
       CaseOwnershipTable_t                                  u_Cases_byKey;      // See Class Note [1]
 
    // Objects (Ranking requires std:sort to access to object members, so can't be statics)
@@ -295,6 +337,7 @@ class CCaseKit {
       EGuiReply                        DestroyCase( NGuiKey );
       EGuiReply                        RankCasesOnCostNotAge( bool );
       void                             RegenCaseRankings( void );
+      void                             RerankHyposOfAllCases( void );
       //void                             SaveCaseKitToFile( void );
       //void                             RestoreCaseKitFromFile( void );
 
@@ -312,6 +355,10 @@ class CCaseKit {
       A CCaseKit object has a 1:1 correspondence to a particular CRuleKit object, and thus to one
       particular ASubject object (i.e., one specific item of equipment... e.g., "VAV Box #127" )        
 
+[3]   Each CCase, with its snapshot Traces, Panes and Krono, is placed in a lease of regions from the
+      kit's arena, and DestroyCase() returns the lease whole once the case d-tor has run.  The arena
+      keeps regions for the next case, so months of case lifecycles do not fragment the heap.
+
 ^^^^ END CLASS NOTES */
 
 };
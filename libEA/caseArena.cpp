@@ -0,0 +1,101 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Implements CCaseArena and CCaseLease, the region store for CCase objects and their view graphs.
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "caseArena.hpp"
+
+#include <stdexcept>
+
+
+//VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
+// Implementations for CCaseArena
+
+CCaseArena::CCaseArena( void )
+                        :  u_Regions(),
+                           iRegionsFree() {
+
+}
+
+
+size_t CCaseArena::LeaseRegion( void ) {
+
+   if ( !iRegionsFree.empty() ) {
+      const size_t iRegion = iRegionsFree.back();
+      iRegionsFree.pop_back();
+      return iRegion;
+   }
+   u_Regions.push_back( std::make_unique<unsigned char[]>( FIXED_CASEARENA_BYTESPERREGION ) );
+   return ( u_Regions.size() - 1u );
+}
+
+
+unsigned char* CCaseArena::SayRegionStart( size_t iRegion ) const { return u_Regions[iRegion].get(); }
+
+
+void CCaseArena::ReturnRegions( const std::vector<size_t>& iRegionsReturned ) {
+
+   iRegionsFree.insert( iRegionsFree.end(), iRegionsReturned.begin(), iRegionsReturned.end() );
+   return;
+}
+
+
+size_t CCaseArena::SayNumRegionsHeld( void ) const { return u_Regions.size(); }
+
+
+//VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
+// Implementations for CCaseLease
+
+CCaseLease::CCaseLease( CCaseArena& arg )
+                        :  ArenaRef (arg),
+                           iRegionsHeld(),
+                           bytesUsedInNewest (FIXED_CASEARENA_BYTESPERREGION) {    // none held yet
+
+   iRegionsHeld.reserve( 4u );
+}
+
+
+CCaseLease::CCaseLease( CCaseLease&& other )
+                        :  ArenaRef (other.ArenaRef),
+                           iRegionsHeld ( std::move( other.iRegionsHeld ) ),
+                           bytesUsedInNewest (other.bytesUsedInNewest) {
+
+   other.iRegionsHeld.clear();
+   other.bytesUsedInNewest = FIXED_CASEARENA_BYTESPERREGION;
+}
+
+
+CCaseLease::~CCaseLease( void ) {
+
+   // Objects placed in the lease must be destroyed by now (their LeasedPtr_t d-tors run d-tors only)
+   ArenaRef.ReturnRegions( iRegionsHeld );
+}
+
+
+void* CCaseLease::Allocate( size_t numBytes, size_t alignment ) {
+
+   if ( numBytes > FIXED_CASEARENA_BYTESPERREGION ) {
+      throw std::logic_error( "Object too large for a case arena region" ); // deliberately no catch
+   }
+   size_t offset = ( ( bytesUsedInNewest + alignment - 1u ) / alignment ) * alignment;
+   if ( ( offset + numBytes ) > FIXED_CASEARENA_BYTESPERREGION ) {
+      iRegionsHeld.push_back( ArenaRef.LeaseRegion() );
+      offset = 0u;
+   }
+   bytesUsedInNewest = offset + numBytes;
+   return ( ArenaRef.SayRegionStart( iRegionsHeld.back() ) + offset );
+}
+
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
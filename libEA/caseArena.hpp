@@ -0,0 +1,103 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Declares CCaseArena, a per-CCaseKit store of fixed-size memory regions, and CCaseLease, the share of
+   those regions held by one CCase.  A case and its whole snapshot view graph (Traces, Panes, Krono) are
+   placed in its lease, and the lease returns all its regions to the arena in one operation when the
+   case is destroyed.  Regions are kept for reuse, so memory held by a case kit stays at its peak number
+   of open cases, however many case lifecycles pass (See Class Note [1] of CCaseArena).
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#ifndef CASEARENA_HPP
+#define CASEARENA_HPP
+
+#include "customTypes.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Deleter for objects placed in a lease: runs the d-tor only, as the lease itself frees the memory
+struct SDestroyInLease {
+
+   template <typename TT>
+   void operator()( TT* ptr ) const { ptr->~TT(); }
+};
+
+template <typename TT>
+using LeasedPtr_t = std::unique_ptr<TT, SDestroyInLease>;
+
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+
+class CCaseArena {
+
+   public:
+
+      CCaseArena( void );
+
+      size_t               LeaseRegion( void );
+      unsigned char*       SayRegionStart( size_t ) const;
+      void                 ReturnRegions( const std::vector<size_t>& );
+      size_t               SayNumRegionsHeld( void ) const;
+
+   private:
+
+      std::vector<std::unique_ptr<unsigned char[]>>   u_Regions;
+      std::vector<size_t>                             iRegionsFree;
+
+/* CLASS NOTES vvvv2vvvvvvvvv3vvvvvvvvv4vvvvvvvvv5vvvvvvvvv6vvvvvvvvv7vvvvvvvvv8vvvvvvvvv9vvvvvvvvvCvvvvv
+
+[1]   Regions are all FIXED_CASEARENA_BYTESPERREGION, allocated from the heap only when none is free, and
+      never freed before the arena.  So a case kit never has more regions than it once had in use at one
+      time, and a returned region is reused whole, leaving nothing for the heap to fragment.
+
+^^^^ END CLASS NOTES */
+
+};
+
+
+class CCaseLease {
+
+   public:
+
+      explicit CCaseLease( CCaseArena& );
+
+      ~CCaseLease( void );
+
+      CCaseLease( CCaseLease&& );                           // moves regions held, not objects in them
+      CCaseLease( const CCaseLease& ) = delete;
+      CCaseLease& operator=( const CCaseLease& ) = delete;
+      CCaseLease& operator=( CCaseLease&& ) = delete;
+
+      template <typename TT, typename... TTargs>
+      LeasedPtr_t<TT> Make( TTargs&&... args ) {
+         static_assert( alignof(TT) <= alignof(std::max_align_t), "Case arena regions not so aligned" );
+         void* p_Memory = Allocate( sizeof(TT), alignof(TT) );
+         return LeasedPtr_t<TT>( new (p_Memory) TT( std::forward<TTargs>( args )... ) );
+      }
+
+   private:
+
+      CCaseArena&          ArenaRef;
+      std::vector<size_t>  iRegionsHeld;
+      size_t               bytesUsedInNewest;
+
+      void*                Allocate( size_t, size_t );
+};
+
+#endif
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
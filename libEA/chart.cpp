@@ -22,6 +22,7 @@ See the License for the specific language governing permissions and limitations
 #include "dataChannel.hpp"
 #include "formula.hpp"
 #include "subject.hpp"
+#include "checkpoint.hpp"
 #include <algorithm>
 #include <numeric>
 
@@ -87,6 +88,15 @@ void AChart::LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ptrTableRef ) con
 }
 
 
+void AChart::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ISeqElement::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( chartRunning );
+   checkpointRef.Exchange( resetPending );
+   return;
+}
+
+
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Implementation for CChartShewhart charts
@@ -442,6 +452,27 @@ bool CChartShewhart::IsSteady( void ) const { return isSteadyNow; }
 size_t CChartShewhart::GetNumCyclesBeingUsed( void ) const { return numCyclesBeingUsed; }
 
 
+void CChartShewhart::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   // Fields set by knobs (zPass, tripFreeMargin, numSecs/numCyclesBeingUsed) are not exchanged
+   AChart::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( stdDevRef );
+   checkpointRef.Exchange( stdDevRefNew );
+   checkpointRef.Exchange( xMean );
+   checkpointRef.Exchange( xNow );
+   checkpointRef.Exchange( xStdDev );
+   checkpointRef.Exchange( zNow );
+   checkpointRef.Exchange( tripFreeCount );
+   checkpointRef.Exchange( abovePassband );
+   checkpointRef.Exchange( belowPassband );
+   checkpointRef.Exchange( chartTrip );
+   checkpointRef.Exchange( flipState );
+   checkpointRef.Exchange( isSteadyNow );
+   checkpointRef.Exchange( wasSteadyOnLastValid );
+   return;
+}
+
+
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // CChartTracking concrete class implementation
 // Applies CUSUM-like chart to detect hunt or drift of input off of its own (i.e., "auto") mean
@@ -846,6 +877,26 @@ bool CChartTracking::IsHunting( void ) const { return isHuntingNow; }
 bool CChartTracking::IsRising( void ) const { return isRisingNow; }
 
 
+void CChartTracking::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   // Fields set by knobs (halfBand, warn, lagFrac, staleFrac, appsBtwnResets) are not exchanged
+   AChart::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( register_N );
+   checkpointRef.Exchange( register_P );
+   checkpointRef.Exchange( xObsvdNow );
+   checkpointRef.Exchange( xGuideNow );
+   checkpointRef.Exchange( appsSinceReset );
+   checkpointRef.Exchange( isFallingNow );
+   checkpointRef.Exchange( isHuntingNow );
+   checkpointRef.Exchange( isRisingNow );
+   checkpointRef.Exchange( wasFallingOnLastValid );
+   checkpointRef.Exchange( wasHuntingOnLastValid );
+   checkpointRef.Exchange( wasRisingOnLastValid );
+   checkpointRef.Exchange( trackerOn );
+   return;
+}
+
+
 /* START FILE NOTES XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXX
 
 [1]   User (GUI) setting of "locks" on objects of state and chart classes only affect value returned by
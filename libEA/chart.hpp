@@ -47,6 +47,7 @@ class AChart  : public ISeqElement {
       virtual ~AChart( void ) { /* empty */ }
 
       void     LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ) const override;
+      void     ExchangeStateWith( CCheckpoint& ) override;
 
    protected:
 
@@ -100,6 +101,7 @@ class CChartShewhart : public AChart {
       size_t         GetNumCyclesBeingUsed( void ) const;
       bool           IsSteady( void ) const;
       virtual void   LendHistogramKeysTo( std::vector<NGuiKey>& ) const override;
+      virtual void   ExchangeStateWith( CCheckpoint& ) override;
 
  
   private:
@@ -178,6 +180,7 @@ class CChartTracking : public AChart {
       bool           IsHunting( void ) const;
       bool           IsRising( void ) const;
       virtual void   LendHistogramKeysTo( std::vector<NGuiKey>& ) const override;
+      virtual void   ExchangeStateWith( CCheckpoint& ) override;
 
 
    private:
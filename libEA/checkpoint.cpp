@@ -0,0 +1,184 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Implements class CCheckpoint, a binary image of the dynamic state of an engine.
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "checkpoint.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+const char           CHECKPOINT_MAGIC[8] = "EACKPT1";
+
+
+static std::uint64_t SayFnv1aHashOf( const std::vector<char>& bytesCref ) {
+
+   std::uint64_t hash = 14695981039346656037ull;
+   for ( char byte : bytesCref ) {
+      hash ^= static_cast<unsigned char>( byte );
+      hash *= 1099511628211ull;
+   }
+   return hash;
+}
+
+
+//VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
+// Implementations for CCheckpoint
+
+CCheckpoint::CCheckpoint( std::uint64_t arg )
+                           :  bytes(),
+                              iNextByte (0u),
+                              fingerprint (arg),
+                              restoring (false) {
+
+}
+
+
+bool CCheckpoint::LoadFromFile( const std::string& filename ) {
+
+   // Reply is false if no file, or if file does not hold an image for this engine (file then set aside)
+   std::ifstream fileIn( filename, std::ios::binary );
+   if ( !fileIn ) { return false; }
+   const std::vector<char> image( ( std::istreambuf_iterator<char>( fileIn ) ),
+                                    std::istreambuf_iterator<char>() );
+   fileIn.close();
+
+   const size_t bytesHeader = sizeof(CHECKPOINT_MAGIC) + ( 2u * sizeof(std::uint64_t) );
+   bool isGood = ( image.size() >= ( bytesHeader + sizeof(std::uint64_t) ) );
+   std::uint64_t fingerprintInFile = 0u;
+   std::uint64_t bytesPayload = 0u;
+   std::uint64_t checksumInFile = 0u;
+   if ( isGood ) {
+      std::memcpy( &fingerprintInFile, image.data() + sizeof(CHECKPOINT_MAGIC), sizeof(std::uint64_t) );
+      std::memcpy( &bytesPayload,
+                   image.data() + sizeof(CHECKPOINT_MAGIC) + sizeof(std::uint64_t),
+                   sizeof(std::uint64_t) );
+      isGood = (  ( std::memcmp( image.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC) ) == 0 ) &&
+                  ( fingerprintInFile == fingerprint ) &&
+                  ( image.size() == ( bytesHeader + bytesPayload + sizeof(std::uint64_t) ) ) );
+   }
+   if ( isGood ) {
+      std::memcpy( &checksumInFile,
+                   image.data() + image.size() - sizeof(std::uint64_t),
+                   sizeof(std::uint64_t) );
+      bytes.assign( image.begin() + bytesHeader, image.end() - sizeof(std::uint64_t) );
+      isGood = ( checksumInFile == SayFnv1aHashOf( bytes ) );
+   }
+   if ( !isGood ) {     // Kept for inspection, but out of the way of the next save
+      bytes.clear();
+      std::rename( filename.c_str(), ( filename + ".rejected" ).c_str() );
+      return false;
+   }
+   iNextByte = 0u;
+   restoring = true;
+   return true;
+}
+
+
+bool CCheckpoint::IsRestoring( void ) const { return restoring; }
+
+
+void CCheckpoint::WriteToFile( const std::string& filename ) const {
+
+   if ( restoring ) {
+      throw std::logic_error( "Checkpoint being restored cannot be written" ); // deliberately no catch
+   }
+   const std::string filenameTemp = filename + ".tmp";
+   const std::uint64_t bytesPayload = bytes.size();
+   const std::uint64_t checksum = SayFnv1aHashOf( bytes );
+
+   errno = 0;
+   {
+      std::ofstream fileOut( filenameTemp, std::ios::binary | std::ios::trunc );
+      fileOut.write( CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC) );
+      fileOut.write( reinterpret_cast<const char*>( &fingerprint ), sizeof(fingerprint) );
+      fileOut.write( reinterpret_cast<const char*>( &bytesPayload ), sizeof(bytesPayload) );
+      fileOut.write( bytes.data(), static_cast<std::streamsize>( bytes.size() ) );
+      fileOut.write( reinterpret_cast<const char*>( &checksum ), sizeof(checksum) );
+      fileOut.flush();
+      if ( !fileOut ) {
+         std::ostringstream squawk;
+         squawk << "Cannot write checkpoint file " << filenameTemp << ": " << std::strerror( errno );
+         throw std::runtime_error( squawk.str() );
+      }
+   }
+   if ( std::rename( filenameTemp.c_str(), filename.c_str() ) != 0 ) {
+      std::ostringstream squawk;
+      squawk << "Cannot rename checkpoint file to " << filename << ": " << std::strerror( errno );
+      throw std::runtime_error( squawk.str() );
+   }
+   return;
+}
+
+
+void CCheckpoint::ExchangeTag( const char* p_Tag ) {
+
+   std::string tag( p_Tag );
+   std::string tagInImage( tag );
+   Exchange( tagInImage );
+   if ( restoring && ( tagInImage != tag ) ) {
+      std::ostringstream squawk;
+      squawk << "Checkpoint out of step: expected section " << tag << " but found " << tagInImage;
+      throw std::runtime_error( squawk.str() );
+   }
+   return;
+}
+
+
+void CCheckpoint::ExchangeBytes( void* p_Field, size_t numBytes ) {
+
+   if ( !restoring ) {
+      const char* p_First = static_cast<const char*>( p_Field );
+      bytes.insert( bytes.end(), p_First, p_First + numBytes );
+      return;
+   }
+   if ( ( iNextByte + numBytes ) > bytes.size() ) {
+      throw std::runtime_error( "Checkpoint ends before engine state restored" );
+   }
+   std::memcpy( p_Field, bytes.data() + iNextByte, numBytes );
+   iNextByte += numBytes;
+   return;
+}
+
+
+void CCheckpoint::Exchange( std::string& textRef ) {
+
+   size_t numChars = textRef.size();
+   Exchange( numChars );
+   if ( restoring ) { textRef.resize( numChars ); }
+   if ( numChars > 0 ) { ExchangeBytes( &textRef[0], numChars ); }
+   return;
+}
+
+
+void CCheckpoint::Exchange( std::vector<bool>& flagsRef ) {
+
+   size_t numFlags = flagsRef.size();
+   Exchange( numFlags );
+   if ( restoring ) { flagsRef.resize( numFlags ); }
+   for ( size_t iFlag = 0; iFlag < numFlags; ++iFlag ) {
+      bool flag = flagsRef[iFlag];
+      Exchange( flag );
+      flagsRef[iFlag] = flag;
+   }
+   return;
+}
+
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
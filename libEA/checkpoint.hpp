@@ -0,0 +1,146 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Declares class CCheckpoint, a binary image of the dynamic state of an engine (bindex logs, statistics,
+   histogram slices, chart registers, fact timers, rule logs, open cases, time axis, knob settings), so
+   an engine can be restarted "warm".  The same ExchangeStateWith( CCheckpoint& ) walk of the engine both
+   saves and restores the image, according to the mode of the CCheckpoint passed (See Class Note [1]).
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "customTypes.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+
+class CCheckpoint {
+
+   public:
+
+      explicit CCheckpoint( std::uint64_t );          // arg = topology fingerprint; starts out saving
+
+      bool                 LoadFromFile( const std::string& );             // if good, now restoring
+      bool                 IsRestoring( void ) const;
+      void                 WriteToFile( const std::string& ) const;        // See Class Note [2]
+      void                 ExchangeTag( const char* );                      // See Class Note [3]
+      void                 ExchangeBytes( void*, size_t );
+
+      template <typename TT>
+      void Exchange( TT& valueRef ) {
+         static_assert( std::is_trivially_copyable<TT>::value, "Checkpoint needs a trivially copyable" );
+         ExchangeBytes( &valueRef, sizeof(TT) );
+      }
+
+      void Exchange( std::string& );
+      void Exchange( std::vector<bool>& );
+
+      template <typename TT>
+      void Exchange( std::vector<TT>& vecRef ) {
+         size_t numItems = vecRef.size();
+         Exchange( numItems );
+         if ( restoring ) { vecRef.resize( numItems ); }
+         for ( TT& itemRef : vecRef ) { Exchange( itemRef ); }
+      }
+
+      template <typename TT>
+      void Exchange( std::deque<TT>& dequeRef ) {
+         size_t numItems = dequeRef.size();
+         Exchange( numItems );
+         if ( restoring ) { dequeRef.resize( numItems ); }
+         for ( TT& itemRef : dequeRef ) { Exchange( itemRef ); }
+      }
+
+      template <typename TTkey, typename TTvalue>
+      void Exchange( std::map<TTkey, TTvalue>& mapRef ) { ExchangeMap( mapRef ); }
+
+      template <typename TTkey, typename TTvalue>
+      void Exchange( std::unordered_map<TTkey, TTvalue>& mapRef ) { ExchangeMap( mapRef ); }
+
+   private:
+
+      std::vector<char>    bytes;
+      size_t               iNextByte;
+      std::uint64_t        fingerprint;
+      bool                 restoring;
+
+      template <typename TTmap>
+      void ExchangeMap( TTmap& mapRef ) {             // See Class Note [4]
+         size_t numItems = mapRef.size();
+         Exchange( numItems );
+         if ( !restoring ) {
+            std::vector<typename TTmap::value_type*> pairPtrs_byKey;
+            pairPtrs_byKey.reserve( numItems );
+            for ( auto& pairRef : mapRef ) { pairPtrs_byKey.push_back( &pairRef ); }
+            std::sort(  pairPtrs_byKey.begin(), pairPtrs_byKey.end(),
+                        []( const auto* p_Lhs, const auto* p_Rhs ) { return ( p_Lhs->first < p_Rhs->first ); } );
+            for ( auto p_Pair : pairPtrs_byKey ) {
+               typename TTmap::key_type keyCopy = p_Pair->first;
+               Exchange( keyCopy );
+               Exchange( p_Pair->second );
+            }
+            return;
+         }
+         std::vector<typename TTmap::key_type> keysRestored;
+         keysRestored.reserve( numItems );
+         for ( size_t iItem = 0; iItem < numItems; ++iItem ) {
+            typename TTmap::key_type key {};
+            Exchange( key );
+            Exchange( mapRef[key] );
+            keysRestored.push_back( key );
+         }
+         for ( auto iter = mapRef.begin(); iter != mapRef.end(); ) {
+            auto iterKey = std::find( keysRestored.begin(), keysRestored.end(), iter->first );
+            iter = ( ( iterKey != keysRestored.end() ) ? std::next( iter ) : mapRef.erase( iter ) );
+         }
+      }
+
+/* CLASS NOTES vvvv2vvvvvvvvv3vvvvvvvvv4vvvvvvvvv5vvvvvvvvv6vvvvvvvvv7vvvvvvvvv8vvvvvvvvv9vvvvvvvvvCvvvvv
+
+[1]   Each class holding dynamic state has one ExchangeStateWith( CCheckpoint& ) method, which calls
+      Exchange() on its fields in a fixed order.  When saving, Exchange() appends the field; when
+      restoring, it overwrites the field from the image, in the same order.  So save and restore cannot
+      drift apart.
+      Only fields that change while the engine runs are exchanged; fields set from topology and knobs
+      are rebuilt by construction, and knobs are restored first by CController (so via their setters).
+
+[2]   File is written to "<name>.tmp" then renamed, so a crash mid-write leaves the prior file intact.
+      Layout: 8-byte magic "EACKPT1", topology fingerprint, payload length, payload, FNV-1a checksum.
+      An image is only good for an engine of the same topology on a machine of the same byte order and
+      type sizes; LoadFromFile() rejects a file whose fingerprint or checksum does not match.
+
+[3]   Tags mark the start of each object's section, so a restore that lost step with the saved image
+      throws at the first misaligned object, rather than loading garbage into the engine.
+
+[4]   Maps are restored in place: saved keys are assigned (emplaced if absent) and keys not saved are
+      erased.  Keys existing in both keep their node, so an existing iteration order is undisturbed.
+      Items are saved in key order, not in iteration order (which for an unordered map depends on its
+      insert history), so an engine restored then saved again writes the same image.
+
+^^^^ END CLASS NOTES */
+
+};
+
+#endif
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
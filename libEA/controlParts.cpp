@@ -30,17 +30,19 @@ AKnob::AKnob(  EApiType bArg,
                EDataLabel arg2,                      // Knob sub-label
                EDataUnit arg3,
                EDataSuffix arg4, 
-               std::vector<GuiFpn_t> arg5,
-               GuiFpn_t arg6 )
+               std::array<GuiFpn_t,2> arg5,
+               bool arg6,
+               GuiFpn_t arg7 )
                :  IGuiShadow( bArg ),
                   CtrlrRef (arg0),
                   HostRef (arg1),
                   fieldLabel (arg2),
                   fieldUnits (arg3),
                   unitsSuffix (arg4),
-                  rangeMinMaxToGui (arg5),
+                  rangeMinMax (arg5),
+                  rangeSentToGui (arg6),
                   valuesSelectable_ifDefined(0),
-                  valueNowToGui (arg6)  {
+                  valueNowToGui (arg7)  {
 
    // Empty base c-tor
 }
@@ -55,7 +57,9 @@ GuiPackKnob_t   AKnob::GetGuiPack( void ) const {
                         ownGuiKey,
                         ( LookUpTag( HostRef.SayLabel() ) + " : " + LookUpTag( fieldLabel ) ),
                         ( LookUpText( fieldUnits ) + LookUpText( unitsSuffix ) ),
-                        rangeMinMaxToGui,
+                        ( rangeSentToGui ?                     // See Class Note [2] in .hpp
+                           std::vector<GuiFpn_t>( rangeMinMax.begin(), rangeMinMax.end() ) :
+                           std::vector<GuiFpn_t>(0) ),
                         valuesSelectable_ifDefined,
                         valueNowToGui
    );
@@ -91,6 +95,24 @@ void AKnob::DefineValuesSelectable( std::vector<Nzint_t> arg ) {
 }
 
 
+GuiFpn_t AKnob::SayValueNow( void ) const { return valueNowToGui; }
+
+
+void AKnob::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   size_t bytesOfObject = 0;
+   switch ( ownApiType ) {
+      case EApiType::Knob_float :         bytesOfObject = sizeof(CKnobFloat);        break;
+      case EApiType::Knob_sint :          bytesOfObject = sizeof(CKnobSint);         break;
+      case EApiType::Knob_Boolean :       bytesOfObject = sizeof(CKnobBool);         break;
+      case EApiType::Knob_selectNzint :   bytesOfObject = sizeof(CKnobSelectNzint);  break;
+      default :                           bytesOfObject = sizeof(AKnob);             break;
+   }
+   censusRef.bytesKnobs += ( bytesOfObject + HeapBytesHeldBy( valuesSelectable_ifDefined ) );
+   return;
+}
+
+
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // CKnobFloat concrete subclass implementation
 
@@ -108,13 +130,14 @@ CKnobFloat::CKnobFloat( CController& bArg0,
                                     bArg2,
                                     bArg3,
                                     bArg4,
-                                    std::vector<GuiFpn_t>({ arg1[0], arg1[2] }),
+                                    std::array<GuiFpn_t,2>( {{ arg1[0], arg1[2] }} ),
+                                    true,
                                     GuiFpn_t(arg3)
                            ),
                            FieldSetter (arg0),
                            fieldRef (arg3) {
 
-   if (  rangeMinMaxToGui[0] > rangeMinMaxToGui[1]  ) {
+   if (  rangeMinMax[0] > rangeMinMax[1]  ) {
       throw std::logic_error( "Knob c-tor given invalid range" );
    }
 
@@ -127,8 +150,8 @@ CKnobFloat::~CKnobFloat( void ) { CtrlrRef.DeregisterKnob( ownGuiKey ); }
 
 EGuiReply CKnobFloat::SetValueTo( GuiFpn_t valueGiven ) {
 
-   if (  (valueGiven < rangeMinMaxToGui[0]) ||
-         (valueGiven > rangeMinMaxToGui[1]) ) {               // The "vett": TRUE rejects valueGiven
+   if (  (valueGiven < rangeMinMax[0]) ||
+         (valueGiven > rangeMinMax[1]) ) {               // The "vett": TRUE rejects valueGiven
       return EGuiReply::FAIL_set_givenValueOutOfRangeAllowed;
    }
    FieldSetter( static_cast<float>(valueGiven) );
@@ -154,15 +177,16 @@ CKnobSint::CKnobSint(   CController& bArg0,        // also useful for u-int inpu
                                     bArg2,
                                     bArg3,
                                     bArg4,
-                                    std::vector<GuiFpn_t>( {static_cast<GuiFpn_t>(arg1[0]),
-                                                            static_cast<GuiFpn_t>(arg1[2]) }
+                                    std::array<GuiFpn_t,2>( {{ static_cast<GuiFpn_t>(arg1[0]),
+                                                               static_cast<GuiFpn_t>(arg1[2]) }}
                                     ), // C++11 cannot implicily "narrow" using an initializer list
+                                    true,
                                     GuiFpn_t(arg3)
                            ),
                            FieldSetter (arg0),
                            fieldRef (arg3) {
 
-   if (  rangeMinMaxToGui[0] > rangeMinMaxToGui[1]  ) {
+   if (  rangeMinMax[0] > rangeMinMax[1]  ) {
       throw std::logic_error( "Knob c-tor given invalid range" );
    }
 
@@ -175,8 +199,8 @@ CKnobSint::~CKnobSint( void ) { CtrlrRef.DeregisterKnob( ownGuiKey ); }
 
 EGuiReply CKnobSint::SetValueTo( GuiFpn_t valueGiven ) {
 
-   if (  (valueGiven < rangeMinMaxToGui[0]) ||
-         (valueGiven > rangeMinMaxToGui[1]) ) {               // The "vett": TRUE rejects valueGiven
+   if (  (valueGiven < rangeMinMax[0]) ||
+         (valueGiven > rangeMinMax[1]) ) {               // The "vett": TRUE rejects valueGiven
       return EGuiReply::FAIL_set_givenValueOutOfRangeAllowed;
    }
    FieldSetter( static_cast<int>(valueGiven) );
@@ -200,7 +224,8 @@ CKnobBool::CKnobBool(   CController& bArg0,
                                     bArg2,
                                     EDataUnit::Binary_Boolean,
                                     bArg3,
-                                    std::vector<GuiFpn_t>(0),  // GUI to "know" empty means range n/a
+                                    std::array<GuiFpn_t,2>( {{ 0.0, 1.0 }} ),
+                                    false,   // GUI to "know" empty means range n/a
                                     ( arg1 ? 1.0 : 0.0 )
                         ),
                         FieldSetter (arg0),
@@ -243,7 +268,8 @@ CKnobSelectNzint::CKnobSelectNzint( CController& bArg0,
                                                 bArg2,
                                                 bArg3,
                                                 EDataSuffix::None,
-                                                std::vector<GuiFpn_t>(0),
+                                                std::array<GuiFpn_t,2>( {{ 0.0, 0.0 }} ),
+                                                false,
                                                 static_cast<GuiFpn_t>(0)
                               ),
                               FieldSetter (arg0),
@@ -36,7 +36,9 @@ class AKnob : public IGuiShadow {
 
       GuiPackKnob_t           GetGuiPack( void ) const;
       std::string             SayIdentifyingText( void ) const;
+      GuiFpn_t                SayValueNow( void ) const;
       void                    DefineValuesSelectable( std::vector<Nzint_t> );
+      void                    AddBytesHeldTo( MemoryCensus_t& ) const;
       virtual EGuiReply       SetValueTo( GuiFpn_t ) = 0;
 
 
@@ -49,7 +51,8 @@ class AKnob : public IGuiShadow {
       const EDataLabel              fieldLabel;             // label of field on the hosting object
       const EDataUnit               fieldUnits;             // units of field, not necessarily = host's
       const EDataSuffix             unitsSuffix;
-      const std::vector<GuiFpn_t>   rangeMinMaxToGui;       // TBD to include sending "default" to GUI
+      const std::array<GuiFpn_t,2>  rangeMinMax;            // TBD to include sending "default" to GUI
+      const bool                    rangeSentToGui;         // See Class Note [3]
       std::vector<GuiFpn_t>   valuesSelectable_ifDefined;   // non-const so subclass c-tor can define it
       GuiFpn_t                valueNowToGui;
 
@@ -60,7 +63,8 @@ class AKnob : public IGuiShadow {
                EDataLabel, 
                EDataUnit,
                EDataSuffix,
-               std::vector<GuiFpn_t>,
+               std::array<GuiFpn_t,2>,
+               bool,
                GuiFpn_t );
 
 /* CLASS NOTES '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
@@ -74,6 +78,9 @@ class AKnob : public IGuiShadow {
          Knobbed field is int: range is vector<GuiFpn_t>( {min allowed, max allowed } )
          Knobbed field is bool: range is an empty vector
          Knobbed field is a selection: range is empty vector, vett is done by owning object
+
+   [3]   Range held inline rather than as the vector sent to GUI, as a campus engine holds thousands of
+         knobs and a vector costs one heap block per knob.  GetGuiPack() builds vector per convention [2].
 */
 
 };
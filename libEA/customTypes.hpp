@@ -21,6 +21,8 @@ See the License for the specific language governing permissions and limitations
 #define CUSTOMTYPES_HPP
 
 #include <memory>
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <array>
 #include <vector>
@@ -127,8 +129,10 @@ const size_t   FIXED_SUBJECT_CYCLESPINNEDFAILHISTORY = 3;   //
 
 const size_t   FIXED_KRONO_SPANCYCLES_MIN = 5;        // arbitrary
 const int      FIXED_KRONO_SNAPSHOT_SPANSECS = 900;   // "Snapshot" = preceding 15 minutes (arbitrary)
+const int      FIXED_KRONO_REALTIME_SECSIDLE_MAX = 600;  // Host secs w/o GUI request before r-t Krono released
 
 const size_t   FIXED_CASEKIT_NUMCASESOUT_MAX = 10u;
+const size_t   FIXED_CASEARENA_BYTESPERREGION = 8192u;   // one case and its snapshot Krono, typically
 const size_t   FIXED_KRONO_SNAPSHOT_SIZE = static_cast<size_t>(   FIXED_KRONO_SNAPSHOT_SPANSECS /
                                                                   FIXED_SEQUENCE_SECSPERTRIGGER );
 const int      FIXED_SEQELEMENT_TRIGGERSPERCYCLE_MAX =
@@ -145,6 +149,11 @@ const size_t   FIXED_RAIN_RULESTATE_NUMBINS = 11u;
 const int      FIXED_RULEKIT_SECSBETWEENTRAPS_MIN = FIXED_DATALOG_SECSLOGGING_MIN;
 const int      START_RULEKIT_SECSBETWEENTRAPS = FIXED_RULEKIT_SECSBETWEENTRAPS_MIN;
 
+//''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+// Parameters for engine checkpoints (warm restart)
+
+const int      START_CHECKPOINT_SECSBETWEENSAVES = 900;  // data-time secs, unless EA_CHECKPOINT_SECS given
+
 // rules/kit <= rainfall width
 const size_t FIXED_RAIN_NUMRULESINKIT_MAX = FIXED_RAIN_ANALOGVALUE_NUMBINS;
 const size_t FIXED_PANE_ANALOG_NUMTRACES_MAX = 3;
@@ -310,13 +319,23 @@ since arithmetic is also done in this type, better to use signed vs. unsigned
 typedef int BinSum_t;
 const BinSum_t FIXED_RULERAIN_FAILSINEMPTYTRAP_MAX = 3; // Max Rule fails in a trap considered "empty"
 
+/*
+Type of each element HELD in a bin sums array. Each histogram keeps dozens of slices of these arrays,
+so elements are stored narrow; arithmetic on them is still done in BinSum_t. Deepest span any slice
+sums over is one week, at fastest possible cycle rate:
+*/
+typedef std::uint16_t BinSumHeld_t;
+static_assert( ( 168 * 3600 / FIXED_SEQUENCE_SECSPERTRIGGER ) <=
+                  std::numeric_limits<BinSumHeld_t>::max(),
+               "BinSumHeld_t too narrow to hold one week of cycles at fastest trigger rate" );
+
 // Each "bin row" of Boolean bins represents one "cycle" ("sample", "time step") within rainfall
 // Analog use is "widest" use, so it fixes width of rainfall. Other uses read/write rows of fewer bins
 
-typedef std::array<BinSum_t,FIXED_RAIN_ANALOGVALUE_NUMBINS >   BinSumsAnalogValue_t;
-typedef std::array<BinSum_t,FIXED_RAIN_ANALOGSTATE_NUMBINS>    BinSumsAnalogState_t;
-typedef std::array<BinSum_t,FIXED_RAIN_FACTSTATE_NUMBINS>      BinSumsFactState_t;
-typedef std::array<BinSum_t,FIXED_RAIN_RULESTATE_NUMBINS>      BinSumsRuleState_t;
+typedef std::array<BinSumHeld_t,FIXED_RAIN_ANALOGVALUE_NUMBINS >   BinSumsAnalogValue_t;
+typedef std::array<BinSumHeld_t,FIXED_RAIN_ANALOGSTATE_NUMBINS>    BinSumsAnalogState_t;
+typedef std::array<BinSumHeld_t,FIXED_RAIN_FACTSTATE_NUMBINS>      BinSumsFactState_t;
+typedef std::array<BinSumHeld_t,FIXED_RAIN_RULESTATE_NUMBINS>      BinSumsRuleState_t;
 
 
 const std::array<EGuiState, FIXED_RAIN_ANALOGSTATE_NUMBINS>
@@ -406,8 +425,8 @@ const size_t INDEX_BINSUMS_RULE_UNAVAIL = static_cast<size_t>(BINDEX_RULE_UNAVAI
 class CTraceSnapshot;
 typedef std::unordered_map<NGuiKey, CTraceSnapshot* >    SsTraceAccessTable_t;
 
-class CTraceRealtime;
-typedef std::unordered_map<NGuiKey, CTraceRealtime* >    RtTraceAccessTable_t;
+class CTraceRealtimeLazy;  // Realtime Traces are reached via stand-ins, as constructed only on demand
+typedef std::unordered_map<NGuiKey, CTraceRealtimeLazy* > RtTraceAccessTable_t;
 
 class CRule;
 typedef std::unordered_map<Nzint_t, CRule*>              RuleUaiToPtrTable_t;
@@ -480,6 +499,76 @@ typedef struct SEnergyPrices {
 } EnergyPrices_t;
 
 
+// Tally of bytes held by engine parts, by category.  Filled in by AddBytesHeldTo() calls, which
+// start at CApplication::SayMemoryCensus(). Bytes of objects not listed are left to the caller to infer.
+
+typedef struct SMemoryCensus {
+
+   size_t   bytesRainfallLogs;      // bindex logs and per-rule working vectors of rainfalls
+   size_t   bytesSnapshotBanks;     // snapshots banked by rainfalls for Cases
+   size_t   bytesHistograms;        // histogram objects and their logs of slices
+   size_t   bytesKnobs;
+   size_t   bytesTraces;            // r-t Trace stand-ins and any r-t Traces constructed from them
+   size_t   bytesStrings;           // heap held by caption and name texts (i.e., beyond SSO)
+
+   SMemoryCensus( void )
+                  :  bytesRainfallLogs (0u),
+                     bytesSnapshotBanks (0u),
+                     bytesHistograms (0u),
+                     bytesKnobs (0u),
+                     bytesTraces (0u),
+                     bytesStrings (0u) {
+   }
+
+   size_t SayBytesTotal( void ) const {
+
+      return ( bytesRainfallLogs + bytesSnapshotBanks + bytesHistograms +
+               bytesKnobs + bytesTraces + bytesStrings );
+   }
+
+} MemoryCensus_t;
+
+
+/* Estimates of heap bytes held by std containers, for use by memory census only.  Estimates follow
+   libstdc++ layouts (e.g., a deque holds a map of node pointers plus 512-byte nodes, even when empty)
+   and ignore per-block overhead of the allocator.
+*/
+template <typename TT>
+size_t HeapBytesHeldBy( const std::vector<TT>& containerRef ) {
+
+   return ( containerRef.capacity() * sizeof(TT) );
+}
+
+inline size_t HeapBytesHeldBy( const std::vector<bool>& containerRef ) {
+
+   return ( ( containerRef.capacity() + 7u ) / 8u );
+}
+
+template <typename TT>
+size_t HeapBytesHeldBy( const std::deque<TT>& containerRef ) {
+
+   const size_t numPerNode = ( sizeof(TT) < 512u ) ? ( 512u / sizeof(TT) ) : 1u;
+   const size_t numNodes = ( containerRef.size() / numPerNode ) + 1u;
+   const size_t numMapSlots = std::max( static_cast<size_t>(8u), numNodes + 2u );
+
+   return ( ( numNodes * numPerNode * sizeof(TT) ) + ( numMapSlots * sizeof(TT*) ) );
+}
+
+inline size_t HeapBytesHeldBy( const std::string& textRef ) {
+
+   return ( textRef.capacity() > 15u ? ( textRef.capacity() + 1u ) : 0u );
+}
+
+template <typename TTKey, typename TTValue>
+size_t HeapBytesHeldBy( const std::unordered_map<TTKey,TTValue>& tableRef ) {
+
+   // Each node holds next ptr, element, and (for non-trivial hashes) the cached hash code
+   const size_t bytesPerNode = sizeof(void*) + sizeof(std::pair<const TTKey,TTValue>) + sizeof(size_t);
+
+   return ( ( tableRef.bucket_count() * sizeof(void*) ) + ( tableRef.size() * bytesPerNode ) );
+}
+
+
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Enums used either as types for class members or return types kept within API (vs. exported out to GUI)
 
@@ -584,7 +673,8 @@ enum class ERealName : unsigned int {
    Subject_vav1,
    Subject_vav2,
    Subject_vav3,
-   Subject_vav4
+   Subject_vav4,
+   Subject_fromTopology = 0x1000u  // First of values issued at run time to names only in a topology file
 };
 
 
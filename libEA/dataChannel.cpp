@@ -22,6 +22,7 @@ See the License for the specific language governing permissions and limitations
 #include "viewParts.hpp"      // get NGuiKey of traces, call d-tor of trace u-ptr
 #include "subject.hpp"        // call getters on subject
 #include "mvc_ctrlr.hpp"      // register point to ctrlr (the only way sampled data enters app)
+#include "checkpoint.hpp"     // save or restore dynamic state
 
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
@@ -73,6 +74,15 @@ void ADataChannel::ReadFromPortAsNextValue( GuiFpn_t arg ) {
    return;
 }
 
+
+void ADataChannel::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ISeqElement::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( xGivenDbl );
+   checkpointRef.Exchange( xPrevDbl );
+   return;
+}
+
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Implement concrete subclass for points handling analog data
 
@@ -101,7 +111,7 @@ CPointAnalog::CPointAnalog(   CSequence&  bArg0,
                                                                            bArg1,
                                                                            bArg4 )
                                  ),
-                                 u_RealtimeTrace ( std::make_unique<CTraceRealtime>(
+                                 u_RealtimeTrace ( std::make_unique<CTraceRealtimeLazy>(
                                                       bArg1.SayViewRef(),
                                                       *u_Rain,
                                                       knobKeys_ownedAndAntecedent  // must be PBR
@@ -170,7 +180,7 @@ void CPointAnalog::LendRealtimeAnalogAccessTo(  RtTraceAccessTable_t& ptrTableRe
 
    std::pair<RtTraceAccessTable_t::iterator, bool> tableVerbReply =
       ptrTableRef.emplace(
-         std::pair< NGuiKey, CTraceRealtime*>(
+         std::pair< NGuiKey, CTraceRealtimeLazy*>(
             u_RealtimeTrace->SayGuiKey(),
             u_RealtimeTrace.get()
          )
@@ -179,6 +189,25 @@ void CPointAnalog::LendRealtimeAnalogAccessTo(  RtTraceAccessTable_t& ptrTableRe
 };
 
 
+void CPointAnalog::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   u_Rain->AddBytesHeldTo( censusRef );
+   u_RealtimeTrace->AddBytesHeldTo( censusRef );
+   return;
+}
+
+
+void CPointAnalog::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ADataChannel::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( xPosted );
+   checkpointRef.Exchange( xLastValid );
+   checkpointRef.Exchange( sameDblAsPrev );
+   u_Rain->ExchangeStateWith( checkpointRef );
+   return;
+}
+
+
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Implement concrete subclass for points handling binary data
 
@@ -49,6 +49,7 @@ class ADataChannel : public ISeqElement {
       // Methods
       EPointName           SayPointName( void ) const;
       void                 ReadFromPortAsNextValue( GuiFpn_t );
+      virtual void         ExchangeStateWith( CCheckpoint& ) override;
 
    protected:
    // Fields
@@ -86,6 +87,8 @@ class CPointAnalog : public ADataChannel {
 
       virtual void      LendHistogramKeysTo( std::vector<NGuiKey>& ) const override;
       virtual void      LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ) const override;
+      virtual void      AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void      ExchangeStateWith( CCheckpoint& ) override;
 
    // Handles
       const std::unique_ptr<CRainAnalog>     u_Rain;
@@ -93,7 +96,7 @@ class CPointAnalog : public ADataChannel {
    private:
 
    // Handles
-      const std::unique_ptr<CTraceRealtime>  u_RealtimeTrace;
+      const std::unique_ptr<CTraceRealtimeLazy>  u_RealtimeTrace;   // Trace itself built on demand
  
    // Fields
       float                   xPosted;   
@@ -117,10 +117,28 @@ typedef IdVec_t::iterator                 IdVecIter_t;
 typedef IdVec_t::const_iterator           IdVecCiter_t;
 
 
+struct SCaseTallyMatrix {        // Dense copy of the KB nodes of one case (See File Note [4])
+
+   IdVec_t                 hypoUais;      // one row per case hypo, in iteration order of its hypoTally
+   IdVec_t                 evidUais;      // one column per case evid
+   std::vector<Tally_t>    countsTrue;    // KB counts of hypo true, at [evid col][evid value][hypo row]
+   std::vector<Tally_t>    countsFalse;   // KB counts of hypo false, same layout
+
+   size_t SayOffsetTo( size_t iEvidCol, size_t evidValue ) const {   // to first hypo row of a run
+      return ( ( ( iEvidCol * 3u ) + evidValue ) * hypoUais.size() );
+   }
+};
+
+
 typedef std::array<Tally_t,2> KnodeRow_t; // 2 columns in k-base node row (hypo = false and hypo = true)
 
 typedef std::array<KnodeRow_t,3> Knode_t; // 3 rows in k-base node (evid = false, true, or unevaluated)
 
+typedef std::array<Nzint_t,3> KnodeCoords_t;   // R-H-E coordinates (rule, hypo, evid UAIs) of a k-base node
+
+const int FIXED_KBASE_WRITEBEHIND_MSECS = 2000;   // Max delay of a node write to reach k-base on disk
+const size_t FIXED_KBASE_MDCACHE_BYTES = 65536;  // HDF5 metadata cache of an open k-base file (default 2 MiB)
+
 typedef std::vector<Nzint_t>                          MimicAxisE_t;
 typedef MimicAxisE_t::const_iterator                  MimicCiterE_t;
 
@@ -179,6 +197,11 @@ typedef JointCountCol_t::iterator                     JointCountColIter_t;
       The columns across all hypos in a case for one evid in the case form a 'page'.  The pages across
       all evids in a case form the joint counts map for that case.    
 
+[4]   SCaseTallyMatrix is filled once, at case creation, by CKnowBaseH5::InitializeCaseTallies().  The
+      counts for one evid value across all case hypos are one contiguous run, so that the Bayes update
+      upon an answer to one evid is a pass over plain arrays, with no KB lookup per hypo.  Hypo-evid
+      pairs having no KB node hold zero counts, as would a node newly made for them.
+
 --------------------------------------------------------------------------------
 XXX END FILE NOTES */
 
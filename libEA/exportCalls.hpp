@@ -36,6 +36,7 @@ class IExportOmni {
       virtual EGuiReply                PrepareApplicationForShutdown( void ) = 0;
 
       virtual EGuiReply                SetTimeStampInDomain( std::tm ) = 0;
+      virtual std::time_t              GetTimeStampFromDomain( void ) const = 0;
 
       virtual EGuiReply                SingleStepDomainOnTimeAndInputs( void ) = 0;
 
@@ -52,6 +53,9 @@ class IExportOmni {
 
       virtual GuiPackDomain_t          SayInfoFromDomain( void ) const = 0;
       virtual std::queue<std::string>  SayNewAlertsFifoFromDomainThenClear( void ) = 0;
+      virtual std::vector<GuiPackAlert_t> SayAlertsFromDomainSince( std::uint64_t ) const = 0;  // File Note [1]
+      virtual std::uint64_t            SayNextAlertIdFromDomain( void ) const = 0;                // File Note [1]
+      virtual GuiPackKbaseIo_t         SayIoCountsFromKnowledgeBases( void ) const = 0;           // File Note [2]
 
       virtual GuiPackSubjectBasic_t    SayInfoFromSubject( NGuiKey ) const = 0;
       virtual GuiPackSubjectCases_t    SayCurrentCasesFromSubject( NGuiKey ) const = 0;
@@ -70,6 +74,8 @@ class IExportOmni {
 
       virtual GuiPackKronoFull_t       SayFullInfoFromKrono( NGuiKey ) const = 0;
       virtual GuiPackKronoDyna_t       SayDynamicInfoFromKrono( NGuiKey) const = 0;
+      virtual GuiPackKronoFull_t       PeekFullInfoFromKrono( NGuiKey ) const = 0;     // File Note [3]
+      virtual EGuiReply                NoteGuiRequestOnKrono( NGuiKey ) = 0;           // File Note [3]
  
       virtual GuiPackPane_t            SayInfoFromPane( NGuiKey ) const = 0;
  
@@ -104,7 +110,19 @@ struct SExportedHandles {
 
 /* START FILE NOTES XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXX
 
-[1]   
+[1]   Unlike every other call here, the two alert ring readers may be called from any thread, also
+      while another thread is stepping the Domain: the ring is read lock-free, from the caller's own
+      cursor (See class CAlertRing).  Each alert ID is one more than the last; pass the ID after the
+      last alert already seen, or 0 for all alerts still held.
+
+[2]   Also callable from any thread: the counts are running totals over every knowledge base in the
+      process, read from atomics (See class CKnowBaseH5, Class Note [4]).
+
+[3]   SayFullInfoFromKrono() and SayDynamicInfoFromKrono() count as a GUI request on the Krono, which
+      keeps a r-t Krono from release when idle (See class AKrono, Class Note [2]).  A host copying
+      every Krono whether or not anyone views it (e.g., into a read model each step) calls
+      PeekFullInfoFromKrono() instead, which replies the same but does not count, then calls
+      NoteGuiRequestOnKrono() for the Kronos its own clients did view.
 
 --------------------------------------------------------------------------------
 XXX END FILE NOTES */
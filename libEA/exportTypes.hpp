@@ -23,6 +23,7 @@ See the License for the specific language governing permissions and limitations
 #include <utility>
 #include <queue>
 #include <ctime>
+#include <cstdint>
 
 // A type being "free" is one not tied to an exported enum interpretation when returned in vectors, etc.
 // (i.e., "just a number")
@@ -638,6 +639,35 @@ typedef struct SGuiPackSubjectCases {
 
 } GuiPackSubjectCases_t;
 
+
+///
+//  One alert posted to the Domain, as read from its alert ring by ID (cursor), oldest first
+
+typedef struct SGuiPackAlert {
+
+   std::uint64_t                   alertId;        // from 0, in the order alerts were posted
+   time_t                          timestamp;
+   std::string                     subjectText;
+   std::string                     sourceTag;
+   std::string                     alertText;
+   std::string                     fullText;       // as in SayNewAlertsFifoFromDomainThenClear()
+
+} GuiPackAlert_t;
+
+
+///
+//  Running counts of knowledge base I/O, summed over every KB in the process since it started
+
+typedef struct SGuiPackKbaseIo {
+
+   std::uint64_t                   nodesReadFromFile;      // node images loaded from an HDF5 KB
+   std::uint64_t                   nodesWrittenToFile;     // node images written behind to HDF5 KBs
+   std::uint64_t                   flushesToFile;          // write-behind batches, or table flushes
+   std::uint64_t                   imagesReadAtCursor;     // ReadCursorToImage() by cases
+   std::uint64_t                   imagesWrittenAtCursor;  // WriteImageToCursor() by cases
+
+} GuiPackKbaseIo_t;
+
 #endif
 
 //END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
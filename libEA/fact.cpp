@@ -21,6 +21,7 @@ See the License for the specific language governing permissions and limitations
 #include "taskClock.hpp"
 #include "process.hpp"
 #include "mvc_ctrlr.hpp"
+#include "checkpoint.hpp"
 
 #include <algorithm>
 
@@ -46,7 +47,7 @@ AFact::AFact(  CSequence& bArg0,
                                                          bArg1
                            )
                   ),
-                  u_RealtimeTrace ( std::make_unique<CTraceRealtime>(
+                  u_RealtimeTrace ( std::make_unique<CTraceRealtimeLazy>(
                                        bArg1.SayViewRef(),
                                        *u_Rain,
                                        knobKeys_ownedAndAntecedent
@@ -86,7 +87,7 @@ AFact::AFact(  CSequence& bArg0,
                                                          bArg1
                            )
                   ),
-                  u_RealtimeTrace ( std::make_unique<CTraceRealtime>(
+                  u_RealtimeTrace ( std::make_unique<CTraceRealtimeLazy>(
                                        bArg1.SayViewRef(),
                                        *u_Rain,
                                        knobKeys_ownedAndAntecedent
@@ -123,7 +124,7 @@ void AFact::LendRealtimeAccessTo( RtTraceAccessTable_t& ptrTableRef ) const {
 
    std::pair<RtTraceAccessTable_t::iterator, bool> tableVerbReply =
       ptrTableRef.emplace(
-         std::pair< NGuiKey, CTraceRealtime*>(
+         std::pair< NGuiKey, CTraceRealtimeLazy*>(
             u_RealtimeTrace->SayGuiKey(),
             u_RealtimeTrace.get()
          )
@@ -142,6 +143,28 @@ void AFact::LendRealtimeAccessTo( RtTraceAccessTable_t& ptrTableRef ) const {
    return;
 }
 
+
+void AFact::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   u_Rain->AddBytesHeldTo( censusRef );
+   u_RealtimeTrace->AddBytesHeldTo( censusRef );
+   return;
+}
+
+
+void AFact::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ISeqElement::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( spillage );
+   checkpointRef.Exchange( timeOfClaimNow );
+   checkpointRef.Exchange( firstCycle );
+   checkpointRef.Exchange( claimNow );
+   checkpointRef.Exchange( claimWas );
+   checkpointRef.Exchange( claimHasFlipped );
+   u_Rain->ExchangeStateWith( checkpointRef );
+   return;
+}
+
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Implementations for CFactFromFacts
 
@@ -708,6 +731,15 @@ void CFactSustained::LendHistogramKeysTo( std::vector<NGuiKey>& borrowerRef ) co
    return;
 }
 
+
+void CFactSustained::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   AFact::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( cyclesSustained );
+   checkpointRef.Exchange( claimToWatch );
+   return;
+}
+
 /* START FILE NOTES XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXX
 
 [1]   'this' pointer of a non-template ABC must be used to register objects of templated subclass,
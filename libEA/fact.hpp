@@ -41,7 +41,7 @@ class CDomain;
 class CPointAnalog;
 class CPointBinary;
 class CProcess;
-class CTraceRealtime;
+class CTraceRealtimeLazy;
 class CView;
 
 enum struct ESustainedAs : unsigned char {
@@ -71,11 +71,13 @@ class AFact : public ISeqElement {
       bool              HasClaimFlipped( void ) const;
 
       void              LendRealtimeAccessTo( RtTraceAccessTable_t& ) const;
+      void              AddBytesHeldTo( MemoryCensus_t& ) const override;
+      void              ExchangeStateWith( CCheckpoint& ) override;
 
    protected:
 
    // Handles
-      const std::unique_ptr<CTraceRealtime>  u_RealtimeTrace;
+      const std::unique_ptr<CTraceRealtimeLazy>  u_RealtimeTrace;   // Trace itself built on demand
    // Vector of handles to input facts (operands)
       std::vector<AFact*>     p_Operands;                         // See Class Note [1]
 
@@ -249,15 +251,15 @@ class CFactFromChart : public AFact {
 /* CFactRelatingLeftToRight concrete class template declaration.
    This class creates fact objects testing a logical relation (<, >, == ) between two ("Left" and
    "Right") analog (float) quantities, where both are primary (acquired) data (i.e., pulled from
-   respective CRainAnalog objects).  The relation is tested via an embedded functor of a concrete
-   subclass, derived from the CRelnFunctor A.B.C., upon which this class is templated.  If one of the 
-   quantities is considered a guide to which the other refers, then "Right" must be that guide.
+   respective CRainAnalog objects).  The relation is tested via an embedded functor, a specialization
+   of CRelnFunctor, upon which this class is templated.  If one of the quantities is considered a guide
+   to which the other refers, then "Right" must be that guide.  See File Note [2] on getter params.
 */
 template <  typename TTLeftObj,
-            typename TTLeftMFptr,
+            PtrRainGetr_t TTLeftGetter,
             typename TTReln,
             typename TTRightObj,
-            typename TTRightMFptr >
+            PtrRainGetr_t TTRightGetter >
 
 class CFactRelatingLeftToRight : public AFact {
 
@@ -265,16 +267,14 @@ class CFactRelatingLeftToRight : public AFact {
    // Methods
 
        CFactRelatingLeftToRight< TTLeftObj,
-                                 TTLeftMFptr,
+                                 TTLeftGetter,
                                  TTReln,
                                  TTRightObj,
-                                 TTRightMFptr>( CSequence& bArg0,
+                                 TTRightGetter>( CSequence& bArg0,
                                                 ASubject& bArg1,
                                                 EDataLabel bArg2,
                                                 TTLeftObj* const arg0,
-                                                TTLeftMFptr arg1,
                                                 TTRightObj* const arg2,
-                                                TTRightMFptr arg3,
                                                 std::array<float,3> arg4, // hysteresis minDefMax
                                                 std::array<float,3> arg5, // slack minDefMax
                                                 CController& arg6 ) 
@@ -286,8 +286,6 @@ class CFactRelatingLeftToRight : public AFact {
                                                    Relate (arg4[1], arg5[1]),
                                                    p_LeftObject (arg0),
                                                    p_RightObject (arg2),
-                                                   p_LeftGetter (arg1),
-                                                   p_RightGetter (arg3),
                                                    p_LeftRain ( arg0->u_Rain.get() ),
                                                    p_RightRain ( arg2->u_Rain.get() ) {
 
@@ -358,6 +356,13 @@ class CFactRelatingLeftToRight : public AFact {
          return;
       }
 
+      void ExchangeStateWith( CCheckpoint& checkpointRef ) override {
+
+         AFact::ExchangeStateWith( checkpointRef );
+         Relate.ExchangeStateWith( checkpointRef );
+         return;
+      }
+
    private:
    // Functor
       TTReln               Relate;
@@ -366,10 +371,6 @@ class CFactRelatingLeftToRight : public AFact {
       TTLeftObj* const     p_LeftObject; // template avoids separate field for every possible obj type
       TTRightObj* const    p_RightObject;
 
-   // Pointers to specific member functions (defined by args passed) of CRain class
-      TTLeftMFptr          p_LeftGetter;    // class MF ptrs bound to host objects at points of call
-      TTRightMFptr         p_RightGetter;
-
       CRainAnalog* const   p_LeftRain;
       CRainAnalog* const   p_RightRain;
 
@@ -456,9 +457,9 @@ class CFactRelatingLeftToRight : public AFact {
 
             claimWas = claimNow;
 
-            // " ->* " syntax binds method pointer to object pointer, properly completing call
-            claimNow = Relate(   (p_LeftRain->*p_LeftGetter)(),
-                                 (p_RightRain->*p_RightGetter)() );
+            // " ->* " syntax binds method pointer (a template param) to object ptr, completing call
+            claimNow = Relate(   (p_LeftRain->*TTLeftGetter)(),
+                                 (p_RightRain->*TTRightGetter)() );
 
             claimHasFlipped = ( claimWas != claimNow );
 
@@ -489,7 +490,7 @@ class CFactRelatingLeftToRight : public AFact {
 *** TBD the part of this fetching param value from an ASubject object. Currently param is hard coded *** 
 */
 template <  typename TTLeftObj,
-            typename TTLeftMFptr,
+            PtrRainGetr_t TTLeftGetter,
             typename TTReln >
 
    class CFactRelatingLeftToParam : public AFact { // 
@@ -498,12 +499,11 @@ template <  typename TTLeftObj,
       // Methods
 
       CFactRelatingLeftToParam<  TTLeftObj,
-                                 TTLeftMFptr,
+                                 TTLeftGetter,
                                  TTReln>( CSequence& bArg0,
                                           ASubject& bArg1,
                                           EDataLabel bArg2,
                                           TTLeftObj* const arg0,
-                                          TTLeftMFptr arg1,
                                           //const std::function< float (void) > arg2,
                                           float param,    // $$$ TBD to not hard code this $$$
                                           std::array<float,3> arg2, // hysteresis minDefMax
@@ -515,7 +515,6 @@ template <  typename TTLeftObj,
                                              ),
                                              Relate (arg2[1], arg3[1]), // functor copy ctor (Deitel p. 482)
                                              p_LeftObject (arg0),
-                                             p_LeftGetter(arg1),
                                              p_LeftRain ( arg0->u_Rain.get() ),
                                              paramNow (param) {
 
@@ -567,6 +566,13 @@ template <  typename TTLeftObj,
          return;
       }
 
+      void ExchangeStateWith( CCheckpoint& checkpointRef ) override {
+
+         AFact::ExchangeStateWith( checkpointRef );
+         Relate.ExchangeStateWith( checkpointRef );
+         return;
+      }
+
    private:
 
       // Functor
@@ -575,10 +581,6 @@ template <  typename TTLeftObj,
       // Handles
       TTLeftObj* const                       p_LeftObject;
 
-      // Pointers to specific member functions (defined by args passed) of CRain class
-      // class MF ptrs bound to host objects at points of call
-      TTLeftMFptr                            p_LeftGetter;
-
       CRainAnalog* const                     p_LeftRain;
 
       //const std::function<float(void)>       GetParam; // Calls via SubjRef held by ISeqElement
@@ -659,8 +661,8 @@ template <  typename TTLeftObj,
 
             claimWas = claimNow;
 
-            // " ->* " syntax binds method pointer to object pointer, properly completing call
-            claimNow = Relate( (p_LeftRain->*p_LeftGetter)(), paramNow );
+            // " ->* " syntax binds method pointer (a template param) to object ptr, completing call
+            claimNow = Relate( (p_LeftRain->*TTLeftGetter)(), paramNow );
 
             claimHasFlipped = (claimNow != claimWas);
             timeOfClaimNow = (   ( claimHasFlipped || (validWas != validNow) || firstCycle ) ?
@@ -871,6 +873,7 @@ class CFactSustained : public AFact {
       ~CFactSustained( void );
 
       virtual void  LendHistogramKeysTo( std::vector<NGuiKey>& ) const override;
+      virtual void  ExchangeStateWith( CCheckpoint& ) override;
 
    private:
    // Handle
@@ -902,6 +905,12 @@ class CFactSustained : public AFact {
       otherwise the template param has to be supplied, making impossible one vector holding handles to
       all AFact objects.
 
+[2]   The relating classes take the rainfall getter (e.g., &CRainAnalog::NowY) as a non-type template
+      param rather than as a c-tor arg held in a member function pointer field.  The getter is then a
+      compile-time constant at each point of call, so (with the getter defined inline in rainfall.hpp)
+      the compiler reduces it to a plain load.  Together with the functor being fixed by TTReln, each
+      instantiation's Cycle() compiles to straight-line float compares.
+
 --------------------------------------------------------------------------------
 XXX END FILE NOTES */
 
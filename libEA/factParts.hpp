@@ -10,8 +10,8 @@ Unless required by applicable law or agreed to in writing, software distributed
 See the License for the specific language governing permissions and limitations under the License. */
 //XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
 /* File summary:
-   Header both declaring and implementing functor classes supporting the fact and rule classes. 
-   There is no "stateParts.cpp", class was templated in an earlier version.
+   Header both declaring and implementing the functor class template supporting the fact classes. 
+   There is no "factParts.cpp", as the functor is templated upon the relation it tests.
 */
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
 
@@ -19,6 +19,7 @@ See the License for the specific language governing permissions and limitations
 #define FACTPARTS_HPP
 
 #include "customTypes.hpp"
+#include "checkpoint.hpp"   // functor exchanges its own dynamic state
 
 #include <string>
 #include <algorithm>
@@ -27,180 +28,114 @@ See the License for the specific language governing permissions and limitations
 #define NOMINMAX  // Per S.O., any hidden include of windows.h will interfere with std::min/std::max (?)
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
-// Abstract Base Class ("ABC") for all functors called by relations embedded in fact objects.
+// Enumerates the relations a fact object can test between its "Left" and "Right" analog values.
 
-class ARelnFunctor { 
+enum struct ERelation : unsigned char {
 
-   public:
-      virtual           ~ARelnFunctor( void ) { /* empty*/ };
-
-      virtual bool      operator() ( float, float ) { return NaNBOOL; } // See Class Note [1]
+   LT = 0u,    // Left < Right
+   GT,         // Left > Right
+   EQ,         // Left == Right (within slack)
+   GTE,        // Left >= Right
+   LTE         // Left <= Right
+};
 
-      const float&      SayHysterCref( void ) const { return hyster; }  // Used primarily by Knobs
-      const float&      SaySlackCref( void ) const { return slack; }  // Used primarily by Knobs
-      void              SetHyster( float arg0 ) { hyster = arg0; }
-      void              SetSlack( float arg0 ) { slack = arg0; }
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+// Class template for all functors called by relations embedded in fact objects.
 
-      float             SaySpillage( void ) const { return spillage; }
+template <ERelation TTRelation>
 
-      char              SaySymbol( void ) const { return symbol; }
+class CRelnFunctor { 
 
-   protected:
+   public:
 
-      ARelnFunctor(  float arg0,
-                     float arg1,
-                     char arg2 )
+      CRelnFunctor(  float arg0,
+                     float arg1 )
                      :  hyster (arg0),
                         slack (arg1),
                         spillage (0.0f),
-                        symbol (arg2),
-                        resultNow (NaNBOOL),
                         resultWas (false) {
       }
 
-      float       hyster;          // hysteresis
-      float       slack;
-      float       spillage;
-      const char  symbol;
-      bool        resultNow;
-      bool        resultWas;
-
-/* Begin Class Notes '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
-
-[1]   Operator() overload is NOP at ABC level.  Taking cheap-to-copy arguments as PBV, but other
-      implementations, having more exotic args, may warrant PBR.
-
-'' End Class Notes ''' */  
-
-};
-
-/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
-// Subclasses of relation functors.  All implementing code is included with these declarations
-
-class Left_LT_Right : public ARelnFunctor {
-
-   public:
-         
-      Left_LT_Right( float bArg0,
-                     float bArg1 )
-                     :  ARelnFunctor( bArg0, bArg1, '<' ) {
-      }
-
-
-      ~Left_LT_Right( void ) { }
-
-
-      virtual bool operator() ( float left, float right ) override {
- 
-
-         resultNow = ( left < ( right + slack + ( hyster * (resultWas ? 1.0f : 0.0f) ) ) );
-         spillage = (std::max)( 0.0f, (left - right) );
+      ~CRelnFunctor( void ) { }
+
+      bool operator() ( float left, float right ) {   // See Class Note [1]
+
+         // Hysteresis widens the band only while the relation held last cycle (a select, not a branch)
+         const float band = ( slack + ( resultWas ? hyster : 0.0f ) );
+         bool resultNow;
+
+         if constexpr ( TTRelation == ERelation::LT ) {
+            resultNow = ( left < ( right + band ) );
+            spillage = (std::max)( 0.0f, (left - right) );
+         }
+         else if constexpr ( TTRelation == ERelation::GT ) {
+            resultNow = ( left > ( right - band ) );
+            spillage = (std::max)( 0.0f, (right - left) );
+         }
+         else if constexpr ( TTRelation == ERelation::EQ ) {
+            resultNow = ( ( left >= ( right - band ) ) && ( left <= ( right + band ) ) );
+            spillage = ( resultNow ? 0.0f : std::fabs(right - left) );
+         }
+         else if constexpr ( TTRelation == ERelation::GTE ) {
+            resultNow = ( left >= ( right - band ) );
+            spillage = (std::max)( 0.0f, (right - left) );
+         }
+         else {
+            static_assert( TTRelation == ERelation::LTE, "CRelnFunctor given unknown ERelation" );
+            resultNow = ( left <= ( right + band ) );
+            spillage = (std::max)( 0.0f, (left - right) );
+         }
          resultWas = resultNow; // hyster requires placing this AFTER first computation of resultNow
 
          return resultNow;
       }
-};
-
-
-class Left_GT_Right : public ARelnFunctor {
-
-   public:
-         
-      Left_GT_Right( float bArg0,
-                     float bArg1 )
-                     :  ARelnFunctor(bArg0, bArg1,'>' ) {
-      }
-
-
-      ~Left_GT_Right( void ) { }
-
-
-      virtual bool operator() ( float left, float right ) override {
-
-         resultNow = ( left > ( right - slack - ( hyster * (resultWas ? 1.0f : 0.0f) ) ) );
-         spillage = (std::max)( 0.0f, (right - left) );
-         resultWas = resultNow;
-
-         return resultNow;
-      }
-};
-
-
-class Left_EQ_Right : public ARelnFunctor {
-
-   public:
-         
-      explicit Left_EQ_Right( float bArg0,
-                              float bArg1 )
-                              : ARelnFunctor( bArg0, bArg1, '=' ) {
-      }
-
-
-      ~Left_EQ_Right( void ) { }
-
-
-      virtual bool operator() ( float left, float right ) override {
 
+      const float&      SayHysterCref( void ) const { return hyster; }  // Used primarily by Knobs
+      const float&      SaySlackCref( void ) const { return slack; }  // Used primarily by Knobs
+      void              SetHyster( float arg0 ) { hyster = arg0; }
+      void              SetSlack( float arg0 ) { slack = arg0; }
 
-         bool aboveFloor =    ( left >= ( right - slack - ( hyster * (resultWas ? 1.0f : 0.0f) ) ) );
-         bool belowCeiling =  ( left <= ( right + slack + ( hyster * (resultWas ? 1.0f : 0.0f) ) ) );
-         resultNow = ( aboveFloor && belowCeiling );
+      float             SaySpillage( void ) const { return spillage; }
 
-         if (resultNow) { spillage = 0.0f; }
-         else { spillage = std::fabs(right - left); }
-         resultWas = resultNow;
+      void              ExchangeStateWith( CCheckpoint& checkpointRef ) {  // hyster, slack are knobbed
 
-         return resultNow;
+         checkpointRef.Exchange( spillage );
+         checkpointRef.Exchange( resultWas );
+         return;
       }
-};
-
 
-class Left_GTE_Right : public ARelnFunctor {
+      static constexpr char SaySymbol( void ) {
 
-   public:
-         
-      explicit Left_GTE_Right(   float bArg0,
-                                 float bArg1 )
-                                 :  ARelnFunctor(bArg0, bArg1, '>' ) {
+         return ( ( TTRelation == ERelation::LT || TTRelation == ERelation::LTE ) ? '<' :
+                  ( ( TTRelation == ERelation::EQ ) ? '=' : '>' ) );
       }
 
+   private:
 
-      ~Left_GTE_Right( void ) { }
+      float       hyster;          // hysteresis
+      float       slack;
+      float       spillage;
+      bool        resultWas;
 
+/* Begin Class Notes '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 
-      virtual bool operator() ( float left, float right ) override {
+[1]   Operator() is deliberately non-virtual.  Fact objects hold their functor by value and are templated
+      upon its concrete type, so the relation is fixed at compile time and the "if constexpr" chain leaves
+      only the compares of the one relation instantiated.  An earlier version derived these functors from
+      an abstract ARelnFunctor and dispatched operator() through its vtable every cycle.
 
-         resultNow = ( left >= ( right - slack - ( hyster * (resultWas ? 1.0f : 0.0f) ) ) );
-         spillage = (std::max)( 0.0f, (right - left) );
-         resultWas = resultNow;
+'' End Class Notes ''' */  
 
-         return resultNow;
-      }
 };
 
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+// Names by which fact objects are specialized upon a relation (see tool.hpp)
 
-class Left_LTE_Right : public ARelnFunctor {
-
-   public:
-         
-      explicit Left_LTE_Right(   float bArg0,
-                                 float bArg1 )
-                              :  ARelnFunctor(bArg0, bArg1, '<' ) {
-      }
-
-
-      ~Left_LTE_Right( void ) { }
-
-
-      virtual bool operator() ( float left, float right ) override {
- 
-         resultNow = ( left <= ( right + slack + ( hyster * (resultWas ? 1.0f : 0.0f) ) ) );
-         spillage = (std::max)( 0.0f, (left - right) );
-         resultWas = resultNow;
-
-         return resultNow;
-      }
-};
+typedef CRelnFunctor<ERelation::LT>    Left_LT_Right;
+typedef CRelnFunctor<ERelation::GT>    Left_GT_Right;
+typedef CRelnFunctor<ERelation::EQ>    Left_EQ_Right;
+typedef CRelnFunctor<ERelation::GTE>   Left_GTE_Right;
+typedef CRelnFunctor<ERelation::LTE>   Left_LTE_Right;
 
 #endif
 
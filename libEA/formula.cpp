@@ -20,6 +20,7 @@ See the License for the specific language governing permissions and limitations
 #include "rainfall.hpp"
 #include "viewParts.hpp"      // get NGuiKey of traces
 #include "subject.hpp"        // call getters on subject
+#include "checkpoint.hpp"     // save or restore dynamic state
 
 #include <limits>
 #include <algorithm>          // min_element()
@@ -57,7 +58,7 @@ CFormula::CFormula(  CSequence& bArg0,
                                     bArg4
                                  )
                         ),
-                        u_RealtimeTrace ( std::make_unique<CTraceRealtime>(
+                        u_RealtimeTrace ( std::make_unique<CTraceRealtimeLazy>(
                                              bArg1.SayViewRef(),
                                              *u_Rain,
                                              knobKeys_ownedAndAntecedent
@@ -182,7 +183,7 @@ void CFormula::LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ptrTableRef ) c
 
    std::pair<RtTraceAccessTable_t::iterator, bool> tableVerbReply =
       ptrTableRef.emplace(
-         std::pair< NGuiKey, CTraceRealtime*>(
+         std::pair< NGuiKey, CTraceRealtimeLazy*>(
             u_RealtimeTrace->SayGuiKey(),
             u_RealtimeTrace.get()
          )
@@ -197,4 +198,22 @@ void CFormula::LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ptrTableRef ) c
 };
 
 
+void CFormula::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   u_Rain->AddBytesHeldTo( censusRef );
+   u_RealtimeTrace->AddBytesHeldTo( censusRef );
+   return;
+}
+
+
+void CFormula::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ISeqElement::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( resultNow );
+   checkpointRef.Exchange( resultLastValid );
+   u_Rain->ExchangeStateWith( checkpointRef );
+   return;
+}
+
+
 //END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -54,10 +54,12 @@ class CFormula  : public ISeqElement {
 
       virtual void      LendHistogramKeysTo( std::vector<NGuiKey>& ) const override;
       virtual void      LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ) const override;
+      virtual void      AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void      ExchangeStateWith( CCheckpoint& ) override;
 
    private:
 
-      const std::unique_ptr<CTraceRealtime>     u_RealtimeTrace;
+      const std::unique_ptr<CTraceRealtimeLazy> u_RealtimeTrace;   // Trace itself built on demand
       const std::vector<CPointAnalog*>          p_Operands;
  
    // Lambda of a formula, wrapped in std::function, expressing RHS only of an eqn assigning "result"  
@@ -18,6 +18,7 @@ See the License for the specific language governing permissions and limitations
 #include "guiShadow.hpp"
 #include <iostream>
 #include <iomanip>
+#include <cctype>
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Static fields for IGuiShadow
@@ -51,6 +52,12 @@ IGuiShadow::IGuiShadow( EApiType arg0 )      // c-tor called when owner is not a
 
 }
 
+IGuiShadow::IGuiShadow( EApiType arg0, NGuiKey arg1 )    // c-tor adopting a key reserved earlier
+                        :  ownGuiKey ( ( arg1 == NGuiKey(0) ) ? GenerateNewGuiKey() : arg1 ),
+                           ownApiType (arg0) {
+
+}
+
 IGuiShadow::~IGuiShadow( void ) { };
 
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
@@ -465,9 +472,15 @@ std::string IGuiShadow::LookUpText( EDataUnit key ) {
       { ERealName::Subject_vav4,             "vav4_" } \
    }
 
-std::string IGuiShadow::LookUpDiskFile( ERealName key ) {
+static DiskFileTable_t& TableOfDiskFilesByRealName( void ) {   // See Method Note [1] to TabulateRealName()
 
    static DiskFileTable_t     textLookup_DiskFile( INIT_DISKFILE );
+   return textLookup_DiskFile;
+}
+
+std::string IGuiShadow::LookUpDiskFile( ERealName key ) {
+
+   DiskFileTable_t& textLookup_DiskFile = TableOfDiskFilesByRealName();
 
    if ( textLookup_DiskFile.count(key) == 0 ) {
       throw std::logic_error("Attempted untabulated disk filename"); // deliberately no catch
@@ -535,9 +548,15 @@ std::string IGuiShadow::LookUpText( ETimeSpan key ) {
       { ERealName::Subject_vav4,          "VAV-4" } \
    }
 
-std::string IGuiShadow::LookUpText( ERealName key ) {
+static RealNameTable_t& TableOfTextsByRealName( void ) {   // See Method Note [1] to TabulateRealName()
 
    static RealNameTable_t     textLookup_RealName( INIT_REALNAME );
+   return textLookup_RealName;
+}
+
+std::string IGuiShadow::LookUpText( ERealName key ) {
+
+   RealNameTable_t& textLookup_RealName = TableOfTextsByRealName();
 
    if ( textLookup_RealName.count(key) == 0 ) {
       throw std::logic_error("Attempted untabulated real name"); // deliberately no catch
@@ -545,6 +564,56 @@ std::string IGuiShadow::LookUpText( ERealName key ) {
    return textLookup_RealName[key];
 }
 
+
+ERealName IGuiShadow::LookUpRealName( const std::string& nameText ) {
+
+   // Reverse lookup, used only while loading a topology (i.e., never on the per-step path)
+   for ( const auto& entry : TableOfTextsByRealName() ) {
+      if ( entry.second == nameText ) { return entry.first; }
+   }
+   return ERealName::Undefined;
+}
+
+
+ERealName IGuiShadow::TabulateRealName( const std::string& nameText ) {
+
+   // Returns existing name if text already tabulated, else issues next name at or above the
+   // Subject_fromTopology value.  Disk filename stem is the text lower-cased, stripped of all but
+   // alphanumerics, and suffixed with '_' (e.g., "VAV-17" -> "vav17_"), same as built-in names.
+
+   ERealName found = LookUpRealName( nameText );
+   if ( found != ERealName::Undefined ) { return found; }
+   if ( nameText.empty() ) {
+      throw std::logic_error( "Attempted to tabulate real name from empty text" ); // deliberately no catch
+   }
+
+   static unsigned int  nextIssuedValue = static_cast<unsigned int>( ERealName::Subject_fromTopology );
+
+   std::string diskStem;
+   for ( char c : nameText ) {
+      if ( std::isalnum( static_cast<unsigned char>(c) ) ) {
+         diskStem.push_back( static_cast<char>( std::tolower( static_cast<unsigned char>(c) ) ) );
+      }
+   }
+   diskStem.push_back( '_' );
+   for ( const auto& entry : TableOfDiskFilesByRealName() ) {
+      if ( entry.second == diskStem ) {
+         throw std::logic_error( "Real name text collides with an existing disk filename" ); // deliberately no catch
+      }
+   }
+
+   ERealName issued = static_cast<ERealName>( nextIssuedValue++ );
+   TableOfTextsByRealName().emplace( issued, nameText );
+   TableOfDiskFilesByRealName().emplace( issued, diskStem );
+   return issued;
+}
+/* Method Notes:   '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+   [1] Both real-name tables are function-local statics returned by reference so that names issued
+       here, while the topology loads, are seen by every later LookUpText() and LookUpDiskFile().
+       Function-local (vs. class-static) avoids any static-initialization-order hazard, since the
+       application is constructed from a library constructor (see libmain.cpp) before main().
+*/
+
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 
 #define INIT_GUITYPE \
@@ -606,6 +675,8 @@ EApiType IGuiShadow::SayApiType( void ) const { return ownApiType; }
 
 NGuiKey IGuiShadow::GenerateNewGuiKey( void ) { return NGuiKey( nextFreshKeySeedValue++ ); }
 
+NGuiKey IGuiShadow::ReserveGuiKey( void ) { return GenerateNewGuiKey(); }
+
 //======================================================================================================/
 // Protected methods
 
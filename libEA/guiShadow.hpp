@@ -61,6 +61,10 @@ class IGuiShadow {
       static std::string                  LookUpText( EInfoMode );
       static std::string                  LookUpText( ETimeSpan );
       static std::string                  LookUpText( ERealName );
+      static ERealName                    LookUpRealName( const std::string& );  // Undefined if untabulated
+      static ERealName                    TabulateRealName( const std::string& ); // issues if untabulated
+
+      static NGuiKey                      ReserveGuiKey( void );   // for a shadow to be constructed later
 
    protected:
    // Fields
@@ -77,6 +81,7 @@ class IGuiShadow {
    // Methods
 
    explicit IGuiShadow( EApiType );
+   IGuiShadow( EApiType, NGuiKey );          // adopts a key from ReserveGuiKey(), or if NGuiKey(0) makes one
    static NGuiKey                         GenerateNewGuiKey( void );
 
    static AlertMsgTable_t                 InitLookupTable_AlertMsg( void );
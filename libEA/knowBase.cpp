@@ -14,21 +14,71 @@ See the License for the specific language governing permissions and limitations
    engine of a CCase object and a knowledge base (KB) on disk.
    The CKnowBaseH5 methods instantiate and destroy objects of the namespace H5Kit, which are the 
    lower-level of intermediary code, calling functions of the HDF5 C-language API.
+   Node reads are served from memory; node writes go to file in batches from the controller's writer.
+   If so configured, nodes are instead held in a memory-mapped table, with HDF5 for import/export.
 */
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
 
 #include "knowBase.hpp"
 #include "knowParts.hpp"
+#include "knowTable.hpp"
 #include "HDF5Parts.hpp"
 
 #include <iostream>
 #include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+
+const char* const ENV_VAR_NAMING_KBASE_FORMAT = "EA_KBASE_FORMAT";
+const char* const KBASE_FORMAT_MAPPED = "mapped";
+
+static bool IsMappedKbaseFormatChosen( void ) {
+
+   const char* p_format = std::getenv( ENV_VAR_NAMING_KBASE_FORMAT );
+   return ( ( p_format != nullptr ) && ( std::string( p_format ) == KBASE_FORMAT_MAPPED ) );
+}
+
+static std::string SayTableFilenameFor( const std::string& hdf5Filename ) {
+
+   const std::string suffixHdf5 = ".h5";
+   const bool hasSuffix =  ( hdf5Filename.size() > suffixHdf5.size() ) &&
+                           ( hdf5Filename.compare(   hdf5Filename.size() - suffixHdf5.size(),
+                                                      suffixHdf5.size(),
+                                                      suffixHdf5 ) == 0 );
+   return ( ( hasSuffix ? hdf5Filename.substr( 0, hdf5Filename.size() - suffixHdf5.size() ) :
+                          hdf5Filename ) + ".kbt" );
+}
 
 //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV5
 // Implementations for CKnowBaseH5
 
+std::atomic<std::uint64_t> CKnowBaseH5::numNodesReadFromFile( 0 );
+std::atomic<std::uint64_t> CKnowBaseH5::numNodesWrittenToFile( 0 );
+std::atomic<std::uint64_t> CKnowBaseH5::numFlushesToFile( 0 );
+std::atomic<std::uint64_t> CKnowBaseH5::numImagesReadAtCursor( 0 );
+std::atomic<std::uint64_t> CKnowBaseH5::numImagesWrittenAtCursor( 0 );
+
+
+GuiPackKbaseIo_t CKnowBaseH5::SayIoCountsAcrossKbases( void ) {
+
+   GuiPackKbaseIo_t counts;
+   counts.nodesReadFromFile = numNodesReadFromFile.load( std::memory_order_relaxed );
+   counts.nodesWrittenToFile = numNodesWrittenToFile.load( std::memory_order_relaxed );
+   counts.flushesToFile = numFlushesToFile.load( std::memory_order_relaxed );
+   counts.imagesReadAtCursor = numImagesReadAtCursor.load( std::memory_order_relaxed );
+   counts.imagesWrittenAtCursor = numImagesWrittenAtCursor.load( std::memory_order_relaxed );
+   return counts;
+}
+
+
 CKnowBaseH5::CKnowBaseH5(  std::string arg)
                            :  hdf5Filename (arg),
+                              u_FileOpenRW(),
+                              u_TableMapped(),
+                              nodeIndices_byCoords(),
+                              nodeImagesCached_sortedByCoords(),
+                              nodeImagesToWrite_byCoords(),
                               p_HypoById(),
                               p_EvidById(),
                               mimicBase(),
@@ -37,20 +87,47 @@ CKnowBaseH5::CKnowBaseH5(  std::string arg)
                               evidZ (0),
                               numNodesActive (0),
                               cursorAtActiveNode (false),
-                              kbaseIsPreexistantHdf5File (false) {
+                              kbaseIsPreexistant (false),
+                              fileClosedForShutdown (false) {
+
+   // See Class Note [3] in header
+   const bool formatIsMapped = IsMappedKbaseFormatChosen();
+   const std::string tableFilename = SayTableFilenameFor( hdf5Filename );
+
+   if ( formatIsMapped && ( std::ifstream( tableFilename ).good() ||
+                            ( ! H5Kit::IsNameAnHdf5File( hdf5Filename ) ) ) ) {
+      u_TableMapped = std::make_unique<CKnodeTableMapped>( tableFilename );   // existing or new empty
+      kbaseIsPreexistant = RebuildMimicFromTable();
+      return;
+   }
 
-   H5Kit::CFileCreatedIffAbsent KbaseCreator( arg );
-   if ( KbaseCreator.WasPreexistingKbaseFound() ) {
-      kbaseIsPreexistantHdf5File = RebuildMimicFromFile();
+   {  // creator closes its own handle upon leaving scope
+      H5Kit::CFileCreatedIffAbsent KbaseCreator( arg );
+      kbaseIsPreexistant = KbaseCreator.WasPreexistingKbaseFound();
+   }
+   if ( kbaseIsPreexistant ) {
+      kbaseIsPreexistant = RebuildMimicFromFile();
    }
 
+   if ( formatIsMapped ) {    // one-time import of HDF5 KB into a new table, then HDF5 file is let go
+      const std::string tableFilenameTemp = tableFilename + ".tmp";
+      std::remove( tableFilenameTemp.c_str() );      // left by an import cut short, never trusted
+      u_TableMapped = std::make_unique<CKnodeTableMapped>( tableFilenameTemp );
+      for ( const auto& pairCref : nodeImagesCached_sortedByCoords ) {
+         nodeIndices_byCoords[pairCref.first] = u_TableMapped->AppendNode( pairCref.first,
+                                                                           pairCref.second );
+      }
+      u_TableMapped->SyncAndRenameTo( tableFilename );   // See Class Note [3] in knowTable.hpp
+      nodeImagesCached_sortedByCoords = {};   // releases storage too
+   }
+   u_FileOpenRW.reset();      // See Class Note [2] in header
 }
 
 
 CKnowBaseH5::~CKnowBaseH5(void) {
 
-   // Empty d-tor
- }
+   CloseFileAfterWritesBehind();
+}
 
 
 //======================================================================================================/
@@ -69,14 +146,14 @@ bool CKnowBaseH5::RebuildMimicFromFile( void ) {  // **** TBD that this checks a
 
    bool reply = false;
    mimicBase.clear();   // TBD to check this releases all allocated memory including sub-elements
-   H5Kit::CFileOpenedReadOnly FileOpenRO( hdf5Filename );
-   hid_t fid = FileOpenRO.SayId();
+   nodeImagesCached_sortedByCoords.clear();
 
    std::string pathRuleToHypo("");
    std::string pathFileToRule("");
    std::string pathRelativeToFile("/");
 
-   H5Kit::CGroupIteratedOnSubgrps LookUpRulesHeld( FileOpenRO.SayId(), pathRelativeToFile, 'R' );
+   const hid_t fid = SayFileOpenedRef().SayId();   // c-tor lets go of file once mimic is rebuilt
+   H5Kit::CGroupIteratedOnSubgrps LookUpRulesHeld( fid, pathRelativeToFile, 'R' );
 
    if ( LookUpRulesHeld.SayNumSubgrpsFound() < 0 ) { return reply; }       // rule extraction fail
    else if ( LookUpRulesHeld.SayNumSubgrpsFound() == 0 ) { return reply; } // no rules found
@@ -90,7 +167,7 @@ bool CKnowBaseH5::RebuildMimicFromFile( void ) {  // **** TBD that this checks a
          pathFileToRule = "/" + ConvertIdToNameInKbase('R', ruleIdsFound.at(i_r));
          pathRelativeToFile = pathFileToRule;
 
-         H5Kit::CGroupIteratedOnSubgrps LookUpHyposOnRule( FileOpenRO.SayId(), pathRelativeToFile, 'H' );
+         H5Kit::CGroupIteratedOnSubgrps LookUpHyposOnRule( fid, pathRelativeToFile, 'H' );
 
          std::vector<Nzint_t> hypoIdsOnRule( LookUpHyposOnRule.SayIdsFound() );
 
@@ -99,7 +176,7 @@ bool CKnowBaseH5::RebuildMimicFromFile( void ) {  // **** TBD that this checks a
             pathRuleToHypo = "/" + ConvertIdToNameInKbase('H', hypoIdsOnRule.at(i_h));
             pathRelativeToFile = pathFileToRule + pathRuleToHypo;
 
-            H5Kit::CGroupIteratedOnSubgrps LookUpEvidsOnHypo( FileOpenRO.SayId(), pathRelativeToFile, 'E' );
+            H5Kit::CGroupIteratedOnSubgrps LookUpEvidsOnHypo( fid, pathRelativeToFile, 'E' );
 
             std::vector<Nzint_t> evidIdsOnHypo( LookUpEvidsOnHypo.SayIdsFound() );
             std::vector<std::string> evidNamesOnHypo( LookUpEvidsOnHypo.SayNamesFound() );
@@ -107,6 +184,7 @@ bool CKnowBaseH5::RebuildMimicFromFile( void ) {  // **** TBD that this checks a
             for ( size_t i_e=0; i_e < evidIdsOnHypo.size(); ++i_e ) {
 
                mimicBase[ ruleIdsFound.at(i_r) ][ hypoIdsOnRule.at(i_h) ].push_back( evidIdsOnHypo.at(i_e) );
+               CacheNodeFromFile( { ruleIdsFound.at(i_r), hypoIdsOnRule.at(i_h), evidIdsOnHypo.at(i_e) } );
             }
          }
       }
@@ -116,6 +194,116 @@ bool CKnowBaseH5::RebuildMimicFromFile( void ) {  // **** TBD that this checks a
 }
 
 
+bool CKnowBaseH5::RebuildMimicFromTable( void ) {
+
+   // One pass over contiguous records builds both the mimic and the index into the table
+   mimicBase.clear();
+   nodeIndices_byCoords.clear();
+
+   const size_t numNodesInTable = u_TableMapped->SayNumNodes();
+   for ( size_t i = 0; i < numNodesInTable; ++i ) {
+
+      const KnodeCoords_t coords = u_TableMapped->SayCoordsAt( i );
+      mimicBase[ coords[0] ][ coords[1] ].push_back( coords[2] );
+      nodeIndices_byCoords.emplace( coords, i );
+   }
+   return ( numNodesInTable > 0 );
+}
+
+
+void CKnowBaseH5::CacheNodeFromFile( const KnodeCoords_t& coords ) {
+
+   // Caller must hold fileLock, unless calling from c-tor (i.e., before writer thread is started)
+
+   const std::string pathToNode =   "/" + ConvertIdToNameInKbase( 'R', coords[0] ) +
+                                    "/" + ConvertIdToNameInKbase( 'H', coords[1] ) +
+                                    "/" + ConvertIdToNameInKbase( 'E', coords[2] );
+
+   Knode_t& imageCachedRef = SayCachedImageRef( coords );
+   H5Kit::CDatasetOpened NodeOpenRO( SayFileOpenedRef().SayId(), pathToNode );
+   H5Kit::CDatasetMediator MediatorRO( imageCachedRef, false );
+   MediatorRO.SetDatasetIdTo( NodeOpenRO.SayId() );
+   MediatorRO.CopyDatasetToImage();
+   numNodesReadFromFile.fetch_add( 1, std::memory_order_relaxed );
+   return;
+}
+
+
+void CKnowBaseH5::WriteBatchToFile( std::map<KnodeCoords_t, Knode_t>& batchRef ) {
+
+   // Caller must hold fileLock.  Whole batch goes out under a single flush of the file.
+
+   for ( auto& pairRef : batchRef ) {
+
+      const std::string pathToNode =   "/" + ConvertIdToNameInKbase( 'R', pairRef.first[0] ) +
+                                       "/" + ConvertIdToNameInKbase( 'H', pairRef.first[1] ) +
+                                       "/" + ConvertIdToNameInKbase( 'E', pairRef.first[2] );
+
+      H5Kit::CDatasetOpened NodeOpenRW( SayFileOpenedRef().SayId(), pathToNode );
+      H5Kit::CDatasetMediator MediatorRW( pairRef.second, true );
+      MediatorRW.SetDatasetIdTo( NodeOpenRW.SayId() );
+      MediatorRW.CopyImageToDataset();
+   }
+   u_FileOpenRW->FlushAllWrites();
+   numNodesWrittenToFile.fetch_add( batchRef.size(), std::memory_order_relaxed );
+   numFlushesToFile.fetch_add( 1, std::memory_order_relaxed );
+   return;
+}
+
+
+H5Kit::CFileOpenedReadWrite& CKnowBaseH5::SayFileOpenedRef( void ) {
+
+   // Caller must hold fileLock, unless calling from c-tor.  File stays open until the next batch ends.
+   if ( fileClosedForShutdown ) {
+      throw std::logic_error( "Knowledge base closed for shutdown cannot be written" ); // deliberately no catch
+   }
+   if ( ! u_FileOpenRW ) { u_FileOpenRW = std::make_unique<H5Kit::CFileOpenedReadWrite>( hdf5Filename ); }
+   return *u_FileOpenRW;
+}
+
+
+Knode_t& CKnowBaseH5::SayCachedImageRef( const KnodeCoords_t& coords ) {
+
+   auto iter = std::lower_bound( nodeImagesCached_sortedByCoords.begin(),
+                                 nodeImagesCached_sortedByCoords.end(),
+                                 coords,
+                                 [] ( const std::pair<KnodeCoords_t, Knode_t>& pairCref,
+                                      const KnodeCoords_t& coordsCref ) -> bool {
+                                    return ( pairCref.first < coordsCref ); } );
+
+   if ( ( iter == nodeImagesCached_sortedByCoords.end() ) || ( iter->first != coords ) ) {
+      iter = nodeImagesCached_sortedByCoords.insert( iter, { coords, Knode_t{} } );
+   }
+   return iter->second;
+}
+
+
+const Knode_t* CKnowBaseH5::SayCachedImagePtr( const KnodeCoords_t& coords ) const {
+
+   auto citer = std::lower_bound(   nodeImagesCached_sortedByCoords.cbegin(),
+                                    nodeImagesCached_sortedByCoords.cend(),
+                                    coords,
+                                    [] ( const std::pair<KnodeCoords_t, Knode_t>& pairCref,
+                                         const KnodeCoords_t& coordsCref ) -> bool {
+                                       return ( pairCref.first < coordsCref ); } );
+
+   return ( ( ( citer == nodeImagesCached_sortedByCoords.cend() ) || ( citer->first != coords ) ) ?
+            nullptr : &citer->second );
+}
+
+
+KnodeCoords_t CKnowBaseH5::SayCursorCoords( void ) const { return { ruleX, hypoY, evidZ }; }
+
+
+Knode_t CKnowBaseH5::SayImageAtCoords( const KnodeCoords_t& coords ) const {
+
+   Knode_t image{};
+   if ( u_TableMapped ) { u_TableMapped->ReadNodeAt( nodeIndices_byCoords.at( coords ), image ); }
+   else if ( const Knode_t* p_imageCached = SayCachedImagePtr( coords ) ) { image = *p_imageCached; }
+   return image;
+}
+
+
 //======================================================================================================/
 // Public methods
 
@@ -129,7 +317,7 @@ void CKnowBaseH5::InitializeNodeAt( Nzint_t ruleId,
                                     bool logicInvertible,
                                     const std::vector<Nzint_t>& idAllHyposAssocToRule) {
 
-   if ( ! kbaseIsPreexistantHdf5File ) {
+   if ( ! kbaseIsPreexistant ) {
 
       /* "By design" because this method is called to initialize the knowledge base (KB) nodes needed
           to meet the expert system designer's original intent, versus any more nodes the KB learns
@@ -137,7 +325,6 @@ void CKnowBaseH5::InitializeNodeAt( Nzint_t ruleId,
       */
       const size_t numHypos = idAllHyposAssocToRule.size();
       const bool oneOrMoreAltHypos = (numHypos > 1);
-      H5Kit::CFileOpenedReadWrite KbaseOpenRW( hdf5Filename );
 
       /*
       At each node of Kbase is a type Knode "JOT" (joint occurence table) holding occurences (counts)
@@ -217,7 +404,7 @@ void CKnowBaseH5::InitializeNodeAt( Nzint_t ruleId,
             if (cursorAtActiveNode) { WriteImageToCursor(); }
          }
       }
-   }  // Close "if" on (! kbaseIsPreexistantHdf5File)
+   }  // Close "if" on (! kbaseIsPreexistant)
 
    //  kBase to hold pointers to all hypos and evids, so CCase objects only need hold a p_Rule
 
@@ -264,9 +451,25 @@ void CKnowBaseH5::PanCursorToNodeAt( Nzint_t ruleId, Nzint_t hypoId, Nzint_t evi
       }
    }
 
-   if ( panAllowed && ( !cursorAtActiveNode ) ) {
+   if ( panAllowed && ( !cursorAtActiveNode ) && u_TableMapped ) {
+
+      // A node added to table is published whole, See Class Note [2] in knowTable.hpp
+      std::lock_guard<std::mutex> fileLockHeld( fileLock );
+      nodeIndices_byCoords[ { ruleId, hypoId, evidId } ] =
+         u_TableMapped->AppendNode( { ruleId, hypoId, evidId }, Knode_t{} );
+      mimicBase[ruleId][hypoId].push_back(evidId);
+      ++numNodesActive;
+
+      ruleX = ruleId;
+      hypoY = hypoId;
+      evidZ = evidId;
+      cursorAtActiveNode = true;
+   }
+   else if ( panAllowed && ( !cursorAtActiveNode ) ) {
 
-      H5Kit::CFileOpenedReadWrite KbaseOpenRW( hdf5Filename );
+      // Node creation is not deferred, so writer never reaches a node absent from file
+      std::lock_guard<std::mutex> fileLockHeld( fileLock );
+      const hid_t fid = SayFileOpenedRef().SayId();
       std::string nameRuleToLink = ConvertIdToNameInKbase('R', ruleId);
       std::string nameHypoToLink = ConvertIdToNameInKbase('H', hypoId);
       std::string nameEvidToLink = ConvertIdToNameInKbase('E', evidId);
@@ -275,7 +478,7 @@ void CKnowBaseH5::PanCursorToNodeAt( Nzint_t ruleId, Nzint_t hypoId, Nzint_t evi
 
          case 'X':   // Entire R-H-E intersection previously unknown to Kbase.  Link all three.
             {     // C++ requires declarations in a case stmt to be scoped locally to the case.
-               H5Kit::CGroupCreated RuleLinked( KbaseOpenRW.SayId(), nameRuleToLink);
+               H5Kit::CGroupCreated RuleLinked( fid, nameRuleToLink);
                H5Kit::CGroupCreated HypoLinked( RuleLinked.SayId(), nameHypoToLink);
                H5Kit::CDatasetCreated NodeMade( HypoLinked.SayId(), nameEvidToLink, 3, 2, 0 );
             }
@@ -284,7 +487,7 @@ void CKnowBaseH5::PanCursorToNodeAt( Nzint_t ruleId, Nzint_t hypoId, Nzint_t evi
          case 'R':   // Rule known, but it has no links (subgroups) for the hypo and evid given.
             {
                std::string dirPathToRule = ("/" + nameRuleToLink);
-               H5Kit::CGroupOpened RuleOpenForLinks(KbaseOpenRW.SayId(), dirPathToRule);
+               H5Kit::CGroupOpened RuleOpenForLinks(fid, dirPathToRule);
                H5Kit::CGroupCreated HypoLinked(RuleOpenForLinks.SayId(), nameHypoToLink);
                H5Kit::CDatasetCreated NodeMade(HypoLinked.SayId(), nameEvidToLink, 3, 2, 0);
             }
@@ -293,7 +496,7 @@ void CKnowBaseH5::PanCursorToNodeAt( Nzint_t ruleId, Nzint_t hypoId, Nzint_t evi
          case 'H':   // Rule and hypo are known to be linked, but evid given is not linked to hypo.
             {
                std::string dirPathToHypoViaRule = ("/" + nameRuleToLink + "/" + nameHypoToLink);
-               H5Kit::CGroupOpened HypoOpenForLinks(KbaseOpenRW.SayId(), dirPathToHypoViaRule);
+               H5Kit::CGroupOpened HypoOpenForLinks(fid, dirPathToHypoViaRule);
                H5Kit::CDatasetCreated NodeMade(HypoOpenForLinks.SayId(), nameEvidToLink, 3, 2, 0);
             }
             break;
@@ -304,6 +507,7 @@ void CKnowBaseH5::PanCursorToNodeAt( Nzint_t ruleId, Nzint_t hypoId, Nzint_t evi
 
       // Update mimicBase and counter to reflect the new node added to actual knowledge base
       mimicBase[ruleId][hypoId].push_back(evidId);
+      SayCachedImageRef( { ruleId, hypoId, evidId } ) = Knode_t{};   // new dataset reads as zeros
        ++numNodesActive;
 
       // Set cursor to the new node
@@ -322,7 +526,8 @@ size_t CKnowBaseH5::SayNumNodesActive( void ) const { return numNodesActive; }
 void CKnowBaseH5::InitializeCaseTallies(  Nzint_t caseRule,
                                           HypoTallyMap_t& caseHypoTally,
                                           EvidTallyMap_t& caseEvidTally,
-                                          Tally_t& sumTruesOfAllCaseHypos ) {
+                                          Tally_t& sumTruesOfAllCaseHypos,
+                                          SCaseTallyMatrix& caseMatrix ) {
 
    if (( ! mimicBase.empty() ) && ( mimicBase.count(caseRule) > 0) ) {
 
@@ -398,7 +603,58 @@ void CKnowBaseH5::InitializeCaseTallies(  Nzint_t caseRule,
       // Current hypo loaded into hypoTally
 
       ruleX = 0;  // pan cursor to origin upon method rtn
+
+      //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+      // Lay out dense tallies of case, rows in the order case will iterate its hypoTally
+
+      caseMatrix.hypoUais.clear();
+      caseMatrix.evidUais.clear();
+      for ( const auto& hypoCref : caseHypoTally ) { caseMatrix.hypoUais.push_back( hypoCref.first ); }
+      for ( const auto& evidCref : caseEvidTally ) { caseMatrix.evidUais.push_back( evidCref.first ); }
+      LoadCaseTallyMatrix( caseRule, caseMatrix );
+   }
+   return;
+}
+
+
+void CKnowBaseH5::LoadCaseTallyMatrix( Nzint_t caseRule, SCaseTallyMatrix& caseMatrix ) {
+
+   const size_t numHypos = caseMatrix.hypoUais.size();
+   caseMatrix.countsTrue.assign( 3u * numHypos * caseMatrix.evidUais.size(), 0 );
+   caseMatrix.countsFalse.assign( caseMatrix.countsTrue.size(), 0 );
+
+   if ( mimicBase.count(caseRule) == 0 ) { return; }
+
+   std::unordered_map<Nzint_t, size_t> iEvidColById;
+   for ( size_t iCol = 0; iCol < caseMatrix.evidUais.size(); ++iCol ) {
+      iEvidColById.emplace( caseMatrix.evidUais[iCol], iCol );
+   }
+   ruleX = caseRule;
+
+   for ( size_t iRow = 0; iRow < numHypos; ++iRow ) {
+
+      hypoY = caseMatrix.hypoUais[iRow];
+      if ( mimicBase.at(ruleX).count(hypoY) == 0 ) { continue; }
+
+      for ( Nzint_t evidId : mimicBase.at(ruleX).at(hypoY) ) {   // only nodes KB holds; others stay 0
+
+         auto citerCol = iEvidColById.find( evidId );
+         if ( citerCol == iEvidColById.end() ) { continue; }
+
+         evidZ = evidId;
+         cursorAtActiveNode = true;
+         ReadCursorToImage();
+         for ( size_t evidValue = 0; evidValue < 3; ++evidValue ) {
+            const size_t iCell = caseMatrix.SayOffsetTo( citerCol->second, evidValue ) + iRow;
+            caseMatrix.countsTrue[iCell] = nodeImage.at(evidValue).at(1);
+            caseMatrix.countsFalse[iCell] = nodeImage.at(evidValue).at(0);
+         }
+      }
    }
+   ruleX = 0;  // pan cursor to origin upon method rtn
+   hypoY = 0;
+   evidZ = 0;
+   cursorAtActiveNode = false;
    return;
 }
 
@@ -513,15 +769,21 @@ bool CKnowBaseH5::ReadCursorToImage( void ) {
 
    if ( cursorAtActiveNode ) {
 
-      H5Kit::CFileOpenedReadOnly KbaseOpenRO( hdf5Filename );
-      std::string pathToNode =   "/" + ConvertIdToNameInKbase('R', ruleX) +
-                                 "/" + ConvertIdToNameInKbase('H', hypoY) +
-                                 "/" + ConvertIdToNameInKbase('E', evidZ);
+      const KnodeCoords_t coords = SayCursorCoords();
+
+      numImagesReadAtCursor.fetch_add( 1, std::memory_order_relaxed );
+      if ( u_TableMapped ) {
+         u_TableMapped->ReadNodeAt( nodeIndices_byCoords.at( coords ), nodeImage );
+         return true;
+      }
+      const Knode_t* p_imageCached = SayCachedImagePtr( coords );
 
-      H5Kit::CDatasetOpened NodeOpenRO( KbaseOpenRO.SayId(), pathToNode );
-      H5Kit::CDatasetMediator MediatorRO( nodeImage, false );
-      MediatorRO.SetDatasetIdTo( NodeOpenRO.SayId() );
-      MediatorRO.CopyDatasetToImage();
+      if ( p_imageCached == nullptr ) {  // not expected, as c-tor caches every node
+         std::lock_guard<std::mutex> fileLockHeld( fileLock );
+         CacheNodeFromFile( coords );
+         p_imageCached = SayCachedImagePtr( coords );
+      }
+      nodeImage = *p_imageCached;
       reply = true;
    }
    return reply;
@@ -534,20 +796,84 @@ bool CKnowBaseH5::WriteImageToCursor( void ) {
 
    if ( cursorAtActiveNode ) {
 
-      H5Kit::CFileOpenedReadWrite KbaseOpenRW( hdf5Filename );
-      std::string pathToNode =   "/" + ConvertIdToNameInKbase( 'R', ruleX ) +
-                                 "/" + ConvertIdToNameInKbase( 'H', hypoY ) +
-                                 "/" + ConvertIdToNameInKbase( 'E', evidZ );
+      const KnodeCoords_t coords = SayCursorCoords();
 
-      H5Kit::CDatasetOpened NodeOpenRW( KbaseOpenRW.SayId(), pathToNode );
-      H5Kit::CDatasetMediator MediatorRW( nodeImage, true );
-      MediatorRW.SetDatasetIdTo( NodeOpenRW.SayId() );
-      MediatorRW.CopyImageToDataset();
-      MediatorRW.FlushAfterWrite();
+      numImagesWrittenAtCursor.fetch_add( 1, std::memory_order_relaxed );
+      if ( u_TableMapped ) {
+         u_TableMapped->WriteNodeAt( nodeIndices_byCoords.at( coords ), nodeImage );
+         return true;
+      }
+      SayCachedImageRef( coords ) = nodeImage;
+
+      std::lock_guard<std::mutex> writesLockHeld( writesLock );
+      nodeImagesToWrite_byCoords[coords] = nodeImage;    // newer image of a queued node supersedes it
       reply = true;
     }
    return reply;
 }
 
 
+void CKnowBaseH5::FlushWritesBehind( void ) {
+
+   // Lock order is always fileLock then writesLock, so no batch can overtake a newer one to file
+   std::lock_guard<std::mutex> fileLockHeld( fileLock );
+   if ( u_TableMapped ) {     // lock keeps an append from re-mapping the table under the flush
+      if ( u_TableMapped->FlushToDisk() ) { numFlushesToFile.fetch_add( 1, std::memory_order_relaxed ); }
+      return;
+   }
+   if ( fileClosedForShutdown ) { return; }     // nothing more reaches disk
+   std::map<KnodeCoords_t, Knode_t> batch;
+   {
+      std::lock_guard<std::mutex> writesLockHeld( writesLock );
+      batch.swap( nodeImagesToWrite_byCoords );
+   }
+   if ( ! batch.empty() ) { WriteBatchToFile( batch ); }
+   u_FileOpenRW.reset();      // also lets go of a file opened since last batch to create nodes
+   return;
+}
+
+
+void CKnowBaseH5::CloseFileAfterWritesBehind( void ) {
+
+   FlushWritesBehind();       // final drain of the queue, then closes the file
+   std::lock_guard<std::mutex> fileLockHeld( fileLock );
+   fileClosedForShutdown = true;
+   return;
+}
+
+
+bool CKnowBaseH5::ExportToHdf5File( const std::string& exportFilename ) {
+
+   // Never overwrites: the export must be to a name not already holding an HDF5 file
+   if ( H5Kit::IsNameAnHdf5File( exportFilename ) ) { return false; }
+
+   std::lock_guard<std::mutex> fileLockHeld( fileLock );
+   {
+      H5Kit::CFileCreatedIffAbsent ExportCreator( exportFilename );
+   }
+   H5Kit::CFileOpenedReadWrite ExportOpenRW( exportFilename );
+
+   for ( const auto& ruleCref : mimicBase ) {
+
+      H5Kit::CGroupCreated RuleLinked( ExportOpenRW.SayId(), ConvertIdToNameInKbase( 'R', ruleCref.first ) );
+
+      for ( const auto& hypoCref : ruleCref.second ) {
+
+         H5Kit::CGroupCreated HypoLinked( RuleLinked.SayId(), ConvertIdToNameInKbase( 'H', hypoCref.first ) );
+
+         for ( const Nzint_t evidId : hypoCref.second ) {
+
+            Knode_t image = SayImageAtCoords( { ruleCref.first, hypoCref.first, evidId } );
+            H5Kit::CDatasetCreated NodeMade( HypoLinked.SayId(), ConvertIdToNameInKbase( 'E', evidId ), 3, 2, 0 );
+            H5Kit::CDatasetMediator MediatorRW( image, true );
+            MediatorRW.SetDatasetIdTo( NodeMade.SayId() );
+            MediatorRW.CopyImageToDataset();
+         }
+      }
+   }
+   ExportOpenRW.FlushAllWrites();
+   return true;
+}
+
+
 //END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -14,6 +14,11 @@ See the License for the specific language governing permissions and limitations
    engine of a CCase object and a knowledge base (KB) on disk.
    The CKnowBaseH5 methods instantiate and destroy objects of the namespace H5Kit, which are the 
    lower-level of intermediary code, calling functions of the HDF5 C-language API.
+   All node images are held in memory.  Writes reach the file "behind" the caller, in batches that the
+   controller's writer thread makes for every KB, and the file is open only while a batch is written
+   (See Class Note [2]).
+   Alternatively, KB nodes live in a memory-mapped table (CKnodeTableMapped), with HDF5 then used only
+   to import a prior KB and to export one (See Class Note [3]).
 */
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
 
@@ -21,9 +26,18 @@ See the License for the specific language governing permissions and limitations
 #define KNOWBASE_HPP
 
 #include "diagnosticTypes.hpp"
+#include "exportTypes.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
 
 class CEvid;
 class CHypo;
+class CKnodeTableMapped;
+
+namespace H5Kit { class CFileOpenedReadWrite; }
 
 //VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
 // Knowledge base
@@ -34,6 +48,8 @@ public:
 
    explicit CKnowBaseH5( std::string );
    ~CKnowBaseH5( void );
+   CKnowBaseH5( const CKnowBaseH5& ) = delete;
+   CKnowBaseH5& operator=( const CKnowBaseH5& ) = delete;
 
    void     InitializeNodeAt( Nzint_t,
                               Nzint_t,
@@ -52,7 +68,9 @@ public:
    void     InitializeCaseTallies(  Nzint_t,                      // See Class Note [1]
                                     HypoTallyMap_t&,
                                     EvidTallyMap_t&,
-                                    Tally_t& );
+                                    Tally_t&,
+                                    SCaseTallyMatrix& );
+   void     LoadCaseTallyMatrix( Nzint_t, SCaseTallyMatrix& );   // refill rows/cols already given
 
    Tally_t  PriorCountsHypoTrueWhenEvid( size_t ) const;
    Tally_t  PriorCountsHypoFalseWhenEvid( size_t ) const;
@@ -63,6 +81,11 @@ public:
    void     IncrementHypoFalseForEvid( size_t );
    void     DevolveCounts( size_t );
    void     DevolveCounts( void );
+   void     FlushWritesBehind( void );                         // See Class Note [2]
+   void     CloseFileAfterWritesBehind( void );
+   bool     ExportToHdf5File( const std::string& );            // See Class Note [3]
+
+   static GuiPackKbaseIo_t SayIoCountsAcrossKbases( void );    // See Class Note [4]
 
 
 private:
@@ -70,7 +93,14 @@ private:
    // Fields
 
    const std::string                                  hdf5Filename;
+   std::unique_ptr<H5Kit::CFileOpenedReadWrite>       u_FileOpenRW;    // See Class Note [2]
+   std::unique_ptr<CKnodeTableMapped>                 u_TableMapped;   // See Class Note [3]
+   std::map<KnodeCoords_t, size_t>                    nodeIndices_byCoords;   // into u_TableMapped
    Knode_t                                            nodeImage;
+   std::vector<std::pair<KnodeCoords_t, Knode_t>>     nodeImagesCached_sortedByCoords;
+   std::map<KnodeCoords_t, Knode_t>                   nodeImagesToWrite_byCoords;
+   std::mutex                                         fileLock;        // serializes all HDF5 calls
+   std::mutex                                         writesLock;      // guards nodeImagesToWrite
    std::unordered_map<Nzint_t, const CHypo* const>    p_HypoById;
    std::unordered_map<Nzint_t, const CEvid* const>    p_EvidById;
    MimicAxisR_t                                       mimicBase;
@@ -79,11 +109,26 @@ private:
    Nzint_t                                            evidZ;
    size_t                                             numNodesActive;
    bool                                               cursorAtActiveNode;
-   bool                                               kbaseIsPreexistantHdf5File;
+   bool                                               kbaseIsPreexistant;
+   bool                                               fileClosedForShutdown;
+
+   static std::atomic<std::uint64_t>                  numNodesReadFromFile;      // See Class Note [4]
+   static std::atomic<std::uint64_t>                  numNodesWrittenToFile;
+   static std::atomic<std::uint64_t>                  numFlushesToFile;
+   static std::atomic<std::uint64_t>                  numImagesReadAtCursor;
+   static std::atomic<std::uint64_t>                  numImagesWrittenAtCursor;
 
    // Methods
    void              RezeroImage( void );
    bool              RebuildMimicFromFile( void );
+   bool              RebuildMimicFromTable( void );
+   void              CacheNodeFromFile( const KnodeCoords_t& );
+   void              WriteBatchToFile( std::map<KnodeCoords_t, Knode_t>& );
+   H5Kit::CFileOpenedReadWrite& SayFileOpenedRef( void );
+   Knode_t&          SayCachedImageRef( const KnodeCoords_t& );      // adds a zero image if absent
+   const Knode_t*    SayCachedImagePtr( const KnodeCoords_t& ) const;   // nullptr if absent
+   KnodeCoords_t     SayCursorCoords( void ) const;
+   Knode_t           SayImageAtCoords( const KnodeCoords_t& ) const;
 
 };
 
@@ -97,6 +142,30 @@ private:
       their object's 'this' pointer supplied as their first argument.  STL way of pointing to a member
       function must "stick-shift in" the object pointer as a member functions "hidden" first arg.
 
+[2]   ReadCursorToImage() copies from nodeImagesCached_sortedByCoords, filled from file once at
+      construction, so a CCase pays no HDF5 open or read per hypothesis.  The cache is a vector sorted
+      for binary search, not a map, as it holds every node of every KB (~64 vs ~112 bytes per node).  WriteImageToCursor() updates the cache and
+      queues the image.  One writer thread, owned by CController, calls FlushWritesBehind() on every
+      registered KB each FIXED_KBASE_WRITEBEHIND_MSECS, which writes all queued nodes under one H5Fflush.
+      The file is opened when a batch (or a node creation) needs it, and closed when the batch is done,
+      so a KB between batches holds no HDF5 handle, metadata cache, or thread: memory per KB stays what
+      it was when the file was opened per node access, which matters with thousands of rule kits.
+      Node creation (PanCursorToNodeAt on an unknown R-H-E) stays synchronous, so a node always exists
+      in file before a batch can reach it.  A process killed between batches loses at most that
+      interval of case teaching.  CloseFileAfterWritesBehind() (from d-tor, or from the controller ahead
+      of H5close() at app shutdown, once its writer has stopped) drains the queue and closes the file.
+
+[3]   With environment variable EA_KBASE_FORMAT=mapped, the KB named "<root>kbase.h5" is instead held in
+      "<root>kbase.kbt", a flat table of node records mapped into memory.  Startup maps the table and
+      indexes it in one pass (no HDF5 group walk), reads and writes are plain loads and stores into the
+      mapping, and nothing is queued.  The OS pages dirty records out, and the controller's writer
+      schedules that on the same cadence as HDF5 batches, by FlushWritesBehind() on a table written to
+      since its last flush.  An import goes to a temporary table renamed into place once complete.  If no table exists but an HDF5 KB does, the HDF5 KB is imported into a new table
+      once.  ExportToHdf5File() writes the KB, in either format, to a new HDF5 file of the usual layout.
+
+[4]   I/O counts are kept per process, not per KB, in relaxed atomics bumped where the I/O happens (by
+      the stepping thread or the controller's writer thread), so SayIoCountsAcrossKbases() may be called from any
+      thread at any time.  Each count is exact; counts read together may be a few operations apart.
 
 
 ^^^^^^^^^^^^^^END OF NOTES
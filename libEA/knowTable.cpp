@@ -0,0 +1,226 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Implements RAII class CKnodeTableMapped, a flat memory-mapped table of knowledge base node records.
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "knowTable.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+const char           KNODETABLE_MAGIC[8] = "EAKNODE";
+const std::uint32_t  KNODETABLE_VERSION = 1u;
+const std::uint64_t  KNODETABLE_START_CAPACITY = 256u;    // records; doubles as needed
+
+
+//VVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVVV
+// Implementations for CKnodeTableMapped
+
+CKnodeTableMapped::CKnodeTableMapped( const std::string& arg )
+                                       :  filename (arg),
+                                          fileDescriptor (-1),
+                                          p_Mapping (nullptr),
+                                          bytesMapped (0u),
+                                          writtenSinceFlush (false) {
+   errno = 0;
+   fileDescriptor = open( filename.c_str(), O_RDWR | O_CREAT, 0644 );
+   struct stat fileStat;
+   if ( ( fileDescriptor < 0 ) || ( fstat( fileDescriptor, &fileStat ) != 0 ) ) {
+      std::ostringstream squawk;
+      squawk << "Cannot open KB table file " << filename << ": " << std::strerror( errno );
+      throw std::runtime_error( squawk.str() );
+   }
+
+   if ( fileStat.st_size == 0 ) {      // new file, so lay down an empty table
+
+      MapToCapacity( KNODETABLE_START_CAPACITY );
+      SKnodeTableHeader& headerRef = SayHeaderRef();
+      std::memcpy( headerRef.magic, KNODETABLE_MAGIC, sizeof(KNODETABLE_MAGIC) );
+      headerRef.version = KNODETABLE_VERSION;
+      headerRef.bytesPerRecord = static_cast<std::uint32_t>( sizeof(SKnodeRecord) );
+      headerRef.capacityInRecords = KNODETABLE_START_CAPACITY;
+      headerRef.numRecords.store( 0u, std::memory_order_release );
+      return;
+   }
+
+   if ( static_cast<size_t>( fileStat.st_size ) < sizeof(SKnodeTableHeader) ) {
+      throw std::runtime_error( "KB table file " + filename + " is truncated" ); // deliberately no catch
+   }
+   SKnodeTableHeader headerOnDisk;
+   if ( pread( fileDescriptor, &headerOnDisk, sizeof(headerOnDisk), 0 ) !=
+        static_cast<ssize_t>( sizeof(headerOnDisk) ) ) {
+      throw std::runtime_error( "Cannot read KB table file " + filename ); // deliberately no catch
+   }
+   if (  ( std::memcmp( headerOnDisk.magic, KNODETABLE_MAGIC, sizeof(KNODETABLE_MAGIC) ) != 0 ) ||
+         ( headerOnDisk.version != KNODETABLE_VERSION ) ||
+         ( headerOnDisk.bytesPerRecord != sizeof(SKnodeRecord) ) ||
+         ( static_cast<std::uint64_t>( fileStat.st_size ) <
+            sizeof(SKnodeTableHeader) + ( headerOnDisk.capacityInRecords * sizeof(SKnodeRecord) ) ) ) {
+      throw std::runtime_error( "File " + filename + " is not a KB table of this version" ); // deliberately no catch
+   }
+   MapToCapacity( headerOnDisk.capacityInRecords );
+}
+
+
+CKnodeTableMapped::~CKnodeTableMapped( void ) {
+
+   if ( p_Mapping != nullptr ) {
+      msync( p_Mapping, bytesMapped, MS_SYNC );
+      munmap( p_Mapping, bytesMapped );
+   }
+   if ( fileDescriptor > -1 ) { close( fileDescriptor ); }
+}
+
+
+//======================================================================================================/
+// Private methods
+
+SKnodeTableHeader& CKnodeTableMapped::SayHeaderRef( void ) const {
+
+   return *static_cast<SKnodeTableHeader*>( p_Mapping );
+}
+
+
+SKnodeRecord& CKnodeTableMapped::SayRecordRef( size_t index ) const {
+
+   return *( reinterpret_cast<SKnodeRecord*>(
+               static_cast<char*>( p_Mapping ) + sizeof(SKnodeTableHeader) ) + index );
+}
+
+
+void CKnodeTableMapped::MapToCapacity( std::uint64_t capacityInRecords ) {
+
+   const size_t bytesWanted = sizeof(SKnodeTableHeader) + ( capacityInRecords * sizeof(SKnodeRecord) );
+
+   if ( p_Mapping != nullptr ) { munmap( p_Mapping, bytesMapped ); p_Mapping = nullptr; }
+
+   errno = 0;
+   struct stat fileStat;
+   fstat( fileDescriptor, &fileStat );
+   if (  ( static_cast<size_t>( fileStat.st_size ) < bytesWanted ) &&
+         ( ftruncate( fileDescriptor, static_cast<off_t>( bytesWanted ) ) != 0 ) ) {
+      std::ostringstream squawk;
+      squawk << "Cannot grow KB table file " << filename << ": " << std::strerror( errno );
+      throw std::runtime_error( squawk.str() );
+   }
+   void* p_New = mmap( nullptr, bytesWanted, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0 );
+   if ( p_New == MAP_FAILED ) {
+      std::ostringstream squawk;
+      squawk << "Cannot map KB table file " << filename << ": " << std::strerror( errno );
+      throw std::runtime_error( squawk.str() );
+   }
+   p_Mapping = p_New;
+   bytesMapped = bytesWanted;
+   return;
+}
+
+
+//======================================================================================================/
+// Public methods
+
+size_t CKnodeTableMapped::SayNumNodes( void ) const {
+
+   return static_cast<size_t>( SayHeaderRef().numRecords.load( std::memory_order_acquire ) );
+}
+
+
+KnodeCoords_t CKnodeTableMapped::SayCoordsAt( size_t index ) const {
+
+   const SKnodeRecord& recordCref = SayRecordRef( index );
+   return { recordCref.ruleUai, recordCref.hypoUai, recordCref.evidUai };
+}
+
+
+void CKnodeTableMapped::ReadNodeAt( size_t index, Knode_t& imageRef ) const {
+
+   // Retries only if a writer in another process was mid-write, See Class Note [2] in header
+   SKnodeRecord& recordRef = SayRecordRef( index );
+   std::uint32_t seqBefore = 0u;
+   std::uint32_t seqAfter = 0u;
+   do {
+      seqBefore = recordRef.writeSeq.load( std::memory_order_acquire );
+      imageRef = recordRef.tallies;
+      std::atomic_thread_fence( std::memory_order_acquire );
+      seqAfter = recordRef.writeSeq.load( std::memory_order_relaxed );
+   } while ( ( ( seqBefore & 1u ) != 0u ) || ( seqBefore != seqAfter ) );
+   return;
+}
+
+
+void CKnodeTableMapped::WriteNodeAt( size_t index, const Knode_t& imageCref ) {
+
+   SKnodeRecord& recordRef = SayRecordRef( index );
+   recordRef.writeSeq.fetch_add( 1u, std::memory_order_acq_rel );    // now odd
+   std::atomic_thread_fence( std::memory_order_release );
+   recordRef.tallies = imageCref;
+   recordRef.writeSeq.fetch_add( 1u, std::memory_order_release );    // even again
+   writtenSinceFlush.store( true, std::memory_order_relaxed );
+   return;
+}
+
+
+size_t CKnodeTableMapped::AppendNode( const KnodeCoords_t& coords, const Knode_t& imageCref ) {
+
+   const std::uint64_t index = SayHeaderRef().numRecords.load( std::memory_order_relaxed );
+
+   if ( index == SayHeaderRef().capacityInRecords ) {
+      MapToCapacity( 2u * index );
+      SayHeaderRef().capacityInRecords = 2u * index;
+   }
+   SKnodeRecord& recordRef = SayRecordRef( index );
+   recordRef.writeSeq.store( 0u, std::memory_order_relaxed );
+   recordRef.ruleUai = coords[0];
+   recordRef.hypoUai = coords[1];
+   recordRef.evidUai = coords[2];
+   recordRef.tallies = imageCref;
+   SayHeaderRef().numRecords.store( index + 1u, std::memory_order_release );   // publish
+   writtenSinceFlush.store( true, std::memory_order_relaxed );
+   return static_cast<size_t>( index );
+}
+
+
+bool CKnodeTableMapped::FlushToDisk( void ) {
+
+   if ( ! writtenSinceFlush.exchange( false, std::memory_order_relaxed ) ) { return false; }
+   msync( p_Mapping, bytesMapped, MS_ASYNC );   // Dirty pages are scheduled to disk, not awaited
+   return true;
+}
+
+
+void CKnodeTableMapped::SyncAndRenameTo( const std::string& filenameFinal ) {
+
+   errno = 0;
+   if (  ( msync( p_Mapping, bytesMapped, MS_SYNC ) != 0 ) ||
+         ( fsync( fileDescriptor ) != 0 ) ||
+         ( std::rename( filename.c_str(), filenameFinal.c_str() ) != 0 ) ) {
+      std::ostringstream squawk;
+      squawk << "Cannot put KB table file " << filename << " in place as " << filenameFinal << ": "
+             << std::strerror( errno );
+      throw std::runtime_error( squawk.str() );
+   }
+   filename = filenameFinal;     // mapping and descriptor follow the file through the rename
+   writtenSinceFlush.store( false, std::memory_order_relaxed );
+   return;
+}
+
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
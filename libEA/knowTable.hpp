@@ -0,0 +1,110 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Declares RAII class CKnodeTableMapped, a compact alternative on-disk format for a knowledge base (KB):
+   one flat, memory-mapped table of fixed-size node records, each holding the R-H-E coordinates and the
+   3x2 tallies (Knode_t) of one KB node.  CKnowBaseH5 uses it in lieu of an HDF5 file when so configured,
+   keeping HDF5 as the import/export format.  POSIX only (open, mmap, msync).
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#ifndef KNOWTABLE_HPP
+#define KNOWTABLE_HPP
+
+#include "diagnosticTypes.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+//''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+// On-disk layout (See Class Note [1])
+
+struct SKnodeTableHeader {
+
+   char                    magic[8];          // "EAKNODE" plus terminating zero
+   std::uint32_t           version;
+   std::uint32_t           bytesPerRecord;
+   std::atomic<std::uint64_t>   numRecords;   // published last on append, See Class Note [2]
+   std::uint64_t           capacityInRecords;
+   char                    pad[32];
+};
+
+struct SKnodeRecord {
+
+   std::atomic<std::uint32_t>   writeSeq;     // odd while a write is in progress, See Class Note [2]
+   Nzint_t                 ruleUai;
+   Nzint_t                 hypoUai;
+   Nzint_t                 evidUai;
+   Knode_t                 tallies;
+};
+
+static_assert( sizeof(SKnodeTableHeader) == 64, "KB table header must stay one cache line" );
+static_assert( sizeof(SKnodeRecord) == 64, "KB table record must stay one cache line" );
+static_assert( std::atomic<std::uint32_t>::is_always_lock_free, "KB table needs lock-free atomics" );
+
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+
+class CKnodeTableMapped {
+
+   public:
+
+      explicit CKnodeTableMapped( const std::string& );   // opens, or creates empty if absent
+      ~CKnodeTableMapped( void );
+      CKnodeTableMapped( const CKnodeTableMapped& ) = delete;
+      CKnodeTableMapped& operator=( const CKnodeTableMapped& ) = delete;
+
+      size_t         SayNumNodes( void ) const;
+      KnodeCoords_t  SayCoordsAt( size_t ) const;
+      void           ReadNodeAt( size_t, Knode_t& ) const;
+      void           WriteNodeAt( size_t, const Knode_t& );
+      size_t         AppendNode( const KnodeCoords_t&, const Knode_t& );
+      bool           FlushToDisk( void );                       // false if nothing written since last
+      void           SyncAndRenameTo( const std::string& );     // See Class Note [3]
+
+   private:
+
+      std::string          filename;
+      int                  fileDescriptor;
+      void*                p_Mapping;
+      size_t               bytesMapped;
+      std::atomic<bool>    writtenSinceFlush;      // set by stepping thread, cleared by writer thread
+
+      SKnodeTableHeader&   SayHeaderRef( void ) const;
+      SKnodeRecord&        SayRecordRef( size_t ) const;
+      void                 MapToCapacity( std::uint64_t );
+};
+
+#endif
+
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXX
+/* NOTES
+
+[1]   File is one 64-byte header then capacityInRecords 64-byte records, of which the first numRecords
+      are in use.  Record order is order of node creation.  No index is stored; CKnowBaseH5 builds its
+      index by (rule, hypo, evid) in one pass over the contiguous records, without any HDF5 group walk.
+      Capacity doubles (file grows, then is re-mapped) when an append finds the table full.
+
+[2]   Updates are atomic to any reader of the mapping (e.g., another process exporting the KB):
+      an append fills its record before publishing it with a release-store of numRecords, and a write
+      of tallies is bracketed by two increments of that record's writeSeq, so a reader seeing the same
+      even writeSeq before and after its copy has a consistent image (a "seqlock").
+
+[3]   A table filled from another source (i.e., an HDF5 KB imported) is built under a temporary name,
+      then SyncAndRenameTo() writes it through to disk and renames it into place, as a checkpoint is
+      saved.  A crash mid-import thus leaves no partial table to be trusted at the next startup.
+
+^^^^^^^^^^^^^^END OF NOTES
+*/
+
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -23,7 +23,41 @@ See the License for the specific language governing permissions and limitations
 #include "taskClock.hpp"
 #include "subject.hpp"
 #include "mvc_ctrlr.hpp"
+#include "knowBase.hpp"
 #include "HDF5Parts.hpp"
+#include "agentTask.hpp"
+#include "checkpoint.hpp"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+
+const char* const ENV_VAR_NAMING_CHECKPOINT_FILE = "EA_CHECKPOINT";
+const char* const ENV_VAR_NAMING_CHECKPOINT_SECS = "EA_CHECKPOINT_SECS";
+
+
+// Knob setting as held in a checkpoint (NGuiKey itself not trivially copyable)
+struct SKnobSetting {
+
+   unsigned long long   key;
+   GuiFpn_t             value;
+};
+
+
+static std::string SayCheckpointFilenameFromEnvironment( void ) {
+
+   const char* p_filename = std::getenv( ENV_VAR_NAMING_CHECKPOINT_FILE );
+   return ( ( p_filename == nullptr ) ? std::string() : std::string( p_filename ) );
+}
+
+
+static int SaySecsBetweenCheckpointsFromEnvironment( void ) {
+
+   const char* p_secs = std::getenv( ENV_VAR_NAMING_CHECKPOINT_SECS );
+   const int secsGiven = ( ( p_secs == nullptr ) ? 0 : std::atoi( p_secs ) );
+   return ( ( secsGiven > 0 ) ? secsGiven : START_CHECKPOINT_SECSBETWEENSAVES );
+}
 
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
@@ -32,21 +66,79 @@ See the License for the specific language governing permissions and limitations
 CController::CController(  CClockPerPort& arg0 )
                            :  ClockRef (arg0),
                               p_Knobs_byKey(),
+                              p_Kbases(),
+                              writerToStop (false),
+                              p_Seq (nullptr),
                               pointNamesZeroToN_bySubjKey(),
-                              pointObjectsZeroToN_bySubjKey() {
+                              pointObjectsZeroToN_bySubjKey(),
+                              checkpointFilename ( SayCheckpointFilenameFromEnvironment() ),
+                              secsBetweenCheckpoints ( SaySecsBetweenCheckpointsFromEnvironment() ),
+                              timeOfLastCheckpoint (0) {
 
 }
 
 
 CController::~CController( void ) {
 
-   // empty interface d-tor
+   StopWriterBehindKbases();
 }
 
 
 //======================================================================================================/
 // Private Methods
 
+void CController::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.ExchangeTag( "knobs" );
+   std::vector<SKnobSetting> knobSettings(0);
+   knobSettings.reserve( p_Knobs_byKey.size() );
+   for ( const auto& pairCref : p_Knobs_byKey ) {
+      knobSettings.push_back( { pairCref.first.Peek(), pairCref.second->SayValueNow() } );
+   }
+   checkpointRef.Exchange( knobSettings );
+
+   if ( checkpointRef.IsRestoring() ) {
+      // Knobs of mortal objects (e.g., r-t Kronos) are not rebuilt at startup, so are skipped here
+      for ( const SKnobSetting& settingCref : knobSettings ) {
+         auto iter = p_Knobs_byKey.find( NGuiKey( settingCref.key ) );
+         if ( ( iter != p_Knobs_byKey.end() ) && ( iter->second->SayValueNow() != settingCref.value ) ) {
+            iter->second->SetValueTo( settingCref.value );
+         }
+      }
+   }
+   ClockRef.ExchangeStateWith( checkpointRef );
+   p_Seq->ExchangeStateWith( checkpointRef );
+   return;
+}
+
+
+void CController::RunWriterBehindKbases( void ) {
+
+   std::unique_lock<std::mutex> kbasesLockHeld( kbasesLock );
+   while ( ! writerToStop ) {
+      writerWake.wait_for( kbasesLockHeld,
+                           std::chrono::milliseconds( FIXED_KBASE_WRITEBEHIND_MSECS ),
+                           [this] () -> bool { return writerToStop; } );
+      if ( writerToStop ) { break; }      // KBs drain their own queues as they are closed out
+      for ( auto p_Kbase : p_Kbases ) { p_Kbase->FlushWritesBehind(); }
+   }
+   return;
+}
+
+
+void CController::StopWriterBehindKbases( void ) {
+
+   if ( writerBehindKbases.joinable() ) {
+      {
+         std::lock_guard<std::mutex> kbasesLockHeld( kbasesLock );
+         writerToStop = true;
+      }
+      writerWake.notify_one();
+      writerBehindKbases.join();
+   }
+   return;
+}
+
 
 
 //======================================================================================================/
@@ -54,17 +146,61 @@ CController::~CController( void ) {
 
 EGuiReply CController::PrepareApplicationForShutdown( void ) {
 
+   // Checkpoint saved first, as its rule kits still hold open cases on open knowledge bases
+   if ( !checkpointFilename.empty() && ( ClockRef.GetTimestamp() != 0 ) ) { SaveCheckpoint(); }
+
+   // Writes still queued behind any knowledge base must reach disk while HDF5 is still open
+   StopWriterBehindKbases();
+   for ( auto p_Kbase : p_Kbases ) { p_Kbase->CloseFileAfterWritesBehind(); }
+
    herr_t reply = H5close();
    return ( (reply < 0) ? EGuiReply::FAIL_any_calledFunctionNotYetImplemented : EGuiReply::OKAY_allDone );
 }
 
 
+bool CController::RestoreCheckpointIfAny( void ) {
+
+   if ( checkpointFilename.empty() || ( p_Seq == nullptr ) ) { return false; }
+
+   CCheckpoint checkpoint( p_Seq->SayTopologyFingerprint() );
+   if ( !checkpoint.LoadFromFile( checkpointFilename ) ) { return false; }
+   ExchangeStateWith( checkpoint );
+   timeOfLastCheckpoint = ClockRef.GetTimestamp();
+   return true;
+}
+
+
+void CController::SaveCheckpoint( void ) {
+
+   if ( checkpointFilename.empty() || ( p_Seq == nullptr ) ) { return; }
+
+   // Interval restarts even if the write fails, so a bad path is retried once per interval, not per step
+   timeOfLastCheckpoint = ClockRef.GetTimestamp();
+
+   CCheckpoint checkpoint( p_Seq->SayTopologyFingerprint() );
+   ExchangeStateWith( checkpoint );
+   try {
+      checkpoint.WriteToFile( checkpointFilename );
+   }
+   catch ( const std::runtime_error& errRef ) {    // See Class Note [1]
+      std::cerr << "Checkpoint not saved: " << errRef.what() << std::endl;
+   }
+   return;
+}
+
+
 EGuiReply CController::SetTimeStampInDomain( std::tm tmStruct ) {
 
    return ClockRef.SetTimeFromPort( tmStruct );
 }
 
 
+time_t CController::GetTimeStampInDomain( void ) const {
+
+   return ClockRef.GetTimestamp();
+}
+
+
 std::vector<EPointName>
 CController::SayInputPointNameOrderExpectedBySubject( NGuiKey subjectKey ) const {
 
@@ -92,9 +228,22 @@ EGuiReply CController::ReadInDataForSubject( const std::vector<GuiFpn_t>& newSam
 
 EGuiReply CController::SingleStepModelOnTimeAndInputs( void ) {
 
-   return ( (ClockRef.RingTaskBell() == EGuiReply::OKAY_allDone) ?
-               p_View->Update() :
-               EGuiReply::WARN_ranSeqToExitWithObjectsYetToCycle_fixApi );
+   const EGuiReply replyOfStep = ClockRef.RingTaskBell();
+
+   // Cases of rules trapped on the step are built after it, See Class Note [2]
+   if ( p_Seq != nullptr ) { p_Seq->CreateCasesForTrapsRecorded(); }
+
+   const EGuiReply reply = ( (replyOfStep == EGuiReply::OKAY_allDone) ?
+                                 p_View->Update() :
+                                 EGuiReply::WARN_ranSeqToExitWithObjectsYetToCycle_fixApi );
+
+   // Checkpoint interval is in data time, so a replay at any speed saves at the same steps
+   if (  !checkpointFilename.empty() &&
+         ( ( ClockRef.GetTimestamp() - timeOfLastCheckpoint ) >= secsBetweenCheckpoints ) ) {
+      if ( timeOfLastCheckpoint == 0 ) { timeOfLastCheckpoint = ClockRef.GetTimestamp(); }
+      else { SaveCheckpoint(); }
+   }
+   return reply;
 }
 
 
@@ -138,30 +287,72 @@ void CController::Register( AKnob* const knobPtr ) {
 
 void CController::RegisterBasPointToSubjectKey( ADataChannel* ptr, NGuiKey subjectKey ) {
 
-   // map insert() nops upon finding key already in unordered map.  Emplace() not advantageous here.
+   // operator[] default-constructs the vector for a key not yet in unordered map, so one hash per table
 
-   pointObjectsZeroToN_bySubjKey.insert( std::pair< NGuiKey,
-                                                   std::vector<ADataChannel*> >(
-                                                      subjectKey,
-                                                      std::vector<ADataChannel*>(0) )
-   );
+   pointObjectsZeroToN_bySubjKey[subjectKey].push_back( ptr );
+   pointNamesZeroToN_bySubjKey[subjectKey].push_back( ptr->SayPointName() );
+   return;
+}
 
-   pointObjectsZeroToN_bySubjKey.at( subjectKey ).push_back( ptr );
 
-   pointNamesZeroToN_bySubjKey.insert( std::pair<   NGuiKey,
-                                                   std::vector<EPointName> >(
-                                                      subjectKey,
-                                                      std::vector<EPointName>(0) )
-   );
+void CController::DeregisterKnob( const NGuiKey knobKey ) {
 
-   pointNamesZeroToN_bySubjKey.at( subjectKey ).push_back( ptr->SayPointName() );
+   p_Knobs_byKey.erase( knobKey );     // erase on maps (vs. vectors) can take key (vs. iterator)
    return;
 }
 
 
-void CController::DeregisterKnob( const NGuiKey knobKey ) {
+void CController::Register( CKnowBaseH5* const ptr ) {
 
-   p_Knobs_byKey.erase( knobKey );     // erase on maps (vs. vectors) can take key (vs. iterator)
+   std::lock_guard<std::mutex> kbasesLockHeld( kbasesLock );
+   p_Kbases.push_back( ptr );
+   if ( ! ( writerBehindKbases.joinable() || writerToStop ) ) {     // See Class Note [3] in header
+      writerBehindKbases = std::thread( [this] () -> void { RunWriterBehindKbases(); } );
+   }
+   return;
+}
+
+
+void CController::Register( CSequence* const ptr ) {
+
+   p_Seq = ptr;
+   return;
+}
+
+
+void CController::DeregisterKbase( CKnowBaseH5* const ptr ) {
+
+   std::lock_guard<std::mutex> kbasesLockHeld( kbasesLock );
+   p_Kbases.erase( std::remove( p_Kbases.begin(), p_Kbases.end(), ptr ), p_Kbases.end() );
+   return;
+}
+
+
+std::vector<size_t> CController::SayRegistrySizes( void ) const {
+
+   // Order here must match order in ReserveRegistries()
+   return std::vector<size_t>{ p_Knobs_byKey.size(), pointObjectsZeroToN_bySubjKey.size() };
+}
+
+
+void CController::ReserveRegistries( const std::vector<size_t>& sizes ) {
+
+   if ( sizes.size() != 2 ) {
+      throw std::logic_error( "Controller registry sizes malformed" ); // deliberately no catch
+   }
+   p_Knobs_byKey.reserve( sizes[0] );
+   pointObjectsZeroToN_bySubjKey.reserve( sizes[1] );
+   pointNamesZeroToN_bySubjKey.reserve( sizes[1] );
+   return;
+}
+
+
+void CController::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesKnobs += HeapBytesHeldBy( p_Knobs_byKey );
+   for ( const auto& pairCref_knob : p_Knobs_byKey ) {
+      pairCref_knob.second->AddBytesHeldTo( censusRef );
+   }
    return;
 }
 
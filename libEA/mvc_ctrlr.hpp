@@ -21,14 +21,21 @@ See the License for the specific language governing permissions and limitations
 
 #include "customTypes.hpp"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 // Forward declares (to avoid unnecessary #includes)
 class ADataChannel;
 class AKnob;
 class ASubject;
 
+class CCheckpoint;
 class CClockPerPort;
 class CCaseKit;
 class CDomain;
+class CKnowBaseH5;
+class CSequence;
 class CView;
 
 typedef std::unordered_map<NGuiKey, AKnob* const>     KnobPtrTable_t; // non-const due to setters
@@ -48,8 +55,11 @@ class CController {
       ~CController( void );
 
       EGuiReply                        PrepareApplicationForShutdown( void );
+      bool                             RestoreCheckpointIfAny( void );     // See Class Note [1]
+      void                             SaveCheckpoint( void );
 
       EGuiReply                        SetTimeStampInDomain( std::tm );
+      time_t                           GetTimeStampInDomain( void ) const;
 
       std::vector<EPointName>          SayInputPointNameOrderExpectedBySubject( NGuiKey ) const;
 
@@ -66,9 +76,16 @@ class CController {
 
       void                             Register( CView* const ); 
       void                             Register( AKnob* const );
+      void                             Register( CKnowBaseH5* const );
+      void                             Register( CSequence* const );
       void                             RegisterBasPointToSubjectKey( ADataChannel*, NGuiKey );
 
       void                             DeregisterKnob( const NGuiKey );
+      void                             DeregisterKbase( CKnowBaseH5* const );
+
+      std::vector<size_t>              SayRegistrySizes( void ) const;   // See CApplication c-tor
+      void                             ReserveRegistries( const std::vector<size_t>& );
+      void                             AddBytesHeldTo( MemoryCensus_t& ) const;
 
    private:
 
@@ -77,8 +94,46 @@ class CController {
       CView*                                 p_View;
 
       KnobPtrTable_t                         p_Knobs_byKey;
+      std::vector<CKnowBaseH5*>              p_Kbases;         // closed out before H5close()
+      std::mutex                             kbasesLock;       // guards p_Kbases against writer
+      std::condition_variable                writerWake;
+      std::thread                            writerBehindKbases;  // See Class Note [3]
+      bool                                   writerToStop;
+      CSequence*                             p_Seq;            // checkpointed with clock and knobs
       SubjPointNameTable_t                   pointNamesZeroToN_bySubjKey;
       SubjPointObjectTable_t                 pointObjectsZeroToN_bySubjKey;
+
+   // Fields
+      const std::string                      checkpointFilename;  // empty if checkpoints not wanted
+      const int                              secsBetweenCheckpoints;
+      time_t                                 timeOfLastCheckpoint;
+
+   // Methods
+      void                                   ExchangeStateWith( CCheckpoint& );
+      void                                   RunWriterBehindKbases( void );
+      void                                   StopWriterBehindKbases( void );
+
+/* CLASS NOTES vvvv2vvvvvvvvv3vvvvvvvvv4vvvvvvvvv5vvvvvvvvv6vvvvvvvvv7vvvvvvvvv8vvvvvvvvv9vvvvvvvvvCvvvvv
+
+[1]   Checkpoints are opt-in, by naming a file in environment variable EA_CHECKPOINT.  The engine then
+      saves its dynamic state to that file every EA_CHECKPOINT_SECS of data time, and at shutdown.  At
+      startup, CApplication calls RestoreCheckpointIfAny() once all objects are built.  Knob settings
+      are restored first, through the knobs' own setters, then the clock, then the sequence.  A save
+      that cannot be written (disk full, path gone) is reported on stderr and skipped until the next
+      interval; the engine keeps stepping, and shutdown still closes out its knowledge bases.
+
+[2]   A step only records trap events of rules.  Their cases are built once the step is done, on the
+      same thread, since a CCase registers Kronos with the View and reads the Kbase, both also used by
+      GUI calls.  The step itself then runs for the same time whether zero or many rules trap on it.
+
+[3]   One writer thread serves every registered knowledge base, started when the first registers.
+      Each FIXED_KBASE_WRITEBEHIND_MSECS it calls FlushWritesBehind() on each KB in turn, so only one
+      KB file is open at a time for write-behind, whatever the number of rule kits.  It holds
+      kbasesLock throughout, so DeregisterKbase() returns only once no batch is using that KB.  It is
+      stopped before KBs are closed out at shutdown, and by the d-tor.
+
+^^^^ END CLASS NOTES */
+
  };   
 
 #endif
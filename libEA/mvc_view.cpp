@@ -21,6 +21,7 @@ See the License for the specific language governing permissions and limitations
 #include "mvc_ctrlr.hpp"      // Needed to register CView
 #include "subject.hpp"
 #include "case.hpp"
+#include "knowBase.hpp"
 #include "viewParts.hpp"
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
@@ -94,6 +95,21 @@ std::queue<std::string> CView::SayNewAlertsFifoFromDomainThenClear( void ) {
    return DomainRef.SayNewAlertsFifoThenClear();
 }
 
+
+std::vector<GuiPackAlert_t> CView::SayAlertsFromDomainSince( std::uint64_t cursor ) const {
+
+   return DomainRef.SayAlertsSince( cursor );
+}
+
+
+std::uint64_t CView::SayNextAlertIdFromDomain( void ) const { return DomainRef.SayNextAlertId(); }
+
+
+GuiPackKbaseIo_t CView::SayIoCountsFromKnowledgeBases( void ) const {
+
+   return CKnowBaseH5::SayIoCountsAcrossKbases();
+}
+
 /*
    Throughout the following getter methods, if called object is immortal, any bad Key given is taken
    as an error in GUI programming, not an error in User action, so letting method throw uncaught off
@@ -178,19 +194,35 @@ EGuiReply CView::AnswerCaseWithOptionIndex(  NGuiKey caseKey, size_t iOption ) {
 }
 
 
-GuiPackKronoFull_t  CView::SayFullGuiPackFromKrono( NGuiKey kronoKey ) const {
+GuiPackKronoFull_t  CView::SayFullGuiPackFromKrono( NGuiKey kronoKey, bool isGuiRequest ) const {
+
+   if ( p_Kronos_byKey.count(kronoKey) == 0 ) {
+      return SGuiPackKronoFull( EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled );
+   }
+   if ( isGuiRequest ) {
+      p_Kronos_byKey.at(kronoKey)->NoteRequestFromGui();   // keeps a r-t Krono from idle release
+   }
+   return p_Kronos_byKey.at(kronoKey)->SayFullGuiPack();
+}
+
+
+EGuiReply  CView::NoteGuiRequestOnKrono( NGuiKey kronoKey ) const {
 
-   return ( p_Kronos_byKey.count(kronoKey) == 0 ?
-            SGuiPackKronoFull( EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled ) :
-            p_Kronos_byKey.at(kronoKey)->SayFullGuiPack() );
+   if ( p_Kronos_byKey.count(kronoKey) == 0 ) {
+      return EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled;
+   }
+   p_Kronos_byKey.at(kronoKey)->NoteRequestFromGui();
+   return EGuiReply::OKAY_allDone;
 }
 
 
 GuiPackKronoDyna_t  CView::SayDynamicGuiPackFromKrono( NGuiKey kronoKey ) const {
 
-   return ( p_Kronos_byKey.count(kronoKey) == 0 ?
-            SGuiPackKronoDyna( EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled ) :
-            p_Kronos_byKey.at(kronoKey)->SayDynamicGuiPack() );
+   if ( p_Kronos_byKey.count(kronoKey) == 0 ) {
+      return SGuiPackKronoDyna( EGuiReply::FAIL_any_givenKeyNotValidForFunctionCalled );
+   }
+   p_Kronos_byKey.at(kronoKey)->NoteRequestFromGui();
+   return p_Kronos_byKey.at(kronoKey)->SayDynamicGuiPack();
 }
 
 GuiPackPane_t  CView::SayGuiPackFromPane( NGuiKey paneKey ) const {
@@ -389,4 +421,33 @@ void CView::AddSubject( ASubject& arg ) {
    return;
 }
 
+
+std::vector<size_t> CView::SayRegistrySizes( void ) const {
+
+   // Order here must match order in ReserveRegistries().  Case kit lookup omitted, as Cases come & go.
+   return std::vector<size_t>{   p_Features_byKey.size(),
+                                 p_Histograms_byKey.size(),
+                                 p_Kronos_byKey.size(),
+                                 p_Panes_byKey.size(),
+                                 p_RuleKitDisplays_byKey.size(),
+                                 p_Subjects_byKey.size(),
+                                 p_Traces_byKey.size() };
+}
+
+
+void CView::ReserveRegistries( const std::vector<size_t>& sizes ) {
+
+   if ( sizes.size() != 7 ) {
+      throw std::logic_error( "View registry sizes malformed" ); // deliberately no catch
+   }
+   p_Features_byKey.reserve( sizes[0] );
+   p_Histograms_byKey.reserve( sizes[1] );
+   p_Kronos_byKey.reserve( sizes[2] );
+   p_Panes_byKey.reserve( sizes[3] );
+   p_RuleKitDisplays_byKey.reserve( sizes[4] );
+   p_Subjects_byKey.reserve( sizes[5] );
+   p_Traces_byKey.reserve( sizes[6] );
+   return;
+}
+
 //END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -74,6 +74,9 @@ class CView {
 
       GuiPackDomain_t            SayGuiPackFromDomain( void ) const;
       std::queue<std::string>    SayNewAlertsFifoFromDomainThenClear( void );
+      std::vector<GuiPackAlert_t> SayAlertsFromDomainSince( std::uint64_t ) const;
+      std::uint64_t              SayNextAlertIdFromDomain( void ) const;
+      GuiPackKbaseIo_t           SayIoCountsFromKnowledgeBases( void ) const;
 
       GuiPackSubjectBasic_t      SayGuiPackFromSubject( NGuiKey ) const;
       GuiPackSubjectCases_t      SayCurrentCasesFromSubject( NGuiKey ) const;
@@ -90,7 +93,8 @@ class CView {
       GuiPackCaseDyna_t          SayDynamicGuiPackFromCase( NGuiKey ) const;
       EGuiReply                  AnswerCaseWithOptionIndex( NGuiKey, size_t );
 
-      GuiPackKronoFull_t         SayFullGuiPackFromKrono( NGuiKey ) const;
+      GuiPackKronoFull_t         SayFullGuiPackFromKrono( NGuiKey, bool isGuiRequest = true ) const;
+      EGuiReply                  NoteGuiRequestOnKrono( NGuiKey ) const;
       GuiPackKronoDyna_t         SayDynamicGuiPackFromKrono( NGuiKey ) const;
 
       GuiPackPane_t              SayGuiPackFromPane( NGuiKey ) const;
@@ -131,6 +135,9 @@ class CView {
       void                       LoseAccessTo( CTraceRealtime* const );
       void                       LoseAccessTo( CTraceSnapshot* const );
 
+      std::vector<size_t>        SayRegistrySizes( void ) const;   // See CApplication c-tor
+      void                       ReserveRegistries( const std::vector<size_t>& );
+
    private:
 
       CDomain&                         DomainRef;
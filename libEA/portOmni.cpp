@@ -53,6 +53,12 @@ EGuiReply CPortOmni::SetTimeStampInDomain( std::tm tmStruct ) {
 }
 
 
+std::time_t CPortOmni::GetTimeStampFromDomain( void ) const {
+
+   return CtrlrRef.GetTimeStampInDomain();
+}
+
+
 EGuiReply CPortOmni::SingleStepDomainOnTimeAndInputs( void ) {
 
    return CtrlrRef.SingleStepModelOnTimeAndInputs();
@@ -106,6 +112,24 @@ std::queue<std::string>  CPortOmni::SayNewAlertsFifoFromDomainThenClear( void )
 }
 
 
+std::vector<GuiPackAlert_t> CPortOmni::SayAlertsFromDomainSince( std::uint64_t cursor ) const {
+
+   return ViewRef.SayAlertsFromDomainSince( cursor );
+}
+
+
+std::uint64_t CPortOmni::SayNextAlertIdFromDomain( void ) const {
+
+   return ViewRef.SayNextAlertIdFromDomain();
+}
+
+
+GuiPackKbaseIo_t CPortOmni::SayIoCountsFromKnowledgeBases( void ) const {
+
+   return ViewRef.SayIoCountsFromKnowledgeBases();
+}
+
+
 GuiPackSubjectBasic_t CPortOmni::SayInfoFromSubject( NGuiKey subjectGuiKey ) const {
 
    return ViewRef.SayGuiPackFromSubject( subjectGuiKey );
@@ -189,6 +213,18 @@ GuiPackKronoDyna_t CPortOmni::SayDynamicInfoFromKrono( NGuiKey kronoGuiKey ) con
 }
 
 
+GuiPackKronoFull_t CPortOmni::PeekFullInfoFromKrono( NGuiKey kronoGuiKey ) const {
+
+   return ViewRef.SayFullGuiPackFromKrono( kronoGuiKey, false );
+}
+
+
+EGuiReply CPortOmni::NoteGuiRequestOnKrono( NGuiKey kronoGuiKey ) {
+
+   return ViewRef.NoteGuiRequestOnKrono( kronoGuiKey );
+}
+
+
 GuiPackPane_t CPortOmni::SayInfoFromPane( NGuiKey paneGuiKey ) const {
 
    return ViewRef.SayGuiPackFromPane( paneGuiKey );
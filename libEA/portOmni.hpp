@@ -49,6 +49,7 @@ class CPortOmni : public IExportOmni {
       virtual EGuiReply                PrepareApplicationForShutdown( void );
 
       virtual EGuiReply                SetTimeStampInDomain( std::tm ) override;
+      virtual std::time_t              GetTimeStampFromDomain( void ) const override;
 
       virtual EGuiReply                SingleStepDomainOnTimeAndInputs( void ) override;
 
@@ -66,6 +67,9 @@ class CPortOmni : public IExportOmni {
 
       virtual GuiPackDomain_t          SayInfoFromDomain( void ) const  override;
       virtual std::queue<std::string>  SayNewAlertsFifoFromDomainThenClear( void ) override;
+      virtual std::vector<GuiPackAlert_t> SayAlertsFromDomainSince( std::uint64_t ) const override;
+      virtual std::uint64_t            SayNextAlertIdFromDomain( void ) const override;
+      virtual GuiPackKbaseIo_t         SayIoCountsFromKnowledgeBases( void ) const override;
 
       virtual GuiPackSubjectBasic_t    SayInfoFromSubject( NGuiKey ) const override;
       virtual GuiPackSubjectCases_t    SayCurrentCasesFromSubject( NGuiKey ) const override;
@@ -84,6 +88,8 @@ class CPortOmni : public IExportOmni {
 
       virtual GuiPackKronoFull_t       SayFullInfoFromKrono( NGuiKey ) const override;
       virtual GuiPackKronoDyna_t       SayDynamicInfoFromKrono( NGuiKey ) const override;
+      virtual GuiPackKronoFull_t       PeekFullInfoFromKrono( NGuiKey ) const override;
+      virtual EGuiReply                NoteGuiRequestOnKrono( NGuiKey ) override;
  
       virtual GuiPackPane_t            SayInfoFromPane( NGuiKey ) const override;
 
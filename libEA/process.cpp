@@ -18,6 +18,7 @@ See the License for the specific language governing permissions and limitations
 #include "agentTask.hpp"      // register to sequence
 #include "dataChannel.hpp"
 #include "subject.hpp"        // call getters on subject
+#include "checkpoint.hpp"     // save or restore dynamic state
 #include <algorithm>          // std::max_element() in CalcOwnTriggerGroup()
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
@@ -139,4 +140,14 @@ void CProcess::Cycle( time_t timestampNow ) {
 bool CProcess::SayBoolPosted( void ) const { return resultNow; }
 
 
+void CProcess::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ISeqElement::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( firstCall );
+   checkpointRef.Exchange( resultNow );
+   checkpointRef.Exchange( resultLastValid );
+   return;
+}
+
+
 //END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
\ No newline at end of file
@@ -44,6 +44,7 @@ class CProcess  : public ISeqElement {
       ~CProcess( void );
 
       bool SayBoolPosted( void ) const;
+      virtual void ExchangeStateWith( CCheckpoint& ) override;
 
    private:
 
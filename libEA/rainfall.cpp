@@ -21,6 +21,7 @@ See the License for the specific language governing permissions and limitations
 #include "fact.hpp"
 #include "rule.hpp"
 #include "agentTask.hpp"        // must follow other *.h includes to override F.D. with a complete type
+#include "checkpoint.hpp"
 
 #include <limits>
 #include <algorithm>
@@ -31,9 +32,8 @@ See the License for the specific language governing permissions and limitations
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // ARainfall ABC implementation
 
-/* One (statically allocated) actual "rainfall" register is reused among all objects of appropriate
-      subclass.  No rainfall init, as gets refilled prior to each object's access, to the depth that
-      object requires.
+/* No rainfall of bins is allocated.  Bins are counted straight off each object's bindex log, to the
+      depth that object requires, via SumBindexLogOverNewestCycles<N>() sized by its bin count.
 
    "Newest" data at lowest index (container "front") and "oldest" at highest index (container "back").
 
@@ -43,16 +43,12 @@ See the License for the specific language governing permissions and limitations
       gets label-mapped and then "pasted" (as a float) into more than one index of the snapshot.
 */
 
-Rainfall_t ARainfall::rainfallRegister;
-
 ARainfall::ARainfall(   ISeqElement& arg0,
                         EApiType arg1 ) 
                         :  SourceRef (arg0),
                            ruleStatesLoggedAsBindex_byRuleUai(),
                            statesLoggedAsBindex(0),
-                           valuesLoggedAsBindex(0),
                            snapshotsStateBindex_bySetSgi(),
-                           snapshotsValueBindex_bySetSgi(),
                            spansInUse(),       // < first, second > = < depth as key, num uses >
                            movingHourSpanInCycles (   static_cast<size_t>(
                                                          3600 / arg0.SaySecsPerCycle() )
@@ -75,32 +71,6 @@ ARainfall::ARainfall(   ISeqElement& arg0,
 // ~ARainfall() destructor must be left as virtual [in class header]
 ARainfall::~ARainfall( void ) { }
 
-//VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
-// Protected methods of abstract class
-
-void ARainfall::ReadBindexLogIntoRainfall( const std::deque<Bindex_t>& logToRead ) {
-
-   // Agnostic as to whether Bindex_t log read holds analog values or holds analog/fact/rule states
-
-   std::deque<Bindex_t>::const_iterator logIter = logToRead.begin();
-
-/* [row][column] paradigm in use of rainfallRegister is:
-   [cycles ago][bin (index) of the value of an analog or of the state of an analog, fact, or rule]
-*/
-   for ( auto rainRowIter = rainfallRegister.begin();
-         rainRowIter < ( rainfallRegister.begin() + logToRead.size() ); // log sizes <= rain size
-         ++rainRowIter ) {
-
-         (*rainRowIter).fill( false );    // all columns of rainfall, whether reading values or states
-         if ( *logIter != NaNBINDEX ) {   // reading NaN from log leaves whole bin row (cycle) 'false'
-            // Sole 'true' put in column indexed by log value read
-            (*rainRowIter)[ static_cast<size_t>( *logIter ) ] = true;
-         }
-         std::advance(logIter,1);
-   } 
-   return;
-}
-
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Public methods
 
@@ -138,10 +108,7 @@ EGuiReply ARainfall::ResizeLoggingToAtLeastSecsAgo( int secsLoggingWanted ) {
          statesLoggedAsBindex.resize( numCyclesProposed, BINDEX_FACT_UNAVAIL );
       }
       else {   // I am a Rainfall of analog subclass
-         valuesLoggedAsBindex.resize(            
-            numCyclesProposed,
-            valuesLoggedAsBindex.back()   // extend analog value log using oldest value presently held
-         );
+         ExtendValueLogToCycles( numCyclesProposed );
          statesLoggedAsBindex.resize(
             numCyclesProposed,
             BINDEX_ANALOGSTATE_UNAVAIL    // extend analog state log using bindex for "unavailable"
@@ -155,19 +122,41 @@ EGuiReply ARainfall::ResizeLoggingToAtLeastSecsAgo( int secsLoggingWanted ) {
 
 bool ARainfall::IsSnapshotSgiValid( Nzint_t sgiToCheck ) const {
 
-   return ( (  snapshotsStateBindex_bySetSgi.count( sgiToCheck ) +
-               snapshotsValueBindex_bySetSgi.count( sgiToCheck ) ) == 0 ?
-            false :
-            true );
+   return ( snapshotsStateBindex_bySetSgi.count( sgiToCheck ) == 0 ? false : true );
 }
 
 
 void ARainfall::DestroySnapshotForSetSgi( Nzint_t snapshotSetSgi) {
 
    snapshotsStateBindex_bySetSgi.erase( snapshotSetSgi );
-   snapshotsValueBindex_bySetSgi.erase( snapshotSetSgi );
    return;
-}    
+}
+
+
+void ARainfall::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesRainfallLogs += (  HeapBytesHeldBy( statesLoggedAsBindex ) +
+                                     HeapBytesHeldBy( ruleStatesLoggedAsBindex_byRuleUai ) );
+   for ( const auto& pairCref_log : ruleStatesLoggedAsBindex_byRuleUai ) {
+      censusRef.bytesRainfallLogs += HeapBytesHeldBy( pairCref_log.second );
+   }
+   censusRef.bytesSnapshotBanks += HeapBytesHeldBy( snapshotsStateBindex_bySetSgi );
+   return;
+}
+
+
+void ARainfall::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   // Rule log table restored in place, so its iteration order (see CRainRuleKit) is kept
+   checkpointRef.ExchangeTag( "rainfall" );
+   checkpointRef.Exchange( ruleStatesLoggedAsBindex_byRuleUai );
+   checkpointRef.Exchange( statesLoggedAsBindex );
+   checkpointRef.Exchange( snapshotsStateBindex_bySetSgi );
+   checkpointRef.Exchange( spansInUse );
+   checkpointRef.Exchange( numCyclesLogging );
+   checkpointRef.Exchange( secsLogging );
+   return;
+}
 
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
@@ -243,6 +232,8 @@ CRainAnalog::CRainAnalog(  CPointAnalog& bArg0,        // for base to call gette
                                                    binParamsRef.labels[0],
                                                    binParamsRef.binWidth )
                               ),
+                              valuesLoggedAsBindex(0),
+                              snapshotsValueBindex_bySetSgi(),
                               yMeansByDepth(),
                               yVariancesByDepth(),
                               yStdDevsByDepth(),
@@ -290,6 +281,8 @@ CRainAnalog::CRainAnalog(  CFormula& bArg0,
                                                    binParamsRef.labels[0],
                                                    binParamsRef.binWidth )
                               ),
+                              valuesLoggedAsBindex(0),
+                              snapshotsValueBindex_bySetSgi(),
                               yMeansByDepth(),
                               yVariancesByDepth(),
                               yStdDevsByDepth(),
@@ -327,6 +320,14 @@ CRainAnalog::~CRainAnalog( void ) {
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Private Methods
 
+void CRainAnalog::ExtendValueLogToCycles( size_t numCyclesWanted ) {
+
+   // extend analog value log using oldest value presently held
+   valuesLoggedAsBindex.resize( numCyclesWanted, valuesLoggedAsBindex.back() );
+   return;
+}
+
+
 void CRainAnalog::UpdateLogging_Analog(   time_t timestampNow,
                                           bool beginNewClockHour,
                                           bool beginNewCalendarDay )  {
@@ -406,11 +407,9 @@ void CRainAnalog::UpdateStatistics_Analog( void ) {
      and pop-off of oldest row at back. Note that valid stats are obtained even initially, when only one
      row (the first) has a bin with a bool "one" ("true") in it, as are stats based on total "ones". */
 
-   ReadBindexLogIntoRainfall( valuesLoggedAsBindex );
-
    // Could declare these high-freq "reusers" as members, but S.O. says they'll run faster on call stack
    size_t                  depth;
-   BinSumsAnalogValue_t    binSums_values;
+   std::array<BinSum_t,FIXED_RAIN_ANALOGVALUE_NUMBINS>   binSums_values;
    BinSum_t                sumBinSums_values;  
    std::vector<float>      binFractions_values( FIXED_RAIN_ANALOGVALUE_NUMBINS, 0.0f );
    std::vector<float>      stackVector_values( FIXED_RAIN_ANALOGVALUE_NUMBINS, 0.0f );
@@ -420,16 +419,12 @@ void CRainAnalog::UpdateStatistics_Analog( void ) {
    for ( auto& pairRef : spansInUse ) { 
 
       depth = ( pairRef.first - 1u );
-      binSums_values.fill( 0 );
 
-      for (size_t cyclesBack=0; cyclesBack < depth; ++cyclesBack) { // See Method Note [1]
-
-         // currently Bindex_t is a u-char, so any bindex from 0 to 255 < 256
-         for ( size_t iBin=0; iBin < FIXED_RAIN_ANALOGVALUE_NUMBINS; ++iBin ) {
-      
-            if ( rainfallRegister[cyclesBack][iBin] ) ++binSums_values[iBin]; 
-         }
-      }
+      // See Method Note [1]
+      binSums_values = SumBindexLogOverNewestCycles<FIXED_RAIN_ANALOGVALUE_NUMBINS>(
+                                                                        valuesLoggedAsBindex,
+                                                                        depth );
+      binSums_values[NaNBINDEX] = 0;   // NaN cycles count into no bin, See Method Note [2]
 
       // prevent zero (however unlikely) on binSums accumulation to protect later divide
       sumBinSums_values = std::max(   std::accumulate(  binSums_values.begin(),
@@ -497,6 +492,10 @@ void CRainAnalog::UpdateStatistics_Analog( void ) {
       without crashing the app, and (2) little to no code still gets executed for ever despite being
       made superfluous once the logs/rainfalls fill with actual sampled data.     
 
+[2]   NaNBINDEX shares bindex 0 with the lowest analog value bin, so a NaN log entry would otherwise be
+      counted as that lowest value.  Zeroing bin 0 keeps NaN cycles (and, as before, that bin) out of
+      the mean and variance.
+
 ''' End Method Notes''' */
 
 
@@ -665,11 +664,7 @@ EGuiState CRainAnalog::SayGuiStateFromNewestBindex( void ) const {
 
 //======================================================================================================/
 // Data getters ('X' refers to values prior to binning, 'Y' is the value post-binning)
-
-float CRainAnalog::NowX( void ) const { return xNow; }
-
-
-float CRainAnalog::NowY( void ) const { return yNow; }
+// [ NowX() and NowY() are defined inline in rainfall.hpp ]
 
 
 float CRainAnalog::OldY_atDepth( size_t depthWanted ) const {
@@ -832,6 +827,53 @@ void CRainAnalog::CaptureSnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
 }
 
 
+bool CRainAnalog::IsSnapshotSgiValid( Nzint_t sgiToCheck ) const {
+
+   return ( ARainfall::IsSnapshotSgiValid( sgiToCheck ) ||
+            ( snapshotsValueBindex_bySetSgi.count( sgiToCheck ) != 0 ) );
+}
+
+
+void CRainAnalog::DestroySnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
+
+   ARainfall::DestroySnapshotForSetSgi( snapshotSetSgi );
+   snapshotsValueBindex_bySetSgi.erase( snapshotSetSgi );
+   return;
+}
+
+
+void CRainAnalog::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   ARainfall::AddBytesHeldTo( censusRef );
+   censusRef.bytesRainfallLogs += HeapBytesHeldBy( valuesLoggedAsBindex );
+   censusRef.bytesSnapshotBanks += HeapBytesHeldBy( snapshotsValueBindex_bySetSgi );
+   u_Histogram_analog->AddBytesHeldTo( censusRef );
+   return;
+}
+
+
+void CRainAnalog::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ARainfall::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( valuesLoggedAsBindex );
+   checkpointRef.Exchange( snapshotsValueBindex_bySetSgi );
+   checkpointRef.Exchange( yMeansByDepth );
+   checkpointRef.Exchange( yVariancesByDepth );
+   checkpointRef.Exchange( yStdDevsByDepth );
+   checkpointRef.Exchange( xNow );
+   checkpointRef.Exchange( yNow );
+   checkpointRef.Exchange( yMaxHeld );
+   checkpointRef.Exchange( yMinHeld );
+   checkpointRef.Exchange( xMaxSeen );
+   checkpointRef.Exchange( xMinSeen );
+   checkpointRef.Exchange( binOverUnderSeen );
+   checkpointRef.Exchange( firstCycle );
+   checkpointRef.Exchange( validAtSource );
+   u_Histogram_analog->ExchangeStateWith( checkpointRef );
+   return;
+}
+
+
 bool CRainAnalog::IsValidOverCycles( size_t spanCallerIsUsing ) const {
 
    auto firstIteratorPositionPastSpan = ( statesLoggedAsBindex.begin() + spanCallerIsUsing );
@@ -1026,6 +1068,24 @@ void CRainFact::CaptureSnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
    );
 }
 
+
+void CRainFact::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   ARainfall::AddBytesHeldTo( censusRef );
+   u_Histogram_fact->AddBytesHeldTo( censusRef );
+   return;
+}
+
+
+void CRainFact::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ARainfall::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( bindexNow );
+   checkpointRef.Exchange( lastValidClaim );
+   u_Histogram_fact->ExchangeStateWith( checkpointRef );
+   return;
+}
+
 //======================================================================================================/
 
 void CRainFact::Cycle(  time_t timestampNow,
@@ -1243,58 +1303,36 @@ void CRainRuleKit::SaveRuleSnapshotUnderSetSgi( Nzint_t ruleUai,
 
 //======================================================================================================/
 
-void CRainRuleKit:: WriteFailsOnRulesToRainfall( const RuleUaiToPtrTable_t& p_RulesByUai ) {
+std::vector<BinSum_t> CRainRuleKit::SumFailsOnRulesOverTrapSpan(
+                                                         const RuleUaiToPtrTable_t& p_RulesByUai ) {
 
-   /* Assigns to each "column" of rainfall bins a CRule object held by kit, and from the bindex logs,
-      writes into each bin of that column false/true value of whether data failed the given rule on
-      the cycle each bin "vertically" represents.  That action is iterated back ("down") to trapDepth.
+   /* From the bindex log of each CRule object held by kit, counts cycles (back to trapDepth) on which
+      data failed that rule while it was in auto mode.  Rule-state rows have few bins, so counts are
+      made directly off each log on call stack.  Sums are in order logs iterate, See Method Note [1]
    */
-   auto citerSteppingLogByLog = ruleStatesLoggedAsBindex_byRuleUai.cbegin();
-      // a "citer" is a const iterator ("iter")
-
-   std::deque<Bindex_t>::const_iterator citerSteppingCycleByCycle;
-   size_t iColumnWritingTo = 0u;
-   Nzint_t ruleUaiOfLogRead = 0u;
-   Bindex_t bindexRead = NaNBINDEX;
-   bool readLogWriteRain = NaNBOOL;
-   bool ruleInAutoMode = NaNBOOL;
+   std::vector<BinSum_t> sumsOfFails_indexedAsLogsIterate;
+   sumsOfFails_indexedAsLogsIterate.reserve( ruleStatesLoggedAsBindex_byRuleUai.size() );
 
    // clear these every call, so any change in source data is effected via a reload
    ruleHasNoSnapshot_indexedAsLogsIterate.clear(); 
 
-   while ( citerSteppingLogByLog != ruleStatesLoggedAsBindex_byRuleUai.end() ) {
-       
-      ruleUaiOfLogRead = (*citerSteppingLogByLog).first;
-      ruleInAutoMode = p_RulesByUai.at(ruleUaiOfLogRead)->IsInAutoMode();
-
-      citerSteppingCycleByCycle = (*citerSteppingLogByLog).second.cbegin();
-
-      for ( size_t iRowWritingTo = 0u;
-            iRowWritingTo < trapSpanInCycles;  // rainRow index @ "back" of trap = (cyclesTrapSpan-1)
-            ++iRowWritingTo ) {
+   for ( const auto& pairRef : ruleStatesLoggedAsBindex_byRuleUai ) {
 
-          bindexRead = *citerSteppingCycleByCycle; // last line in FOR-loop steps this back thru "time"
+      // For const use of container, must call at(), since operator[] is not read-only
+      const auto& p_Rule = p_RulesByUai.at( pairRef.first );
 
-         // For rainfall register as utilized by CRuleKit, [row][column] is [time step][rule log]
-         rainfallRegister[iRowWritingTo][iColumnWritingTo] =
-            (  (  ( bindexRead == static_cast<Bindex_t>(0) ) && ruleInAutoMode ) ?
-                     true :
-                     false ); // reads NaNs okay as ='false'
+      // NaNBINDEX shares bindex 0 with a fail, so NaNs count as fails (as always in this kit)
+      sumsOfFails_indexedAsLogsIterate.push_back(
+         p_Rule->IsInAutoMode() ?
+            SumBindexLogOverNewestCycles<FIXED_RAIN_RULESTATE_NUMBINS>(
+                                                   pairRef.second,
+                                                   trapSpanInCycles )[BINDEX_RULE_AUTOMODEFAIL] :
+            0 );
 
-         // "Advancing" thru a bindex log is actually stepping back thru cycles (older values)
-         // trapSpanInCycles is elsewhere ensured to be <= fixed size of static rainfall register
-         std::advance( citerSteppingCycleByCycle, 1 );
-      } 
-      // For const use of container, must call at(), since operator[] is not read-only
       // Following is vector of ints having Boolean meaning       
-      ruleHasNoSnapshot_indexedAsLogsIterate.push_back(
-         ( (p_RulesByUai.at(ruleUaiOfLogRead)->SaySnapshotSetSgi() == 0u) ? 1 : 0 ) );
-
-     //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/ 
-      std::advance(citerSteppingLogByLog, 1);   // advance citer to next log
-      ++iColumnWritingTo;
+      ruleHasNoSnapshot_indexedAsLogsIterate.push_back( ( p_Rule->SaySnapshotSetSgi() == 0u ) ? 1 : 0 );
    }   
-   return;  // Results of all Logs in Rule Kit loaded into Rainfall, ready for trap action
+   return sumsOfFails_indexedAsLogsIterate;  // Counting on NRVO
 }
 
 //======================================================================================================/
@@ -1305,28 +1343,10 @@ RuleTrapResult_t CRainRuleKit::EnableTrapAndSayResult( const RuleUaiToPtrTable_t
    Nzint_t uaiOfAutoModeRuleHavingMostFailsInTrapSpan = 0u;
    Nzint_t uaiOfAutoModeRuleToDiscardItsOldSnapshots = 0u;
 
-   // side-effect of following call is to refresh 'ruleLoggedHasNoSnapshot'
-   WriteFailsOnRulesToRainfall( p_RulesById );
-
-   // See Method Note [1]
-   std::vector<BinSum_t>      sumsOfFails_indexedAsLogsIterate( p_RulesById.size(), 0 ); 
+   // See Method Note [1]; side-effect of following call is to refresh 'ruleLoggedHasNoSnapshot'
+   std::vector<BinSum_t>      sumsOfFails_indexedAsLogsIterate = SumFailsOnRulesOverTrapSpan( p_RulesById );
    BinSum_t                   sumSumsOfFails = 0;
 
-   for ( size_t cyclesBack=0u;
-         cyclesBack < trapSpanInCycles;
-         ++cyclesBack ) {
-
-      for ( size_t iLogReadFrom = 0;
-            iLogReadFrom < sumsOfFails_indexedAsLogsIterate.size(); // i.e., number of rules in kit
-            ++iLogReadFrom ) {
-
-         // For rainfall register as utilized by CRuleKit, [row][column] is [time step][rule log]      
-         if ( rainfallRegister[cyclesBack][iLogReadFrom] == true ) {
-            ++sumsOfFails_indexedAsLogsIterate[iLogReadFrom];
-         } 
-      } // close on each rule in kit (rainfall "column")
-   } // close on each cycle spanned by trap (rainfall "row")
-
    // sum fails to signal whether trap is empty or not
    sumSumsOfFails = std::accumulate(   sumsOfFails_indexedAsLogsIterate.begin(),
                                        sumsOfFails_indexedAsLogsIterate.end(),
@@ -1399,8 +1419,8 @@ xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
 Method Notes
 
 [1]   Per S.O., typically faster that following entities are local vs. object members or class statics.
-      Rule UAIs associated to columns in rainfallRegister (a 2-D array) are in order the p_RulesByUai
-      pointer table (an unordered map) was iterated in WriteFailsOnRulesToRainfall() (i.e., an 
+      Rule UAIs associated to elements of the sums of fails are in order the bindex logs table (an
+      unordered map) was iterated in SumFailsOnRulesOverTrapSpan() (i.e., an 
       "unordered" order totally up to compiler), and NOT in order rules were emplaced into p_RulesByUai
       (i.e., NOT in order CRule objects were added to the CRuleKit object.).   
 
@@ -1557,6 +1577,55 @@ EGuiReply CRainRuleKit::SetTrapSpanInSecs( int secsSpanGiven ) {
    return EGuiReply::OKAY_allDone; 
 }
 
+
+void CRainRuleKit::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   ARainfall::AddBytesHeldTo( censusRef );
+   censusRef.bytesRainfallLogs += ( HeapBytesHeldBy( bindexEnteringMovingHour_byRuleUai ) +
+                                    HeapBytesHeldBy( bindexLeavingMovingHour_byRuleUai ) +
+                                    HeapBytesHeldBy( ruleFailCosts_byRuleUai ) +
+                                    HeapBytesHeldBy( ruleUais_indexedAsLogsIterate ) +
+                                    HeapBytesHeldBy( ruleStatesNewest_indexedAsLogsIterate ) +
+                                    HeapBytesHeldBy( ruleHasNoSnapshot_indexedAsLogsIterate ) +
+                                    HeapBytesHeldBy( rulePinnedToUnitOutput_indexedAsLogsIterate ) +
+                                    HeapBytesHeldBy( ruleFailedNow_anyMode_indexedAsLogsIterate ) +
+                                    HeapBytesHeldBy( pinnedRuleFailedNow_anyMode_indexedAsLogsIterate ) );
+   censusRef.bytesSnapshotBanks += HeapBytesHeldBy( snapshotSetSgis_byRuleUai );
+
+   censusRef.bytesHistograms += HeapBytesHeldBy( u_HistogramsForEachRuleInKit_byUai );
+   for ( const auto& pairCref_histo : u_HistogramsForEachRuleInKit_byUai ) {
+      pairCref_histo.second->AddBytesHeldTo( censusRef );
+   }
+   if ( u_Histogram_ruleKitOverview ) { u_Histogram_ruleKitOverview->AddBytesHeldTo( censusRef ); }
+   return;
+}
+
+
+void CRainRuleKit::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   // Trap span is knobbed, and UAI iteration order is kept by restoring rule log table in place
+   ARainfall::ExchangeStateWith( checkpointRef );
+   checkpointRef.Exchange( bindexEnteringMovingHour_byRuleUai );
+   checkpointRef.Exchange( bindexLeavingMovingHour_byRuleUai );
+   checkpointRef.Exchange( ruleFailCosts_byRuleUai );
+   checkpointRef.Exchange( snapshotSetSgis_byRuleUai );
+   checkpointRef.Exchange( ruleStatesNewest_indexedAsLogsIterate );
+   checkpointRef.Exchange( ruleHasNoSnapshot_indexedAsLogsIterate );
+   checkpointRef.Exchange( ruleFailedNow_anyMode_indexedAsLogsIterate );
+   checkpointRef.Exchange( pinnedRuleFailedNow_anyMode_indexedAsLogsIterate );
+   checkpointRef.Exchange( cyclesUntilTrapEnable );
+
+   for ( Nzint_t ruleUai : ruleUais_indexedAsLogsIterate ) {
+      Nzint_t ruleUaiInImage = ruleUai;
+      checkpointRef.Exchange( ruleUaiInImage );
+      u_HistogramsForEachRuleInKit_byUai.at( ruleUaiInImage )->ExchangeStateWith( checkpointRef );
+   }
+   bool hasOverview = static_cast<bool>( u_Histogram_ruleKitOverview );
+   checkpointRef.Exchange( hasOverview );
+   if ( hasOverview ) { u_Histogram_ruleKitOverview->ExchangeStateWith( checkpointRef ); }
+   return;
+}
+
 //======================================================================================================/
 
 std::pair<Nzint_t,bool> CRainRuleKit::CycleRulesInKitAndSayResults(  time_t timestampNow,
@@ -28,6 +28,7 @@ class CHistogramAnalog;
 class CHistogramFact;
 class CHistogramRule;
 class CHistogramRuleKit;
+class CCheckpoint;
 class CPointAnalog;
 class CRule;
 class CRuleKit;
@@ -40,19 +41,36 @@ class ISeqElement;
    class hdrs via customTypes.hpp).
 */
 
-typedef bool Bin_t;    // One bin in any evaluated row of rainfall bins is "true", ALL others "false"
-
 //cycle-by-cycle (i.e., time-series) log of index of the "true" bin ("bindex") in row of rainfall bins :
 typedef std::deque<Bindex_t>                                   BindexLog_t;
 typedef std::unordered_map<Nzint_t, BindexLog_t>               RuleToLogTable_t;
-typedef std::array<Bin_t,FIXED_RAIN_ANALOGVALUE_NUMBINS>       BinRowAnalogValue_t;
-typedef std::array<BinRowAnalogValue_t, FIXED_RAINFALL_SIZE>   Rainfall_t;
 
 /* So, rainfall[row][col] -> [ index of source object cycle (i.e., "time") ][ index of binned value ]
-   Methods writing data into rainfall put "newest" row at lowest index ("front"); "oldest" row at
-   highest index ("back") [so "front" of "rainfall" is its "top" (the "cloud"), its "back" is "ground"] 
+   Logs put "newest" row at lowest index ("front"); "oldest" row at highest index ("back") [so "front"
+   of "rainfall" is its "top" (the "cloud"), its "back" is "ground"].  A row of bins has exactly one
+   "true" bin, so it is never materialized: counting "rain" in a bin column over the newest N rows is
+   just counting occurrences of that bindex in the newest N log entries.
 */
 
+template <size_t TTNumBins>
+std::array<BinSum_t,TTNumBins> SumBindexLogOverNewestCycles(   const BindexLog_t& logToRead,
+                                                               size_t numCyclesToSum ) {
+
+   // Bin count fixed at compile time, so sums of state rainfalls (3, 4, 11 bins) sit on call stack
+   static_assert( TTNumBins <= FIXED_RAIN_ANALOGVALUE_NUMBINS, "Bindex_t cannot index past 256 bins" );
+
+   std::array<BinSum_t,TTNumBins> binSums;
+   binSums.fill( 0 );
+
+   auto citerEnd = logToRead.cbegin();
+   std::advance( citerEnd, std::min( numCyclesToSum, logToRead.size() ) );
+
+   for ( auto citer = logToRead.cbegin(); citer != citerEnd; ++citer ) {
+      if ( static_cast<size_t>( *citer ) < TTNumBins ) { ++binSums[ static_cast<size_t>( *citer ) ]; }
+   }
+   return binSums;
+}
+
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 // Rainfall-related data structures
 
@@ -98,8 +116,10 @@ class ARainfall {
       virtual ~ARainfall( void );
 
       EGuiReply                     ResizeLoggingToAtLeastSecsAgo( int );
-      bool                          IsSnapshotSgiValid( Nzint_t ) const;
-      void                          DestroySnapshotForSetSgi( Nzint_t );
+      virtual bool                  IsSnapshotSgiValid( Nzint_t ) const;
+      virtual void                  DestroySnapshotForSetSgi( Nzint_t );
+      virtual void                  AddBytesHeldTo( MemoryCensus_t& ) const;
+      virtual void                  ExchangeStateWith( CCheckpoint& );     // See Class Note [4]
  
    protected:
 
@@ -108,14 +128,11 @@ class ARainfall {
 
    // Fields
 
-      static Rainfall_t             rainfallRegister;      // One actual "rainfall" that all instances use
       static size_t                 numIndiciesInSnapshot;
 
       RuleToLogTable_t              ruleStatesLoggedAsBindex_byRuleUai;
       BindexLog_t                   statesLoggedAsBindex;
-      BindexLog_t                   valuesLoggedAsBindex; // used only by CRainAnalog subclass
       SnapshotBindexBank_t          snapshotsStateBindex_bySetSgi; // See Class Note [2]
-      SnapshotBindexBank_t          snapshotsValueBindex_bySetSgi; // used only by CRainAnalog subclass
       std::map<size_t, Nzint_t>     spansInUse;      // <first, second> = <spanInCycles, num "users">
       const size_t                  movingHourSpanInCycles;    // used by histograms and long-term statistics
       const size_t                  lastIndexInMovingHour;     // used by histograms and long-term statistics
@@ -132,7 +149,7 @@ class ARainfall {
                   EApiType );
  
 
-      static void                   ReadBindexLogIntoRainfall( const std::deque<Bindex_t>& );
+      virtual void                  ExtendValueLogToCycles( size_t ) { } // See Class Note [3]
 
 
 /* CLASS NOTES vvvv2vvvvvvvvv3vvvvvvvvv4vvvvvvvvv5vvvvvvvvv6vvvvvvvvv7vvvvvvvvv8vvvvvvvvv9vvvvvvvvvCvvvvv
@@ -147,6 +164,13 @@ class ARainfall {
       only that set of rule/fact/point snapshots are taken and "banked", whenever any CRule has a
       'fail' result.  The set remains in existence 
 
+[3]   Value log and its snapshot bank are held only by CRainAnalog, as no other subclass logs values.
+      (Every std::deque allocates a map and a node even while empty, a cost paid per fact and rule kit
+      if they sat here.)  Base resizer reaches value log through this hook; no-op for other subclasses.
+
+[4]   Logs, snapshot banks, statistics and histogram slices are exchanged with a checkpoint, so a warm
+      restart resumes with full logs.  Log lengths are exchanged too, as they follow resize requests.
+
 ^^^^^ END CLASS NOTES */
      
 };
@@ -183,8 +207,8 @@ class CRainAnalog : public ARainfall {
       EGuiState                     SayGuiStateFromNewestBindex( void ) const;
 
 
-      float                         NowX( void ) const;
-      float                         NowY( void ) const;
+      float                         NowX( void ) const { return xNow; }  // Inline, see fact.hpp
+      float                         NowY( void ) const { return yNow; }
       float                         OldY_atDepth( size_t ) const;
       float                         MeanY_toDepth( size_t ) const;   // See File Note [1]
       float                         StdDevY_toDepth( size_t ) const; // See File Note [1]
@@ -193,7 +217,11 @@ class CRainAnalog : public ARainfall {
       EGuiReply                     AddNewStatisticsUserSpanningCycles( size_t );
       EGuiReply                     ShiftSpanOfStatisticsForOneUserFromTo( size_t, size_t );
       bool                          IsValidOverCycles( size_t ) const;
+      bool                          IsSnapshotSgiValid( Nzint_t ) const override;
       void                          CaptureSnapshotForSetSgi( Nzint_t );
+      void                          DestroySnapshotForSetSgi( Nzint_t ) override;
+      void                          AddBytesHeldTo( MemoryCensus_t& ) const override;
+      void                          ExchangeStateWith( CCheckpoint& ) override;
 
       void                          Cycle(   time_t,     // timestamp now
                                              bool,       // new calendar day?                
@@ -211,6 +239,8 @@ class CRainAnalog : public ARainfall {
       std::unique_ptr<CHistogramAnalog>      u_Histogram_analog;    // See Class Note [1]
  
    // Fields
+      BindexLog_t                            valuesLoggedAsBindex;   // See ARainfall Class Note [3]
+      SnapshotBindexBank_t                   snapshotsValueBindex_bySetSgi;
       std::unordered_map<size_t, float>      yMeansByDepth;
       std::unordered_map<size_t, float>      yVariancesByDepth;
       std::unordered_map<size_t, float>      yStdDevsByDepth;
@@ -231,6 +261,7 @@ class CRainAnalog : public ARainfall {
                                                                bool,
                                                                bool );
       void                             UpdateStatistics_Analog( void );
+      void                             ExtendValueLogToCycles( size_t ) override;
 
 /* Class Notes '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 
@@ -269,6 +300,8 @@ class CRainFact : public ARainfall {
       EGuiState                     SayGuiStateFromNewestBindex( void ) const;
       Bindex_t                      BindexWas_atCycles( size_t ) const;
       void                          CaptureSnapshotForSetSgi( Nzint_t );
+      void                          AddBytesHeldTo( MemoryCensus_t& ) const override;
+      void                          ExchangeStateWith( CCheckpoint& ) override;
 
       void                          Cycle(   time_t,     // time now
                                              bool,       // new calendar day?
@@ -330,6 +363,8 @@ class CRainRuleKit : public ARainfall {
       EGuiState                     SayGuiStateFromNewestBindexUnderRuleUai( Nzint_t ) const;
       int                           GetTrapSpanInSecs( void ) const;
       EGuiReply                     SetTrapSpanInSecs( int );
+      void                          AddBytesHeldTo( MemoryCensus_t& ) const override;
+      void                          ExchangeStateWith( CCheckpoint& ) override;
       std::pair<Nzint_t,bool>       CycleRulesInKitAndSayResults( time_t,  // time now
                                                                   bool,    // new day?
                                                                   bool,    // new hour?
@@ -373,7 +408,7 @@ class CRainRuleKit : public ARainfall {
       RuleTrapResult_t           EnableTrapAndSayResult( const RuleUaiToPtrTable_t& );
       void                       SaveRuleSnapshotUnderSetSgi(  Nzint_t,
                                                                Nzint_t );
-      void                       WriteFailsOnRulesToRainfall( const RuleUaiToPtrTable_t& );
+      std::vector<BinSum_t>      SumFailsOnRulesOverTrapSpan( const RuleUaiToPtrTable_t& );
 
 /*
 ''' START Class Notes ''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
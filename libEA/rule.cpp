@@ -22,8 +22,10 @@ See the License for the specific language governing permissions and limitations
 #include "case.hpp"              // call CreateCase() in rule kit cycle
 #include "agentTask.hpp"         // register rule kit to sequence
 #include "knowBase.hpp"          // call d-tor on CKnowBaseH5 u-pointer
+#include "mvc_ctrlr.hpp"         // register knowledge base for close-out at app shutdown
 #include "knowParts.hpp"         // call CHypo to add nodes to knowledge base
 #include "viewParts.hpp"
+#include "checkpoint.hpp"
 
 #include <algorithm>
 #include <numeric>
@@ -41,6 +43,13 @@ Nzint_t CRule::GenerateSgiForNewSnapshotSet( void ) {
    return sgiForNextSnapshotSet++;
 }  
 
+
+void CRule::ExchangeSgiCounterWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.Exchange( sgiForNextSnapshotSet );
+   return;
+}
+
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // C-tor and d-tor
 
@@ -237,6 +246,19 @@ bool CRule::HasDiagnostics( void ) const { return !p_AssocHypo.empty(); }
 bool CRule::HasSnapshotSet( void ) const { return holdingSnapshots; }
 
 
+void CRule::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.ExchangeTag( "rule" );
+   checkpointRef.Exchange( snapshotSetSgi );
+   checkpointRef.Exchange( bindexNow );
+   checkpointRef.Exchange( holdingSnapshots );
+   checkpointRef.Exchange( resultIf );
+   checkpointRef.Exchange( resultThen );
+   checkpointRef.Exchange( valid );
+   return;
+}
+
+
 bool CRule::IsInAutoMode( void ) const { return ( (caseModeOffset + idleModeOffset) == 0u ); }
 
 
@@ -398,6 +420,7 @@ CRuleKit::CRuleKit(  CSequence& bArg0,
 
    CalcOwnTriggerGroup();
    bArg0.Register(this);
+   CtrlrRef.Register( u_Kbase.get() );
    AttachOwnKnobs( arg1 );
    LendKnobKeysTo( knobKeys_ownedAndAntecedent );
 
@@ -412,7 +435,11 @@ CRuleKit::CRuleKit(  CSequence& bArg0,
 
 CRuleKit::~CRuleKit( void ) {
 
-   // Empty CRuleKit dtor
+   /* Stand-ins of antecedent Traces go with their sources (Tool members destroyed before the kit), so
+      drop ptrs to them before the r-t Krono d-tor would return Traces to them. Owned Traces go anyway.
+   */
+   p_TracesInRealtimeKrono_byKey.clear();
+   CtrlrRef.DeregisterKbase( u_Kbase.get() );
 }
 
 
@@ -527,7 +554,7 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithLogicChainOfRule(  Nzint_t uaiOfRule )
 
    std::pair<RtTraceAccessTable_t::iterator, bool> traceTableVerbReply =
       p_TracesInRealtimeKrono_byKey.emplace(
-         std::pair< NGuiKey, CTraceRealtime*>(
+         std::pair< NGuiKey, CTraceRealtimeLazy*>(
             ruleTraceKey,
             u_RealtimeTracesForRulesInKit_byUai[uaiOfRule].get()
          )
@@ -535,10 +562,11 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithLogicChainOfRule(  Nzint_t uaiOfRule )
 
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 /* Declare one local name to use for multiple allocations of new Panes on the heap, first constructing
-   a Pane exclusively for the rule :
+   a Pane exclusively for the rule.  Every Trace in the access table is borrowed exactly once here and
+   returned by ClearKitOfRealtimeKronoParts(), so Traces exist only while shown on the Krono.
 */ 
    std::unique_ptr<CPaneRealtime> u_RealtimePane_locallyScopedOnHeap =
-      std::make_unique<CPaneRealtime>( p_TracesInRealtimeKrono_byKey[ruleTraceKey],
+      std::make_unique<CPaneRealtime>( p_TracesInRealtimeKrono_byKey[ruleTraceKey]->BorrowTrace(),
                                        ViewRef
    );
 
@@ -561,6 +589,7 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithLogicChainOfRule(  Nzint_t uaiOfRule )
 
       if ( pairRef_trace.first == ruleTraceKey ) { continue; }  // Rule result keeps its own pane
 
+      const CTraceRealtime* const p_trace = pairRef_trace.second->BorrowTrace();
       traceMatchedAndAddedToPane = false;
 
       // Iter over created Panes; redeclare on each lap of for-loop in case emplacing invalidates it (?)
@@ -569,7 +598,7 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithLogicChainOfRule(  Nzint_t uaiOfRule )
       while ( ! traceMatchedAndAddedToPane ) {
 
          traceMatchedAndAddedToPane =
-            pairIter_pane->second->AddTraceIfCompatible( pairRef_trace.second );
+            pairIter_pane->second->AddTraceIfCompatible( p_trace );
 
          if ( traceMatchedAndAddedToPane ) {
             // go to next available Trace via for-loop, which also puts Pane iterator back to begin()
@@ -584,7 +613,7 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithLogicChainOfRule(  Nzint_t uaiOfRule )
          // ... or, if no more panes, create a new pane based upon currently iterated trace :
 
          u_RealtimePane_locallyScopedOnHeap = 
-            std::make_unique<CPaneRealtime>( pairRef_trace.second,
+            std::make_unique<CPaneRealtime>( p_trace,
                                              ViewRef
             );
 
@@ -654,12 +683,25 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithResultsFromAllRulesInKit( bool userInpu
 
    if ( userInput == false ) { return EGuiReply::OKAY_allDone; } 
 
+//''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+// Load access to Traces of all Rules in kit, so ClearKitOfRealtimeKronoParts() returns those borrowed
+
+   for ( const auto& pairRef_ruleTrace : u_RealtimeTracesForRulesInKit_byUai ) {
+
+      p_TracesInRealtimeKrono_byKey.emplace(
+         std::pair< NGuiKey, CTraceRealtimeLazy*>(
+            pairRef_ruleTrace.second->SayGuiKey(),
+            pairRef_ruleTrace.second.get()
+         )
+      );
+   }
+
 //''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 // Construct one Pane to display all Traces of Rules in kit, initialized with Trace of Rule at top of GUI
  
    std::unique_ptr<CPaneRealtime> u_RealtimePane_locallyScopedOnHeap =
       std::make_unique<CPaneRealtime>(
-         u_RealtimeTracesForRulesInKit_byUai[ ruleUais_guiTopToBottom[0] ].get(),
+         u_RealtimeTracesForRulesInKit_byUai[ ruleUais_guiTopToBottom[0] ]->BorrowTrace(),
          ViewRef
       );
 
@@ -680,7 +722,7 @@ EGuiReply CRuleKit::LoadRealtimeKronoWithResultsFromAllRulesInKit( bool userInpu
       traceMatchedAndAddedToPane =
          u_PanesInRealtimeKrono_byKey[keyOfRulesPane]->
             AddTraceIfCompatible(
-               u_RealtimeTracesForRulesInKit_byUai[ ruleUais_guiTopToBottom[iRead] ].get()
+               u_RealtimeTracesForRulesInKit_byUai[ ruleUais_guiTopToBottom[iRead] ]->BorrowTrace()
             );
    }       
 
@@ -714,6 +756,13 @@ void CRuleKit::Cycle( time_t timestampNow ) {
 
    if ( ! kitFinalized ) { throw std::logic_error( "Attempted to run unfinalized Rule Kit" ); }
 
+   // Release a r-t Krono the GUI stopped polling; its d-tor returns Traces and resets selecting knobs
+   if (  ( u_RealtimeKrono != nullptr ) &&
+         u_RealtimeKrono->HasGoneUnrequestedForSecs( FIXED_KRONO_REALTIME_SECSIDLE_MAX ) ) {
+
+      u_RealtimeKrono.reset( nullptr );
+   }
+
    // triggering the kit's individual CRule objects to cycle is done by the kit's rainfall object
    std::pair<Nzint_t,bool> cycleResults =
       u_RainRuleKit->CycleRulesInKitAndSayResults( timestampNow,                                                                        
@@ -740,14 +789,8 @@ void CRuleKit::Cycle( time_t timestampNow ) {
 
    if ( p_Rules_byUai[uaiTrappedRule]->IsInAutoMode() ) {
 
-      CaseKitRef.CreateAndOwnCase(  *this,
-                                    SubjRef,
-                                    timestampNow,
-                                    triggerCount,
-                                    secsPerCycle,
-                                    *p_Rules_byUai[uaiTrappedRule],
-                                    *u_RealtimeTracesForRulesInKit_byUai[uaiTrappedRule]
-      );
+      // Case itself is built after the step, See Class Note [6] in header
+      trapsAwaitingCase.push_back( { timestampNow, uaiTrappedRule, triggerCount } );
       areAllRulesNotInCaseModePutToIdle = false; // the knob idling all rules needs to know this
    }
    return;                                             
@@ -900,12 +943,13 @@ void CRuleKit::AddRuleToKit( CRule* const p_Rule ) {
 void CRuleKit::ClearKitOfRealtimeKronoParts( void ) {
 
    // Clear Rule Kit's standing tables of Traces and Panes:
-   // All r-t Traces are immortal and owned elsewhere, so clear local ptrs but do not deallocate 
-   p_TracesInRealtimeKrono_byKey.clear();
-
    // r-t Panes are mortal and owned locally, so let smart ptrs self-deallocate upon clearing vector
    u_PanesInRealtimeKrono_byKey.clear();
 
+   // r-t Trace stand-ins are immortal and owned elsewhere, so return borrowed Traces and clear ptrs
+   for ( auto pairByValue : p_TracesInRealtimeKrono_byKey ) { pairByValue.second->ReturnTrace(); }
+   p_TracesInRealtimeKrono_byKey.clear();
+
    // in case Krono had been showing results from "all rules in kit" :
    isRealtimeKronoShowingAllRules = false;
 
@@ -913,6 +957,58 @@ void CRuleKit::ClearKitOfRealtimeKronoParts( void ) {
    return;
  }
 
+//======================================================================================================/
+
+void CRuleKit::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   u_RainRuleKit->AddBytesHeldTo( censusRef );
+   censusRef.bytesTraces += HeapBytesHeldBy( u_RealtimeTracesForRulesInKit_byUai );
+   for ( const auto& pairCref_lazy : u_RealtimeTracesForRulesInKit_byUai ) {
+      pairCref_lazy.second->AddBytesHeldTo( censusRef );
+   }
+   return;
+}
+
+
+//======================================================================================================/
+
+void CRuleKit::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   ISeqElement::ExchangeStateWith( checkpointRef );
+   u_RainRuleKit->ExchangeStateWith( checkpointRef );
+   for ( Nzint_t uai : ruleUais_guiTopToBottom ) {
+      p_Rules_byUai.at(uai)->ExchangeStateWith( checkpointRef );
+   }
+   checkpointRef.Exchange( areAllRulesNotInCaseModePutToIdle );
+
+   // Cases are exchanged as trap records and reopened, See Class Note [5] in header
+   std::vector<SCaseTrap> caseTraps = CaseKitRef.SayTrapsOfOpenCasesOldestFirst();
+   caseTraps.insert( caseTraps.end(), trapsAwaitingCase.begin(), trapsAwaitingCase.end() );
+   checkpointRef.Exchange( caseTraps );
+   if ( checkpointRef.IsRestoring() ) {
+      trapsAwaitingCase = caseTraps;
+      CreateCasesForTrapsRecorded();
+   }
+   return;
+}
+
+
+void CRuleKit::CreateCasesForTrapsRecorded( void ) {
+
+   for ( const SCaseTrap& trapCref : trapsAwaitingCase ) {
+      CaseKitRef.CreateAndOwnCase(  *this,
+                                    SubjRef,
+                                    trapCref.timeTrapped,
+                                    trapCref.triggerCountAtTrap,
+                                    secsPerCycle,
+                                    *p_Rules_byUai.at(trapCref.ruleUai),
+                                    *u_RealtimeTracesForRulesInKit_byUai.at(trapCref.ruleUai)
+      );
+   }
+   trapsAwaitingCase.clear();
+   return;
+}
+
 
 //======================================================================================================/
 
@@ -957,12 +1053,12 @@ void CRuleKit::FinalizeRuleKitAndBuildKbase( void ) {
 
       std::pair<RtRuleTraceOwnershipTable_t::iterator, bool> ruleTraceTableVerbReply =
          u_RealtimeTracesForRulesInKit_byUai.emplace(
-            std::pair<Nzint_t, std::unique_ptr<CTraceRealtime> >(
+            std::pair<Nzint_t, std::unique_ptr<CTraceRealtimeLazy> >(
                pairByValue_rule.first,    // first in pair is the Rule's UAI
-               std::make_unique<CTraceRealtime>(   SubjRef.SayViewRef(),
-                                                   *u_RainRuleKit,
-                                                   *pairByValue_rule.second,
-                                                   pairByValue_rule.second->SayCrefToKnobKeys()
+               std::make_unique<CTraceRealtimeLazy>(  SubjRef.SayViewRef(),
+                                                      *u_RainRuleKit,
+                                                      *pairByValue_rule.second,
+                                                      pairByValue_rule.second->SayCrefToKnobKeys()
                )
          )
       );
@@ -996,6 +1092,7 @@ void CRuleKit::FinalizeRuleKitAndBuildKbase( void ) {
 
       p_ruleIter.second->BuildRuleIntoKbase( *u_Kbase );
    }
+   u_Kbase->FlushWritesBehind();    // initial nodes to disk now, and file let go before next kit opens its own
    kitFinalized = true;
    return;
 }
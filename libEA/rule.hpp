@@ -40,13 +40,14 @@ class CPaneRealtime;
 class CRainRuleKit;
 class CRuleKit;
 class CSeqTimeAxis;
-class CTraceRealtime;
+class CTraceRealtimeLazy;
 class CView;
 
+struct SCaseTrap;
 struct SEnergyPrices;
 
 typedef std::unordered_map<NGuiKey, std::unique_ptr<CPaneRealtime>>     RtPaneOwnershipTable_t;
-typedef std::unordered_map<Nzint_t, std::unique_ptr<CTraceRealtime>>    RtRuleTraceOwnershipTable_t;
+typedef std::unordered_map<Nzint_t, std::unique_ptr<CTraceRealtimeLazy>>   RtRuleTraceOwnershipTable_t;
 
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
@@ -96,6 +97,8 @@ class CRule {
       EApiReply                     DestroySnapshotSet( void );
       void                          AssociateHypo( CHypo* const );
       void                          BuildRuleIntoKbase( CKnowBaseH5& );    // See Class Note [3]  
+      void                          ExchangeStateWith( CCheckpoint& );     // See Class Note [7]
+      static void                   ExchangeSgiCounterWith( CCheckpoint& );
 
       int      SayDollarPerDayFaultCost( const SEnergyPrices& );           // See Class Note [1]
 
@@ -166,6 +169,10 @@ class CRule {
 
 [6]   = 0 when Rule holds no snapshot.          
 
+[7]   Exchanges results and snapshot state only.  Idle mode is restored by the rule's own knob, and case
+      mode by the CCase its kit reopens on restore.  The static SGI counter is exchanged once per engine,
+      by CSequence, so a restored engine does not reissue SGIs of snapshot sets it still holds.
+
 ^^^^ END CLASS NOTES */
 
 };
@@ -213,6 +220,9 @@ class CRuleKit  : public ISeqElement {
       NGuiKey                          SayHistogramKey( void ) const;
       void                             AddRuleToKit( CRule* const );
       void                             ClearKitOfRealtimeKronoParts( void );
+      void                             CreateCasesForTrapsRecorded( void );    // See Class Note [6]
+      virtual void                     AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void                     ExchangeStateWith( CCheckpoint& ) override; // See Class Note [5]
 
       // Called explicitly by tool.cpp only after all rules/hypos/evid registered to kit:
       // $$$ (Yes, smelly, but do not now see TBD alternative) $$$
@@ -239,6 +249,7 @@ class CRuleKit  : public ISeqElement {
       std::vector<NGuiKey>             knobKeysOfRuleKitItself;
       std::vector<NGuiKey>             knobKeyOfEachRuleInKit_guiTopToBottom;
       std::vector<NGuiKey>             histogramKeyOfEachRuleInKit_guiTopToBottom;
+      std::vector<SCaseTrap>           trapsAwaitingCase;
       const Nzint_t                    kitSgiFromSubject;
       Nzint_t                          uaiOfRuleInRtKrono_zeroIfNoneOrAll;
       bool                             areAllRulesNotInCaseModePutToIdle;  // needed for implementing a knob
@@ -286,6 +297,15 @@ class CRuleKit  : public ISeqElement {
 
 [4]   depth of failedRuleRain, in cycles = (depth in triggers) / tpc.            
 
+[5]   Cases open at save are reopened on restore from their trap record (rule, trap time, trigger count),
+      reading tallies afresh from the Kbase.  A reopened case keeps its snapshots, but its dialogue with
+      the User restarts at the top menu.
+
+[6]   A rule trapping on Cycle() only records an immutable trap event (the snapshots it needs were
+      already taken by the kit's rainfall).  Building the case (its snapshot Krono, Kbase tallies and
+      report text) is deferred to this method, called by CController once the whole step has run.  So a
+      burst of traps does not stretch the step in which they happen.
+
 ^^^^ END CLASS NOTES */
 
 };
@@ -20,6 +20,7 @@ See the License for the specific language governing permissions and limitations
 #include "controlParts.hpp"
 #include "agentTask.hpp"
 #include "taskClock.hpp"
+#include "checkpoint.hpp"
 
 #include <iomanip>
 #include <algorithm>
@@ -214,6 +215,26 @@ void ISeqElement::LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ptrTable ) c
 }
 
 
+void ISeqElement::AddBytesHeldTo( MemoryCensus_t& /*censusRef*/ ) const {
+
+   // Base class defaults to NOP; subclasses holding a rainfall or r-t Trace(s) must override
+   return;
+}
+
+
+void ISeqElement::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.ExchangeTag( "element" );
+   checkpointRef.Exchange( triggerCount );
+   checkpointRef.Exchange( triggersUntilCycle );
+   checkpointRef.Exchange( cycleBeginsNewCalendarDay );
+   checkpointRef.Exchange( cycleBeginsNewClockHour );
+   checkpointRef.Exchange( validNow );
+   checkpointRef.Exchange( validWas );
+   return;
+}
+
+
 /* START FILE NOTES XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXX
 
 [1]   Typ for protected fields related to cycling, initialized with default values that may be
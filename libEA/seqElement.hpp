@@ -28,6 +28,7 @@ See the License for the specific language governing permissions and limitations
 // fwd declare
 class AKnob;
 class ASubject;
+class CCheckpoint;
 class CSequence;
 class CView;
 
@@ -60,6 +61,8 @@ class ISeqElement {
       void                 LendKnobKeysTo( std::vector<NGuiKey>& ) const;      // See Class Note [5]
       virtual void         LendHistogramKeysTo( std::vector<NGuiKey>& ) const; // Base defaults to NOP
       virtual void         LendRealtimeAnalogAccessTo( RtTraceAccessTable_t& ) const;
+      virtual void         AddBytesHeldTo( MemoryCensus_t& ) const;            // Base defaults to NOP
+      virtual void         ExchangeStateWith( CCheckpoint& );                  // See Class Note [8]
   
    protected:
 
@@ -143,6 +146,10 @@ class ISeqElement {
 
 [7]   Starts empty and passed PBR to ctors of trace and histogram, then loaded by AttchOwnKnobs()
       routine and sent to antecedent object(s) at end of subclass ctor.      
+
+[8]   Saves or restores (per mode of the CCheckpoint) the fields here that change as the object cycles.
+      Subclasses override to add their own fields and those of their rainfall, then call the base
+      version first.  Fields set by c-tor or by knobs are not exchanged; see checkpoint.hpp.
   
 ^^^^^ END CLASS NOTES */
 
@@ -31,6 +31,7 @@ See the License for the specific language governing permissions and limitations
 #include "fact.hpp"
 #include "rule.hpp"
 #include "viewParts.hpp"   // needed for CSeqTimeAxis length
+#include "checkpoint.hpp"
 
 #include <numeric>
 
@@ -112,6 +113,89 @@ void CSequence::Register( CRuleKit* arg )  {
    return;
 }
 
+
+std::vector<size_t> CSequence::SayRegistrySizes( void ) const {
+
+   // Order here must match order in ReserveRegistries()
+   return std::vector<size_t>{   p_Points.size(),
+                                 p_Formulas.size(),
+                                 p_Charts.size(),
+                                 p_Processes.size(),
+                                 p_Facts.size(),
+                                 p_RuleKits.size() };
+}
+
+
+void CSequence::ReserveRegistries( const std::vector<size_t>& sizes ) {
+
+   if ( sizes.size() != 6 ) {
+      throw std::logic_error( "Sequence registry sizes malformed" ); // deliberately no catch
+   }
+   p_Points.reserve( sizes[0] );
+   p_Formulas.reserve( sizes[1] );
+   p_Charts.reserve( sizes[2] );
+   p_Processes.reserve( sizes[3] );
+   p_Facts.reserve( sizes[4] );
+   p_RuleKits.reserve( sizes[5] );
+   return;
+}
+
+
+void CSequence::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   for ( const auto ptr : p_Points ) { ptr->AddBytesHeldTo( censusRef ); }
+   for ( const auto ptr : p_Formulas ) { ptr->AddBytesHeldTo( censusRef ); }
+   for ( const auto ptr : p_Charts ) { ptr->AddBytesHeldTo( censusRef ); }
+   for ( const auto ptr : p_Processes ) { ptr->AddBytesHeldTo( censusRef ); }
+   for ( const auto ptr : p_Facts ) { ptr->AddBytesHeldTo( censusRef ); }
+   for ( const auto ptr : p_RuleKits ) { ptr->AddBytesHeldTo( censusRef ); }
+   return;
+}
+
+
+void CSequence::CreateCasesForTrapsRecorded( void ) {
+
+   for ( const auto ptr : p_RuleKits ) { ptr->CreateCasesForTrapsRecorded(); }
+   return;
+}
+
+
+void CSequence::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   // Order here must match order in SayTopologyFingerprint()
+   u_TimeAxis->ExchangeStateWith( checkpointRef );
+   CRule::ExchangeSgiCounterWith( checkpointRef );
+   for ( const auto ptr : p_Points ) { ptr->ExchangeStateWith( checkpointRef ); }
+   for ( const auto ptr : p_Formulas ) { ptr->ExchangeStateWith( checkpointRef ); }
+   for ( const auto ptr : p_Charts ) { ptr->ExchangeStateWith( checkpointRef ); }
+   for ( const auto ptr : p_Processes ) { ptr->ExchangeStateWith( checkpointRef ); }
+   for ( const auto ptr : p_Facts ) { ptr->ExchangeStateWith( checkpointRef ); }
+   for ( const auto ptr : p_RuleKits ) { ptr->ExchangeStateWith( checkpointRef ); }
+   return;
+}
+
+
+std::uint64_t CSequence::SayTopologyFingerprint( void ) const {
+
+   std::uint64_t hash = 14695981039346656037ull;      // FNV-1a, over whole values rather than bytes
+   auto HashIn = [&hash]( std::uint64_t value ) { hash ^= value; hash *= 1099511628211ull; };
+
+   for ( size_t size : SayRegistrySizes() ) { HashIn( size ); }
+   for ( const auto p_Registry : { &p_Points, &p_Formulas, &p_Charts, &p_Processes, &p_Facts } ) {
+      for ( const auto ptr : *p_Registry ) {
+         HashIn( static_cast<std::uint64_t>( ptr->SayApiType() ) );
+         HashIn( static_cast<std::uint64_t>( ptr->SayLabel() ) );
+         HashIn( static_cast<std::uint64_t>( ptr->SayTriggersPerCycle() ) );
+         HashIn( static_cast<std::uint64_t>( ptr->SaySecsPerCycle() ) );
+      }
+   }
+   for ( const auto ptr : p_RuleKits ) {
+      HashIn( static_cast<std::uint64_t>( ptr->SayLabel() ) );
+      HashIn( static_cast<std::uint64_t>( ptr->SaySecsPerCycle() ) );
+   }
+   return hash;
+}
+
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 
 void CSequence::Configure( void ) {
@@ -366,6 +450,17 @@ void CSeqTimeAxis::DestroySnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
 }   
 
 
+void CSeqTimeAxis::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.ExchangeTag( "timeAxis" );
+   checkpointRef.Exchange( snapshots_bySetSgi );
+   checkpointRef.Exchange( timesHeld_newestToOldest );
+   checkpointRef.Exchange( secsLogging );
+   checkpointRef.Exchange( firstCall );
+   return;
+}
+
+
 time_t CSeqTimeAxis::SayTimeNewest( void ) const { return timesHeld_newestToOldest[0]; }
 
 
@@ -394,7 +394,8 @@ CDomain::CDomain( ERealName arg )
                      p_SubjOutputs_byName_byLabel(),
                      p_Subjects_byName(),
                      p_View (nullptr),
-                     unsaidAlertsFifo(),
+                     alertRing(),
+                     unsaidAlertsCursor( 0 ),
                      energyPrices( SEnergyPrices(0, 0, 0, 0, 0) ),
                      domainName (arg) {
 }
@@ -408,12 +409,25 @@ std::queue<std::string> CDomain::SayNewAlertsFifoThenClear( void ) {
 
    std::queue<std::string> reply;         // constructs empty
 
-   std::swap( unsaidAlertsFifo, reply );  // exchanges values between left and right arguments
+   // Alerts not yet said are those in the ring past the cursor; any the ring has overwritten are lost
+   for ( const auto& alertCref : alertRing.SayAlertsSince( unsaidAlertsCursor ) ) {
+      reply.push( alertCref.fullText );
+   }
+   unsaidAlertsCursor = alertRing.SayNextAlertId();
 
    return reply;
 }
 
 
+std::vector<GuiPackAlert_t> CDomain::SayAlertsSince( std::uint64_t cursor ) const {
+
+   return alertRing.SayAlertsSince( cursor );
+}
+
+
+std::uint64_t CDomain::SayNextAlertId( void ) const { return alertRing.SayNextAlertId(); }
+
+
 std::vector<NGuiKey>  CDomain::SaySubjectKeys( void ) const {
 
    std::vector<NGuiKey> reply(0);
@@ -489,11 +503,13 @@ void CDomain::PostAsNewAlert( time_t timestamp,
    std::string timeAsText("");
    WriteTimestampAsTextTo( timestamp, timeAsText );
 
-   unsaidAlertsFifo.push(  timeAsText + " " +
-                           LookUpText( domainName ) + " " +
-                           LookUpText( forwardingSubjectsName ) + " " +
-                           LookUpTag( sourceLabel ) + " " +
-                           LookUpText( alertFromSource )
+   // Texts are looked up here, on the stepping thread, so ring readers on other threads need none
+   alertRing.Post(   timestamp,
+                     timeAsText,
+                     LookUpText( domainName ),
+                     LookUpText( forwardingSubjectsName ),
+                     LookUpTag( sourceLabel ),
+                     LookUpText( alertFromSource )
    );
    return;
 }
@@ -18,6 +18,7 @@ See the License for the specific language governing permissions and limitations
 #define SUBJECT_HPP
 
 #include "guiShadow.hpp"      // brings customTypes.hpp, which brings exportTypes.hpp
+#include "alertRing.hpp"
 
 #include <memory>
 
@@ -295,6 +296,8 @@ class CDomain : public IGuiShadow {
 
       GuiPackDomain_t                  SayGuiPack( void ) const;
       std::queue<std::string>          SayNewAlertsFifoThenClear( void );
+      std::vector<GuiPackAlert_t>      SayAlertsSince( std::uint64_t ) const;    // any thread
+      std::uint64_t                    SayNextAlertId( void ) const;              // any thread
       std::vector<NGuiKey>             SaySubjectKeys( void ) const;
       const SEnergyPrices&             SayEnergyPricesRef( void ) const;
       std::string                      SayRootTextForDiskFilenames( void ) const;
@@ -317,7 +320,8 @@ class CDomain : public IGuiShadow {
       std::unordered_map<ERealName, ASubject*>           p_Subjects_byName;
       CView*                                             p_View;
       //ParamPack_t                                      ownParamPack;
-      std::queue<std::string>                            unsaidAlertsFifo;
+      CAlertRing                                         alertRing;
+      std::uint64_t                                      unsaidAlertsCursor;   // for the FIFO getter
       EnergyPrices_t                                     energyPrices;
       const ERealName                                    domainName;
    
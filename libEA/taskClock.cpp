@@ -16,6 +16,7 @@ See the License for the specific language governing permissions and limitations
 
 #include "taskClock.hpp"
 #include "agentTask.hpp"
+#include "checkpoint.hpp"
 
 #ifndef __linux
   // e.g. MacOS
@@ -71,6 +72,27 @@ void AClock::RegisterForBells( CAgent* arg ) {
 }
 
 
+void AClock::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.ExchangeTag( "clock" );
+   // std::tm exchanged field by field, as (glibc) tm_zone points into memory of the saving process
+   for ( std::tm* p_TimeStruct : { &timeStructNow, &timeStructWas } ) {
+      checkpointRef.Exchange( p_TimeStruct->tm_sec );
+      checkpointRef.Exchange( p_TimeStruct->tm_min );
+      checkpointRef.Exchange( p_TimeStruct->tm_hour );
+      checkpointRef.Exchange( p_TimeStruct->tm_mday );
+      checkpointRef.Exchange( p_TimeStruct->tm_mon );
+      checkpointRef.Exchange( p_TimeStruct->tm_year );
+      checkpointRef.Exchange( p_TimeStruct->tm_wday );
+      checkpointRef.Exchange( p_TimeStruct->tm_yday );
+      checkpointRef.Exchange( p_TimeStruct->tm_isdst );
+   }
+   checkpointRef.Exchange( clockReadAtBell );
+   checkpointRef.Exchange( valid );
+   return;
+}
+
+
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // CClockPerCtrlPort implementation
 
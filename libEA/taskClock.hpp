@@ -22,6 +22,7 @@ See the License for the specific language governing permissions and limitations
 #include <ctime>
 
 class CAgent;
+class CCheckpoint;
 
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Declare an abstract base class (ABC) for Clock objects.
@@ -40,6 +41,7 @@ class AClock {
       int                  SayBellPeriodSecs( void ) const;
       bool                 IsValid( void ) const;
       void                 RegisterForBells( CAgent* );
+      void                 ExchangeStateWith( CCheckpoint& );
 
    protected:
 
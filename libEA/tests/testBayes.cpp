@@ -0,0 +1,319 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Test of case Bayes updates over the dense tally matrix (CCase::ApplyBayesOverTallyRuns(),
+   CCase::SayPriorCountsTrueByRow()), on a small knowledge base built here from one rule of four hypos
+   and five evids, then "taught" by pseudo-random count increments.  Cases tested:
+   (1) Equivalence: the same evidence sequences are applied both by reading each node of the KB through
+       its cursor, as cases did before the tally matrix, and by the dense passes.  After every answer
+       the hypos alive, their states, accumulated counts and posteriors (pct x 10) must agree, the
+       posteriors within POSTERIOR_TOLERANCE_PCTX10.
+   (2) Rerank after learning: once the KB is taught further, a matrix reloaded from the KB must give the
+       same a-priori counts as a fresh read of the KB, and the hypo just taught must rank first.
+   Usage:  bin/testBayes      (run from any writable directory; exit status is count of failures)
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "case.hpp"
+#include "knowBase.hpp"
+#include "knowParts.hpp"
+#include "HDF5Parts.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+static const char*   KBASE_FILE = "testBayes_kb.h5";
+static const Nzint_t RULE_ID = 1u;
+static const Nzint_t NUM_HYPOS = 4u;
+static const Nzint_t NUM_EVIDS = 5u;
+static const size_t  NUM_TEACHINGS = 240u;
+static const size_t  NUM_SEQUENCES = 40u;
+static const short   POSTERIOR_TOLERANCE_PCTX10 = 1;
+
+
+// Evids associated to each hypo: { hypo, evid, direct?, invertible? }
+
+struct SAssoc {
+   Nzint_t  hypoId;
+   Nzint_t  evidId;
+   bool     direct;
+   bool     invertible;
+};
+
+static const std::vector<SAssoc> ASSOCS = {
+   { 1u, 1u, true,  true  }, { 1u, 2u, false, true  }, { 1u, 5u, true,  false },
+   { 2u, 2u, true,  true  }, { 2u, 3u, true,  false },
+   { 3u, 3u, false, true  }, { 3u, 4u, true,  true  }, { 3u, 1u, false, false },
+   { 4u, 4u, false, true  }, { 4u, 5u, true,  true  } };
+
+
+// Deterministic pseudo-random numbers (LCG), so a failure can be re-run as is
+
+static size_t SayNextRandom( unsigned long long& stateRef, size_t bound ) {
+
+   stateRef = ( stateRef * 6364136223846793005ULL ) + 1442695040888963407ULL;
+   return static_cast<size_t>( ( stateRef >> 33 ) % bound );
+}
+
+
+static void BuildKbase( CKnowBaseH5& kbaseRef,
+                        std::vector<std::unique_ptr<CHypo>>& u_HyposRef,
+                        std::vector<std::unique_ptr<CEvid>>& u_EvidsRef ) {
+
+   std::vector<Nzint_t> allHypoIds;
+   for ( Nzint_t id = 1u; id <= NUM_EVIDS; ++id ) {
+      u_EvidsRef.push_back( std::make_unique<CEvid>( id, "Is evid " + std::to_string( id ) + " true?" ) );
+   }
+   for ( Nzint_t id = 1u; id <= NUM_HYPOS; ++id ) {
+      u_HyposRef.push_back( std::make_unique<CHypo>( id, "Hypo " + std::to_string( id ) ) );
+      allHypoIds.push_back( id );
+   }
+   for ( const SAssoc& assocCref : ASSOCS ) {
+      u_HyposRef[assocCref.hypoId - 1u]->AssociateEvid(  u_EvidsRef[assocCref.evidId - 1u].get(),
+                                                         assocCref.direct,
+                                                         assocCref.invertible );
+   }
+   for ( const auto& u_HypoCref : u_HyposRef ) {
+      u_HypoCref->BuildRuleAndHypoIntoKbase( RULE_ID, allHypoIds, kbaseRef );
+   }
+}
+
+
+// Adds one count (hypo true, or hypo false) at a node, as a case learning its solution would
+
+static void TeachNode( CKnowBaseH5& kbaseRef, Nzint_t hypoId, Nzint_t evidId, size_t evidValue, bool hypoTrue ) {
+
+   kbaseRef.PanCursorToNodeAt( RULE_ID, hypoId, evidId );
+   kbaseRef.ReadCursorToImage();
+   if ( hypoTrue ) { kbaseRef.IncrementHypoTrueForEvid( evidValue ); }
+   else            { kbaseRef.IncrementHypoFalseForEvid( evidValue ); }
+   kbaseRef.WriteImageToCursor();
+}
+
+
+/* Reference: one answer applied by reading each node of the KB through its cursor, as the sparse case
+   math did before the tally matrix.  Hypos are walked in matrix row order, so the first hypo found at
+   100% MAPP is the same one the dense pass finds.
+*/
+static void ApplyBayesPerKbaseNodes(   CKnowBaseH5& kbaseRef,
+                                       Nzint_t evidId,
+                                       size_t evidValue,
+                                       const std::vector<Nzint_t>& hypoIdsByRow,
+                                       HypoTallyMap_t& hypoTallyRef,
+                                       Tally_t& sumJointPostCountsRef,
+                                       size_t& numHyposAliveRef,
+                                       Nzint_t& uaiMappHypoRef,
+                                       bool& mappAt100pctRef ) {
+
+   Tally_t weightAtPostValue = 0;
+   sumJointPostCountsRef = 0;
+
+   for ( Nzint_t hypoId : hypoIdsByRow ) {
+      if ( hypoTallyRef.at( hypoId ).hypoStatus == 0 ) { continue; }
+      kbaseRef.PanCursorToNodeAt( RULE_ID, hypoId, evidId );
+      kbaseRef.ReadCursorToImage();
+      weightAtPostValue += kbaseRef.PriorCountsHypoTrueWhenEvid( evidValue );
+   }
+   const bool evidValueGivenIsNovel = ( weightAtPostValue == 0 );
+
+   for ( Nzint_t hypoId : hypoIdsByRow ) {
+
+      SHypoTally& hypoTallyCellRef = hypoTallyRef.at( hypoId );
+      if ( hypoTallyCellRef.hypoStatus == 0 ) { continue; }
+
+      if ( evidValueGivenIsNovel ) {
+         hypoTallyCellRef.accumPostCountsJointToThisHypoTrue += 1;
+         sumJointPostCountsRef += 1;
+         continue;
+      }
+      kbaseRef.PanCursorToNodeAt( RULE_ID, hypoId, evidId );
+      kbaseRef.ReadCursorToImage();
+      const Tally_t postCounts = kbaseRef.PriorCountsHypoTrueWhenEvid( evidValue );
+
+      if ( ( postCounts == 0 ) && kbaseRef.HasHypoEverBeenFalseWhenEvid( evidValue ) ) {
+         hypoTallyCellRef.hypoStatus = 0;
+         hypoTallyCellRef.accumPostCountsJointToThisHypoTrue = 0;
+         --numHyposAliveRef;
+         continue;
+      }
+      else if ( ( postCounts > 0 ) && ( postCounts == weightAtPostValue ) ) {
+         uaiMappHypoRef = hypoId;
+         mappAt100pctRef = true;
+         hypoTallyCellRef.hypoStatus = 1;
+         hypoTallyCellRef.accumPostCountsJointToThisHypoTrue += postCounts;
+         for ( auto& hypoIterB : hypoTallyRef ) {
+            if ( hypoIterB.second.hypoStatus == 2 ) {
+               hypoIterB.second.hypoStatus = 0;
+               hypoIterB.second.accumPostCountsJointToThisHypoTrue = 0;
+            }
+         }
+         sumJointPostCountsRef = hypoTallyCellRef.accumPostCountsJointToThisHypoTrue;
+         break;
+      }
+      hypoTallyCellRef.accumPostCountsJointToThisHypoTrue += postCounts;
+      sumJointPostCountsRef += hypoTallyCellRef.accumPostCountsJointToThisHypoTrue;
+   }
+}
+
+
+static short SayPosterior_pctX10( const SHypoTally& tallyCref, Tally_t sumJointPostCounts ) {
+
+   if ( ( tallyCref.hypoStatus == 0 ) || ( sumJointPostCounts == 0 ) ) { return 0; }
+   return static_cast<short>( ( tallyCref.accumPostCountsJointToThisHypoTrue * 1000 ) / sumJointPostCounts );
+}
+
+
+static int Check( bool isPassed, const char* p_Text ) {
+
+   std::printf( "%s: %s\n", ( isPassed ? "PASS" : "FAIL" ), p_Text );
+   return ( isPassed ? 0 : 1 );
+}
+
+
+// (1) Runs one evidence sequence both ways; returns count of answers at which the two disagreed
+
+static size_t SayAnswersDisagreeing( CKnowBaseH5& kbaseRef, unsigned long long& randomRef ) {
+
+   HypoTallyMap_t hypoTallySparse;
+   EvidTallyMap_t evidTally;
+   Tally_t sumPrior = 0;
+   SCaseTallyMatrix matrix;
+   kbaseRef.InitializeCaseTallies( RULE_ID, hypoTallySparse, evidTally, sumPrior, matrix );
+
+   HypoTallyMap_t hypoTallyDense( hypoTallySparse );
+   std::vector<SHypoTally*> p_TalliesByRow;
+   for ( Nzint_t hypoId : matrix.hypoUais ) { p_TalliesByRow.push_back( &hypoTallyDense.at( hypoId ) ); }
+
+   Tally_t sumSparse = 0, sumDense = 0;
+   size_t aliveSparse = matrix.hypoUais.size(), aliveDense = aliveSparse;
+   Nzint_t mappSparse = 0, mappDense = 0;
+   bool mapp100Sparse = false, mapp100Dense = false;
+   size_t numDisagreeing = 0;
+
+   std::vector<size_t> iEvidColsToAsk( matrix.evidUais.size() );
+   for ( size_t iCol = 0; iCol < iEvidColsToAsk.size(); ++iCol ) { iEvidColsToAsk[iCol] = iCol; }
+
+   while ( ( ! iEvidColsToAsk.empty() ) && ( aliveDense > 0 ) && ( ! mapp100Dense ) ) {
+
+      const size_t iPick = SayNextRandom( randomRef, iEvidColsToAsk.size() );
+      const size_t iEvidCol = iEvidColsToAsk[iPick];
+      iEvidColsToAsk.erase( iEvidColsToAsk.begin() + static_cast<std::ptrdiff_t>( iPick ) );
+      const size_t evidValue = SayNextRandom( randomRef, 3u );
+
+      ApplyBayesPerKbaseNodes(   kbaseRef, matrix.evidUais[iEvidCol], evidValue, matrix.hypoUais,
+                                 hypoTallySparse, sumSparse, aliveSparse, mappSparse, mapp100Sparse );
+      CCase::ApplyBayesOverTallyRuns(  matrix, iEvidCol, evidValue, p_TalliesByRow,
+                                       sumDense, aliveDense, mappDense, mapp100Dense );
+
+      bool agree = ( sumSparse == sumDense ) && ( aliveSparse == aliveDense ) &&
+                   ( mappSparse == mappDense ) && ( mapp100Sparse == mapp100Dense );
+      for ( Nzint_t hypoId : matrix.hypoUais ) {
+         const SHypoTally& sparseCref = hypoTallySparse.at( hypoId );
+         const SHypoTally& denseCref = hypoTallyDense.at( hypoId );
+         const int gap = SayPosterior_pctX10( sparseCref, sumSparse ) - SayPosterior_pctX10( denseCref, sumDense );
+         agree = agree && ( sparseCref.hypoStatus == denseCref.hypoStatus ) &&
+                 ( sparseCref.accumPostCountsJointToThisHypoTrue ==
+                   denseCref.accumPostCountsJointToThisHypoTrue ) &&
+                 ( std::abs( gap ) <= POSTERIOR_TOLERANCE_PCTX10 );
+      }
+      if ( ! agree ) { ++numDisagreeing; }
+   }
+   return numDisagreeing;
+}
+
+
+int main( void ) {
+
+   H5Kit::CMuteHDF5ErrorHdlg muteHdf5;    // Each new knowledge base file otherwise logs "not found"
+
+   const std::filesystem::path scratch = std::filesystem::current_path() / "testBayes_scratch";
+   std::filesystem::remove_all( scratch );
+   std::filesystem::create_directory( scratch );
+   int failures = 0;
+   unsigned long long random = 20250709ULL;
+
+   std::vector<std::unique_ptr<CHypo>> u_Hypos;
+   std::vector<std::unique_ptr<CEvid>> u_Evids;
+   std::unique_ptr<CKnowBaseH5> u_Kbase =
+      std::make_unique<CKnowBaseH5>( ( scratch / KBASE_FILE ).string() );
+   BuildKbase( *u_Kbase, u_Hypos, u_Evids );
+
+   for ( size_t iTeach = 0; iTeach < NUM_TEACHINGS; ++iTeach ) {
+      const SAssoc& assocCref = ASSOCS[SayNextRandom( random, ASSOCS.size() )];
+      const size_t evidValue = SayNextRandom( random, 3u );
+      TeachNode( *u_Kbase, assocCref.hypoId, assocCref.evidId, evidValue, ( SayNextRandom( random, 4u ) != 0 ) );
+   }
+
+   // (1) Equivalence
+   size_t numDisagreeing = 0;
+   for ( size_t iSeq = 0; iSeq < NUM_SEQUENCES; ++iSeq ) {
+      numDisagreeing += SayAnswersDisagreeing( *u_Kbase, random );
+   }
+   failures += Check(   numDisagreeing == 0,
+                        "dense passes match per-node KB reads over every evidence sequence" );
+
+   // (2) Rerank after learning
+   HypoTallyMap_t hypoTallyBefore;
+   EvidTallyMap_t evidTally;
+   Tally_t sumPriorBefore = 0;
+   SCaseTallyMatrix matrix;
+   u_Kbase->InitializeCaseTallies( RULE_ID, hypoTallyBefore, evidTally, sumPriorBefore, matrix );
+
+   std::vector<Tally_t> priorsByRowBefore;
+   CCase::SayPriorCountsTrueByRow( matrix, priorsByRowBefore );
+   const size_t iRowTopBefore = static_cast<size_t>( std::distance(
+      priorsByRowBefore.cbegin(), std::max_element( priorsByRowBefore.cbegin(), priorsByRowBefore.cend() ) ) );
+   const size_t iRowTaught = ( iRowTopBefore + 1u ) % matrix.hypoUais.size();
+   const Nzint_t hypoTaught = matrix.hypoUais[iRowTaught];
+
+   for ( const SAssoc& assocCref : ASSOCS ) {     // enough solved cases to overtake the former MAPP
+      if ( assocCref.hypoId != hypoTaught ) { continue; }
+      for ( Tally_t count = 0; count <= sumPriorBefore; ++count ) {
+         TeachNode( *u_Kbase, hypoTaught, assocCref.evidId, 1u, true );
+      }
+   }
+   u_Kbase->LoadCaseTallyMatrix( RULE_ID, matrix );
+   std::vector<Tally_t> priorsByRowAfter;
+   const Tally_t sumPriorAfter = CCase::SayPriorCountsTrueByRow( matrix, priorsByRowAfter );
+
+   HypoTallyMap_t hypoTallyFresh;
+   EvidTallyMap_t evidTallyFresh;
+   Tally_t sumPriorFresh = 0;
+   SCaseTallyMatrix matrixFresh;
+   u_Kbase->InitializeCaseTallies( RULE_ID, hypoTallyFresh, evidTallyFresh, sumPriorFresh, matrixFresh );
+
+   bool priorsMatchFresh = ( sumPriorAfter == sumPriorFresh );
+   for ( size_t iRow = 0; iRow < matrix.hypoUais.size(); ++iRow ) {
+      priorsMatchFresh = priorsMatchFresh &&
+         ( priorsByRowAfter[iRow] == hypoTallyFresh.at( matrix.hypoUais[iRow] ).priorCountsThisHypoTrue );
+   }
+   failures += Check(   priorsMatchFresh,
+                        "priors re-derived from reloaded matrix match a fresh read of the KB" );
+   failures += Check(   priorsByRowAfter != priorsByRowBefore,
+                        "reloaded matrix sees what the KB learned" );
+   failures += Check(   std::max_element( priorsByRowAfter.cbegin(), priorsByRowAfter.cend() ) ==
+                        ( priorsByRowAfter.cbegin() + static_cast<std::ptrdiff_t>( iRowTaught ) ),
+                        "hypo just taught ranks first after rerank" );
+
+   u_Kbase.reset();                       // closes KB file before scratch is removed
+   std::filesystem::remove_all( scratch );
+   return failures;
+}
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -0,0 +1,216 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Test of engine checkpoints (CCheckpoint, CController::SaveCheckpoint()/RestoreCheckpointIfAny()).
+   Each engine is built in a forked child process, as a restart would build it, so that GUI keys and
+   other process-wide registries start over as they do in service.  Cases tested:
+   (1) Round trip: engine A steps on inputs, saving a checkpoint each step.  Engine B, built fresh on the
+       same topology, restores that checkpoint and saves it again at shutdown without stepping.  Both
+       files must carry the same topology fingerprint, and the same state, byte for byte.
+   (2) A checkpoint whose payload is corrupted is renamed to ".rejected" by the next engine built.
+   (3) A checkpoint from a different topology (fingerprint mismatch) is renamed to ".rejected".
+   (4) A checkpoint that cannot be written (its directory is missing) is skipped: the engine keeps
+       stepping, and shuts down cleanly.
+   Usage:  bin/testCheckpoint      (run from any writable directory; exit status is count of failures)
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "exportCalls.hpp"
+#include "tool.hpp"
+#include "HDF5Parts.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+static const char*   CHECKPOINT_FILE = "engine.ckpt";
+static const char*   UNWRITABLE_CHECKPOINT_FILE = "no_such_dir/engine.ckpt";
+static const size_t  STEPS_BEFORE_SAVE = 180u;
+static const size_t  BYTES_MAGIC = 8u;
+
+
+static std::string SayTopologyText( size_t numVavs ) {
+
+   return (  "ahu_ibal, AHU-1, 1, CHW Plant, HW PlantSim\n"
+             "vav_ibal, VAV-, " + std::to_string( numVavs ) + ", AHU-1, HW PlantSim\n" );
+}
+
+
+static std::vector<char> SayBytesOfFile( const std::filesystem::path& pathRef ) {
+
+   std::ifstream fileIn( pathRef, std::ios::binary );
+   return std::vector<char>( ( std::istreambuf_iterator<char>( fileIn ) ),
+                               std::istreambuf_iterator<char>() );
+}
+
+
+static std::uint64_t SayFingerprintOf( const std::vector<char>& bytesCref ) {
+
+   std::uint64_t fingerprint = 0u;
+   if ( bytesCref.size() >= ( BYTES_MAGIC + sizeof(fingerprint) ) ) {
+      std::memcpy( &fingerprint, bytesCref.data() + BYTES_MAGIC, sizeof(fingerprint) );
+   }
+   return fingerprint;
+}
+
+
+static bool SteppedOnInputs( IExportOmni* p_Port ) {
+
+   const GuiPackDomain_t domain = p_Port->SayInfoFromDomain();
+
+   std::tm tmStart {};
+   tmStart.tm_year = 125;
+   tmStart.tm_mon = 6;
+   tmStart.tm_mday = 9;
+   tmStart.tm_isdst = -1;
+   const std::time_t timeStart = std::mktime( &tmStart );
+
+   for ( size_t step = 0; step < STEPS_BEFORE_SAVE; ++step ) {
+      const std::time_t timeNow = timeStart + static_cast<std::time_t>( 60u * step );
+      std::tm tmNow {};
+      localtime_r( &timeNow, &tmNow );
+      p_Port->SetTimeStampInDomain( tmNow );
+      size_t channel = 0;
+      for ( NGuiKey subjectKey : domain.subjectKeys ) {
+         std::vector<GuiFpn_t> inputs;
+         for ( size_t i = 0; i < p_Port->SayInputPointNameOrderExpectedBySubject( subjectKey ).size(); ++i ) {
+            inputs.push_back( static_cast<GuiFpn_t>( 50.0 + 20.0 * std::sin( 0.05 * step + channel ) ) );
+            ++channel;
+         }
+         p_Port->SetCoincidentInputsForSubject( inputs, subjectKey );
+      }
+      if ( p_Port->SingleStepDomainOnTimeAndInputs() != EGuiReply::OKAY_allDone ) { return false; }
+   }
+   return true;
+}
+
+
+// Child process bodies, each returns its exit status
+
+static int RunEngineSteppingThenSaving( size_t numVavs ) {
+
+   setenv( "EA_CHECKPOINT_SECS", "60", 1 );
+   CApplication app( CTopology::ReadFromText( SayTopologyText( numVavs ) ) );
+   return ( SteppedOnInputs( SExportedHandles::GetPortPointer() ) ? 0 : 1 );
+}
+
+
+static int RunEngineRestoringThenSaving( size_t numVavs ) {
+
+   CApplication app( CTopology::ReadFromText( SayTopologyText( numVavs ) ) );
+   IExportOmni* p_Port = SExportedHandles::GetPortPointer();
+   return ( ( p_Port->PrepareApplicationForShutdown() == EGuiReply::OKAY_allDone ) ? 0 : 1 );
+}
+
+
+static int RunEngineSteppingToUnwritableCheckpoint( void ) {
+
+   setenv( "EA_CHECKPOINT", UNWRITABLE_CHECKPOINT_FILE, 1 );
+   setenv( "EA_CHECKPOINT_SECS", "1800", 1 );    // a failed save is retried each interval, not each step
+   CApplication app( CTopology::ReadFromText( SayTopologyText( 2u ) ) );
+   IExportOmni* p_Port = SExportedHandles::GetPortPointer();
+   if ( !SteppedOnInputs( p_Port ) ) { return 1; }
+   return ( ( p_Port->PrepareApplicationForShutdown() == EGuiReply::OKAY_allDone ) ? 0 : 1 );
+}
+
+
+template <typename TT>
+static bool RanInChild( const std::filesystem::path& scratchRef, TT fnBody ) {
+
+   std::fflush( stdout );
+   pid_t child = fork();
+   if ( child == 0 ) {
+      std::filesystem::current_path( scratchRef );
+      setenv( "EA_CHECKPOINT", CHECKPOINT_FILE, 1 );
+      std::_Exit( fnBody() );
+   }
+   int status = 0;
+   waitpid( child, &status, 0 );
+   return ( WIFEXITED( status ) && ( WEXITSTATUS( status ) == 0 ) );
+}
+
+
+static int Check( bool isPassed, const char* p_Text ) {
+
+   std::printf( "%s: %s\n", ( isPassed ? "PASS" : "FAIL" ), p_Text );
+   return ( isPassed ? 0 : 1 );
+}
+
+
+int main( void ) {
+
+   H5Kit::CMuteHDF5ErrorHdlg muteHdf5;    // Each new knowledge base file otherwise logs "not found"
+
+   const std::filesystem::path scratch = std::filesystem::current_path() / "testCheckpoint_scratch";
+   const std::filesystem::path checkpointPath = scratch / CHECKPOINT_FILE;
+   const std::filesystem::path rejectedPath = scratch / ( std::string( CHECKPOINT_FILE ) + ".rejected" );
+   std::filesystem::remove_all( scratch );
+   std::filesystem::create_directory( scratch );
+   int failures = 0;
+
+   // (1) Round trip
+   failures += Check(   RanInChild( scratch, [](){ return RunEngineSteppingThenSaving( 2u ); } ) &&
+                        std::filesystem::exists( checkpointPath ),
+                        "engine saves a checkpoint while stepping" );
+   const std::vector<char> bytesSaved = SayBytesOfFile( checkpointPath );
+
+   failures += Check(   RanInChild( scratch, [](){ return RunEngineRestoringThenSaving( 2u ); } ),
+                        "fresh engine restores the checkpoint and saves again" );
+   const std::vector<char> bytesResaved = SayBytesOfFile( checkpointPath );
+
+   failures += Check(   !std::filesystem::exists( rejectedPath ),
+                        "checkpoint of same topology is not rejected" );
+   failures += Check(   ( SayFingerprintOf( bytesSaved ) != 0u ) &&
+                        ( SayFingerprintOf( bytesSaved ) == SayFingerprintOf( bytesResaved ) ),
+                        "topology fingerprint matches after restore" );
+   failures += Check(   !bytesSaved.empty() && ( bytesSaved == bytesResaved ),
+                        "state matches after restore" );
+
+   // (2) Corrupt payload
+   std::vector<char> bytesCorrupt( bytesSaved );
+   if ( bytesCorrupt.size() > ( BYTES_MAGIC + 32u ) ) { bytesCorrupt[BYTES_MAGIC + 32u] ^= 0x5a; }
+   std::ofstream( checkpointPath, std::ios::binary | std::ios::trunc )
+      .write( bytesCorrupt.data(), static_cast<std::streamsize>( bytesCorrupt.size() ) );
+   RanInChild( scratch, [](){ return RunEngineRestoringThenSaving( 2u ); } );
+   failures += Check(   std::filesystem::exists( rejectedPath ) &&
+                        ( SayBytesOfFile( rejectedPath ) == bytesCorrupt ),
+                        "corrupt checkpoint is renamed to .rejected" );
+   std::filesystem::remove( rejectedPath );
+
+   // (3) Fingerprint mismatch, a checkpoint of 2 VAVs offered to an engine of 3 VAVs
+   std::ofstream( checkpointPath, std::ios::binary | std::ios::trunc )
+      .write( bytesSaved.data(), static_cast<std::streamsize>( bytesSaved.size() ) );
+   RanInChild( scratch, [](){ return RunEngineRestoringThenSaving( 3u ); } );
+   failures += Check(   std::filesystem::exists( rejectedPath ) &&
+                        ( SayBytesOfFile( rejectedPath ) == bytesSaved ),
+                        "checkpoint of other topology is renamed to .rejected" );
+
+   // (4) Checkpoint that cannot be written
+   failures += Check(   RanInChild( scratch, [](){ return RunEngineSteppingToUnwritableCheckpoint(); } ),
+                        "engine keeps stepping and shuts down when its checkpoint cannot be written" );
+
+   std::filesystem::remove_all( scratch );
+   return failures;
+}
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -354,13 +354,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_UvgFull = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_UvgFull,
                                     u_Uvg.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_PERCENT_FULL,
                                     INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
                                     INIT_MINDEFMAX_RELATE_SLACK_ANYPERCENT,
@@ -368,13 +367,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_WecDraw = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_GT_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_WecDraw,
                                     u_Wec.get(),
-                                    &CRainAnalog::NowY,
                                     0.40f,
                                     INIT_MINDEFMAX_RELATE_HYSTER_ALLZEROS,
                                     INIT_MINDEFMAX_RELATE_SLACK_ALLZEROS,
@@ -382,13 +380,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_QgeLowOOR = std::make_unique<  CFactRelatingLeftToParam<
                                        CPointAnalog,
-                                       PtrRainGetr_t,
+                                       &CRainAnalog::NowY,
                                        Left_LT_Right>
                                     >( seq0Ref,
                                        *u_Subject,
                                        EDataLabel::Fact_para_QgeLowOOR,
                                        u_Qge.get(),
-                                       &CRainAnalog::NowY,
                                        56.8f,
                                        INIT_MINDEFMAX_RELATE_HYSTER_ALLZEROS,
                                        INIT_MINDEFMAX_RELATE_SLACK_ALLZEROS,
@@ -396,13 +393,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_PrsLowOOR = std::make_unique<  CFactRelatingLeftToParam<
                                        CPointAnalog,
-                                       PtrRainGetr_t,
+                                       &CRainAnalog::NowY,
                                        Left_LT_Right>
                                     >( seq0Ref,
                                        *u_Subject,
                                        EDataLabel::Fact_para_PrsLowOOR,
                                        u_Prs.get(),
-                                       &CRainAnalog::NowY,
                                        344.8f,
                                        INIT_MINDEFMAX_RELATE_HYSTER_ALLZEROS,
                                        INIT_MINDEFMAX_RELATE_SLACK_ALLZEROS,
@@ -410,13 +406,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_PrdHighOOR = std::make_unique<  CFactRelatingLeftToParam<
                                        CPointAnalog,
-                                       PtrRainGetr_t,
+                                       &CRainAnalog::NowY,
                                        Left_GT_Right>
                                     >( seq0Ref,
                                        *u_Subject,
                                        EDataLabel::Fact_para_PrdHighOOR,
                                        u_Prd.get(),
-                                       &CRainAnalog::NowY,
                                        3400.0f,
                                        INIT_MINDEFMAX_RELATE_HYSTER_ALLZEROS,
                                        INIT_MINDEFMAX_RELATE_SLACK_ALLZEROS,
@@ -430,17 +425,15 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tgl_EQ_setpt = std::make_unique<  CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_EQ_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_data_Tgl_EQ_setpt,
                                              u_Tgl.get(),
-                                             &CRainAnalog::NowY,
                                              u_TglSetpt.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                              ctrlrRef );
@@ -940,13 +933,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_TgiAtChargeTemp = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_TgiAtChargeTemp,
                                     u_Xice.get(),
-                                    &CRainAnalog::NowY,
                                     INIT_HVACPARAM_TES_PRITEMPTOMAKEICE_DEGC,
                                     INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                     INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_ZERO,
@@ -954,13 +946,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_XiceZero = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_XiceZero,
                                     u_Xice.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_PERCENT_SHUT,
                                     INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
                                     INIT_MINDEFMAX_RELATE_SLACK_ANYPERCENT,
@@ -977,13 +968,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_QgTesZero = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_QgTesZero,
                                     u_QgTes.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_ZERO,
                                     INIT_MINDEFMAX_RELATE_HYSTER_LPM_0TO150,
                                     INIT_MINDEFMAX_RELATE_SLACK_LPM_0TO150,
@@ -1006,34 +996,30 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tgo_GT_Tgi = std::make_unique<  CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_GT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_data_Tgo_GT_Tgi,
                                              u_Tgo.get(),
-                                             &CRainAnalog::NowY,
                                              u_Tgi.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                              ctrlrRef );
 
    u_Tgo_LT_Tgi = std::make_unique<  CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_LT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_data_Tgo_LT_Tgi,
                                              u_Tgo.get(),
-                                             &CRainAnalog::NowY,
                                              u_Tgi.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                              ctrlrRef );
@@ -1630,13 +1616,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_PsasZero = std::make_unique<   CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_PsasZero,
                                     u_Psas.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_ZERO,
                                     INIT_MINDEFMAX_RELATE_HYSTER_PA_0TO1K,
                                     INIT_MINDEFMAX_RELATE_SLACK_PA_0TO1K,
@@ -1644,13 +1629,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_QasZero = std::make_unique< CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_QasZero,
                                     u_Qas.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_ZERO,
                                     INIT_MINDEFMAX_RELATE_HYSTER_LPS_0TO1416,
                                     INIT_MINDEFMAX_RELATE_SLACK_LPS_0TO1416,
@@ -1658,13 +1642,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_UdmFullOA = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_UdmFullOA,
                                     u_Udm.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_PERCENT_FULL,   // Udm = 1.0 (100%) for full OA ***? chk OK***
                                     INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
                                     INIT_MINDEFMAX_RELATE_SLACK_ANYPERCENT,
@@ -1672,13 +1655,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_UvcShut = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_UvcShut,
                                     u_Uvc.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_PERCENT_SHUT,
                                     INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
                                     INIT_MINDEFMAX_RELATE_SLACK_ANYPERCENT,
@@ -1696,13 +1678,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_fracOAatMin = std::make_unique<   CFactRelatingLeftToParam<
                                        CFormula,
-                                       PtrRainGetr_t,
+                                       &CRainAnalog::NowY,
                                        Left_LTE_Right>
                                        >( seq0Ref,
                                           *u_Subject,
                                           EDataLabel::Fact_para_fracOA_EQ_min,
                                           u_fracOA.get(),
-                                          &CRainAnalog::NowY,
                                           // $$$ TBD hvac params by r-t calls vs. hard code $$$
                                           INIT_HVACPARAM_AHU_OAFRAC_MIN,  // TBD that this be forumulated in r-t from current occupancy
                                           INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
@@ -1711,13 +1692,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tam_GT_frzStat = std::make_unique<   CFactRelatingLeftToParam<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_GT_Right>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_para_Tam_GT_frzStat,
                                              u_Tam.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_HVACPARAM_AHU_FRZSTAT_DEGC,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
@@ -1725,13 +1705,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_absDifTaoTar_GTE_10F = std::make_unique<   CFactRelatingLeftToParam<
                                                 CFormula,
-                                                PtrRainGetr_t,
+                                                &CRainAnalog::NowY,
                                                 Left_GTE_Right>
                                                 >( seq0Ref,
                                                    *u_Subject,
                                                    EDataLabel::Fact_para_absDifTarTao_GTE_10F,
                                                    u_absDifTaoTar.get(),
-                                                   &CRainAnalog::NowY,
                                                    10.0f,
                                                    INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                                    INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_ZERO,
@@ -1743,17 +1722,15 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tas_EQ_TasSetpt = std::make_unique<  CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_EQ_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_data_Tas_EQ_setpt,
                                              u_Tas.get(),
-                                             &CRainAnalog::NowY,
                                              u_TasSetpt.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                              ctrlrRef );
@@ -1765,34 +1742,30 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tam_GT_TasSetpt = std::make_unique<  CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_GT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_data_Tam_GT_TasSetpt,
                                              u_Tam.get(),
-                                             &CRainAnalog::NowY,
                                              u_TasSetpt.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                              ctrlrRef );
 
    u_Tam_GTE_minTaoTar = std::make_unique<   CFactRelatingLeftToRight<
                                              CPointAnalog,
-                                             PtrRainGetr_t,
+                                             &CRainAnalog::NowY,
                                              Left_GTE_Right,
                                              CFormula,
-                                             PtrRainGetr_t>
+                                             &CRainAnalog::NowY>
                                              >( seq0Ref,
                                                 *u_Subject,
                                                 EDataLabel::Fact_data_Tam_GTE_minTaoTar,
                                                 u_Tam.get(),
-                                                &CRainAnalog::NowY,
                                                 u_minTaoTar.get(),
-                                                &CRainAnalog::NowY,
                                                 INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                                 INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                                 ctrlrRef );
@@ -1802,17 +1775,15 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tao_LT_Tar = std::make_unique< CFactRelatingLeftToRight<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_LT_Right,
                                     CPointAnalog,
-                                    PtrRainGetr_t>
+                                    &CRainAnalog::NowY>
                                     >( seq0Ref,
                                        *u_Subject,
                                        EDataLabel::Fact_data_Tao_LT_Tar,
                                        u_Tao.get(),
-                                       &CRainAnalog::NowY,
                                        u_Tar.get(),
-                                       &CRainAnalog::NowY,
                                        INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                        INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                        ctrlrRef );
@@ -1820,51 +1791,45 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tao_LT_TasSetpt = std::make_unique<  CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_LT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                           >( seq0Ref,
                                              *u_Subject,
                                              EDataLabel::Fact_data_Tao_LT_TasSetpt,
                                              u_Tao.get(),
-                                             &CRainAnalog::NowY,
                                              u_TasSetpt.get(),
-                                             &CRainAnalog::NowY,
                                              INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                              INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                              ctrlrRef );
 
    u_Tas_LT_Tam = std::make_unique< CFactRelatingLeftToRight<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_LT_Right,
                                     CPointAnalog,
-                                    PtrRainGetr_t>
+                                    &CRainAnalog::NowY>
                                     >( seq0Ref,
                                        *u_Subject,
                                        EDataLabel::Fact_data_Tas_LT_Tam,
                                        u_Tas.get(),
-                                       &CRainAnalog::NowY,
                                        u_Tam.get(),
-                                       &CRainAnalog::NowY,
                                        INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                        INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                        ctrlrRef );
 
    u_Tam_LTE_maxTaoTar = std::make_unique<   CFactRelatingLeftToRight<
                                              CPointAnalog,
-                                             PtrRainGetr_t,
+                                             &CRainAnalog::NowY,
                                              Left_LTE_Right,
                                              CFormula,
-                                             PtrRainGetr_t>
+                                             &CRainAnalog::NowY>
                                              >( seq0Ref,
                                                 *u_Subject,
                                                 EDataLabel::Fact_data_Tam_LTE_maxTaoTar,
                                                 u_Tam.get(),
-                                                &CRainAnalog::NowY,
                                                 u_maxTaoTar.get(),
-                                                &CRainAnalog::NowY,
                                                 INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                                 INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                                 ctrlrRef );
@@ -2959,13 +2924,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_QadZero = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_QadZero,
                                     u_Qad.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_ZERO,
                                     INIT_MINDEFMAX_RELATE_HYSTER_LPS_0TO1416,
                                     INIT_MINDEFMAX_RELATE_SLACK_LPS_0TO1416,
@@ -2973,13 +2937,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_UddFull = std::make_unique< CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_UddFull,
                                     u_Udd.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_PERCENT_FULL,
                                     INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
                                     INIT_MINDEFMAX_RELATE_SLACK_ANYPERCENT,
@@ -2987,13 +2950,12 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_UvhShut = std::make_unique<  CFactRelatingLeftToParam<
                                     CPointAnalog,
-                                    PtrRainGetr_t,
+                                    &CRainAnalog::NowY,
                                     Left_EQ_Right>
                                  >( seq0Ref,
                                     *u_Subject,
                                     EDataLabel::Fact_para_UvhShut,
                                     u_Uvh.get(),
-                                    &CRainAnalog::NowY,
                                     FIXED_PARAM_PERCENT_SHUT,
                                     INIT_MINDEFMAX_RELATE_HYSTER_ANYPERCENT,
                                     INIT_MINDEFMAX_RELATE_SLACK_ANYPERCENT,
@@ -3005,51 +2967,45 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tad_GT_Tai = std::make_unique< CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_GT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                        >( seq0Ref,
                                           *u_Subject,
                                           EDataLabel::Fact_data_Tad_GT_Tai,
                                           u_Tad.get(),
-                                          &CRainAnalog::NowY,
                                           u_Tai.get(),
-                                          &CRainAnalog::NowY,
                                           INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                           INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_HARD,
                                           ctrlrRef );
 
    u_Tad_GT_Taz = std::make_unique< CFactRelatingLeftToRight<
                                        CPointAnalog,
-                                       PtrRainGetr_t,
+                                       &CRainAnalog::NowY,
                                        Left_GT_Right,
                                        CPointAnalog,
-                                       PtrRainGetr_t>
+                                       &CRainAnalog::NowY>
                                     >( seq0Ref,
                                       *u_Subject,
                                       EDataLabel::Fact_data_Tad_GT_Taz,
                                       u_Tad.get(),
-                                      &CRainAnalog::NowY,
                                       u_Taz.get(),
-                                      &CRainAnalog::NowY,
                                       INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                       INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                       ctrlrRef );
 
    u_Taz_GT_setptClg = std::make_unique<   CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_GT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                        >( seq0Ref,
                                           *u_Subject,
                                           EDataLabel::Fact_data_Taz_GT_setptClg,
                                           u_Taz.get(),
-                                          &CRainAnalog::NowY,
                                           u_TazSetptClg.get(),
-                                          &CRainAnalog::NowY,
                                           INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                           INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_HARD,
                                           ctrlrRef );
@@ -3059,34 +3015,30 @@ u_RuleKit = std::make_unique<CRuleKit>(
 
    u_Tad_LT_Taz = std::make_unique< CFactRelatingLeftToRight<
                                        CPointAnalog,
-                                       PtrRainGetr_t,
+                                       &CRainAnalog::NowY,
                                        Left_LT_Right,
                                        CPointAnalog,
-                                       PtrRainGetr_t>
+                                       &CRainAnalog::NowY>
                                     >( seq0Ref,
                                        *u_Subject,
                                        EDataLabel::Fact_data_Tad_LT_Taz,
                                        u_Tad.get(),
-                                       &CRainAnalog::NowY,
                                        u_Taz.get(),
-                                       &CRainAnalog::NowY,
                                        INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                        INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_EASY,
                                        ctrlrRef );
 
    u_Taz_LT_setptHtg = std::make_unique< CFactRelatingLeftToRight<
                                           CPointAnalog,
-                                          PtrRainGetr_t,
+                                          &CRainAnalog::NowY,
                                           Left_LT_Right,
                                           CPointAnalog,
-                                          PtrRainGetr_t>
+                                          &CRainAnalog::NowY>
                                        >( seq0Ref,
                                           *u_Subject,
                                           EDataLabel::Fact_data_Taz_LT_setptHtg,
                                           u_Taz.get(),
-                                          &CRainAnalog::NowY,
                                           u_TazSetptHtg.get(),
-                                          &CRainAnalog::NowY,
                                           INIT_MINDEFMAX_RELATE_HYSTER_DEGC_n18TO49,
                                           INIT_MINDEFMAX_RELATE_SLACK_DEGC_n18TO49_HARD,
                                           ctrlrRef );
@@ -3783,7 +3735,10 @@ CTool_vav_ibal::~CTool_vav_ibal( void ) { /* Emtpy d-tor*/ }
 /////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
 // Begin Application implementation
 
-CApplication::CApplication( void )
+CApplication::CApplication( void ) : CApplication( CTopology::ReadFromEnvironmentOrDefault() ) { }
+
+
+CApplication::CApplication( const CTopology& topology )
                   :  unitSys (EUnitSystem::SI),
                      u_Domain( std::make_unique<CDomain>( ERealName::Domain_ibal ) ),
                      u_Clock( std::make_unique<CClockPerPort>( FIXED_CLOCK_SECSPERBELL )
@@ -3802,105 +3757,131 @@ CApplication::CApplication( void )
                      ),
                      u_EachToolInApp(0) {
 
+   u_Ctrlr->Register( u_Seq0.get() );
+   u_EachToolInApp.reserve( topology.SayNumTools() );
 
-   u_EachToolInApp.push_back(
-
-      std::make_unique<CTool_ahu_ibal>(   unitSys,
-                                         *u_Domain,  
-                                          EDataLabel::Subject_ahu_singleDuct_vavReheat,
-                                          ERealName::Subject_ahu1,
-                                          ERealName::Subject_chwPlant,
-                                          ERealName::Subject_hwPlant_sim,
-                                          *u_Clock,
-                                          *u_Seq0,
-                                          *u_Ctrlr,
-                                          *u_View,
-                                          *u_OmniPort
-      )
-   );  // end pushback call
-
-   u_EachToolInApp.push_back(
-
-      std::make_unique<CTool_ahu_ibal>(   unitSys,
-                                          *u_Domain,  
-                                          EDataLabel::Subject_ahu_singleDuct_vavReheat,
-                                          ERealName::Subject_ahu2,
-                                          ERealName::Subject_chwPlant,
-                                          ERealName::Subject_hwPlant_sim,
-                                          *u_Clock,
-                                          *u_Seq0,
-                                          *u_Ctrlr,
-                                          *u_View,
-                                          *u_OmniPort
-      )
-   );  // end pushback call
-
-   u_EachToolInApp.push_back(
-
-      std::make_unique<CTool_vav_ibal>(   unitSys,
-                                          *u_Domain,  
-                                          EDataLabel::Subject_vav_pressIndep_hwReheat,
-                                          ERealName::Subject_vav1,
-                                          ERealName::Subject_ahu2,
-                                          ERealName::Subject_hwPlant_sim,
-                                          *u_Clock,
-                                          *u_Seq0,
-                                          *u_Ctrlr,
-                                          *u_View,
-                                          *u_OmniPort
-      )
-   );
-
-   u_EachToolInApp.push_back(
-
-      std::make_unique<CTool_vav_ibal>(   unitSys,
-                                          *u_Domain,  
-                                          EDataLabel::Subject_vav_pressIndep_hwReheat,
-                                          ERealName::Subject_vav2,
-                                          ERealName::Subject_ahu2,
-                                          ERealName::Subject_hwPlant_sim,
-                                          *u_Clock,
-                                          *u_Seq0,
-                                          *u_Ctrlr,
-                                          *u_View,
-                                          *u_OmniPort
-      )
-   );
-   
-   u_EachToolInApp.push_back(
-
-      std::make_unique<CTool_vav_ibal>(   unitSys,
-                                          *u_Domain,  
-                                          EDataLabel::Subject_vav_pressIndep_hwReheat,
-                                          ERealName::Subject_vav3,
-                                          ERealName::Subject_ahu1,
-                                          ERealName::Subject_hwPlant_sim,
-                                          *u_Clock,
-                                          *u_Seq0,
-                                          *u_Ctrlr,
-                                          *u_View,
-                                          *u_OmniPort
-      )
-   );
+   for ( const TopologyEntry_t& entry : topology.SayEntries() ) { ConstructToolsOfEntry( entry ); }
 
-   u_EachToolInApp.push_back(
-
-      std::make_unique<CTool_vav_ibal>(   unitSys,
-                                          *u_Domain,  
-                                          EDataLabel::Subject_vav_pressIndep_hwReheat,
-                                          ERealName::Subject_vav4,
-                                          ERealName::Subject_ahu1,
-                                          ERealName::Subject_hwPlant_sim,
-                                          *u_Clock,
-                                          *u_Seq0,
-                                          *u_Ctrlr,
-                                          *u_View,
-                                          *u_OmniPort
-      )
-   );
+   u_Ctrlr->RestoreCheckpointIfAny();     // warm restart, only if EA_CHECKPOINT names a good file
 
 }   // End CApplication constructor
 
+
+void CApplication::ConstructToolsOfEntry( const TopologyEntry_t& entry ) {
+
+   // See Method Note [1]
+
+   std::vector<ERealName> antecedents;
+   antecedents.reserve( entry.antecedentsText.size() );
+   for ( const std::string& text : entry.antecedentsText ) {
+      antecedents.push_back( IGuiShadow::LookUpRealName( text ) );
+   }
+
+   std::vector<size_t> sizesBeforeFirst = SayRegistrySizes();
+
+   for ( size_t i = 0; i < entry.count; ++i ) {
+
+      ERealName ownName = IGuiShadow::TabulateRealName( CTopology::SayNameTextOfTool( entry, i ) );
+      u_EachToolInApp.push_back( MakeTool( entry.toolType, ownName, antecedents ) );
+
+      if ( ( i == 0 ) && ( entry.count > 1 ) ) {
+         std::vector<size_t> sizesNeeded = SayRegistrySizes();
+         for ( size_t k = 0; k < sizesNeeded.size(); ++k ) {
+            sizesNeeded[k] += ( ( sizesNeeded[k] - sizesBeforeFirst[k] ) * ( entry.count - 1 ) );
+         }
+         ReserveRegistries( sizesNeeded );
+      }
+   }
+   return;
+}
+/* Method Notes:   '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+
+[1]   Every Tool of one entry registers the same number of Points, Facts, Knobs, Features, etc.  So after
+      the first Tool of an entry is constructed, growth of each registry is measured and the registries
+      are reserved for the entry's remaining Tools.  Constructing hundreds of Tools then costs no rehash
+      or vector regrowth partway through.
+*/
+
+
+std::unique_ptr<ATool> CApplication::MakeTool(  EToolType type,
+                                                ERealName ownName,
+                                                const std::vector<ERealName>& antecedents ) {
+
+   // CTopology has already checked count of antecedents against SayNumAntecedentsRequired()
+
+   switch ( type ) {
+
+      case EToolType::Ahu_ibal:
+         return std::make_unique<CTool_ahu_ibal>(  unitSys,
+                                                   *u_Domain,
+                                                   EDataLabel::Subject_ahu_singleDuct_vavReheat,
+                                                   ownName,
+                                                   antecedents[0],   // CHW plant
+                                                   antecedents[1],   // HW plant
+                                                   *u_Clock,
+                                                   *u_Seq0,
+                                                   *u_Ctrlr,
+                                                   *u_View,
+                                                   *u_OmniPort );
+
+      case EToolType::Vav_ibal:
+         return std::make_unique<CTool_vav_ibal>(  unitSys,
+                                                   *u_Domain,
+                                                   EDataLabel::Subject_vav_pressIndep_hwReheat,
+                                                   ownName,
+                                                   antecedents[0],   // AHU
+                                                   antecedents[1],   // HW plant
+                                                   *u_Clock,
+                                                   *u_Seq0,
+                                                   *u_Ctrlr,
+                                                   *u_View,
+                                                   *u_OmniPort );
+
+      default:
+         throw std::logic_error( "Topology named a tool type having no factory" ); // deliberately no catch
+   }
+}
+
+
+std::vector<size_t> CApplication::SayRegistrySizes( void ) const {
+
+   // Concatenated in fixed order Sequence, Controller, View; ReserveRegistries() splits the same way
+   std::vector<size_t> sizes = u_Seq0->SayRegistrySizes();
+   std::vector<size_t> ctrlrSizes = u_Ctrlr->SayRegistrySizes();
+   std::vector<size_t> viewSizes = u_View->SayRegistrySizes();
+
+   sizes.insert( sizes.end(), ctrlrSizes.begin(), ctrlrSizes.end() );
+   sizes.insert( sizes.end(), viewSizes.begin(), viewSizes.end() );
+   return sizes;
+}
+
+
+void CApplication::ReserveRegistries( const std::vector<size_t>& sizes ) {
+
+   const size_t numSeq = u_Seq0->SayRegistrySizes().size();
+   const size_t numCtrlr = u_Ctrlr->SayRegistrySizes().size();
+
+   u_Seq0->ReserveRegistries( std::vector<size_t>( sizes.begin(), sizes.begin() + numSeq ) );
+   u_Ctrlr->ReserveRegistries( std::vector<size_t>(   sizes.begin() + numSeq,
+                                                      sizes.begin() + numSeq + numCtrlr ) );
+   u_View->ReserveRegistries( std::vector<size_t>( sizes.begin() + numSeq + numCtrlr, sizes.end() ) );
+   return;
+}
+
+
+size_t CApplication::SayNumTools( void ) const { return u_EachToolInApp.size(); }
+
+
+MemoryCensus_t CApplication::SayMemoryCensus( void ) const {
+
+   // Histograms are counted via the rainfalls owning them, and r-t Traces via their stand-ins
+   MemoryCensus_t census;
+   u_Seq0->AddBytesHeldTo( census );
+   u_Ctrlr->AddBytesHeldTo( census );
+   return census;
+}
+
+
 CApplication::~CApplication( void ) {
 
    u_EachToolInApp.clear();
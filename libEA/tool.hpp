@@ -25,6 +25,7 @@ See the License for the specific language governing permissions and limitations
 #include "fact.hpp"          // Includes all AFact subclasses
 #include "chart.hpp"
 #include "rainfall.hpp"
+#include "topology.hpp"
 
 class CAgent;
 class CCaseKit;
@@ -62,7 +63,7 @@ class ATool {
    public:
     // Methods
 
-     ~ATool( void );
+     virtual ~ATool( void );    // virtual, since CApplication owns Tools via unique_ptr<ATool>
 
    protected:
    // fields
@@ -149,7 +150,7 @@ class CTool_chlr_ibal : public ATool {
 //------------------------------ 
 // EQ specializations
 
-      //std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_PsasZero;
+      //std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_PsasZero;
 
  //======================================================================================================/ 
 // CFactRelatingLeftToRight objects relate two ("left" and "right") analog values, with bool result
@@ -160,15 +161,15 @@ class CTool_chlr_ibal : public ATool {
 
       std::unique_ptr<
          CFactRelatingLeftToRight<
-            CPointAnalog, PtrRainGetr_t, Left_EQ_Right, CPointAnalog, PtrRainGetr_t>
+            CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tgl_EQ_setpt;
 
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_UvgFull;
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_GT_Right> >  u_WecDraw;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_UvgFull;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_GT_Right> >  u_WecDraw;
    
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_LT_Right> >  u_QgeLowOOR;
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_LT_Right> >  u_PrsLowOOR;
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_GT_Right> >  u_PrdHighOOR;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_LT_Right> >  u_QgeLowOOR;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_LT_Right> >  u_PrsLowOOR;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_GT_Right> >  u_PrdHighOOR;
 
 //======================================================================================================/ 
 // Declare direct Facts and any sustainers
@@ -277,7 +278,7 @@ class CTool_tes_ibal : public ATool {
 //------------------------------ 
 // EQ specializations
 
-      //std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_PsasZero;
+      //std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_PsasZero;
 
  //======================================================================================================/ 
 // CFactRelatingLeftToRight objects relate two ("left" and "right") analog values, with bool result
@@ -288,19 +289,19 @@ class CTool_tes_ibal : public ATool {
 
       std::unique_ptr<
          CFactRelatingLeftToRight<
-            CPointAnalog, PtrRainGetr_t, Left_GT_Right, CPointAnalog, PtrRainGetr_t>
+            CPointAnalog, &CRainAnalog::NowY, Left_GT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tgo_GT_Tgi;
 
       std::unique_ptr<
          CFactRelatingLeftToRight<
-            CPointAnalog, PtrRainGetr_t, Left_LT_Right, CPointAnalog, PtrRainGetr_t>
+            CPointAnalog, &CRainAnalog::NowY, Left_LT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tgo_LT_Tgi;
 
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_TgiAtChargeTemp;
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_ZvTesShut;
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_QgTesZero;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_TgiAtChargeTemp;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_ZvTesShut;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_QgTesZero;
    std::unique_ptr<CFactSustained> u_QgTesNonzeroSus;
-   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_XiceZero;
+   std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_XiceZero;
    std::unique_ptr<CFactSustained> u_XiceZeroSus; 
 //======================================================================================================/ 
 // Declare direct Facts and any sustainers
@@ -427,14 +428,14 @@ class CTool_ahu_ibal : public ATool {
 //------------------------------ 
 // EQ specializations
 
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_PsasZero;
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_QasZero;
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_UdmFullOA;
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_UvcShut;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_PsasZero;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_QasZero;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_UdmFullOA;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_UvcShut;
       std::unique_ptr<CFactSustained> u_UvcShutSus;
-      std::unique_ptr< CFactRelatingLeftToParam<CFormula, PtrRainGetr_t, Left_LTE_Right> >  u_fracOAatMin;
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_GT_Right> >  u_Tam_GT_frzStat;
-      std::unique_ptr< CFactRelatingLeftToParam<CFormula, PtrRainGetr_t, Left_GTE_Right> > u_absDifTaoTar_GTE_10F;
+      std::unique_ptr< CFactRelatingLeftToParam<CFormula, &CRainAnalog::NowY, Left_LTE_Right> >  u_fracOAatMin;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_GT_Right> >  u_Tam_GT_frzStat;
+      std::unique_ptr< CFactRelatingLeftToParam<CFormula, &CRainAnalog::NowY, Left_GTE_Right> > u_absDifTaoTar_GTE_10F;
 
 
 //======================================================================================================/ 
@@ -444,7 +445,7 @@ class CTool_ahu_ibal : public ATool {
 // EQ specializations
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_EQ_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tas_EQ_TasSetpt;
 
 
@@ -452,30 +453,30 @@ class CTool_ahu_ibal : public ATool {
 // GT specializations
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_GT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_GT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tam_GT_TasSetpt;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_GTE_Right, CFormula, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_GTE_Right, CFormula, &CRainAnalog::NowY>
          >  u_Tam_GTE_minTaoTar;
 
 //------------------------------ 
 // LT specializations
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_LT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_LT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tao_LT_Tar;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_LT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_LT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tao_LT_TasSetpt;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_LT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_LT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tas_LT_Tam;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_LTE_Right, CFormula, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_LTE_Right, CFormula, &CRainAnalog::NowY>
          >  u_Tam_LTE_maxTaoTar;
 
 //======================================================================================================/ 
@@ -652,9 +653,9 @@ class CTool_vav_ibal : public ATool {
 //------------------------------ 
 // EQ specializations
 
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_QadZero;
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_UddFull;
-      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, PtrRainGetr_t, Left_EQ_Right> >  u_UvhShut;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_QadZero;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_UddFull;
+      std::unique_ptr< CFactRelatingLeftToParam<CPointAnalog, &CRainAnalog::NowY, Left_EQ_Right> >  u_UvhShut;
 
 //======================================================================================================/ 
 // CFactRelatingLeftToRight objects relate two ("left" and "right") analog values, with bool result
@@ -663,26 +664,26 @@ class CTool_vav_ibal : public ATool {
 // GT specializations
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_GT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_GT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tad_GT_Tai;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight< CPointAnalog, PtrRainGetr_t, Left_GT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight< CPointAnalog, &CRainAnalog::NowY, Left_GT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tad_GT_Taz;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight< CPointAnalog, PtrRainGetr_t, Left_GT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight< CPointAnalog, &CRainAnalog::NowY, Left_GT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Taz_GT_setptClg;
 
 //------------------------------ 
 // LT specializations
 
       std::unique_ptr<
-         CFactRelatingLeftToRight<CPointAnalog, PtrRainGetr_t, Left_LT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight<CPointAnalog, &CRainAnalog::NowY, Left_LT_Right, CPointAnalog, &CRainAnalog::NowY>
          >  u_Tad_LT_Taz;
 
       std::unique_ptr<
-         CFactRelatingLeftToRight< CPointAnalog, PtrRainGetr_t, Left_LT_Right, CPointAnalog, PtrRainGetr_t>
+         CFactRelatingLeftToRight< CPointAnalog, &CRainAnalog::NowY, Left_LT_Right, CPointAnalog, &CRainAnalog::NowY>
       >  u_Taz_LT_setptHtg;
 
 //======================================================================================================/ 
@@ -785,10 +786,14 @@ class CApplication {
 
    public:
 
-      CApplication( void );
+      CApplication( void );                        // Topology from EA_TOPOLOGY file, else built-in IBAL
+      explicit CApplication( const CTopology& );
 
       ~CApplication( void );
 
+      size_t                                          SayNumTools( void ) const;
+      MemoryCensus_t                                  SayMemoryCensus( void ) const;
+
    private:
 
       EUnitSystem                                     unitSys;
@@ -801,6 +806,14 @@ class CApplication {
       std::unique_ptr<CPortOmni>                      u_OmniPort;
       std::vector< std::unique_ptr<ATool> >           u_EachToolInApp;
 
+   // Methods
+      void                                            ConstructToolsOfEntry( const TopologyEntry_t& );
+      std::unique_ptr<ATool>                          MakeTool(   EToolType,
+                                                                  ERealName,
+                                                                  const std::vector<ERealName>& );
+      std::vector<size_t>                             SayRegistrySizes( void ) const;
+      void                                            ReserveRegistries( const std::vector<size_t>& );
+
 };
 
 
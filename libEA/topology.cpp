@@ -0,0 +1,183 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Implementation of class CTopology, which parses the declarative building description from which
+   CApplication constructs its Tools.
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#include "topology.hpp"
+#include "guiShadow.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+const char* const ENV_VAR_NAMING_TOPOLOGY_FILE = "EA_TOPOLOGY";
+
+// Built-in IBAL building.  Order of lines sets order of construction, so must not be changed casually.
+const char* const TOPOLOGY_IBAL_BUILTIN = R"(
+# tool type, real name, count, antecedent, antecedent
+ahu_ibal, AHU-1, 1, CHW Plant, HW PlantSim
+ahu_ibal, AHU-2, 1, CHW Plant, HW PlantSim
+vav_ibal, VAV-1, 1, AHU-2, HW PlantSim
+vav_ibal, VAV-2, 1, AHU-2, HW PlantSim
+vav_ibal, VAV-3, 1, AHU-1, HW PlantSim
+vav_ibal, VAV-4, 1, AHU-1, HW PlantSim
+)";
+
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+// CTopology implementation
+
+CTopology::CTopology( std::istream& source )
+                        :  entries (),
+                           numTools (0) {
+
+   std::vector<std::string>   namesDeclared;    // texts of Tool names declared on earlier lines
+   std::string                line;
+   size_t                     lineNum = 0;
+
+   while ( std::getline( source, line ) ) {
+
+      ++lineNum;
+      size_t commentAt = line.find( '#' );
+      if ( commentAt != std::string::npos ) { line.erase( commentAt ); }
+      if ( line.find_first_not_of( " \t\r" ) == std::string::npos ) { continue; }
+
+      std::vector<std::string> fields = SplitTrimmed( line, ',' );
+      if ( fields.size() < 3 ) { ThrowAtLine( lineNum, "needs at least tool type, name, and count" ); }
+
+      TopologyEntry_t entry;
+      entry.toolType = LookUpToolType( fields[0] );
+      if ( entry.toolType == EToolType::Undefined ) {
+         ThrowAtLine( lineNum, "unknown tool type \"" + fields[0] + "\"" );
+      }
+      entry.nameText = fields[1];
+      if ( entry.nameText.empty() ) { ThrowAtLine( lineNum, "empty real name" ); }
+
+      size_t countParsedChars = 0;
+      long long countParsed = 0;
+      try { countParsed = std::stoll( fields[2], &countParsedChars ); }
+      catch ( const std::exception& ) { countParsedChars = 0; }
+      if ( ( countParsedChars != fields[2].size() ) || ( countParsed < 1 ) ) {
+         ThrowAtLine( lineNum, "count must be a positive integer" );
+      }
+      entry.count = static_cast<size_t>( countParsed );
+      entry.antecedentsText.assign( fields.begin() + 3, fields.end() );
+      entry.lineInSource = lineNum;
+
+      if ( entry.antecedentsText.size() != SayNumAntecedentsRequired( entry.toolType ) ) {
+         ThrowAtLine( lineNum,   "tool type \"" + fields[0] + "\" needs " +
+                                 std::to_string( SayNumAntecedentsRequired( entry.toolType ) ) +
+                                 " antecedents" );
+      }
+      for ( const std::string& antecedent : entry.antecedentsText ) {
+         bool declaredEarlier = false;
+         for ( const std::string& declared : namesDeclared ) {
+            if ( declared == antecedent ) { declaredEarlier = true; break; }
+         }
+         if ( !declaredEarlier && ( IGuiShadow::LookUpRealName( antecedent ) == ERealName::Undefined ) ) {
+            ThrowAtLine( lineNum, "antecedent \"" + antecedent + "\" is neither built in nor declared above" );
+         }
+      }
+      for ( size_t i = 0; i < entry.count; ++i ) {
+         std::string toolName = SayNameTextOfTool( entry, i );
+         for ( const std::string& declared : namesDeclared ) {
+            if ( declared == toolName ) { ThrowAtLine( lineNum, "real name \"" + toolName + "\" repeated" ); }
+         }
+         namesDeclared.push_back( toolName );
+      }
+      numTools += entry.count;
+      entries.push_back( std::move( entry ) );
+   }
+   if ( numTools == 0 ) {
+      throw std::runtime_error( "Topology declares no Tools" ); // deliberately no catch
+   }
+}
+
+
+CTopology::~CTopology( void ) { /* Empty d-tor */ }
+
+
+CTopology CTopology::ReadFromText( const std::string& text ) {
+
+   std::istringstream source( text );
+   return CTopology( source );
+}
+
+
+CTopology CTopology::ReadFromEnvironmentOrDefault( void ) {
+
+   const char* p_filename = std::getenv( ENV_VAR_NAMING_TOPOLOGY_FILE );
+
+   if ( ( p_filename == nullptr ) || ( *p_filename == '\0' ) ) {
+      return ReadFromText( TOPOLOGY_IBAL_BUILTIN );
+   }
+   std::ifstream source( p_filename );
+   if ( !source.is_open() ) {
+      throw std::runtime_error( std::string( "Cannot open topology file " ) + p_filename ); // deliberately no catch
+   }
+   return CTopology( source );
+}
+
+
+const std::vector<TopologyEntry_t>& CTopology::SayEntries( void ) const { return entries; }
+
+size_t CTopology::SayNumTools( void ) const { return numTools; }
+
+
+std::string CTopology::SayNameTextOfTool( const TopologyEntry_t& entry, size_t indexInEntry ) {
+
+   return ( entry.count == 1 ? entry.nameText : ( entry.nameText + std::to_string( indexInEntry + 1 ) ) );
+}
+
+
+size_t CTopology::SayNumAntecedentsRequired( EToolType type ) {
+
+   switch ( type ) {
+      case EToolType::Ahu_ibal:  return 2;   // CHW plant, HW plant
+      case EToolType::Vav_ibal:  return 2;   // AHU, HW plant
+      default:                   return 0;
+   }
+}
+
+
+EToolType CTopology::LookUpToolType( const std::string& text ) {
+
+   if ( text == "ahu_ibal" ) { return EToolType::Ahu_ibal; }
+   if ( text == "vav_ibal" ) { return EToolType::Vav_ibal; }
+   return EToolType::Undefined;
+}
+
+
+std::vector<std::string> CTopology::SplitTrimmed( const std::string& line, char delimiter ) {
+
+   std::vector<std::string>   fields;
+   std::istringstream         splitter( line );
+   std::string                field;
+
+   while ( std::getline( splitter, field, delimiter ) ) {
+      size_t first = field.find_first_not_of( " \t\r" );
+      size_t last = field.find_last_not_of( " \t\r" );
+      fields.push_back( first == std::string::npos ? std::string() : field.substr( first, last - first + 1 ) );
+   }
+   return fields;
+}
+
+
+void CTopology::ThrowAtLine( size_t lineNum, const std::string& what ) {
+
+   throw std::runtime_error( "Topology line " + std::to_string( lineNum ) + ": " + what ); // deliberately no catch
+}
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
@@ -0,0 +1,98 @@
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* Source code file to an "EA" part of the ZandrEA (tm) project at: https://github.com/usnistgov/ZandrEA
+This file last edited in base repo by: DAV, U.S. National Institute of Standards and Technology (NIST).
+As a Work of the United States Government, this file is not subject to copyright within the United
+States. For other countries, Copyright 2025-2026 National Institute of Standards and Technology.
+For countries other than the United States, this file is licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance with the License. You may obtain a copy
+of the License at: https://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software distributed under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and limitations under the License. */
+//XXXXXXX1XXXXXXXXX2XXXXXXXXX3XXXXXXXXX4XXXXXXXXX5XXXXXXXXX6XXXXXXXXX7XXXXXXXXX8XXXXXXXXX9XXXXXXXXXCXXXXV
+/* File summary:
+   Declares class CTopology, which reads a declarative description of the building (which Tools, of
+   which type, under which real names, fed by which antecedent Subjects) so CApplication can construct
+   its Tools from data instead of from one hard-coded constructor call per Subject.
+*/
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C////V
+
+#ifndef TOPOLOGY_HPP
+#define TOPOLOGY_HPP
+
+#include "customTypes.hpp"
+#include <istream>
+
+enum struct EToolType : unsigned char {
+
+   Undefined = 0u,
+   Ahu_ibal,      // CTool_ahu_ibal
+   Vav_ibal       // CTool_vav_ibal
+};
+
+
+typedef struct STopologyEntry {
+
+   EToolType                  toolType;
+   std::string                nameText;            // Real name text (or its prefix, if count > 1)
+   size_t                     count;               // Number of Tools the entry declares
+   std::vector<std::string>   antecedentsText;     // Real name texts of antecedent Subjects
+   size_t                     lineInSource;        // For error messages
+
+} TopologyEntry_t;
+
+
+/////////1/////////2/////////3/////////4/////////5/////////6/////////7/////////8/////////9/////////C/////
+//  Concrete class holding the parsed topology of one application (See Class Notes)
+
+class CTopology {
+
+   public:
+   // Methods
+
+      explicit CTopology( std::istream& );
+      ~CTopology( void );
+
+      static CTopology                       ReadFromText( const std::string& );
+      static CTopology                       ReadFromEnvironmentOrDefault( void );
+
+      const std::vector<TopologyEntry_t>&    SayEntries( void ) const;
+      size_t                                 SayNumTools( void ) const;
+
+      static std::string                     SayNameTextOfTool( const TopologyEntry_t&, size_t );
+      static size_t                          SayNumAntecedentsRequired( EToolType );
+
+   private:
+   // Fields
+
+      std::vector<TopologyEntry_t>           entries;
+      size_t                                 numTools;
+
+   // Methods
+
+      static EToolType                       LookUpToolType( const std::string& );
+      static std::vector<std::string>        SplitTrimmed( const std::string&, char );
+      [[noreturn]] static void               ThrowAtLine( size_t, const std::string& );
+};
+
+/* Class Notes:   ''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+
+[1]   Text format is one Tool entry per line, fields comma-separated, blank lines and '#' comments ignored:
+
+         <tool type>, <real name>, <count>, <antecedent name>, <antecedent name>, ...
+
+      Tool types are "ahu_ibal" and "vav_ibal".  If count is 1, the real name is used as given.  If count
+      is N > 1, the real name is a prefix and Tools are named prefix1 ... prefixN (e.g., "VAV-", 300).
+      Antecedents must be real names either built in (e.g., "CHW Plant") or declared on an earlier line.
+
+[2]   ReadFromEnvironmentOrDefault() reads the file named by env variable EA_TOPOLOGY.  If that is unset
+      it returns the built-in IBAL topology, which reproduces (in order) the Tools the EA has always had.
+      An environment variable, rather than a command-line option, is used because the application is
+      constructed by the library constructor (see libmain.cpp) before main() parses any options.
+
+[3]   Malformed input throws std::runtime_error naming the offending line. Deliberately no catch; a
+      topology that cannot be honored should stop the EA before it starts, not run a partial building.
+'''End Class Notes '''*/
+
+#endif
+
+//END-OF-FILE ZZZZZ2ZZZZZZZZZ3ZZZZZZZZZ4ZZZZZZZZZ5ZZZZZZZZZ6ZZZZZZZZZ7ZZZZZZZZZ8ZZZZZZZZZ9ZZZZZZZZZCZZZZZ
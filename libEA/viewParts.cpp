@@ -24,6 +24,7 @@ See the License for the specific language governing permissions and limitations
 #include "fact.hpp"
 #include "rainfall.hpp"
 #include "controlParts.hpp"
+#include "checkpoint.hpp"
 
 #include <algorithm>
 #include <limits>
@@ -213,8 +214,9 @@ ATrace::ATrace(   EApiType bArg0,
                   CView& arg2,
                   const std::vector<NGuiKey>& arg3,
                   NGuiKey arg4,
-                  Nzint_t arg5 ) 
-                  :  IGuiShadow( bArg0 ),
+                  Nzint_t arg5,
+                  NGuiKey arg6 ) 
+                  :  IGuiShadow( bArg0, arg6 ),
                      SourceRef (arg0.SourceRef ),
                      SubjectRef (arg1),
                      ViewRef (arg2),
@@ -233,8 +235,9 @@ ATrace::ATrace(   EApiType bArg0,
                   const CRule& arg1,
                   const ASubject& arg2,
                   CView& arg3,
-                  const std::vector<NGuiKey>& arg4 ) 
-                  :  IGuiShadow( bArg0 ),
+                  const std::vector<NGuiKey>& arg4,
+                  NGuiKey arg5 ) 
+                  :  IGuiShadow( bArg0, arg5 ),
                      SourceRef (arg0.SourceRef ),
                      SubjectRef (arg2),
                      ViewRef (arg3),
@@ -260,20 +263,28 @@ EDataRange ATrace::SayRange( void ) const { return SourceRef.SayRange(); }
 
 EPlotGroup ATrace::SayPlotGroup( void ) const { return SourceRef.SayPlotGroup(); }
 
+void ATrace::AddTextBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesStrings += HeapBytesHeldBy( nameText );
+   return;
+}
+
 
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Implementation of CTraceRealtime concrete class
 
 CTraceRealtime::CTraceRealtime(  CView& bArg0,
                                  CRainAnalog& arg0,
-                                 const std::vector<NGuiKey>& arg1 ) 
+                                 const std::vector<NGuiKey>& arg1,
+                                 NGuiKey arg2 ) 
                                  :  ATrace(  EApiType::Trace_realtime_analog,
                                              arg0,
                                              arg0.SourceRef.SaySubjectRefAsConst(),
                                              bArg0,
                                              arg1,
                                              arg0.SayHistogramKey(),
-                                             0 // passed explicitly, as snapshots also use ATrace ctor
+                                             0, // passed explicitly, as snapshots also use ATrace ctor
+                                             arg2
                                     ),
                                     p_RainAnalog (&arg0),
                                     p_RainFact (nullptr),
@@ -284,14 +295,16 @@ CTraceRealtime::CTraceRealtime(  CView& bArg0,
 
 CTraceRealtime::CTraceRealtime(  CView& bArg0,
                                  CRainFact& arg0,
-                                 const std::vector<NGuiKey>& arg1 ) 
+                                 const std::vector<NGuiKey>& arg1,
+                                 NGuiKey arg2 ) 
                                  :  ATrace(  EApiType::Trace_realtime_fact,
                                              arg0,
                                              arg0.SourceRef.SaySubjectRefAsConst(),
                                              bArg0,
                                              arg1,
                                              arg0.SayHistogramKey(),
-                                             0 // passed explicitly, as snapshots also use ATrace ctor
+                                             0, // passed explicitly, as snapshots also use ATrace ctor
+                                             arg2
                                     ),
                                     p_RainAnalog (nullptr),
                                     p_RainFact (&arg0),
@@ -307,13 +320,15 @@ CTraceRealtime::CTraceRealtime(  CView& bArg0,
 CTraceRealtime::CTraceRealtime(  CView& bArg0,
                                  CRainRuleKit& arg0,
                                  const CRule& arg1,
-                                 const std::vector<NGuiKey>& arg2 )
+                                 const std::vector<NGuiKey>& arg2,
+                                 NGuiKey arg3 )
                                  :  ATrace(  EApiType::Trace_realtime_rule,
                                              arg0,
                                              arg1,
                                              arg0.SourceRef.SaySubjectRefAsConst(),
                                              bArg0,
-                                             arg2                                             
+                                             arg2,
+                                             arg3
                                     ),
                                     p_RainAnalog (nullptr),
                                     p_RainFact (nullptr),
@@ -329,44 +344,6 @@ CTraceRealtime::~CTraceRealtime( void ) { ViewRef.LoseAccessTo( this ); }
 // Public methods
 
 
-void CTraceRealtime::CaptureSnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
-
-   switch ( ownApiType ) {
-
-      case EApiType::Trace_realtime_fact:
-         p_RainFact->CaptureSnapshotForSetSgi( snapshotSetSgi );
-         break;
-
-      case EApiType::Trace_realtime_analog:
-         p_RainAnalog->CaptureSnapshotForSetSgi( snapshotSetSgi );
-         break;
-
-      default:
-         break;
-   }
-   return;
-}
-
-
-void CTraceRealtime::DestroySnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
-
-   switch ( ownApiType ) {
-
-      case EApiType::Trace_realtime_fact:
-         p_RainFact->DestroySnapshotForSetSgi( snapshotSetSgi );
-         break;
-
-      case EApiType::Trace_realtime_analog:
-         p_RainAnalog->DestroySnapshotForSetSgi( snapshotSetSgi );
-         break;
-
-      default:
-         break;
-   }
-   return;
-}
-
-
 GuiPackTraceFull_t CTraceRealtime::SayFullGuiPack( void ) const {
 
    // note that triadics test first for most likely source type, thru to least likely source type
@@ -415,24 +392,162 @@ GuiPackTraceDyna_t CTraceRealtime::SayDynamicGuiPack( void ) const {
 }
 
 
+///VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
+// Implementation of CTraceRealtimeLazy class
+
+CTraceRealtimeLazy::CTraceRealtimeLazy(   CView& bArg0,
+                                          CRainAnalog& arg0,
+                                          const std::vector<NGuiKey>& arg1 )
+                                          :  ViewRef (bArg0),
+                                             knobKeys_sourceRef (arg1),
+                                             p_RainAnalog (&arg0),
+                                             p_RainFact (nullptr),
+                                             p_RainRuleKit (nullptr),
+                                             p_Rule (nullptr),
+                                             u_Trace (nullptr),
+                                             reservedKey ( IGuiShadow::ReserveGuiKey() ),
+                                             numBorrowers (0) {  }
+
+CTraceRealtimeLazy::CTraceRealtimeLazy(   CView& bArg0,
+                                          CRainFact& arg0,
+                                          const std::vector<NGuiKey>& arg1 )
+                                          :  ViewRef (bArg0),
+                                             knobKeys_sourceRef (arg1),
+                                             p_RainAnalog (nullptr),
+                                             p_RainFact (&arg0),
+                                             p_RainRuleKit (nullptr),
+                                             p_Rule (nullptr),
+                                             u_Trace (nullptr),
+                                             reservedKey ( IGuiShadow::ReserveGuiKey() ),
+                                             numBorrowers (0) {  }
+
+CTraceRealtimeLazy::CTraceRealtimeLazy(   CView& bArg0,
+                                          CRainRuleKit& arg0,
+                                          const CRule& arg1,
+                                          const std::vector<NGuiKey>& arg2 )
+                                          :  ViewRef (bArg0),
+                                             knobKeys_sourceRef (arg2),
+                                             p_RainAnalog (nullptr),
+                                             p_RainFact (nullptr),
+                                             p_RainRuleKit (&arg0),
+                                             p_Rule (&arg1),
+                                             u_Trace (nullptr),
+                                             reservedKey ( IGuiShadow::ReserveGuiKey() ),
+                                             numBorrowers (0) {  }
+
+CTraceRealtimeLazy::~CTraceRealtimeLazy( void ) {  }   // any Trace still borrowed goes with u_Trace
+
+//=====================================================================================================/
+// Public methods
+
+NGuiKey CTraceRealtimeLazy::SayGuiKey( void ) const { return reservedKey; }
+
+
+bool CTraceRealtimeLazy::IsTraceConstructed( void ) const { return ( u_Trace != nullptr ); }
+
+
+void CTraceRealtimeLazy::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesTraces += sizeof(CTraceRealtimeLazy);
+   if ( u_Trace ) {
+      censusRef.bytesTraces += sizeof(CTraceRealtime);
+      u_Trace->AddTextBytesHeldTo( censusRef );
+   }
+   return;
+}
+
+
+const CTraceRealtime* CTraceRealtimeLazy::BorrowTrace( void ) {
+
+   if ( u_Trace == nullptr ) {
+
+      u_Trace = (  ( p_RainAnalog != nullptr ) ?
+                     std::make_unique<CTraceRealtime>(   ViewRef,
+                                                         *p_RainAnalog,
+                                                         knobKeys_sourceRef,
+                                                         reservedKey ) :
+                     ( p_RainFact != nullptr ) ?
+                        std::make_unique<CTraceRealtime>(   ViewRef,
+                                                            *p_RainFact,
+                                                            knobKeys_sourceRef,
+                                                            reservedKey ) :
+                        std::make_unique<CTraceRealtime>(   ViewRef,
+                                                            *p_RainRuleKit,
+                                                            *p_Rule,
+                                                            knobKeys_sourceRef,
+                                                            reservedKey )
+      );
+   }
+   ++numBorrowers;
+   return u_Trace.get();
+}
+
+
+void CTraceRealtimeLazy::ReturnTrace( void ) {
+
+   if ( numBorrowers == 0 ) {
+
+      throw std::logic_error( "Realtime Trace returned more times than borrowed" );
+      // deliberately no catch
+   }
+   if ( --numBorrowers == 0 ) { u_Trace.reset( nullptr ); }
+   return;
+}
+
+
+void CTraceRealtimeLazy::CaptureSnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
+
+   if ( p_RainFact != nullptr ) { p_RainFact->CaptureSnapshotForSetSgi( snapshotSetSgi ); }
+   else if ( p_RainAnalog != nullptr ) { p_RainAnalog->CaptureSnapshotForSetSgi( snapshotSetSgi ); }
+   return;
+}
+
+
+void CTraceRealtimeLazy::DestroySnapshotForSetSgi( Nzint_t snapshotSetSgi ) {
+
+   if ( p_RainFact != nullptr ) { p_RainFact->DestroySnapshotForSetSgi( snapshotSetSgi ); }
+   else if ( p_RainAnalog != nullptr ) { p_RainAnalog->DestroySnapshotForSetSgi( snapshotSetSgi ); }
+   return;
+}
+
+//=====================================================================================================/
+// Private methods
+
+const ARainfall& CTraceRealtimeLazy::SayRainUpcast( void ) const {
+
+   return (  ( p_RainAnalog != nullptr ) ?
+               static_cast<const ARainfall&>( *p_RainAnalog ) :
+               ( p_RainFact != nullptr ) ?
+                  static_cast<const ARainfall&>( *p_RainFact ) :
+                  static_cast<const ARainfall&>( *p_RainRuleKit ) );
+}
+
+
 ///VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Implementation of CTraceSnapshot concrete class
 
-CTraceSnapshot::CTraceSnapshot(  const CTraceRealtime& rtRef,
+CTraceSnapshot::CTraceSnapshot(  const CTraceRealtimeLazy& rtRef,
                                  Nzint_t snapshotSetSgi ) 
                                  :  ATrace(
-                                       (  ( rtRef.ownApiType == EApiType::Trace_realtime_fact ) ?
+                                       (  ( rtRef.p_RainFact != nullptr ) ?
                                              EApiType::Trace_snapshot_fact :
-                                             ( rtRef.ownApiType == EApiType::Trace_realtime_analog ) ?
+                                             ( rtRef.p_RainAnalog != nullptr ) ?
                                                 EApiType::Trace_snapshot_analog :
                                                 EApiType::Trace_snapshot_rule
                                        ),
-                                       rtRef.RainRef_upcast,                                          
-                                       rtRef.SubjectRef,
+                                       rtRef.SayRainUpcast(),
+                                       rtRef.SayRainUpcast().SourceRef.SaySubjectRefAsConst(),
                                        rtRef.ViewRef,
                                        rtRef.knobKeys_sourceRef,
-                                       rtRef.histogramKey_source,
-                                       rtRef.ruleUai
+                                       (  ( rtRef.p_RainAnalog != nullptr ) ?
+                                             rtRef.p_RainAnalog->SayHistogramKey() :
+                                             ( rtRef.p_RainFact != nullptr ) ?
+                                                rtRef.p_RainFact->SayHistogramKey() :
+                                                rtRef.p_RainRuleKit->SayKeyToHistogramOfRule(
+                                                   rtRef.p_Rule->SayRuleUai() )
+                                       ),
+                                       (  ( rtRef.p_Rule != nullptr ) ? rtRef.p_Rule->SayRuleUai() : 0 ),
+                                       NGuiKey(0)  // snapshot Traces are mortal, so get fresh key
                                     ),
                                     p_RainAnalog ( rtRef.p_RainAnalog ),
                                     p_RainFact ( rtRef.p_RainFact ),
@@ -447,8 +562,8 @@ CTraceSnapshot::CTraceSnapshot(  const CTraceRealtime& rtRef,
       a much shorter lookup), so they appear on View immediately upon construction and are vanished only
       upon destruction.
 
-[2]   No calls needed by c-tor to populate histogram and knob key lists; those are copied from
-      progenitor realtime trace
+[2]   No calls needed by c-tor to populate histogram and knob key lists; those are copied from the
+      stand-in of progenitor realtime trace, which need not itself exist at the time
 
 '' End Method Notes ''' */   
 
@@ -684,7 +799,8 @@ AKrono::AKrono(   EApiType bArg0,
                      caption (arg3),
                      secsPerIndex_sharedTimeAxis ( arg0.SaySecsPerCycle() ),
                      numIndicies_sharedTimeAxis ( START_DATALOG_SECSLOGGING / arg0.SaySecsPerCycle() ),
-                     snapshotSetSgi (arg4) {
+                     snapshotSetSgi (arg4),
+                     timeOfLatestGuiRequest ( std::chrono::steady_clock::now() ) {
 
    // register/unregister with CView at subclass level even when View holds base class handle
 }
@@ -732,6 +848,20 @@ void AKrono::SetSecsLookingBack( int secsWanted ) {
 }
 
 
+void AKrono::NoteRequestFromGui( void ) {
+
+   timeOfLatestGuiRequest = std::chrono::steady_clock::now();
+   return;
+}
+
+
+bool AKrono::HasGoneUnrequestedForSecs( int secsIdle ) const {
+
+   return ( ( std::chrono::steady_clock::now() - timeOfLatestGuiRequest ) >
+               std::chrono::seconds( secsIdle ) );
+}
+
+
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Concrete class for realtime krono
 
@@ -1019,6 +1149,55 @@ SHistoSliceRuleKit::SHistoSliceRuleKit( size_t arg1,  // number of rules in rule
 }
 
 
+void SHistoSliceAnalog::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.Exchange( binSums_analogValue );
+   checkpointRef.Exchange( binSums_analogState );
+   checkpointRef.Exchange( timeOfFrontEdge );
+   return;
+}
+
+
+void SHistoSliceFact::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.Exchange( binSums_factState );
+   checkpointRef.Exchange( timeOfFrontEdge );
+   return;
+}
+
+
+void SHistoSliceRule::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.Exchange( binSums_ruleState );
+   checkpointRef.Exchange( timeOfFrontEdge );
+   return;
+}
+
+
+void SHistoSliceRuleKit::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.Exchange( binSums_validsOnEachRule_barsLeftToRight );
+   checkpointRef.Exchange( binSums_testsOnEachRule_barsLeftToRight );
+   checkpointRef.Exchange( binSums_failsOnEachRule_barsLeftToRight );
+   checkpointRef.Exchange( timeOfFrontEdge );
+   return;
+}
+
+
+template <typename TTSlice>
+static void ExchangeSliceLogWith( CCheckpoint& checkpointRef, std::deque<TTSlice>& sliceLogRef ) {
+
+   // Slice logs keep the length given by histogram c-tor, so only slice contents are exchanged
+   size_t numSlices = sliceLogRef.size();
+   checkpointRef.Exchange( numSlices );
+   if ( numSlices != sliceLogRef.size() ) {
+      throw std::runtime_error( "Checkpoint holds histogram slice log of another length" );
+   }
+   for ( auto& sliceRef : sliceLogRef ) { sliceRef.ExchangeStateWith( checkpointRef ); }
+   return;
+}
+
+
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Histogram abstract base class implementation
 
@@ -1033,6 +1212,12 @@ std::array<std::string,3> AHistogram::spanLabels = {  "Moving hr",
                                                       "Past 24hr",
                                                       "Past 7days" };
 
+// Bar label legends (caption lines 5 and 6), shared by all histograms of a type. See Class Note [3]
+const std::array<std::string,2> AHistogram::barLabelLegend_none = { "", "" };
+const std::array<std::string,2> AHistogram::barLabelLegend_rule = {
+                                    "Mark: F=fail, P=pass, S=skip, X=invalid, U=unavail",
+                                    "Mode: a=auto, c=case, i=idle" };
+
 //======================================================================================================/
 
 AHistogram::AHistogram( const ASubject& arg0,
@@ -1044,8 +1229,7 @@ AHistogram::AHistogram( const ASubject& arg0,
                            ViewRef ( arg0.SayViewRef() ),
                            knobKeys_sourceRef (arg2),
                            captionTextLine_sourceInfo ( LookUpTag( arg1.SayLabel() ) ),
-                           captionTextLine_barLabelLegend_1 (""),
-                           captionTextLine_barLabelLegend_2 (""),
+                           captionTextLines_barLabelLegend (barLabelLegend_none),
                            movingHourSpanInSourceCycles (arg3),
                            secsPerSourceCycle ( arg1.SaySecsPerCycle() ),
                            modeActive (EInfoMode::Histo_analog_valuesOverValidCycles),
@@ -1065,8 +1249,7 @@ AHistogram::AHistogram( const ASubject& arg0,
                            ViewRef ( arg0.SayViewRef() ),
                            knobKeys_sourceRef (arg2),
                            captionTextLine_sourceInfo ( LookUpTag( arg1.SayLabel() ) ),
-                           captionTextLine_barLabelLegend_1 (""),
-                           captionTextLine_barLabelLegend_2 (""),
+                           captionTextLines_barLabelLegend (barLabelLegend_none),
                            movingHourSpanInSourceCycles (arg3),
                            secsPerSourceCycle ( arg1.SaySecsPerCycle() ),
                            modeActive (EInfoMode::Histo_analog_valuesOverValidCycles),
@@ -1086,8 +1269,7 @@ AHistogram::AHistogram( const ASubject& arg0,
                            ViewRef ( arg0.SayViewRef() ),
                            knobKeys_sourceRef (arg2),
                            captionTextLine_sourceInfo ( LookUpTag( arg1.SayLabel() ) ),
-                           captionTextLine_barLabelLegend_1 (""),
-                           captionTextLine_barLabelLegend_2 (""),
+                           captionTextLines_barLabelLegend (barLabelLegend_none),
                            movingHourSpanInSourceCycles (arg3),
                            secsPerSourceCycle ( arg1.SaySecsPerCycle() ),
                            modeActive (EInfoMode::Histo_fact_statesOverAllCycles),
@@ -1112,9 +1294,7 @@ AHistogram::AHistogram( const ASubject& arg0,
                                                          ":" + arg2.SayKitSgiOfNumberAsText() + " :" +
                                                          arg1.SayRuleUaiText() // includes "Rule-"
                            ),
-                           captionTextLine_barLabelLegend_1
-                              ("Mark: F=fail, P=pass, S=skip, X=invalid, U=unavail"),
-                           captionTextLine_barLabelLegend_2 ("Mode: a=auto, c=case, i=idle"), 
+                           captionTextLines_barLabelLegend (barLabelLegend_rule),
                            movingHourSpanInSourceCycles (arg4),
                            secsPerSourceCycle ( arg2.SaySecsPerCycle() ),
                            modeActive (EInfoMode::Histo_rule_statesOverAllCycles),
@@ -1136,8 +1316,7 @@ AHistogram::AHistogram( const ASubject& arg0,
                            ViewRef ( arg0.SayViewRef() ),
                            knobKeys_sourceRef (arg2),
                            captionTextLine_sourceInfo ( arg1.SayKitCaption() ),
-                           captionTextLine_barLabelLegend_1 (""),
-                           captionTextLine_barLabelLegend_2 (""),
+                           captionTextLines_barLabelLegend (barLabelLegend_none),
                            movingHourSpanInSourceCycles (arg3),
                            secsPerSourceCycle ( arg1.SaySecsPerCycle() ),
                            modeActive (EInfoMode::Histo_ruleKit_failsOverTests),
@@ -1162,8 +1341,8 @@ std::vector<std::string> AHistogram::GenerateCaptionText( time_t frontEdgeTime )
    caption[1] = second line, mode of histogram (a constant only for Facts (which have one mode)) 
    caption[2] = third line, span of histogram (lookback time) per ETimeSpan defns available
    caption[3] = fourth line, saying time of histogram "front edge"
-   caption[4] = captionTextLine_barLabelLegend_1, which can be empty
-   caption[5] = captionTextLine_barLabelLegend_2, which can be empty
+   caption[4] = captionTextLines_barLabelLegend[0], which can be empty
+   caption[5] = captionTextLines_barLabelLegend[1], which can be empty
 */
    std::string frontEdgeTimeAsText = ""; 
    WriteTimestampAsTextTo( frontEdgeTime, frontEdgeTimeAsText );
@@ -1173,8 +1352,8 @@ std::vector<std::string> AHistogram::GenerateCaptionText( time_t frontEdgeTime )
                                        "Showing: " + LookUpText( modeActive ),
                                        "Look back: " + LookUpText( spanActive ),
                                        "From: " + frontEdgeTimeAsText,
-                                        captionTextLine_barLabelLegend_1,
-                                        captionTextLine_barLabelLegend_2 } );
+                                        captionTextLines_barLabelLegend[0],
+                                        captionTextLines_barLabelLegend[1] } );
 }
 
 
@@ -1201,6 +1380,18 @@ EGuiReply AHistogram::SetModeActiveToOptionIndex( size_t indexGivenByUser ) {
 }
 
 
+void AHistogram::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   checkpointRef.ExchangeTag( "histogram" );
+   checkpointRef.Exchange( modeActive );
+   checkpointRef.Exchange( spanActive );
+   checkpointRef.Exchange( modeActive_index );
+   checkpointRef.Exchange( spanActive_index );
+   checkpointRef.Exchange( firstCycle );
+   return;
+}
+
+
 
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
 // Concrete class for histograms owned by analog-handling sources (points, formula, charts)
@@ -1302,6 +1493,26 @@ CHistogramAnalog::~CHistogramAnalog( void ) {
 }
 
 
+void CHistogramAnalog::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesHistograms += (   sizeof(CHistogramAnalog) +
+                                    HeapBytesHeldBy( sliceLog_past24clockHrs ) +
+                                    HeapBytesHeldBy( sliceLog_past7calendarDays ) );
+   censusRef.bytesStrings += HeapBytesHeldBy( captionTextLine_sourceInfo );
+   return;
+}
+
+
+void CHistogramAnalog::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   AHistogram::ExchangeStateWith( checkpointRef );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past24clockHrs );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past7calendarDays );
+   realtimeSlice_movingHour.ExchangeStateWith( checkpointRef );
+   return;
+}
+
+
 std::vector<GuiFpn_t>
 CHistogramAnalog::GenerateBarHeightsFromSlice( const SHistoSliceAnalog& sliceRef ) {
 
@@ -1606,6 +1817,26 @@ CHistogramFact::~CHistogramFact( void ) {
 
 }
 
+
+void CHistogramFact::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesHistograms += (   sizeof(CHistogramFact) +
+                                    HeapBytesHeldBy( sliceLog_past24clockHrs ) +
+                                    HeapBytesHeldBy( sliceLog_past7calendarDays ) );
+   censusRef.bytesStrings += HeapBytesHeldBy( captionTextLine_sourceInfo );
+   return;
+}
+
+
+void CHistogramFact::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   AHistogram::ExchangeStateWith( checkpointRef );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past24clockHrs );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past7calendarDays );
+   realtimeSlice_movingHour.ExchangeStateWith( checkpointRef );
+   return;
+}
+
 //======================================================================================================/
 
 std::vector<GuiFpn_t>
@@ -1815,6 +2046,26 @@ CHistogramRule::~CHistogramRule( void ) {
 }
 
 
+void CHistogramRule::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesHistograms += (   sizeof(CHistogramRule) +
+                                    HeapBytesHeldBy( sliceLog_past24clockHrs ) +
+                                    HeapBytesHeldBy( sliceLog_past7calendarDays ) );
+   censusRef.bytesStrings += HeapBytesHeldBy( captionTextLine_sourceInfo );
+   return;
+}
+
+
+void CHistogramRule::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   AHistogram::ExchangeStateWith( checkpointRef );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past24clockHrs );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past7calendarDays );
+   realtimeSlice_movingHour.ExchangeStateWith( checkpointRef );
+   return;
+}
+
+
 //======================================================================================================/
 
 std::vector<GuiFpn_t>
@@ -2034,6 +2285,42 @@ CHistogramRuleKit::~CHistogramRuleKit( void ) {
 
 }
 
+
+void CHistogramRuleKit::AddBytesHeldTo( MemoryCensus_t& censusRef ) const {
+
+   censusRef.bytesHistograms += (   sizeof(CHistogramRuleKit) +
+                                    HeapBytesHeldBy( sliceLog_past24clockHrs ) +
+                                    HeapBytesHeldBy( sliceLog_past7calendarDays ) );
+
+   // Unlike other slice types, each Rule Kit slice holds its bin sums on the heap
+   auto AddSliceVectors = [&censusRef]( const SHistoSliceRuleKit& sliceRef ) {
+      censusRef.bytesHistograms +=
+         HeapBytesHeldBy( sliceRef.binSums_validsOnEachRule_barsLeftToRight ) +
+         HeapBytesHeldBy( sliceRef.binSums_testsOnEachRule_barsLeftToRight ) +
+         HeapBytesHeldBy( sliceRef.binSums_failsOnEachRule_barsLeftToRight );
+   };
+   for ( const auto& sliceCref : sliceLog_past24clockHrs ) { AddSliceVectors( sliceCref ); }
+   for ( const auto& sliceCref : sliceLog_past7calendarDays ) { AddSliceVectors( sliceCref ); }
+   AddSliceVectors( realtimeSlice_movingHour );
+
+   censusRef.bytesStrings += HeapBytesHeldBy( captionTextLine_sourceInfo );
+   censusRef.bytesStrings += HeapBytesHeldBy( barLabels_ruleIdentifiers );
+   for ( const auto& labelCref : barLabels_ruleIdentifiers ) {
+      censusRef.bytesStrings += HeapBytesHeldBy( labelCref );
+   }
+   return;
+}
+
+
+void CHistogramRuleKit::ExchangeStateWith( CCheckpoint& checkpointRef ) {
+
+   AHistogram::ExchangeStateWith( checkpointRef );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past24clockHrs );
+   ExchangeSliceLogWith( checkpointRef, sliceLog_past7calendarDays );
+   realtimeSlice_movingHour.ExchangeStateWith( checkpointRef );
+   return;
+}
+
 //======================================================================================================/
 
 
@@ -19,6 +19,7 @@ See the License for the specific language governing permissions and limitations
 
 #include "guiShadow.hpp"   // brings "customTypes.hpp"
 
+#include <chrono>
 #include <functional>
 #include <queue>
 
@@ -28,6 +29,7 @@ class ARainfall;
 class ASubject;
 
 class CCase;
+class CCheckpoint;
 class CController;
 class CFormula;
 class CKnobSint;
@@ -197,6 +199,7 @@ class ATrace : public IGuiShadow {
       EDataUnit                        SayUnits( void ) const;             // for compat. check on traces
       EDataRange                       SayRange( void ) const;             // for compat. check on traces
       EPlotGroup                       SayPlotGroup( void ) const;
+      void                             AddTextBytesHeldTo( MemoryCensus_t& ) const;
 
    protected:
 
@@ -222,14 +225,16 @@ class ATrace : public IGuiShadow {
                CView&,
                const std::vector<NGuiKey>&,
                NGuiKey,
-               Nzint_t );
+               Nzint_t,
+               NGuiKey );     // own key if reserved earlier, else NGuiKey(0) to generate one
 
       ATrace(  EApiType,
                const CRainRuleKit&,
                const CRule&,
                const ASubject&,  
                CView&,
-               const std::vector<NGuiKey>& );
+               const std::vector<NGuiKey>&,
+               NGuiKey );
 
 /* Begin Class Notes '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 
@@ -254,36 +259,104 @@ class CTraceRealtime : public ATrace {
    public:
    // Methods
 
+      // Constructed only by a CTraceRealtimeLazy, adopting key it reserved (See its Class Note [1])
+
       CTraceRealtime(   CView&,
-                        CRainAnalog&,                    // cannot be const, re. snapshot capture/destroy
-                        const std::vector<NGuiKey>& );   // keys to source's own and antecedent knob(s)
+                        CRainAnalog&,
+                        const std::vector<NGuiKey>&,     // keys to source's own and antecedent knob(s)
+                        NGuiKey );
 
       CTraceRealtime(   CView&,
                         CRainFact&,
-                        const std::vector<NGuiKey>& );
+                        const std::vector<NGuiKey>&,
+                        NGuiKey );
 
       CTraceRealtime(   CView&,
                         CRainRuleKit&,
                         const CRule&,
-                        const std::vector<NGuiKey>& );
+                        const std::vector<NGuiKey>&,
+                        NGuiKey );
 
       ~CTraceRealtime( void );
 
       virtual GuiPackTraceFull_t    SayFullGuiPack( void ) const override;
       virtual GuiPackTraceDyna_t    SayDynamicGuiPack( void ) const override;
 
-      void                          CaptureSnapshotForSetSgi( Nzint_t );
-      void                          DestroySnapshotForSetSgi( Nzint_t );
+   private:
+
+   // Handles
+      CRainAnalog* const            p_RainAnalog;
+      CRainFact* const              p_RainFact;
+      CRainRuleKit* const           p_RainRuleKit;
+};
+
+
+//======================================================================================================/
+// Stand-in owned by the source of a realtime Trace, which constructs the Trace only while borrowed
+
+class CTraceRealtimeLazy {
+
+   public:
+   // Methods
+
+      CTraceRealtimeLazy(  CView&,
+                           CRainAnalog&,                 // cannot be const, re. snapshot capture/destroy
+                           const std::vector<NGuiKey>& );
+
+      CTraceRealtimeLazy(  CView&,
+                           CRainFact&,
+                           const std::vector<NGuiKey>& );
+
+      CTraceRealtimeLazy(  CView&,
+                           CRainRuleKit&,
+                           const CRule&,
+                           const std::vector<NGuiKey>& );
 
+      ~CTraceRealtimeLazy( void );
+
+      NGuiKey                          SayGuiKey( void ) const;   // key Trace has whenever it exists
+      bool                             IsTraceConstructed( void ) const;
+      void                             AddBytesHeldTo( MemoryCensus_t& ) const;
+
+      const CTraceRealtime*            BorrowTrace( void );       // See Class Note [2]
+      void                             ReturnTrace( void );
+
+      void                             CaptureSnapshotForSetSgi( Nzint_t );
+      void                             DestroySnapshotForSetSgi( Nzint_t );
 
    private:
 
       friend class CTraceSnapshot;
 
    // Handles
-      CRainAnalog* const            p_RainAnalog;
-      CRainFact* const              p_RainFact;
-      CRainRuleKit* const           p_RainRuleKit;
+      CView&                           ViewRef;
+      const std::vector<NGuiKey>&      knobKeys_sourceRef;
+      CRainAnalog* const               p_RainAnalog;
+      CRainFact* const                 p_RainFact;
+      CRainRuleKit* const              p_RainRuleKit;
+      const CRule* const               p_Rule;           // non-null only for Trace of a Rule
+      std::unique_ptr<CTraceRealtime>  u_Trace;          // null unless borrowed
+
+   // Fields
+      const NGuiKey                    reservedKey;
+      unsigned int                     numBorrowers;
+
+   // Methods
+      const ARainfall&                 SayRainUpcast( void ) const;
+
+/* Begin Class Notes '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
+
+[1]   Only Kronos show r-t Traces to the GUI, and a GUI loads only a few Kronos at once, so every Point,
+      Formula, Fact, and Rule owns this stand-in instead of its Trace.  Stand-in reserves the Trace key
+      at c-tor (i.e., same point in start-up as Trace c-tor was before), so all keys handed to the GUI are
+      unchanged.  All data a Trace shows is held in the source's rainfall, so none is lost on destruction.
+
+[2]   Borrows are counted, as Kronos of different Rule Kits can share antecedents.  Trace is constructed
+      (and gains View access) on first borrow, and is destroyed on last return.  Snapshot capture and
+      Snapshot Traces go direct to rainfall, so never need the r-t Trace.
+
+'' End Class Notes */
+
 };
 
 
@@ -295,7 +368,7 @@ class CTraceSnapshot : public ATrace {
    public:
    // Methods
 
-      CTraceSnapshot(   const CTraceRealtime&,
+      CTraceSnapshot(   const CTraceRealtimeLazy&,
                         Nzint_t );
 
       ~CTraceSnapshot( void );
@@ -415,6 +488,8 @@ class AKrono : public IGuiShadow {
       size_t                        SayNumCyclesLookingBack( void ) const;
       int                           GetSecsLookingBack( void ) const;
       void                          SetSecsLookingBack( int );
+      void                          NoteRequestFromGui( void );         // See Class Note [2]
+      bool                          HasGoneUnrequestedForSecs( int ) const;
   
    protected:
 
@@ -430,6 +505,7 @@ class AKrono : public IGuiShadow {
       int                        secsPerIndex_sharedTimeAxis;
       size_t                     numIndicies_sharedTimeAxis;
       const Nzint_t              snapshotSetSgi;         // = 0 for realtime Krono
+      std::chrono::steady_clock::time_point  timeOfLatestGuiRequest;   // host clock, not data time
 
    // Methods
       AKrono(  EApiType,
@@ -443,6 +519,9 @@ class AKrono : public IGuiShadow {
 
 [1]   Virtualized only to allow "FAIL" return if a snapshot krono is asked for dynamic update.
 
+[2]   CView notes each GUI request for a Krono's packs.  A realtime Krono the GUI has stopped polling is
+      released by its Rule Kit after FIXED_KRONO_REALTIME_SECSIDLE_MAX secs, returning borrowed Traces.
+
 ''' END Class Notes ''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 */
 
@@ -540,6 +619,8 @@ struct SHistoSliceAnalog {
                        ETimeSpan,
                        bool = false );
 
+   void  ExchangeStateWith( CCheckpoint& );     // const fields are rebuilt by histogram c-tor
+
 /* ''' START Class Notes '''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''''/
 
 [1]   If bins are a 'closed set' on all possible values/states, then count_allCycles remains a constant
@@ -571,6 +652,8 @@ struct SHistoSliceFact {
                     ETimeSpan,
                     bool = false  );
 
+   void  ExchangeStateWith( CCheckpoint& );
+
 };
 
 //======================================================================================================/
@@ -590,6 +673,8 @@ struct SHistoSliceRule {
                     ETimeSpan,
                     bool = false );
 
+   void  ExchangeStateWith( CCheckpoint& );
+
 };
 
 //======================================================================================================/
@@ -597,9 +682,9 @@ struct SHistoSliceRule {
 
 struct SHistoSliceRuleKit {
 
-   std::vector<BinSum_t>            binSums_validsOnEachRule_barsLeftToRight;
-   std::vector<BinSum_t>            binSums_testsOnEachRule_barsLeftToRight;
-   std::vector<BinSum_t>            binSums_failsOnEachRule_barsLeftToRight;
+   std::vector<BinSumHeld_t>        binSums_validsOnEachRule_barsLeftToRight;
+   std::vector<BinSumHeld_t>        binSums_testsOnEachRule_barsLeftToRight;
+   std::vector<BinSumHeld_t>        binSums_failsOnEachRule_barsLeftToRight;
    const size_t                     numRulesInKit;
    const size_t                     numCyclesInSpan;
    time_t                           timeOfFrontEdge;
@@ -612,6 +697,8 @@ struct SHistoSliceRuleKit {
                        int,           // source secsPerCycle
                        ETimeSpan );
 
+   void  ExchangeStateWith( CCheckpoint& );
+
 };
 
 //VVVVVVV1VVVVVVVVV2VVVVVVVVV3VVVVVVVVV4VVVVVVVVV5VVVVVVVVV6VVVVVVVVV7VVVVVVVVV8VVVVVVVVV9VVVVVVVVVCVVVVV
@@ -651,6 +738,8 @@ class AHistogram : public IGuiShadow {
       virtual EGuiReply             SetModeActiveToOptionIndex( size_t );
       EGuiReply                     SetSpanActiveToOptionIndex( size_t );
       std::string                   SayIdentifyingText( void ) const;      // used by exported API (?)
+      virtual void                  AddBytesHeldTo( MemoryCensus_t& ) const = 0;
+      virtual void                  ExchangeStateWith( CCheckpoint& );     // subclasses add slices
 
 
    protected:
@@ -689,9 +778,10 @@ class AHistogram : public IGuiShadow {
    // Fields
       static std::array<ETimeSpan,3>      spansSupported;
       static std::array<std::string,3>    spanLabels;
+      static const std::array<std::string,2>  barLabelLegend_none;
+      static const std::array<std::string,2>  barLabelLegend_rule;
       const std::string                   captionTextLine_sourceInfo;
-      const std::string                   captionTextLine_barLabelLegend_1; // see Class Note [3]
-      const std::string                   captionTextLine_barLabelLegend_2; 
+      const std::array<std::string,2>&    captionTextLines_barLabelLegend; // see Class Note [3]
       const size_t                        movingHourSpanInSourceCycles;
       const int                           secsPerSourceCycle;
       EInfoMode                           modeActive;
@@ -715,14 +805,15 @@ class AHistogram : public IGuiShadow {
          caption[1] = second line, mode of histogram (a constant only for Facts (which have one mode)) 
          caption[2] = third line, span of histogram (lookback time) per ETimeSpan defns available
          caption[3] = fourth line, saying time of histogram "front edge"
-         caption[4] = captionTextLine_barLabelLegend_1, which can be empty
-         caption[5] = captionTextLine_barLabelLegend_2, which can be empty 
+         caption[4] = captionTextLines_barLabelLegend[0], which can be empty
+         caption[5] = captionTextLines_barLabelLegend[1], which can be empty 
       The only surely static information in caption is the source-description part of the top line
       Second and third lines are user-selectable via EInfoMode and ETimeSpan, respectively
 
 [3]   Empty unless concrete subclass needs it (typ when there are so many bars that very abbreviated
       bar labels are needed, so translation lines in caption are also needed).  In that case the
-      subclass c-tor loads it.      
+      subclass c-tor loads it.  Legend lines are the same for every histogram of a given type, so each
+      histogram refers to one static pair rather than holding its own copies of the text.
 */
 
 };
@@ -752,6 +843,8 @@ class CHistogramAnalog : public AHistogram {
       ~CHistogramAnalog( void );
 
       virtual GuiPackHistogram_t    SayGuiPack( void ) override;
+      virtual void                  AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void                  ExchangeStateWith( CCheckpoint& ) override;
       virtual EGuiReply             SetModeActiveToOptionIndex( size_t ) override;
       void                          Cycle(   time_t,
                                              bool,
@@ -812,6 +905,8 @@ class CHistogramFact : public AHistogram {
       ~CHistogramFact( void );
 
       virtual GuiPackHistogram_t    SayGuiPack( void ) override;
+      virtual void                  AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void                  ExchangeStateWith( CCheckpoint& ) override;
       void                          Cycle(   time_t,
                                              bool,
                                              bool,
@@ -851,6 +946,8 @@ class CHistogramRule : public AHistogram {
       ~CHistogramRule( void );
 
       virtual GuiPackHistogram_t    SayGuiPack( void ) override;
+      virtual void                  AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void                  ExchangeStateWith( CCheckpoint& ) override;
       void                          Cycle(   time_t,
                                              bool,
                                              bool,
@@ -890,6 +987,8 @@ class CHistogramRuleKit : public AHistogram {
       ~CHistogramRuleKit( void );
 
       virtual GuiPackHistogram_t    SayGuiPack( void ) override;
+      virtual void                  AddBytesHeldTo( MemoryCensus_t& ) const override;
+      virtual void                  ExchangeStateWith( CCheckpoint& ) override;
       virtual EGuiReply             SetModeActiveToOptionIndex( size_t ) override;
       void                          Cycle(   time_t,
                                              bool,